@@ -151,6 +151,21 @@ char* route_api(const char* path, const char* api_root);
  */
 char* route_static_files(const char* path, const char* static_root);
 
+/**
+ * Serve a static file from the precompiled response cache
+ * Headers are serialized once per file; hits are written with writev/sendfile
+ * and answered with 304 when if_none_match matches the file's ETag.
+ * @param client_socket Connected client socket
+ * @param path Request path
+ * @param static_root Static files root directory
+ * @param if_none_match If-None-Match request header value (may be NULL)
+ * @param keep_alive Non-zero to answer with Connection: keep-alive
+ * @param head_only Non-zero for HEAD requests (headers only)
+ * @return HTTP status sent (200 or 304), 0 if the file was not found, -1 on write failure
+ */
+int serve_static_file(int client_socket, const char* path, const char* static_root,
+                      const char* if_none_match, int keep_alive, int head_only);
+
 /**
  * Route temporary URL requests for domains during DNS propagation
  * Format: /?user=username/ -> /web/username/working-dir/
@@ -186,6 +201,8 @@ void startup_procedure_validation_health_status();
 #ifdef __cplusplus
 }
 
+#include "medusaserv_hot_response.hpp"
+
 // C++ namespace access for advanced users
 namespace medusaserv {
 namespace pathing {
@@ -209,6 +226,8 @@ namespace pathing {
     }
     namespace static_files {
         char* route(const char* path, const char* static_root);
+        // Cached, precompiled response for the file route() resolves to
+        medusaserv::http::HotResponsePtr serve(const char* path, const char* static_root);
     }
     namespace temporary_url {
         char* route(const char* query_string, const char* web_root);
@@ -35,7 +35,12 @@
 #include <optional>
 #include <variant>
 #include <map>
+#include <list>
+#include <unordered_map>
 #include <mutex>
+#include <atomic>
+#include <future>
+#include <algorithm>
 #include <stdexcept>
 #include <chrono>
 #include <thread>
@@ -281,21 +286,144 @@ struct KeyPairResult {
     std::string yorkshire_comment;
 };
 
+using SecureKey = SecureVector<uint8_t>;
+
+// Derived key cache - PBKDF2 runs once per (password, context, length), not per call
+// Passwords are never stored: entries are keyed by an HMAC of the password under a
+// per-process random key. Keys live in secure memory and are wiped when the last
+// holder drops them (eviction, expiry or clear()).
+class DerivedKeyCache {
+public:
+    static constexpr size_t SHARD_COUNT = 16;
+    static constexpr size_t ENTRIES_PER_SHARD = 32;
+    static constexpr std::chrono::minutes TIME_TO_LIVE{10};
+    
+    static DerivedKeyCache& instance() {
+        static DerivedKeyCache cache;
+        return cache;
+    }
+    
+    // Concurrent misses on the same key wait for one derivation instead of each running PBKDF2
+    template<typename Derive>
+    std::shared_ptr<const SecureKey> getOrDerive(const std::string& password, const std::string& context,
+                                                 size_t key_length, Derive&& derive) {
+        std::string fingerprint = fingerprintOf(password, context, key_length);
+        Shard& shard = shards_[std::hash<std::string>()(fingerprint) % SHARD_COUNT];
+        auto now = std::chrono::steady_clock::now();
+        std::promise<std::shared_ptr<const SecureKey>> promise;
+        std::shared_future<std::shared_ptr<const SecureKey>> cached;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.entries.find(fingerprint);
+            if (it != shard.entries.end() && now - it->second.created < TIME_TO_LIVE) {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second.position);
+                cached = it->second.key;
+            } else if (it != shard.entries.end()) {
+                shard.lru.erase(it->second.position);
+                shard.entries.erase(it);
+            }
+            if (!cached.valid()) {
+                if (shard.entries.size() >= ENTRIES_PER_SHARD) {
+                    shard.entries.erase(shard.lru.back());
+                    shard.lru.pop_back();
+                }
+                shard.lru.push_front(fingerprint);
+                shard.entries.emplace(fingerprint, Entry{promise.get_future().share(), now, shard.lru.begin()});
+            }
+        }
+        if (cached.valid()) {
+            hits_.fetch_add(1, std::memory_order_relaxed);
+            return cached.get();
+        }
+        
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        try {
+            std::shared_ptr<const SecureKey> key = derive();
+            promise.set_value(key);
+            return key;
+        } catch (...) {
+            // Waiters see the failure; the next caller retries
+            promise.set_exception(std::current_exception());
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.entries.find(fingerprint);
+            if (it != shard.entries.end() && it->second.created == now) {
+                shard.lru.erase(it->second.position);
+                shard.entries.erase(it);
+            }
+            throw;
+        }
+    }
+    
+    void clear() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.entries.clear();
+            shard.lru.clear();
+        }
+    }
+    
+    size_t getHits() const { return hits_.load(std::memory_order_relaxed); }
+    size_t getMisses() const { return misses_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        std::shared_future<std::shared_ptr<const SecureKey>> key;
+        std::chrono::steady_clock::time_point created;
+        std::list<std::string>::iterator position;
+    };
+    
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+        std::list<std::string> lru;
+    };
+    
+    DerivedKeyCache() : secret_(32) {
+        if (medusa_generate_secure_random(secret_.data(), secret_.size()) != 1) {
+            throw MedusaEncryptionException("Failed to seed derived key cache",
+                                          "Key cache went sideways, champion!");
+        }
+    }
+    
+    // The salt is derived from the context inside the library, so context covers it
+    std::string fingerprintOf(const std::string& password, const std::string& context, size_t key_length) const {
+        unsigned char mac[32];
+        size_t mac_len = sizeof(mac);
+        if (medusa_hmac_sha256(reinterpret_cast<const unsigned char*>(password.data()), password.size(),
+                               secret_.data(), secret_.size(), mac, &mac_len) != 1) {
+            throw KeyDerivationException("Failed to fingerprint password for key cache");
+        }
+        std::string fingerprint(reinterpret_cast<const char*>(mac), mac_len);
+        fingerprint += std::to_string(key_length);
+        fingerprint += '\0';
+        fingerprint += context;
+        return fingerprint;
+    }
+    
+    SecureKey secret_;
+    Shard shards_[SHARD_COUNT];
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+};
+
 // Main encryption class - Yorkshire Champion design
+// The C library is thread-safe, so AES-GCM and PBKDF2 calls run concurrently;
+// library_mutex_ only guards the rarely used key generation and audit calls
 class MedusaEncryption {
 private:
     mutable std::mutex library_mutex_;
-    bool initialized_ = false;
     
-    // Library initialization
-    void ensureInitialized() const {
-        std::lock_guard<std::mutex> lock(library_mutex_);
-        if (!initialized_) {
-            if (medusa_encryption_init() != 1) {
-                throw MedusaEncryptionException("Failed to initialize Medusa encryption library",
-                                              "Library initialization went sideways, champion!");
-            }
-            const_cast<MedusaEncryption*>(this)->initialized_ = true;
+    // Batches at least this large are split across threads
+    static constexpr size_t BATCH_CHUNK = 64;
+    
+    // Library initialization - once per process
+    static void ensureInitialized() {
+        static std::once_flag once;
+        static bool initialized = false;
+        std::call_once(once, [] { initialized = medusa_encryption_init() == 1; });
+        if (!initialized) {
+            throw MedusaEncryptionException("Failed to initialize Medusa encryption library",
+                                          "Library initialization went sideways, champion!");
         }
     }
     
@@ -304,12 +432,115 @@ private:
     static const T* vectorData(const std::vector<T>& vec) {
         return vec.empty() ? nullptr : vec.data();
     }
+    
+    // Per-thread output buffer, reused across calls instead of a fresh allocation each time
+    static std::vector<uint8_t>& threadScratch(size_t size) {
+        thread_local std::vector<uint8_t> scratch;
+        if (scratch.size() < size) {
+            scratch.resize(size);
+        }
+        return scratch;
+    }
+    
+    void encryptRaw(const uint8_t* plaintext, size_t plaintext_len,
+                    const uint8_t* key, size_t key_len,
+                    const std::string& context, EncryptionResult& result) const {
+        std::vector<uint8_t>& encrypted_data = threadScratch(plaintext_len + 1024); // Extra space
+        uint8_t iv[AES_IV_SIZE];
+        uint8_t tag[AES_TAG_SIZE];
+        
+        size_t encrypted_len = encrypted_data.size();
+        size_t iv_len = sizeof(iv);
+        size_t tag_len = sizeof(tag);
+        
+        int encrypt_result = medusa_encrypt_aes_gcm(
+            plaintext, plaintext_len,
+            key, key_len,
+            context.empty() ? nullptr : context.c_str(),
+            encrypted_data.data(), &encrypted_len,
+            iv, &iv_len,
+            tag, &tag_len
+        );
+        
+        if (encrypt_result == 1) {
+            result.success = true;
+            result.encrypted_data.assign(encrypted_data.begin(), encrypted_data.begin() + encrypted_len);
+            result.iv.assign(iv, iv + iv_len);
+            result.tag.assign(tag, tag + tag_len);
+            result.yorkshire_comment = "Encryption successful, champion level security!";
+        } else {
+            result.success = false;
+            result.error_message = "AES-GCM encryption failed";
+            result.yorkshire_comment = "Encryption went sideways, champion!";
+        }
+    }
+    
+    void decryptRaw(const EncryptionResult& encryption_result,
+                    const uint8_t* key, size_t key_len,
+                    const std::string& context, DecryptionResult& result) const {
+        std::vector<uint8_t>& decrypted_data = threadScratch(encryption_result.encrypted_data.size() + 1024);
+        size_t decrypted_len = decrypted_data.size();
+        
+        int decrypt_result = medusa_decrypt_aes_gcm(
+            vectorData(encryption_result.encrypted_data), encryption_result.encrypted_data.size(),
+            key, key_len,
+            vectorData(encryption_result.iv), encryption_result.iv.size(),
+            vectorData(encryption_result.tag), encryption_result.tag.size(),
+            context.empty() ? nullptr : context.c_str(),
+            decrypted_data.data(), &decrypted_len
+        );
+        
+        if (decrypt_result == 1) {
+            result.success = true;
+            result.authentic = true;
+            result.decrypted_data.assign(decrypted_data.begin(), decrypted_data.begin() + decrypted_len);
+            result.yorkshire_comment = "Decryption successful, authentication verified, champion!";
+            // Plaintext must not linger in the shared scratch
+            medusa_secure_memzero(decrypted_data.data(), decrypted_len);
+        } else {
+            result.success = false;
+            result.authentic = false;
+            result.error_message = "AES-GCM decryption or authentication failed";
+            result.yorkshire_comment = "Decryption or authentication failed, champion!";
+            // GCM writes plaintext before the tag check fails; wipe the unauthenticated bytes too
+            medusa_secure_memzero(decrypted_data.data(),
+                                  std::min(decrypted_data.size(), encryption_result.encrypted_data.size()));
+        }
+    }
+    
+    // Run fn(begin, end) over [0, count), split across threads when the batch is large
+    template<typename Fn>
+    static void forEachChunk(size_t count, Fn&& fn) {
+        size_t threads = std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                                          count / BATCH_CHUNK);
+        if (threads <= 1) {
+            fn(0, count);
+            return;
+        }
+        size_t per_thread = (count + threads - 1) / threads;
+        std::vector<std::future<void>> workers;
+        for (size_t begin = per_thread; begin < count; begin += per_thread) {
+            workers.push_back(std::async(std::launch::async, [&fn, begin, per_thread, count] {
+                fn(begin, std::min(count, begin + per_thread));
+            }));
+        }
+        fn(0, std::min(count, per_thread));
+        for (auto& worker : workers) {
+            worker.get();
+        }
+    }
 
 public:
     MedusaEncryption() {
         ensureInitialized();
     }
     
+    // Instance shared by sessions and helpers (the library itself is process-wide)
+    static std::shared_ptr<MedusaEncryption> shared() {
+        static std::shared_ptr<MedusaEncryption> instance = std::make_shared<MedusaEncryption>();
+        return instance;
+    }
+    
     // Library information
     std::string getVersion() const {
         ensureInitialized();
@@ -326,7 +557,6 @@ public:
                                               const std::string& context = "",
                                               size_t key_length = AES_KEY_SIZE) const {
         ensureInitialized();
-        std::lock_guard<std::mutex> lock(library_mutex_);
         
         std::vector<uint8_t> derived_key(key_length);
         size_t derived_len = key_length;
@@ -347,6 +577,34 @@ public:
         return derived_key;
     }
     
+    // Same derivation, served from DerivedKeyCache after the first call.
+    // For encryption keys only: password verification should keep paying for PBKDF2.
+    std::shared_ptr<const SecureKey> deriveKeyCached(const std::string& password,
+                                                     const std::string& context = "",
+                                                     size_t key_length = AES_KEY_SIZE) const {
+        ensureInitialized();
+        return DerivedKeyCache::instance().getOrDerive(password, context, key_length, [&] {
+            auto key = std::make_shared<SecureKey>(key_length);
+            size_t derived_len = key_length;
+            int result = medusa_derive_key_pbkdf2(
+                password.c_str(),
+                context.empty() ? nullptr : context.c_str(),
+                key_length,
+                key->data(),
+                &derived_len
+            );
+            if (result != 1 || derived_len != key_length) {
+                throw KeyDerivationException("PBKDF2 key derivation failed");
+            }
+            return std::shared_ptr<const SecureKey>(std::move(key));
+        });
+    }
+    
+    // Drop (and wipe) every cached derived key, e.g. after a password rotation
+    static void clearKeyCache() {
+        DerivedKeyCache::instance().clear();
+    }
+    
     // AES-256-GCM Encryption
     EncryptionResult encryptAESGCM(const std::vector<uint8_t>& plaintext,
                                   const std::vector<uint8_t>& key,
@@ -357,39 +615,8 @@ public:
             throw EncryptionException("Invalid AES key size. Must be 32 bytes.");
         }
         
-        std::lock_guard<std::mutex> lock(library_mutex_);
         EncryptionResult result;
-        
-        // Prepare output buffers
-        std::vector<uint8_t> encrypted_data(plaintext.size() + 1024); // Extra space
-        std::vector<uint8_t> iv(AES_IV_SIZE);
-        std::vector<uint8_t> tag(AES_TAG_SIZE);
-        
-        size_t encrypted_len = encrypted_data.size();
-        size_t iv_len = iv.size();
-        size_t tag_len = tag.size();
-        
-        int encrypt_result = medusa_encrypt_aes_gcm(
-            vectorData(plaintext), plaintext.size(),
-            vectorData(key), key.size(),
-            context.empty() ? nullptr : context.c_str(),
-            encrypted_data.data(), &encrypted_len,
-            iv.data(), &iv_len,
-            tag.data(), &tag_len
-        );
-        
-        if (encrypt_result == 1) {
-            result.success = true;
-            result.encrypted_data.assign(encrypted_data.begin(), encrypted_data.begin() + encrypted_len);
-            result.iv.assign(iv.begin(), iv.begin() + iv_len);
-            result.tag.assign(tag.begin(), tag.begin() + tag_len);
-            result.yorkshire_comment = "Encryption successful, champion level security!";
-        } else {
-            result.success = false;
-            result.error_message = "AES-GCM encryption failed";
-            result.yorkshire_comment = "Encryption went sideways, champion!";
-        }
-        
+        encryptRaw(vectorData(plaintext), plaintext.size(), key.data(), key.size(), context, result);
         return result;
     }
     
@@ -407,48 +634,65 @@ public:
             throw DecryptionException("Invalid AES key size. Must be 32 bytes.");
         }
         
-        std::lock_guard<std::mutex> lock(library_mutex_);
         DecryptionResult result;
-        
-        std::vector<uint8_t> decrypted_data(encryption_result.encrypted_data.size() + 1024);
-        size_t decrypted_len = decrypted_data.size();
-        
-        int decrypt_result = medusa_decrypt_aes_gcm(
-            vectorData(encryption_result.encrypted_data), encryption_result.encrypted_data.size(),
-            vectorData(key), key.size(),
-            vectorData(encryption_result.iv), encryption_result.iv.size(),
-            vectorData(encryption_result.tag), encryption_result.tag.size(),
-            context.empty() ? nullptr : context.c_str(),
-            decrypted_data.data(), &decrypted_len
-        );
-        
-        if (decrypt_result == 1) {
-            result.success = true;
-            result.authentic = true;
-            result.decrypted_data.assign(decrypted_data.begin(), decrypted_data.begin() + decrypted_len);
-            result.yorkshire_comment = "Decryption successful, authentication verified, champion!";
-        } else {
-            result.success = false;
-            result.authentic = false;
-            result.error_message = "AES-GCM decryption or authentication failed";
-            result.yorkshire_comment = "Decryption or authentication failed, champion!";
-        }
-        
+        decryptRaw(encryption_result, key.data(), key.size(), context, result);
         return result;
     }
     
+    // Batch AES-256-GCM: one key check for the whole batch, large batches run in parallel.
+    // Each item gets its own IV; failures are reported per item.
+    std::vector<EncryptionResult> encryptBatch(const std::vector<std::vector<uint8_t>>& plaintexts,
+                                               const std::vector<uint8_t>& key,
+                                               const std::string& context = "") const {
+        ensureInitialized();
+        if (key.size() != AES_KEY_SIZE) {
+            throw EncryptionException("Invalid AES key size. Must be 32 bytes.");
+        }
+        std::vector<EncryptionResult> results(plaintexts.size());
+        forEachChunk(plaintexts.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                encryptRaw(vectorData(plaintexts[i]), plaintexts[i].size(), key.data(), key.size(), context, results[i]);
+            }
+        });
+        return results;
+    }
+    
+    std::vector<DecryptionResult> decryptBatch(const std::vector<EncryptionResult>& encrypted,
+                                               const std::vector<uint8_t>& key,
+                                               const std::string& context = "") const {
+        ensureInitialized();
+        if (key.size() != AES_KEY_SIZE) {
+            throw DecryptionException("Invalid AES key size. Must be 32 bytes.");
+        }
+        std::vector<DecryptionResult> results(encrypted.size());
+        forEachChunk(encrypted.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (!encrypted[i].success) {
+                    results[i].error_message = "Cannot decrypt invalid encryption result";
+                    continue;
+                }
+                decryptRaw(encrypted[i], key.data(), key.size(), context, results[i]);
+            }
+        });
+        return results;
+    }
+    
     // High-level string encryption (password-based)
     std::string encryptString(const std::string& plaintext, 
                              const std::string& password,
                              const std::string& context = "") const {
-        // Derive key from password
-        auto key = deriveKeyFromPassword(password, context);
-        
-        // Convert string to bytes
-        std::vector<uint8_t> plaintext_bytes(plaintext.begin(), plaintext.end());
-        
-        // Encrypt
-        auto result = encryptAESGCM(plaintext_bytes, key, context);
+        // Derive key from password (cached)
+        auto key = deriveKeyCached(password, context);
+        return encryptStringWithKey(plaintext, *key, context);
+    }
+    
+    std::string encryptStringWithKey(const std::string& plaintext,
+                                     const SecureKey& key,
+                                     const std::string& context = "") const {
+        ensureInitialized();
+        EncryptionResult result;
+        encryptRaw(reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+                   key.data(), key.size(), context, result);
         
         if (!result.success) {
             throw EncryptionException(result.error_message);
@@ -462,17 +706,24 @@ public:
     std::string decryptString(const std::string& encrypted_base64,
                              const std::string& password,
                              const std::string& context = "") const {
+        // Derive key from password (cached)
+        auto key = deriveKeyCached(password, context);
+        return decryptStringWithKey(encrypted_base64, *key, context);
+    }
+    
+    std::string decryptStringWithKey(const std::string& encrypted_base64,
+                                     const SecureKey& key,
+                                     const std::string& context = "") const {
+        ensureInitialized();
         // Parse base64 encrypted data
         auto encryption_result = EncryptionResult::fromBase64String(encrypted_base64);
         if (!encryption_result) {
             throw DecryptionException("Invalid encrypted data format");
         }
         
-        // Derive key from password
-        auto key = deriveKeyFromPassword(password, context);
-        
         // Decrypt
-        auto result = decryptAESGCM(*encryption_result, key, context);
+        DecryptionResult result;
+        decryptRaw(*encryption_result, key.data(), key.size(), context, result);
         
         if (!result.success || !result.authentic) {
             throw DecryptionException(result.error_message);
@@ -481,6 +732,74 @@ public:
         return result.toString();
     }
     
+    // Batch string encryption: the key is derived (or fetched) once for every item
+    std::vector<std::string> encryptStrings(const std::vector<std::string>& plaintexts,
+                                            const std::string& password,
+                                            const std::string& context = "") const {
+        auto key = deriveKeyCached(password, context);
+        return encryptStringsWithKey(plaintexts, *key, context);
+    }
+    
+    // Throws on the first item that fails to parse or authenticate
+    std::vector<std::string> decryptStrings(const std::vector<std::string>& encrypted_base64,
+                                            const std::string& password,
+                                            const std::string& context = "") const {
+        auto key = deriveKeyCached(password, context);
+        return decryptStringsWithKey(encrypted_base64, *key, context);
+    }
+    
+    std::vector<std::string> encryptStringsWithKey(const std::vector<std::string>& plaintexts,
+                                                   const SecureKey& key,
+                                                   const std::string& context = "") const {
+        ensureInitialized();
+        std::vector<std::string> out(plaintexts.size());
+        std::atomic<bool> failed{false};
+        forEachChunk(plaintexts.size(), [&](size_t begin, size_t end) {
+            EncryptionResult result;
+            for (size_t i = begin; i < end && !failed.load(std::memory_order_relaxed); ++i) {
+                encryptRaw(reinterpret_cast<const uint8_t*>(plaintexts[i].data()), plaintexts[i].size(),
+                           key.data(), key.size(), context, result);
+                if (!result.success) {
+                    failed = true;
+                    return;
+                }
+                out[i] = result.toBase64String();
+            }
+        });
+        if (failed) {
+            throw EncryptionException("AES-GCM encryption failed");
+        }
+        return out;
+    }
+    
+    std::vector<std::string> decryptStringsWithKey(const std::vector<std::string>& encrypted_base64,
+                                                   const SecureKey& key,
+                                                   const std::string& context = "") const {
+        ensureInitialized();
+        std::vector<std::string> out(encrypted_base64.size());
+        std::atomic<bool> failed{false};
+        forEachChunk(encrypted_base64.size(), [&](size_t begin, size_t end) {
+            DecryptionResult result;
+            for (size_t i = begin; i < end && !failed.load(std::memory_order_relaxed); ++i) {
+                auto parsed = EncryptionResult::fromBase64String(encrypted_base64[i]);
+                if (!parsed) {
+                    failed = true;
+                    return;
+                }
+                decryptRaw(*parsed, key.data(), key.size(), context, result);
+                if (!result.success || !result.authentic) {
+                    failed = true;
+                    return;
+                }
+                out[i] = result.toString();
+            }
+        });
+        if (failed) {
+            throw DecryptionException("Invalid encrypted data or AES-GCM authentication failed");
+        }
+        return out;
+    }
+    
     // RSA-4096 key pair generation
     KeyPairResult generateRSAKeyPair() const {
         ensureInitialized();
@@ -620,32 +939,48 @@ namespace Utils {
 }
 
 // RAII Encryption Session for managing encryption contexts
+// The key is derived once per session (through the shared cache) and the password is not kept
 class EncryptionSession {
 private:
-    std::unique_ptr<MedusaEncryption> crypto_;
-    std::string password_;
+    std::shared_ptr<MedusaEncryption> crypto_;
+    std::shared_ptr<const SecureKey> key_;
     std::string context_;
     
 public:
     EncryptionSession(const std::string& password, const std::string& context = "")
-        : crypto_(std::make_unique<MedusaEncryption>()), password_(password), context_(context) {}
+        : crypto_(MedusaEncryption::shared()),
+          key_(crypto_->deriveKeyCached(password, context)),
+          context_(context) {}
     
     std::string encrypt(const std::string& data) {
-        return crypto_->encryptString(data, password_, context_);
+        return crypto_->encryptStringWithKey(data, *key_, context_);
     }
     
     std::string decrypt(const std::string& encrypted_data) {
-        return crypto_->decryptString(encrypted_data, password_, context_);
+        return crypto_->decryptStringWithKey(encrypted_data, *key_, context_);
+    }
+    
+    std::vector<std::string> encryptBatch(const std::vector<std::string>& data) {
+        return crypto_->encryptStringsWithKey(data, *key_, context_);
+    }
+    
+    std::vector<std::string> decryptBatch(const std::vector<std::string>& encrypted_data) {
+        return crypto_->decryptStringsWithKey(encrypted_data, *key_, context_);
     }
     
     template<typename T>
     std::string encryptData(const T& data) {
-        return crypto_->encryptData(data, password_, context_);
+        std::ostringstream oss;
+        oss << data;
+        return encrypt(oss.str());
     }
     
     template<typename T>  
     T decryptData(const std::string& encrypted_data) {
-        return crypto_->decryptData<T>(encrypted_data, password_, context_);
+        std::istringstream iss(decrypt(encrypted_data));
+        T data;
+        iss >> data;
+        return data;
     }
 };
 
@@ -669,8 +1004,8 @@ namespace Utils {
     
     // Hash password for authentication (compatible with Python wrapper)
     std::string hashPasswordYorkshire(const std::string& password, const std::string& context = "") {
-        MedusaEncryption crypto;
-        auto key = crypto.deriveKeyFromPassword(password, context, 64);
+        // Deliberately uncached: verification should cost a full PBKDF2 run
+        auto key = MedusaEncryption::shared()->deriveKeyFromPassword(password, context, 64);
         return bytesToHex(key);
     }
     
@@ -757,7 +1092,14 @@ auto encrypted2 = session.encrypt("Data 2");
 auto decrypted1 = session.decrypt(encrypted1);
 ```
 
-5. Template-based data encryption:
+5. Batches (one key derivation, large batches spread across cores):
+```cpp
+std::vector<std::string> records = loadVaultRecords();
+auto sealed = crypto.encryptStrings(records, "password", "vault");
+auto opened = crypto.decryptStrings(sealed, "password", "vault");
+```
+
+6. Template-based data encryption:
 ```cpp
 int secret_number = 42;
 std::string encrypted_number = crypto.encryptData(secret_number, "password");
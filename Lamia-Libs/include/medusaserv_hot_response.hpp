@@ -0,0 +1,9 @@
+/**
+ * LIBMEDUSASERV_HOT_RESPONSE HEADER v0.3.0a
+ * ==========================================
+ * Forwarding header: the implementation lives in the top-level
+ * medusaserv_hot_response.hpp, shared with medusaserv_core.hpp
+ * © 2025 The Medusa Project | Roylepython | D Hargreaves
+ */
+
+#include "../../medusaserv_hot_response.hpp"
@@ -21,10 +21,14 @@ extern "C" {
 #define MEDUSASERV_ERROR_INVALID_PARAMETER -3
 
 // HTTP engine structures
+// Counters are kept per event loop; get_http_stats() returns the aggregate
+// and get_http_loop_stats() returns a single loop's view.
 typedef struct {
     int active_connections;
     long total_requests_processed;
     bool server_initialized;
+    int event_loops;
+    long keepalive_reuses;
 } MedusaServHttpStats;
 
 typedef struct {
@@ -37,7 +41,14 @@ typedef struct {
 } MedusaServHttpRequest;
 
 // HTTP server functions
+// create_http_server() starts one edge-triggered epoll loop per core, each
+// with its own SO_REUSEPORT listener, and returns the first listening socket.
+// That socket is non-blocking and owned by event loop 0, which already
+// accepts on it: use it only to identify the server (e.g. getsockname), do
+// not accept() or close() it yourself; stop_http_server() closes it.
 int create_http_server(int port);
+int create_http_server_with_loops(int port, int event_loops);
+int stop_http_server();
 int process_http_requests(int client_socket);
 int manage_http_connections();
 int implement_http_methods();
@@ -46,6 +57,7 @@ int handle_concurrent_requests();
 
 // HTTP utility functions
 int get_http_stats(MedusaServHttpStats* stats);
+int get_http_loop_stats(int loop_index, MedusaServHttpStats* stats);
 const char* generate_http_response(const char* request);
 const char* get_http_version();
 
@@ -14,6 +14,8 @@
 #include <vector>
 #include <algorithm>
 #include <cstring>
+#include <poll.h>
+#include "medusaserv_hot_response.hpp"
 
 // Forward declarations for SSL verbose engine functions
 extern "C" {
@@ -195,6 +197,8 @@ namespace pathing {
 
 // Path resolution cache for performance
 static std::unordered_map<std::string, std::string> g_path_cache;
+// Precompiled static file responses keyed by (static root, request path)
+static medusaserv::http::HotResponseCache g_hot_static_cache;
 static std::string g_base_directory = "/";
 static bool g_pathing_initialized = false;
 
@@ -447,6 +451,7 @@ void free_path_string(char* path_string) {
 // Clear path cache
 void clear_path_cache() {
     g_path_cache.clear();
+    g_hot_static_cache.clear();
     std::cout << "🗂️ PATH CACHE CLEARED" << std::endl;
 }
 
@@ -855,6 +860,33 @@ namespace static_files {
         
         return nullptr;
     }
+    
+    // A hit goes straight from the request path to a prebuilt response;
+    // resolution, MIME lookup and logging only run on a miss.
+    medusaserv::http::HotResponsePtr serve(const char* path, const char* static_root) {
+        if (!path || !static_root) {
+            return nullptr;
+        }
+        
+        if (auto cached = g_hot_static_cache.find(static_root, path)) {
+            return cached;
+        }
+        
+        char* resolved = route(path, static_root);
+        if (!resolved) {
+            return nullptr;
+        }
+        
+        char* mime_type = get_mime_type(resolved);
+        auto response = medusaserv::http::HotResponse::fromFile(resolved, mime_type);
+        free_path_string(mime_type);
+        free_path_string(resolved);
+        
+        if (response) {
+            g_hot_static_cache.insert(static_root, path, response);
+        }
+        return response;
+    }
 }
 
 extern "C" {
@@ -888,6 +920,32 @@ char* route_static_files(const char* path, const char* static_root) {
     return static_files::route(path, static_root);
 }
 
+int serve_static_file(int client_socket, const char* path, const char* static_root,
+                      const char* if_none_match, int keep_alive, int head_only) {
+    auto response = static_files::serve(path, static_root);
+    if (!response) {
+        return 0;
+    }
+    
+    auto cursor = response->begin(keep_alive != 0, head_only != 0,
+                                  if_none_match ? std::string_view(if_none_match) : std::string_view());
+    while (true) {
+        auto status = response->deliver(client_socket, cursor);
+        if (status == medusaserv::http::DeliveryStatus::COMPLETE) {
+            break;
+        }
+        if (status == medusaserv::http::DeliveryStatus::FAILED) {
+            return -1;
+        }
+        // Non-blocking caller socket: wait for room rather than spinning
+        struct pollfd writable = {client_socket, POLLOUT, 0};
+        if (poll(&writable, 1, 5000) <= 0) {
+            return -1;
+        }
+    }
+    return cursor.not_modified ? 304 : response->statusCode();
+}
+
 // C wrapper functions for Startup::Procedure namespace functions
 void startup_procedure_system_initialize_core() {
     Startup::Procedure::System::initialize_core();
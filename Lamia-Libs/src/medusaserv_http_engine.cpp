@@ -10,68 +10,619 @@
 #include "medusaserv_http_engine.hpp"
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
+#include <memory>
+#include <mutex>
 #include <atomic>
 #include <thread>
+#include <chrono>
+#include <cerrno>
+#include <cstdint>
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 
 namespace medusaserv {
 namespace http {
 
+// Reactor tuning
+static constexpr size_t kReadChunkSize = 16 * 1024;
+static constexpr size_t kMaxHeaderBytes = 64 * 1024;
+static constexpr size_t kMaxBodyBytes = 8 * 1024 * 1024;
+static constexpr int kMaxEpollEvents = 256;
+static constexpr int kEpollWaitMs = 1000;
+static constexpr int kKeepAliveTimeoutSeconds = 15;
+static constexpr int kMaxKeepAliveRequests = 1000;
+
+static const char kServerHeader[] = "Server: MedusaServ v0.3.0a (Professional Native C++ Server)\r\n";
+
+// One client connection, owned exclusively by the loop thread that accepted it
+struct HttpConnection {
+    int fd = -1;
+    std::string input;
+    std::string output;
+    size_t output_offset = 0;
+    int requests_served = 0;
+    bool close_after_flush = false;
+    std::chrono::steady_clock::time_point last_activity;
+};
+
+// One edge-triggered epoll reactor with its own SO_REUSEPORT listener
+struct HttpEventLoop {
+    int index = 0;
+    int listen_fd = -1;
+    int epoll_fd = -1;
+    int wake_fd = -1;
+    std::thread thread;
+    std::atomic<int> active_connections{0};
+    std::atomic<long> requests_processed{0};
+    std::atomic<long> keepalive_reuses{0};
+    std::unordered_map<int, HttpConnection> connections;
+};
+
 // Global HTTP engine state
 static std::atomic<bool> g_http_initialized{false};
+static std::mutex g_loops_mutex;
+static std::vector<std::unique_ptr<HttpEventLoop>> g_loops;
+
+// Counters for sockets handed to the blocking process_http_requests() path
 static std::atomic<int> g_active_connections{0};
 static std::atomic<long> g_requests_processed{0};
+static std::atomic<long> g_keepalive_reuses{0};
 
-extern "C" {
+// ----------------------------------------------------------------------------
+// Request framing
+// ----------------------------------------------------------------------------
 
-int create_http_server(int port) {
-    std::cout << "🌐 Creating HTTP server on port " << port << "..." << std::endl;
-    std::cout << "🔬 Ground Up HTTP engine - established library implementation" << std::endl;
-    
-    // Create socket
-    int server_socket = socket(AF_INET, SOCK_STREAM, 0);
-    if (server_socket < 0) {
-        std::cerr << "❌ Failed to create HTTP server socket" << std::endl;
-        return MEDUSASERV_ERROR_GENERIC;
+enum class FrameStatus {
+    INCOMPLETE,
+    COMPLETE,
+    BAD_REQUEST,
+    TOO_LARGE,
+    NOT_IMPLEMENTED
+};
+
+struct RequestFrame {
+    std::string_view method;
+    std::string_view path;
+    size_t total_length = 0;
+    bool keep_alive = false;
+};
+
+static bool equals_ignore_case(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
     }
-    
-    // Set socket options for professional operation
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i] >= 'A' && a[i] <= 'Z' ? a[i] + 32 : a[i];
+        char y = b[i] >= 'A' && b[i] <= 'Z' ? b[i] + 32 : b[i];
+        if (x != y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool contains_token_ignore_case(std::string_view value, std::string_view token) {
+    if (value.size() < token.size()) {
+        return false;
+    }
+    for (size_t i = 0; i + token.size() <= value.size(); ++i) {
+        if (equals_ignore_case(value.substr(i, token.size()), token)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static std::string_view trim_header_value(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+static bool parse_request_line(std::string_view line, std::string_view& method,
+                               std::string_view& path, std::string_view& version) {
+    size_t first_space = line.find(' ');
+    if (first_space == std::string_view::npos || first_space == 0) {
+        return false;
+    }
+    size_t second_space = line.find(' ', first_space + 1);
+    if (second_space == std::string_view::npos || second_space == first_space + 1) {
+        return false;
+    }
+    method = line.substr(0, first_space);
+    path = line.substr(first_space + 1, second_space - first_space - 1);
+    version = line.substr(second_space + 1);
+    return true;
+}
+
+// Locates one complete request at the front of buffer. Views in frame point into buffer.
+static FrameStatus frame_http_request(std::string_view buffer, RequestFrame& frame) {
+    size_t header_end = buffer.find("\r\n\r\n");
+    if (header_end == std::string_view::npos) {
+        return buffer.size() > kMaxHeaderBytes ? FrameStatus::TOO_LARGE : FrameStatus::INCOMPLETE;
+    }
+    if (header_end > kMaxHeaderBytes) {
+        return FrameStatus::TOO_LARGE;
+    }
+
+    std::string_view head = buffer.substr(0, header_end);
+    size_t line_end = head.find("\r\n");
+    std::string_view request_line = head.substr(0, line_end);
+
+    std::string_view version;
+    if (!parse_request_line(request_line, frame.method, frame.path, version)) {
+        return FrameStatus::BAD_REQUEST;
+    }
+    if (version == "HTTP/1.1") {
+        frame.keep_alive = true;
+    } else if (version == "HTTP/1.0") {
+        frame.keep_alive = false;
+    } else {
+        return FrameStatus::BAD_REQUEST;
+    }
+
+    size_t content_length = 0;
+    bool have_content_length = false;
+    while (line_end != std::string_view::npos) {
+        size_t start = line_end + 2;
+        line_end = head.find("\r\n", start);
+        std::string_view line = head.substr(start, line_end == std::string_view::npos
+                                                       ? std::string_view::npos
+                                                       : line_end - start);
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos || colon == 0) {
+            return FrameStatus::BAD_REQUEST;
+        }
+        std::string_view name = line.substr(0, colon);
+        std::string_view value = trim_header_value(line.substr(colon + 1));
+
+        if (equals_ignore_case(name, "content-length")) {
+            if (value.empty() || value.size() > 18) {
+                return FrameStatus::BAD_REQUEST;
+            }
+            size_t parsed = 0;
+            for (char c : value) {
+                if (c < '0' || c > '9') {
+                    return FrameStatus::BAD_REQUEST;
+                }
+                parsed = parsed * 10 + static_cast<size_t>(c - '0');
+            }
+            if (have_content_length && parsed != content_length) {
+                return FrameStatus::BAD_REQUEST;
+            }
+            content_length = parsed;
+            have_content_length = true;
+        } else if (equals_ignore_case(name, "connection")) {
+            if (contains_token_ignore_case(value, "close")) {
+                frame.keep_alive = false;
+            } else if (contains_token_ignore_case(value, "keep-alive")) {
+                frame.keep_alive = true;
+            }
+        } else if (equals_ignore_case(name, "transfer-encoding")) {
+            return FrameStatus::NOT_IMPLEMENTED;
+        }
+    }
+
+    if (content_length > kMaxBodyBytes) {
+        return FrameStatus::TOO_LARGE;
+    }
+    frame.total_length = header_end + 4 + content_length;
+    return buffer.size() >= frame.total_length ? FrameStatus::COMPLETE : FrameStatus::INCOMPLETE;
+}
+
+// ----------------------------------------------------------------------------
+// Response generation
+// ----------------------------------------------------------------------------
+
+static void append_http_response(std::string& out, std::string_view method,
+                                 std::string_view path, bool keep_alive) {
+    static const char kHealthBody[] =
+        "{\n"
+        "  \"status\": \"healthy\",\n"
+        "  \"server\": \"MedusaServ v0.3.0a\",\n"
+        "  \"engine\": \"Native C++\"\n"
+        "}";
+    static const char kIndexBody[] =
+        "<html><body><h1>MedusaServ v0.3.0a</h1><p>Native C++ Professional Server</p></body></html>";
+
+    bool health = path == "/health";
+    std::string_view body = health ? std::string_view(kHealthBody, sizeof(kHealthBody) - 1)
+                                   : std::string_view(kIndexBody, sizeof(kIndexBody) - 1);
+
+    out.append("HTTP/1.1 200 OK\r\n");
+    out.append(kServerHeader);
+    out.append(health ? "Content-Type: application/json\r\n" : "Content-Type: text/html\r\n");
+    out.append("Content-Length: ");
+    out.append(std::to_string(body.size()));
+    out.append(keep_alive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n");
+    if (method != "HEAD") {
+        out.append(body);
+    }
+}
+
+static void append_http_error(std::string& out, FrameStatus status) {
+    switch (status) {
+        case FrameStatus::TOO_LARGE:
+            out.append("HTTP/1.1 413 Payload Too Large\r\n");
+            break;
+        case FrameStatus::NOT_IMPLEMENTED:
+            out.append("HTTP/1.1 501 Not Implemented\r\n");
+            break;
+        default:
+            out.append("HTTP/1.1 400 Bad Request\r\n");
+            break;
+    }
+    out.append(kServerHeader);
+    out.append("Content-Length: 0\r\n"
+               "Connection: close\r\n\r\n");
+}
+
+// Serves every complete request in conn.input, appending responses to conn.output.
+static void process_buffered_requests(HttpConnection& conn, std::atomic<long>& requests_processed,
+                                      std::atomic<long>& keepalive_reuses) {
+    size_t consumed = 0;
+    while (!conn.close_after_flush && consumed < conn.input.size()) {
+        RequestFrame frame;
+        std::string_view pending(conn.input.data() + consumed, conn.input.size() - consumed);
+        FrameStatus status = frame_http_request(pending, frame);
+
+        if (status == FrameStatus::INCOMPLETE) {
+            break;
+        }
+        if (status != FrameStatus::COMPLETE) {
+            append_http_error(conn.output, status);
+            conn.close_after_flush = true;
+            consumed = conn.input.size();
+            break;
+        }
+
+        if (conn.requests_served > 0) {
+            keepalive_reuses.fetch_add(1, std::memory_order_relaxed);
+        }
+        conn.requests_served++;
+
+        bool keep_alive = frame.keep_alive && conn.requests_served < kMaxKeepAliveRequests;
+        append_http_response(conn.output, frame.method, frame.path, keep_alive);
+        requests_processed.fetch_add(1, std::memory_order_relaxed);
+
+        consumed += frame.total_length;
+        if (!keep_alive) {
+            conn.close_after_flush = true;
+        }
+    }
+    conn.input.erase(0, consumed);
+}
+
+// ----------------------------------------------------------------------------
+// Event loop
+// ----------------------------------------------------------------------------
+
+static int open_listener(int port, bool reuse_port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
     int opt = 1;
-    if (setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-        std::cerr << "❌ Failed to set socket options" << std::endl;
-        close(server_socket);
-        return MEDUSASERV_ERROR_GENERIC;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0 ||
+        (reuse_port && setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0)) {
+        close(fd);
+        return -1;
     }
-    
-    // Bind socket
+
     struct sockaddr_in address;
     address.sin_family = AF_INET;
     address.sin_addr.s_addr = INADDR_ANY;
     address.sin_port = htons(port);
-    
-    if (bind(server_socket, (struct sockaddr*)&address, sizeof(address)) < 0) {
-        std::cerr << "❌ Failed to bind HTTP server to port " << port << std::endl;
-        close(server_socket);
-        return MEDUSASERV_ERROR_GENERIC;
+
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) < 0 || listen(fd, 1024) < 0) {
+        close(fd);
+        return -1;
     }
-    
-    // Listen for connections
-    if (listen(server_socket, 1024) < 0) {
-        std::cerr << "❌ Failed to listen on HTTP server socket" << std::endl;
-        close(server_socket);
+    return fd;
+}
+
+static void close_connection(HttpEventLoop* loop, int fd) {
+    epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    loop->connections.erase(fd);
+    loop->active_connections.fetch_sub(1, std::memory_order_relaxed);
+}
+
+static void accept_connections(HttpEventLoop* loop) {
+    while (true) {
+        int client = accept4(loop->listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            // EAGAIN drains the edge; EMFILE and friends retry on the next edge
+            return;
+        }
+
+        int opt = 1;
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+
+        struct epoll_event event;
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = client;
+        if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, client, &event) < 0) {
+            close(client);
+            continue;
+        }
+
+        HttpConnection& conn = loop->connections[client];
+        conn.fd = client;
+        conn.last_activity = std::chrono::steady_clock::now();
+        loop->active_connections.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// Returns false once the connection should be closed.
+static bool flush_connection(HttpConnection& conn) {
+    while (conn.output_offset < conn.output.size()) {
+        ssize_t sent = send(conn.fd, conn.output.data() + conn.output_offset,
+                            conn.output.size() - conn.output_offset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        conn.output_offset += static_cast<size_t>(sent);
+    }
+    conn.output.clear();
+    conn.output_offset = 0;
+    return !conn.close_after_flush;
+}
+
+// Drains the socket for the current edge. Returns false once the connection should be closed.
+static bool read_connection(HttpEventLoop* loop, HttpConnection& conn) {
+    char chunk[kReadChunkSize];
+    bool peer_closed = false;
+
+    while (!conn.close_after_flush) {
+        ssize_t bytes_read = recv(conn.fd, chunk, sizeof(chunk), 0);
+        if (bytes_read > 0) {
+            conn.input.append(chunk, static_cast<size_t>(bytes_read));
+            // Frame as we go so pipelined input never grows past one request
+            process_buffered_requests(conn, loop->requests_processed, loop->keepalive_reuses);
+            continue;
+        }
+        if (bytes_read == 0) {
+            peer_closed = true;
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        return false;
+    }
+
+    conn.last_activity = std::chrono::steady_clock::now();
+    if (peer_closed) {
+        conn.close_after_flush = true;
+    }
+    return flush_connection(conn);
+}
+
+static void expire_idle_connections(HttpEventLoop* loop, std::chrono::steady_clock::time_point now) {
+    std::vector<int> expired;
+    for (const auto& entry : loop->connections) {
+        if (now - entry.second.last_activity > std::chrono::seconds(kKeepAliveTimeoutSeconds)) {
+            expired.push_back(entry.first);
+        }
+    }
+    for (int fd : expired) {
+        close_connection(loop, fd);
+    }
+}
+
+static void run_event_loop(HttpEventLoop* loop) {
+    struct epoll_event events[kMaxEpollEvents];
+    auto last_sweep = std::chrono::steady_clock::now();
+
+    while (g_http_initialized.load(std::memory_order_acquire)) {
+        int ready = epoll_wait(loop->epoll_fd, events, kMaxEpollEvents, kEpollWaitMs);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "❌ HTTP event loop " << loop->index << " epoll_wait failed" << std::endl;
+            break;
+        }
+
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            uint32_t mask = events[i].events;
+
+            if (fd == loop->wake_fd) {
+                uint64_t value;
+                while (read(loop->wake_fd, &value, sizeof(value)) > 0) {
+                }
+                continue;
+            }
+            if (fd == loop->listen_fd) {
+                accept_connections(loop);
+                continue;
+            }
+
+            auto it = loop->connections.find(fd);
+            if (it == loop->connections.end()) {
+                continue;
+            }
+            HttpConnection& conn = it->second;
+
+            if (mask & EPOLLERR) {
+                close_connection(loop, fd);
+                continue;
+            }
+
+            bool keep = true;
+            if (mask & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+                keep = read_connection(loop, conn);
+            } else if (mask & EPOLLOUT) {
+                keep = flush_connection(conn);
+            }
+            if (!keep) {
+                close_connection(loop, fd);
+            }
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_sweep >= std::chrono::milliseconds(kEpollWaitMs)) {
+            expire_idle_connections(loop, now);
+            last_sweep = now;
+        }
+    }
+
+    for (auto& entry : loop->connections) {
+        close(entry.first);
+    }
+    loop->active_connections.fetch_sub(static_cast<int>(loop->connections.size()),
+                                       std::memory_order_relaxed);
+    loop->connections.clear();
+}
+
+static void destroy_event_loop(HttpEventLoop* loop) {
+    if (loop->epoll_fd >= 0) close(loop->epoll_fd);
+    if (loop->wake_fd >= 0) close(loop->wake_fd);
+    if (loop->listen_fd >= 0) close(loop->listen_fd);
+    loop->epoll_fd = loop->wake_fd = loop->listen_fd = -1;
+}
+
+static bool setup_event_loop(HttpEventLoop* loop) {
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    loop->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (loop->epoll_fd < 0 || loop->wake_fd < 0) {
+        return false;
+    }
+
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = loop->listen_fd;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->listen_fd, &event) < 0) {
+        return false;
+    }
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = loop->wake_fd;
+    return epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->wake_fd, &event) == 0;
+}
+
+static void fill_stats(MedusaServHttpStats* stats, int active, long processed, long reuses, int loops) {
+    stats->active_connections = active;
+    stats->total_requests_processed = processed;
+    stats->server_initialized = g_http_initialized.load();
+    stats->event_loops = loops;
+    stats->keepalive_reuses = reuses;
+}
+
+extern "C" {
+
+int create_http_server(int port) {
+    return create_http_server_with_loops(port, 0);
+}
+
+int create_http_server_with_loops(int port, int event_loops) {
+    std::cout << "🌐 Creating HTTP server on port " << port << "..." << std::endl;
+    std::cout << "🔬 Ground Up HTTP engine - established library implementation" << std::endl;
+
+    if (port <= 0 || port > 65535) {
+        return MEDUSASERV_ERROR_INVALID_PARAMETER;
+    }
+
+    std::lock_guard<std::mutex> lock(g_loops_mutex);
+    if (g_http_initialized.load()) {
+        std::cerr << "❌ HTTP server already running" << std::endl;
         return MEDUSASERV_ERROR_GENERIC;
     }
-    
-    g_http_initialized.store(true);
-    
+
+    if (event_loops <= 0) {
+        event_loops = static_cast<int>(std::thread::hardware_concurrency());
+        if (event_loops <= 0) {
+            event_loops = 1;
+        }
+    }
+
+    // Every loop binds its own SO_REUSEPORT listener so the kernel spreads accepts
+    for (int i = 0; i < event_loops; ++i) {
+        auto loop = std::make_unique<HttpEventLoop>();
+        loop->index = i;
+        loop->listen_fd = open_listener(port, true);
+        if (loop->listen_fd < 0 && i == 0) {
+            // Kernels without SO_REUSEPORT still get a single reactor
+            loop->listen_fd = open_listener(port, false);
+            event_loops = 1;
+        }
+        if (loop->listen_fd < 0) {
+            if (i == 0) {
+                std::cerr << "❌ Failed to bind HTTP server to port " << port << std::endl;
+                return MEDUSASERV_ERROR_GENERIC;
+            }
+            std::cerr << "⚠️ SO_REUSEPORT listener " << i << " unavailable, running "
+                      << i << " event loops" << std::endl;
+            break;
+        }
+        if (!setup_event_loop(loop.get())) {
+            std::cerr << "❌ Failed to create epoll event loop " << i << std::endl;
+            destroy_event_loop(loop.get());
+            for (auto& created : g_loops) {
+                destroy_event_loop(created.get());
+            }
+            g_loops.clear();
+            return MEDUSASERV_ERROR_GENERIC;
+        }
+        g_loops.push_back(std::move(loop));
+    }
+
+    g_http_initialized.store(true, std::memory_order_release);
+    for (auto& loop : g_loops) {
+        loop->thread = std::thread(run_event_loop, loop.get());
+    }
+
     std::cout << "✅ HTTP server created successfully on port " << port << std::endl;
-    std::cout << "⚡ Professional HTTP engine ready for maximum performance" << std::endl;
-    
-    return server_socket;
+    std::cout << "⚡ " << g_loops.size() << " edge-triggered epoll loops with HTTP/1.1 keep-alive" << std::endl;
+
+    return g_loops.front()->listen_fd;
+}
+
+int stop_http_server() {
+    std::lock_guard<std::mutex> lock(g_loops_mutex);
+    if (!g_http_initialized.load()) {
+        return MEDUSASERV_ERROR_NOT_INITIALIZED;
+    }
+
+    g_http_initialized.store(false, std::memory_order_release);
+    for (auto& loop : g_loops) {
+        uint64_t one = 1;
+        ssize_t ignored = write(loop->wake_fd, &one, sizeof(one));
+        (void)ignored;
+    }
+    for (auto& loop : g_loops) {
+        if (loop->thread.joinable()) {
+            loop->thread.join();
+        }
+        destroy_event_loop(loop.get());
+    }
+    g_loops.clear();
+
+    std::cout << "🛑 HTTP server stopped" << std::endl;
+    return MEDUSASERV_SUCCESS;
 }
 
 int process_http_requests(int client_socket) {
@@ -80,21 +631,44 @@ int process_http_requests(int client_socket) {
     }
     
     g_active_connections.fetch_add(1);
-    
-    char buffer[4096];
-    ssize_t bytes_read = recv(client_socket, buffer, sizeof(buffer) - 1, 0);
-    
-    if (bytes_read > 0) {
-        buffer[bytes_read] = '\0';
-        
-        // Professional HTTP request processing
-        std::string request(buffer);
-        std::string response = generate_http_response(request.c_str());
-        
-        // Send response with professional headers
-        send(client_socket, response.c_str(), response.length(), 0);
-        
-        g_requests_processed.fetch_add(1);
+
+    // Blocking fallback for callers that accept themselves: same framing and
+    // keep-alive rules as the reactor, bounded by the keep-alive timeout.
+    struct timeval timeout;
+    timeout.tv_sec = kKeepAliveTimeoutSeconds;
+    timeout.tv_usec = 0;
+    setsockopt(client_socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    HttpConnection conn;
+    conn.fd = client_socket;
+    char chunk[kReadChunkSize];
+
+    while (!conn.close_after_flush) {
+        ssize_t bytes_read = recv(client_socket, chunk, sizeof(chunk), 0);
+        if (bytes_read <= 0) {
+            if (bytes_read < 0 && errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        conn.input.append(chunk, static_cast<size_t>(bytes_read));
+        process_buffered_requests(conn, g_requests_processed, g_keepalive_reuses);
+
+        while (conn.output_offset < conn.output.size()) {
+            ssize_t sent = send(client_socket, conn.output.data() + conn.output_offset,
+                                conn.output.size() - conn.output_offset, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent <= 0) {
+                conn.close_after_flush = true;
+                break;
+            }
+            conn.output_offset += static_cast<size_t>(sent);
+        }
+        conn.output.clear();
+        conn.output_offset = 0;
     }
     
     close(client_socket);
@@ -111,15 +685,15 @@ int manage_http_connections() {
     std::cout << "🔗 Managing HTTP connections..." << std::endl;
     
     // Connection management implementation
-    int active = g_active_connections.load();
-    long processed = g_requests_processed.load();
+    MedusaServHttpStats stats;
+    get_http_stats(&stats);
     
-    std::cout << "📊 Active connections: " << active << std::endl;
-    std::cout << "📈 Requests processed: " << processed << std::endl;
+    std::cout << "📊 Active connections: " << stats.active_connections << std::endl;
+    std::cout << "📈 Requests processed: " << stats.total_requests_processed << std::endl;
+    std::cout << "🔁 Keep-alive reuses: " << stats.keepalive_reuses << std::endl;
     
     return MEDUSASERV_SUCCESS;
 }
-
 int implement_http_methods() {
     if (!g_http_initialized.load()) {
         return MEDUSASERV_ERROR_NOT_INITIALIZED;
@@ -175,60 +749,57 @@ int get_http_stats(MedusaServHttpStats* stats) {
         return MEDUSASERV_ERROR_INVALID_PARAMETER;
     }
     
-    stats->active_connections = g_active_connections.load();
-    stats->total_requests_processed = g_requests_processed.load();
-    stats->server_initialized = g_http_initialized.load();
+    std::lock_guard<std::mutex> lock(g_loops_mutex);
+    int active = g_active_connections.load();
+    long processed = g_requests_processed.load();
+    long reuses = g_keepalive_reuses.load();
+    for (const auto& loop : g_loops) {
+        active += loop->active_connections.load(std::memory_order_relaxed);
+        processed += loop->requests_processed.load(std::memory_order_relaxed);
+        reuses += loop->keepalive_reuses.load(std::memory_order_relaxed);
+    }
+    fill_stats(stats, active, processed, reuses, static_cast<int>(g_loops.size()));
+    
+    return MEDUSASERV_SUCCESS;
+}
+
+int get_http_loop_stats(int loop_index, MedusaServHttpStats* stats) {
+    if (!stats) {
+        return MEDUSASERV_ERROR_INVALID_PARAMETER;
+    }
+    
+    std::lock_guard<std::mutex> lock(g_loops_mutex);
+    if (loop_index < 0 || loop_index >= static_cast<int>(g_loops.size())) {
+        return MEDUSASERV_ERROR_INVALID_PARAMETER;
+    }
+    const HttpEventLoop& loop = *g_loops[loop_index];
+    fill_stats(stats, loop.active_connections.load(std::memory_order_relaxed),
+               loop.requests_processed.load(std::memory_order_relaxed),
+               loop.keepalive_reuses.load(std::memory_order_relaxed), 1);
     
     return MEDUSASERV_SUCCESS;
 }
 
 const char* generate_http_response(const char* request) {
-    static std::string response_buffer;
+    thread_local std::string response_buffer;
+    response_buffer.clear();
     
     if (!request) {
-        response_buffer = "HTTP/1.1 400 Bad Request\r\n"
-                         "Server: MedusaServ v0.3.0a (Professional Native C++ Server)\r\n"
-                         "Content-Length: 0\r\n"
-                         "Connection: close\r\n\r\n";
+        append_http_error(response_buffer, FrameStatus::BAD_REQUEST);
         return response_buffer.c_str();
     }
     
     // Parse request method and path
-    std::string req_str(request);
-    size_t first_space = req_str.find(' ');
-    size_t second_space = req_str.find(' ', first_space + 1);
-    
-    if (first_space == std::string::npos || second_space == std::string::npos) {
-        response_buffer = "HTTP/1.1 400 Bad Request\r\n"
-                         "Server: MedusaServ v0.3.0a (Professional Native C++ Server)\r\n"
-                         "Content-Length: 0\r\n"
-                         "Connection: close\r\n\r\n";
+    std::string_view req_str(request);
+    std::string_view method, path, version;
+    
+    if (!parse_request_line(req_str.substr(0, req_str.find("\r\n")), method, path, version)) {
+        append_http_error(response_buffer, FrameStatus::BAD_REQUEST);
         return response_buffer.c_str();
     }
     
-    std::string method = req_str.substr(0, first_space);
-    std::string path = req_str.substr(first_space + 1, second_space - first_space - 1);
-    
     // Generate professional HTTP response
-    if (path == "/health") {
-        response_buffer = "HTTP/1.1 200 OK\r\n"
-                         "Server: MedusaServ v0.3.0a (Professional Native C++ Server)\r\n"
-                         "Content-Type: application/json\r\n"
-                         "Content-Length: 85\r\n"
-                         "Connection: close\r\n\r\n"
-                         "{\n"
-                         "  \"status\": \"healthy\",\n"
-                         "  \"server\": \"MedusaServ v0.3.0a\",\n"
-                         "  \"engine\": \"Native C++\"\n"
-                         "}";
-    } else {
-        response_buffer = "HTTP/1.1 200 OK\r\n"
-                         "Server: MedusaServ v0.3.0a (Professional Native C++ Server)\r\n"
-                         "Content-Type: text/html\r\n"
-                         "Content-Length: 100\r\n"
-                         "Connection: close\r\n\r\n"
-                         "<html><body><h1>MedusaServ v0.3.0a</h1><p>Native C++ Professional Server</p></body></html>";
-    }
+    append_http_response(response_buffer, method, path, false);
     
     return response_buffer.c_str();
 }
@@ -240,4 +811,4 @@ const char* get_http_version() {
 } // extern "C"
 
 } // namespace http
-} // namespace medusaserv
\ No newline at end of file
+} // namespace medusaserv
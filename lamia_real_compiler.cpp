@@ -14,10 +14,33 @@
 #include <fstream>
 #include <string>
 #include <vector>
-#include <map>
-#include <regex>
 #include <memory>
-#include <sstream>
+#include <string_view>
+#include <unordered_map>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <cstdint>
+#include <cctype>
+#include <cstdlib>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "lamia_template_vm.hpp"
 
 namespace MedusaServ {
 namespace Language {
@@ -44,46 +67,202 @@ enum class NodeType {
 };
 
 /**
- * @brief AST Node for parsed Lamia syntax
+ * @brief Lamia source buffer - memory-maps a file, or borrows/owns text
+ *
+ * Tokens and AST slices point into this buffer, so it must outlive them.
  */
-struct ASTNode {
-    NodeType type;
-    std::string name;
-    std::map<std::string, std::string> attributes;
-    std::vector<std::string> content;
-    std::vector<std::shared_ptr<ASTNode>> children;
-    
-    ASTNode(NodeType t, const std::string& n = "") : type(t), name(n) {}
+class SourceBuffer {
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    void* mapping_ = nullptr;
+    std::string owned_;
+    
+public:
+    SourceBuffer() = default;
+    explicit SourceBuffer(std::string text) : owned_(std::move(text)) {
+        data_ = owned_.data();
+        size_ = owned_.size();
+    }
+    ~SourceBuffer() { release(); }
+    
+    SourceBuffer(const SourceBuffer&) = delete;
+    SourceBuffer& operator=(const SourceBuffer&) = delete;
+    
+    bool open(const std::string& path) {
+        release();
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                ::madvise(mapping, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+                mapping_ = mapping;
+                data_ = static_cast<const char*>(mapping);
+                size_ = static_cast<size_t>(info.st_size);
+                ::close(fd);
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+        // Empty files, pipes and platforms without mmap
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return false;
+        owned_.assign((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        data_ = owned_.data();
+        size_ = owned_.size();
+        return true;
+    }
+    
+    std::string_view view() const { return std::string_view(data_, size_); }
+    
+private:
+    void release() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapping_) ::munmap(mapping_, size_);
+#endif
+        mapping_ = nullptr;
+        owned_.clear();
+        data_ = nullptr;
+        size_ = 0;
+    }
 };
 
 /**
- * @brief Lamia Lexer - Tokenizes Lamia source code
+ * @brief Symbol table - interns identifiers to dense ids
+ *
+ * Keywords, widget names and the attribute keys the transpiler reads are
+ * pre-interned so both compare ids, not strings. Text is copied into the table's own storage, so one table
+ * can serve many sources.
+ */
+class SymbolTable {
+public:
+    enum Builtin : uint32_t {
+        MANIFEST, CREATE, STARTUP, RETURN_LIGHT, NEURAL,
+        RADIANT_HEADING, RADIANT_TEXT, RADIANT_BUTTON, CONSTELLATION_LIST, RADIANT_QUOTE,
+        GCODE_BLOCK, BAMBU_PRINTER, SOCIAL_EMBED, EMOTION_3D,
+        CONTENT, ACTION, TITLE, ITEMS, ATTRIBUTION, COMMANDS, VALUE, EXPRESSION, WIDGET_TYPE, RETURN_TYPE,
+        WHEN,
+        BUILTIN_COUNT
+    };
+    
+private:
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    std::vector<std::string_view> names_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t block_used_ = 0;
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+    
+public:
+    SymbolTable() {
+        static const char* const builtins[BUILTIN_COUNT] = {
+            "manifest", "create", "@startup", "return_light", "neural",
+            "RADIANT_HEADING", "RADIANT_TEXT", "RADIANT_BUTTON", "CONSTELLATION_LIST", "RADIANT_QUOTE",
+            "GCODE_BLOCK", "BAMBU_PRINTER", "SOCIAL_EMBED", "3D_EMOTION",
+            "content", "action", "title", "items", "attribution", "commands", "value", "expression",
+            "widget_type", "return_type",
+            "when"
+        };
+        for (const char* name : builtins) intern(name);
+    }
+    
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+    
+    uint32_t intern(std::string_view text) {
+        auto found = ids_.find(text);
+        if (found != ids_.end()) return found->second;
+        std::string_view stored = store(text);
+        uint32_t id = static_cast<uint32_t>(names_.size());
+        names_.push_back(stored);
+        ids_.emplace(stored, id);
+        return id;
+    }
+    
+    std::string_view name(uint32_t id) const { return names_[id]; }
+    size_t size() const { return names_.size(); }
+    
+private:
+    std::string_view store(std::string_view text) {
+        if (text.size() > BLOCK_SIZE / 4) {
+            // Oversized: own block, inserted behind the one being filled
+            if (blocks_.empty()) blocks_.emplace_back(new char[BLOCK_SIZE]);
+            auto at = blocks_.emplace(blocks_.end() - 1, new char[text.size()]);
+            std::memcpy(at->get(), text.data(), text.size());
+            return std::string_view(at->get(), text.size());
+        }
+        if (blocks_.empty() || block_used_ + text.size() > BLOCK_SIZE) {
+            blocks_.emplace_back(new char[BLOCK_SIZE]);
+            block_used_ = 0;
+        }
+        char* at = blocks_.back().get() + block_used_;
+        std::memcpy(at, text.data(), text.size());
+        block_used_ += text.size();
+        return std::string_view(at, text.size());
+    }
+};
+
+/**
+ * @brief Lamia Lexer - Tokenizes Lamia source code on demand
+ *
+ * Borrows the source (it must outlive the lexer and its tokens). Tokens are
+ * 16 bytes: kind, source offset and length, and a symbol id for identifiers;
+ * line and column are recomputed from the offset only when reported.
  */
 class LamiaLexer {
 public:
     struct Token {
-        enum Type { MANIFEST, CREATE, IDENTIFIER, STRING, NUMBER, LBRACE, RBRACE, SEMICOLON, COLON, COMMA, ARROW, AT, LBRACKET, RBRACKET, NEWLINE, END_OF_FILE };
-        Type type;
-        std::string value;
-        size_t line, column;
+        enum Type : uint8_t { MANIFEST, CREATE, IDENTIFIER, STRING, NUMBER, LBRACE, RBRACE, SEMICOLON, COLON, COMMA, ARROW, AT, LBRACKET, RBRACKET, NEWLINE, END_OF_FILE };
+        enum Flags : uint8_t { ESCAPED = 1 };   // STRING: body contains backslash escapes
+        Type type = END_OF_FILE;
+        uint8_t flags = 0;
+        uint32_t offset = 0;                    // STRING: first byte after the opening quote
+        uint32_t length = 0;
+        uint32_t symbol = UINT32_MAX;           // IDENTIFIER, AT, MANIFEST, CREATE
     };
     
 private:
-    std::string source_;
+    std::string_view source_;
     size_t pos_ = 0;
-    size_t line_ = 1;
-    size_t column_ = 1;
+    size_t produced_ = 0;
+    SymbolTable* symbols_;
+    std::unique_ptr<SymbolTable> owned_symbols_;
+    
+    enum CharClass : uint8_t { IDENT_START = 1, IDENT_PART = 2, DIGIT = 4, BLANK = 8 };
+    
+    static const uint8_t* char_classes() {
+        static const auto table = [] {
+            std::array<uint8_t, 256> t{};
+            for (int c = 'a'; c <= 'z'; ++c) t[c] = IDENT_START | IDENT_PART;
+            for (int c = 'A'; c <= 'Z'; ++c) t[c] = IDENT_START | IDENT_PART;
+            for (int c = '0'; c <= '9'; ++c) t[c] = IDENT_PART | DIGIT;
+            t['_'] = t['@'] = IDENT_START | IDENT_PART;
+            t[' '] = t['\t'] = t['\r'] = t['\v'] = t['\f'] = BLANK;
+            return t;
+        }();
+        return table.data();
+    }
     
 public:
-    LamiaLexer(const std::string& source) : source_(source) {}
+    explicit LamiaLexer(std::string_view source, SymbolTable* symbols = nullptr)
+        : source_(source), symbols_(symbols) {
+        if (!symbols_) {
+            owned_symbols_.reset(new SymbolTable());
+            symbols_ = owned_symbols_.get();
+        }
+    }
     
-    std::vector<Token> tokenize() {
-        std::vector<Token> tokens;
-        
-        while (pos_ < source_.length()) {
-            skip_whitespace();
-            
-            if (pos_ >= source_.length()) break;
+    /**
+     * @brief Produce the next token; END_OF_FILE repeats once reached
+     */
+    Token next() {
+        const uint8_t* classes = char_classes();
+        for (;;) {
+            skip_blanks();
+            if (pos_ >= source_.size()) return make(Token::END_OF_FILE, pos_, 0);
             
             char current = source_[pos_];
             
@@ -97,168 +276,395 @@ public:
                 continue;
             }
             
+            uint8_t cls = classes[static_cast<uint8_t>(current)];
+            
             // Keywords and identifiers
-            if (std::isalpha(current) || current == '_' || current == '@') {
-                tokens.push_back(read_identifier_or_keyword());
-                continue;
-            }
+            if (cls & IDENT_START) return read_identifier_or_keyword();
             
             // Strings
-            if (current == '"') {
-                tokens.push_back(read_string());
-                continue;
-            }
+            if (current == '"') return read_string();
             
             // Numbers
-            if (std::isdigit(current)) {
-                tokens.push_back(read_number());
-                continue;
-            }
+            if (cls & DIGIT) return read_number();
             
             // Operators and punctuation
+            size_t start = pos_++;
             switch (current) {
-                case '{': tokens.push_back({Token::LBRACE, "{", line_, column_}); advance(); break;
-                case '}': tokens.push_back({Token::RBRACE, "}", line_, column_}); advance(); break;
-                case ':': tokens.push_back({Token::COLON, ":", line_, column_}); advance(); break;
-                case ',': tokens.push_back({Token::COMMA, ",", line_, column_}); advance(); break;
-                case '[': tokens.push_back({Token::LBRACKET, "[", line_, column_}); advance(); break;
-                case ']': tokens.push_back({Token::RBRACKET, "]", line_, column_}); advance(); break;
-                case ';': tokens.push_back({Token::SEMICOLON, ";", line_, column_}); advance(); break;
-                case '\n': tokens.push_back({Token::NEWLINE, "\n", line_, column_}); advance(); line_++; column_ = 1; break;
+                case '{': return make(Token::LBRACE, start, 1);
+                case '}': return make(Token::RBRACE, start, 1);
+                case ':': return make(Token::COLON, start, 1);
+                case ',': return make(Token::COMMA, start, 1);
+                case '[': return make(Token::LBRACKET, start, 1);
+                case ']': return make(Token::RBRACKET, start, 1);
+                case ';': return make(Token::SEMICOLON, start, 1);
+                case '\n': return make(Token::NEWLINE, start, 1);
                 case '-':
-                    if (peek() == '>') {
-                        tokens.push_back({Token::ARROW, "->", line_, column_});
-                        advance(); advance();
-                    } else {
-                        advance(); // Skip unknown character
+                    if (pos_ < source_.size() && source_[pos_] == '>') {
+                        ++pos_;
+                        return make(Token::ARROW, start, 2);
                     }
-                    break;
+                    break; // Skip unknown character
                 default:
-                    advance(); // Skip unknown character
-                    break;
+                    break; // Skip unknown character
             }
         }
-        
-        tokens.push_back({Token::END_OF_FILE, "", line_, column_});
+    }
+    
+    /**
+     * @brief Tokenize the whole source (tools and diagnostics; the parser pulls tokens lazily)
+     */
+    std::vector<Token> tokenize() {
+        std::vector<Token> tokens;
+        tokens.reserve(source_.size() / 4 + 1);
+        do {
+            tokens.push_back(next());
+        } while (tokens.back().type != Token::END_OF_FILE);
         return tokens;
     }
     
-private:
-    char peek() { return (pos_ + 1 < source_.length()) ? source_[pos_ + 1] : '\0'; }
-    void advance() { pos_++; column_++; }
+    // Raw source text of a token (a STRING token's body without quotes, escapes undecoded)
+    std::string_view text(const Token& token) const { return source_.substr(token.offset, token.length); }
     
-    void skip_whitespace() {
-        while (pos_ < source_.length() && std::isspace(source_[pos_]) && source_[pos_] != '\n') {
-            advance();
+    // Token value as the parser sees it: STRING escapes decoded
+    std::string value(const Token& token) const {
+        if (token.type != Token::STRING || !(token.flags & Token::ESCAPED)) return std::string(text(token));
+        std::string value;
+        value.reserve(token.length);
+        decode_string(text(token), value);
+        return value;
+    }
+    
+    static void decode_string(std::string_view body, std::string& out) {
+        for (size_t i = 0; i < body.size(); ++i) {
+            if (body[i] == '\\' && i + 1 < body.size()) {
+                switch (body[++i]) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case '\\': out += '\\'; break;
+                    case '"': out += '"'; break;
+                    default: out += body[i]; break;
+                }
+            } else {
+                out += body[i];
+            }
         }
     }
     
-    void skip_line_comment() {
-        while (pos_ < source_.length() && source_[pos_] != '\n') {
-            advance();
+    std::pair<size_t, size_t> location(const Token& token) const {
+        size_t line = 1, line_start = 0;
+        for (const char* at = source_.data(), *end = source_.data() + token.offset;
+             (at = static_cast<const char*>(std::memchr(at, '\n', end - at))) != nullptr; ++at) {
+            ++line;
+            line_start = at - source_.data() + 1;
         }
+        return {line, token.offset - line_start + 1};
     }
     
-    void skip_block_comment() {
-        advance(); advance(); // Skip /*
-        while (pos_ + 1 < source_.length()) {
-            if (source_[pos_] == '*' && source_[pos_ + 1] == '/') {
-                advance(); advance();
-                break;
+    SymbolTable& symbols() { return *symbols_; }
+    size_t tokens_produced() const { return produced_; }
+    std::string_view source() const { return source_; }
+    
+private:
+    char peek() const { return (pos_ + 1 < source_.size()) ? source_[pos_ + 1] : '\0'; }
+    
+    Token make(Token::Type type, size_t offset, size_t length, uint32_t symbol = UINT32_MAX, uint8_t flags = 0) {
+        ++produced_;
+        Token token;
+        token.type = type;
+        token.flags = flags;
+        token.offset = static_cast<uint32_t>(offset);
+        token.length = static_cast<uint32_t>(length);
+        token.symbol = symbol;
+        return token;
+    }
+    
+    // Spaces, tabs and carriage returns, 16 bytes at a time (newlines are tokens)
+    void skip_blanks() {
+        const uint8_t* classes = char_classes();
+        const char* data = source_.data();
+        size_t size = source_.size();
+        for (;;) {
+#ifdef __SSE2__
+            const __m128i space = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t');
+            const __m128i cr = _mm_set1_epi8('\r');
+            while (pos_ + 16 <= size) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos_));
+                __m128i blank = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                                             _mm_cmpeq_epi8(chunk, cr));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(blank)) ^ 0xFFFFu;
+                if (mask) {
+                    pos_ += __builtin_ctz(mask);
+                    break;
+                }
+                pos_ += 16;
             }
-            if (source_[pos_] == '\n') { line_++; column_ = 1; }
-            advance();
+#endif
+            if (pos_ < size && (classes[static_cast<uint8_t>(data[pos_])] & BLANK)) {
+                ++pos_;
+                continue;
+            }
+            return;
         }
     }
     
+    // memchr is vectorised by the C library
+    void skip_line_comment() {
+        const void* newline = std::memchr(source_.data() + pos_, '\n', source_.size() - pos_);
+        pos_ = newline ? static_cast<const char*>(newline) - source_.data() : source_.size();
+    }
+    
+    void skip_block_comment() {
+        size_t end = source_.find("*/", pos_ + 2);
+        pos_ = end == std::string_view::npos ? source_.size() : end + 2;
+    }
+    
     Token read_identifier_or_keyword() {
-        size_t start_line = line_, start_column = column_;
-        std::string value;
-        
-        while (pos_ < source_.length() && (std::isalnum(source_[pos_]) || source_[pos_] == '_' || source_[pos_] == '@')) {
-            value += source_[pos_];
-            advance();
+        const uint8_t* classes = char_classes();
+        size_t start = pos_;
+        while (pos_ < source_.size() && (classes[static_cast<uint8_t>(source_[pos_])] & IDENT_PART)) {
+            ++pos_;
         }
+        std::string_view value = source_.substr(start, pos_ - start);
+        uint32_t symbol = symbols_->intern(value);
         
         // Check for keywords
-        if (value == "manifest") return {Token::MANIFEST, value, start_line, start_column};
-        if (value == "create") return {Token::CREATE, value, start_line, start_column};
-        if (value.front() == '@') return {Token::AT, value, start_line, start_column};
+        if (symbol == SymbolTable::MANIFEST) return make(Token::MANIFEST, start, value.size(), symbol);
+        if (symbol == SymbolTable::CREATE) return make(Token::CREATE, start, value.size(), symbol);
+        if (value.front() == '@') return make(Token::AT, start, value.size(), symbol);
         
-        return {Token::IDENTIFIER, value, start_line, start_column};
+        return make(Token::IDENTIFIER, start, value.size(), symbol);
     }
     
     Token read_string() {
-        size_t start_line = line_, start_column = column_;
-        std::string value;
-        advance(); // Skip opening quote
-        
-        while (pos_ < source_.length() && source_[pos_] != '"') {
-            if (source_[pos_] == '\\' && pos_ + 1 < source_.length()) {
-                advance();
-                switch (source_[pos_]) {
-                    case 'n': value += '\n'; break;
-                    case 't': value += '\t'; break;
-                    case 'r': value += '\r'; break;
-                    case '\\': value += '\\'; break;
-                    case '"': value += '"'; break;
-                    default: value += source_[pos_]; break;
-                }
-            } else {
-                value += source_[pos_];
+        size_t start = ++pos_; // Skip opening quote
+        uint8_t flags = 0;
+        for (;;) {
+            const char* quote = static_cast<const char*>(std::memchr(source_.data() + pos_, '"', source_.size() - pos_));
+            size_t end = quote ? quote - source_.data() : source_.size();
+            const char* escape = static_cast<const char*>(std::memchr(source_.data() + pos_, '\\', end - pos_));
+            if (!escape) {
+                pos_ = end;
+                break;
+            }
+            // An escape before the quote may escape the quote itself: step over it and rescan
+            flags = Token::ESCAPED;
+            pos_ = escape - source_.data() + 2;
+            if (pos_ >= source_.size()) {
+                pos_ = source_.size();
+                break;
             }
-            advance();
         }
-        
-        if (pos_ < source_.length()) advance(); // Skip closing quote
-        return {Token::STRING, value, start_line, start_column};
+        size_t length = pos_ - start;
+        if (pos_ < source_.size()) ++pos_; // Skip closing quote
+        return make(Token::STRING, start, length, UINT32_MAX, flags);
     }
     
     Token read_number() {
-        size_t start_line = line_, start_column = column_;
-        std::string value;
-        
-        while (pos_ < source_.length() && (std::isdigit(source_[pos_]) || source_[pos_] == '.')) {
-            value += source_[pos_];
-            advance();
+        const uint8_t* classes = char_classes();
+        size_t start = pos_;
+        while (pos_ < source_.size() && ((classes[static_cast<uint8_t>(source_[pos_])] & DIGIT) || source_[pos_] == '.')) {
+            ++pos_;
         }
-        
-        return {Token::NUMBER, value, start_line, start_column};
+        return make(Token::NUMBER, start, pos_ - start);
+    }
+};
+
+/**
+ * @brief Flat Lamia AST
+ *
+ * Nodes, attributes and values sit in contiguous arrays and refer to each
+ * other by index (first child / next sibling). Text is a slice of the
+ * source, or of the AST's own buffer for decoded escapes and joined values,
+ * so the source must outlive the AST. Attribute keys are symbol ids.
+ */
+class LamiaAst {
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    
+    struct Slice {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        bool owned = false;       // in text_ rather than the source
+    };
+    
+    struct Value {
+        Slice text;               // arrays: the joined "[a, b]" form
+        uint32_t first_item = 0;  // arrays: values_[first_item, first_item + item_count)
+        uint32_t item_count = 0;
+        bool is_array = false;
+        bool closed = false;      // arrays: the closing bracket was present
+    };
+    
+    struct Attribute {
+        uint32_t key;
+        Value value;
+    };
+    
+    struct Node {
+        NodeType type;
+        Slice name;
+        uint32_t first_child = NONE;
+        uint32_t next_sibling = NONE;
+        uint32_t first_attribute = 0;
+        uint32_t attribute_count = 0;
+    };
+    
+private:
+    std::string_view source_;
+    std::vector<Node> nodes_;
+    std::vector<Attribute> attributes_;
+    std::vector<Value> values_;           // array items
+    std::string text_;
+    
+public:
+    explicit LamiaAst(std::string_view source) : source_(source) {
+        add_node(NodeType::MANIFEST, own("program"));
+    }
+    
+    uint32_t root() const { return 0; }
+    const Node& node(uint32_t index) const { return nodes_[index]; }
+    size_t node_count() const { return nodes_.size(); }
+    
+    std::string_view text(const Slice& slice) const {
+        return (slice.owned ? std::string_view(text_) : source_).substr(slice.offset, slice.length);
+    }
+    
+    const Value& item(const Value& array, uint32_t index) const { return values_[array.first_item + index]; }
+    
+    /**
+     * @brief Attribute value by key (last assignment wins); nullptr when absent
+     */
+    const Value* find_attribute(uint32_t node_index, uint32_t key) const {
+        const Node& n = nodes_[node_index];
+        for (uint32_t i = n.attribute_count; i-- > 0;) {
+            const Attribute& attribute = attributes_[n.first_attribute + i];
+            if (attribute.key == key) return &attribute.value;
+        }
+        return nullptr;
+    }
+    
+    // Attribute text; empty when absent (never inserts)
+    std::string_view attribute(uint32_t node_index, uint32_t key) const {
+        const Value* value = find_attribute(node_index, key);
+        return value ? text(value->text) : std::string_view();
+    }
+    
+    /**
+     * @brief Pre-order walk from first and its following siblings, without recursion
+     * @param visit called per node index; returns true to descend into its children
+     */
+    template <typename Visit>
+    void walk(uint32_t first, Visit&& visit) const {
+        std::vector<uint32_t> resume;
+        uint32_t at = first;
+        while (at != NONE || !resume.empty()) {
+            if (at == NONE) {
+                at = resume.back();
+                resume.pop_back();
+                continue;
+            }
+            const Node& n = nodes_[at];
+            if (visit(at) && n.first_child != NONE) {
+                resume.push_back(n.next_sibling);
+                at = n.first_child;
+            } else {
+                at = n.next_sibling;
+            }
+        }
+    }
+    
+    size_t memory_bytes() const {
+        return nodes_.capacity() * sizeof(Node) + attributes_.capacity() * sizeof(Attribute) +
+               values_.capacity() * sizeof(Value) + text_.capacity();
+    }
+    
+    // Building (LamiaParser)
+    
+    uint32_t add_node(NodeType type) { return add_node(type, Slice()); }
+    
+    uint32_t add_node(NodeType type, Slice name) {
+        Node n;
+        n.type = type;
+        n.name = name;
+        n.first_attribute = static_cast<uint32_t>(attributes_.size());
+        nodes_.push_back(n);
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+    
+    // tail: the parent's last child so far (NONE initially), updated
+    void append_child(uint32_t parent, uint32_t child, uint32_t& tail) {
+        if (tail == NONE) nodes_[parent].first_child = child;
+        else nodes_[tail].next_sibling = child;
+        tail = child;
+    }
+    
+    void set_type(uint32_t node_index, NodeType type) { nodes_[node_index].type = type; }
+    void set_name(uint32_t node_index, Slice name) { nodes_[node_index].name = name; }
+    
+    // A node's attributes must be added before any other node's
+    void set_attribute(uint32_t node_index, uint32_t key, const Value& value) {
+        Node& n = nodes_[node_index];
+        if (n.attribute_count == 0) n.first_attribute = static_cast<uint32_t>(attributes_.size());
+        attributes_.push_back(Attribute{key, value});
+        ++n.attribute_count;
+    }
+    
+    uint32_t add_items(const std::vector<Value>& items) {
+        uint32_t first = static_cast<uint32_t>(values_.size());
+        values_.insert(values_.end(), items.begin(), items.end());
+        return first;
+    }
+    
+    Slice source_slice(size_t offset, size_t length) const {
+        return Slice{static_cast<uint32_t>(offset), static_cast<uint32_t>(length), false};
+    }
+    
+    Slice own(std::string_view text) {
+        Slice slice{static_cast<uint32_t>(text_.size()), static_cast<uint32_t>(text.size()), true};
+        text_.append(text.data(), text.size());
+        return slice;
     }
 };
 
 /**
- * @brief Lamia Parser - Builds AST from tokens
+ * @brief Lamia Parser - Builds the flat AST from tokens
  */
 class LamiaParser {
 private:
-    std::vector<LamiaLexer::Token> tokens_;
-    size_t current_ = 0;
+    LamiaLexer& lexer_;
+    LamiaLexer::Token current_;
+    LamiaAst ast_;
+    std::string scratch_;
     
 public:
-    LamiaParser(const std::vector<LamiaLexer::Token>& tokens) : tokens_(tokens) {}
+    // Pulls tokens from the lexer one at a time; no token vector is built
+    explicit LamiaParser(LamiaLexer& lexer) : lexer_(lexer), current_(lexer.next()), ast_(lexer.source()) {}
     
-    std::shared_ptr<ASTNode> parse() {
-        auto root = std::make_shared<ASTNode>(NodeType::MANIFEST, "program");
+    LamiaAst parse() {
+        uint32_t root = ast_.root();
+        uint32_t tail = LamiaAst::NONE;
         
         while (!is_at_end()) {
             skip_newlines();
             if (is_at_end()) break;
             
-            auto node = parse_statement();
-            if (node) {
-                root->children.push_back(node);
+            uint32_t node = parse_statement();
+            if (node != LamiaAst::NONE) {
+                ast_.append_child(root, node, tail);
             }
         }
         
-        return root;
+        return std::move(ast_);
     }
     
 private:
-    bool is_at_end() { return current_ >= tokens_.size() || tokens_[current_].type == LamiaLexer::Token::END_OF_FILE; }
-    LamiaLexer::Token& current() { return tokens_[current_]; }
-    LamiaLexer::Token& peek() { return tokens_[current_ + 1]; }
-    void advance() { if (!is_at_end()) current_++; }
+    using Value = LamiaAst::Value;
+    
+    bool is_at_end() { return current_.type == LamiaLexer::Token::END_OF_FILE; }
+    const LamiaLexer::Token& current() { return current_; }
+    void advance() { if (!is_at_end()) current_ = lexer_.next(); }
     
     void skip_newlines() {
         while (!is_at_end() && current().type == LamiaLexer::Token::NEWLINE) {
@@ -273,57 +679,64 @@ private:
         return true;
     }
     
-    std::shared_ptr<ASTNode> parse_statement() {
+    LamiaAst::Slice token_slice(const LamiaLexer::Token& token) { return ast_.source_slice(token.offset, token.length); }
+    
+    uint32_t parse_statement() {
         if (current().type == LamiaLexer::Token::MANIFEST) {
             return parse_manifest();
         }
         if (current().type == LamiaLexer::Token::CREATE) {
             return parse_create();
         }
-        if (current().type == LamiaLexer::Token::AT && current().value == "@startup") {
+        if (current().type == LamiaLexer::Token::AT && current().symbol == SymbolTable::STARTUP) {
             return parse_startup();
         }
-        if (current().type == LamiaLexer::Token::IDENTIFIER && current().value == "return_light") {
+        if (current().type == LamiaLexer::Token::IDENTIFIER && current().symbol == SymbolTable::RETURN_LIGHT) {
             return parse_return_light();
         }
-        if (current().type == LamiaLexer::Token::IDENTIFIER && current().value == "neural") {
+        if (current().type == LamiaLexer::Token::IDENTIFIER && current().symbol == SymbolTable::NEURAL) {
             return parse_neural();
         }
         
         // Skip unknown statements
         advance();
-        return nullptr;
+        return LamiaAst::NONE;
     }
     
-    std::shared_ptr<ASTNode> parse_manifest() {
-        auto node = std::make_shared<ASTNode>(NodeType::MANIFEST);
+    uint32_t parse_manifest() {
+        uint32_t node = ast_.add_node(NodeType::MANIFEST);
         advance(); // consume 'manifest'
         
         if (current().type == LamiaLexer::Token::IDENTIFIER) {
-            node->name = current().value;
+            ast_.set_name(node, token_slice(current()));
             advance();
         }
         
         // Parse parameters if present
         if (match(LamiaLexer::Token::ARROW)) {
             // Parse return type and attributes
+            scratch_.clear();
             while (!is_at_end() && current().type != LamiaLexer::Token::LBRACE) {
                 if (current().type == LamiaLexer::Token::IDENTIFIER || current().type == LamiaLexer::Token::AT) {
-                    node->attributes["return_type"] += current().value + " ";
-                    advance();
+                    scratch_.append(lexer_.text(current())).append(" ");
                 }
+                advance();
             }
+            Value value;
+            value.text = ast_.own(scratch_);
+            ast_.set_attribute(node, SymbolTable::RETURN_TYPE, value);
         }
         
         // Parse body
         if (match(LamiaLexer::Token::LBRACE)) {
+            uint32_t tail = LamiaAst::NONE;
             while (!is_at_end() && current().type != LamiaLexer::Token::RBRACE) {
                 skip_newlines();
                 if (current().type == LamiaLexer::Token::RBRACE) break;
                 
-                auto child = parse_statement();
-                if (child) {
-                    node->children.push_back(child);
+                uint32_t child = parse_statement();
+                if (child != LamiaAst::NONE) {
+                    ast_.append_child(node, child, tail);
                 }
             }
             match(LamiaLexer::Token::RBRACE);
@@ -332,24 +745,28 @@ private:
         return node;
     }
     
-    std::shared_ptr<ASTNode> parse_create() {
-        auto node = std::make_shared<ASTNode>(NodeType::CREATE);
+    uint32_t parse_create() {
+        uint32_t node = ast_.add_node(NodeType::CREATE);
         advance(); // consume 'create'
         
         if (current().type == LamiaLexer::Token::IDENTIFIER) {
-            std::string widget_type = current().value;
-            node->attributes["widget_type"] = widget_type;
+            Value widget_type;
+            widget_type.text = token_slice(current());
+            ast_.set_attribute(node, SymbolTable::WIDGET_TYPE, widget_type);
             
             // Determine specific node type
-            if (widget_type == "RADIANT_HEADING") node->type = NodeType::RADIANT_HEADING;
-            else if (widget_type == "RADIANT_TEXT") node->type = NodeType::RADIANT_TEXT;
-            else if (widget_type == "RADIANT_BUTTON") node->type = NodeType::RADIANT_BUTTON;
-            else if (widget_type == "CONSTELLATION_LIST") node->type = NodeType::CONSTELLATION_LIST;
-            else if (widget_type == "RADIANT_QUOTE") node->type = NodeType::RADIANT_QUOTE;
-            else if (widget_type == "GCODE_BLOCK") node->type = NodeType::GCODE_BLOCK;
-            else if (widget_type == "BAMBU_PRINTER") node->type = NodeType::BAMBU_PRINTER;
-            else if (widget_type == "SOCIAL_EMBED") node->type = NodeType::SOCIAL_EMBED;
-            else if (widget_type == "3D_EMOTION") node->type = NodeType::EMOTION_3D;
+            switch (current().symbol) {
+                case SymbolTable::RADIANT_HEADING: ast_.set_type(node, NodeType::RADIANT_HEADING); break;
+                case SymbolTable::RADIANT_TEXT: ast_.set_type(node, NodeType::RADIANT_TEXT); break;
+                case SymbolTable::RADIANT_BUTTON: ast_.set_type(node, NodeType::RADIANT_BUTTON); break;
+                case SymbolTable::CONSTELLATION_LIST: ast_.set_type(node, NodeType::CONSTELLATION_LIST); break;
+                case SymbolTable::RADIANT_QUOTE: ast_.set_type(node, NodeType::RADIANT_QUOTE); break;
+                case SymbolTable::GCODE_BLOCK: ast_.set_type(node, NodeType::GCODE_BLOCK); break;
+                case SymbolTable::BAMBU_PRINTER: ast_.set_type(node, NodeType::BAMBU_PRINTER); break;
+                case SymbolTable::SOCIAL_EMBED: ast_.set_type(node, NodeType::SOCIAL_EMBED); break;
+                case SymbolTable::EMOTION_3D: ast_.set_type(node, NodeType::EMOTION_3D); break;
+                default: break;
+            }
             
             advance();
         }
@@ -363,19 +780,18 @@ private:
         return node;
     }
     
-    void parse_attributes(std::shared_ptr<ASTNode> node) {
+    void parse_attributes(uint32_t node) {
         while (!is_at_end() && current().type != LamiaLexer::Token::RBRACE) {
             skip_newlines();
             if (current().type == LamiaLexer::Token::RBRACE) break;
             
             // Parse key: value pairs
             if (current().type == LamiaLexer::Token::IDENTIFIER) {
-                std::string key = current().value;
+                uint32_t key = current().symbol;
                 advance();
                 
                 if (match(LamiaLexer::Token::COLON)) {
-                    std::string value = parse_value();
-                    node->attributes[key] = value;
+                    ast_.set_attribute(node, key, parse_value());
                 }
             } else {
                 advance(); // Skip unknown tokens
@@ -388,19 +804,19 @@ private:
         }
     }
     
-    std::string parse_value() {
+    Value parse_value() {
+        Value value;
         if (current().type == LamiaLexer::Token::STRING) {
-            std::string value = current().value;
-            advance();
-            return value;
-        }
-        if (current().type == LamiaLexer::Token::NUMBER) {
-            std::string value = current().value;
+            if (current().flags & LamiaLexer::Token::ESCAPED) {
+                value.text = ast_.own(lexer_.value(current()));
+            } else {
+                value.text = token_slice(current());
+            }
             advance();
             return value;
         }
-        if (current().type == LamiaLexer::Token::IDENTIFIER) {
-            std::string value = current().value;
+        if (current().type == LamiaLexer::Token::NUMBER || current().type == LamiaLexer::Token::IDENTIFIER) {
+            value.text = token_slice(current());
             advance();
             return value;
         }
@@ -409,271 +825,503 @@ private:
         }
         
         advance();
-        return "";
+        return value;
     }
     
-    std::string parse_array() {
-        std::string result = "[";
+    Value parse_array() {
         advance(); // consume '['
         
-        bool first = true;
+        std::vector<Value> items;
         while (!is_at_end() && current().type != LamiaLexer::Token::RBRACKET) {
             skip_newlines();
             if (current().type == LamiaLexer::Token::RBRACKET) break;
             
-            if (!first) result += ", ";
-            first = false;
-            
-            result += parse_value();
+            items.push_back(parse_value());
             
             if (current().type == LamiaLexer::Token::COMMA) {
                 advance();
             }
         }
         
-        if (match(LamiaLexer::Token::RBRACKET)) {
-            result += "]";
-        }
+        // Nested arrays have already stored their items; ours follow as one run
+        Value array;
+        array.is_array = true;
+        array.closed = match(LamiaLexer::Token::RBRACKET);
+        array.item_count = static_cast<uint32_t>(items.size());
+        array.first_item = ast_.add_items(items);
         
-        return result;
+        std::string joined = "[";
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (i) joined += ", ";
+            joined.append(ast_.text(items[i].text));
+        }
+        if (array.closed) joined += "]";
+        array.text = ast_.own(joined);
+        return array;
     }
     
-    std::shared_ptr<ASTNode> parse_startup() {
-        auto node = std::make_shared<ASTNode>(NodeType::STARTUP);
+    uint32_t parse_startup() {
+        uint32_t node = ast_.add_node(NodeType::STARTUP);
         advance(); // consume '@startup'
         skip_newlines();
         
         // Parse the following manifest
         if (current().type == LamiaLexer::Token::MANIFEST) {
-            auto manifest = parse_manifest();
-            node->children.push_back(manifest);
+            uint32_t tail = LamiaAst::NONE;
+            ast_.append_child(node, parse_manifest(), tail);
         }
         
         return node;
     }
     
-    std::shared_ptr<ASTNode> parse_return_light() {
-        auto node = std::make_shared<ASTNode>(NodeType::RETURN_LIGHT);
+    uint32_t parse_return_light() {
+        uint32_t node = ast_.add_node(NodeType::RETURN_LIGHT);
         advance(); // consume 'return_light'
         
         if (!is_at_end()) {
-            node->attributes["value"] = parse_value();
+            ast_.set_attribute(node, SymbolTable::VALUE, parse_value());
         }
         
         return node;
     }
     
-    std::shared_ptr<ASTNode> parse_neural() {
-        auto node = std::make_shared<ASTNode>(NodeType::NEURAL);
+    uint32_t parse_neural() {
+        uint32_t node = ast_.add_node(NodeType::NEURAL);
         advance(); // consume 'neural'
         
         if (current().type == LamiaLexer::Token::IDENTIFIER) {
-            node->name = current().value;
+            ast_.set_name(node, token_slice(current()));
             advance();
         }
         
         if (match(LamiaLexer::Token::COLON)) {
-            node->attributes["expression"] = parse_value();
+            ast_.set_attribute(node, SymbolTable::EXPRESSION, parse_value());
         }
         
         return node;
     }
 };
 
+/**
+ * @brief Output buffer for generated code
+ *
+ * Everything for one document is appended to a single growable buffer.
+ * Given a file descriptor (file, pipe or socket) it flushes whenever it
+ * passes FLUSH_THRESHOLD, so output of any size streams in fixed memory.
+ */
+class OutputBuffer {
+private:
+    std::string buffer_;
+    int fd_ = -1;
+    bool failed_ = false;
+    static constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+    static constexpr size_t INDENT_TABLE_SIZE = 64;
+    
+public:
+    OutputBuffer() { buffer_.reserve(16 * 1024); }
+    explicit OutputBuffer(int fd) : fd_(fd) { buffer_.reserve(FLUSH_THRESHOLD * 2); }
+    ~OutputBuffer() { flush(); }
+    
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+    
+    OutputBuffer& append(std::string_view text) {
+        buffer_.append(text.data(), text.size());
+        if (fd_ >= 0 && buffer_.size() >= FLUSH_THRESHOLD) flush();
+        return *this;
+    }
+    
+    OutputBuffer& append(char c) {
+        buffer_.push_back(c);
+        return *this;
+    }
+    
+    // Spaces from a fixed table: no per-line string
+    OutputBuffer& indent(size_t width) {
+        static const std::string spaces(INDENT_TABLE_SIZE, ' ');
+        for (; width > INDENT_TABLE_SIZE; width -= INDENT_TABLE_SIZE) buffer_.append(spaces);
+        buffer_.append(spaces, 0, width);
+        return *this;
+    }
+    
+    /**
+     * @brief Append HTML-escaped text (< > & ")
+     * Runs of safe bytes are found 16 at a time and copied in one go.
+     */
+    OutputBuffer& append_escaped_html(std::string_view text) {
+        return append_escaped(text, [](char c) -> std::string_view {
+            switch (c) {
+                case '<': return "&lt;";
+                case '>': return "&gt;";
+                case '&': return "&amp;";
+                case '"': return "&quot;";
+                default: return std::string_view();
+            }
+        }, "<>&\"");
+    }
+    
+    /**
+     * @brief Append text escaped for a single-quoted JavaScript string
+     */
+    OutputBuffer& append_escaped_js(std::string_view text) {
+        return append_escaped(text, [](char c) -> std::string_view {
+            switch (c) {
+                case '\'': return "\\'";
+                case '\\': return "\\\\";
+                case '\n': return "\\n";
+                case '\r': return "\\r";
+                default: return std::string_view();
+            }
+        }, "'\\\n\r");
+    }
+    
+    /**
+     * @brief Write out buffered bytes (descriptor mode; no-op in memory)
+     * @return false once any write has failed
+     */
+    bool flush() {
+        if (fd_ < 0 || buffer_.empty()) return !failed_;
+#if defined(__unix__) || defined(__APPLE__)
+        const char* at = buffer_.data();
+        size_t left = buffer_.size();
+        while (left && !failed_) {
+            ssize_t written = ::write(fd_, at, left);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) {
+                failed_ = true;
+                break;
+            }
+            at += written;
+            left -= static_cast<size_t>(written);
+        }
+#else
+        failed_ = true;
+#endif
+        buffer_.clear();
+        return !failed_;
+    }
+    
+    bool failed() const { return failed_; }
+    size_t size() const { return buffer_.size(); }
+    const std::string& str() const { return buffer_; }
+    std::string take() { return std::move(buffer_); }
+    
+private:
+    // specials: the (at most four) bytes escape() maps
+    template <typename Escape>
+    OutputBuffer& append_escaped(std::string_view text, Escape escape, const char (&specials)[5]) {
+        const char* data = text.data();
+        size_t size = text.size();
+        size_t run = 0;   // start of the pending safe run
+        size_t i = 0;
+        while (i < size) {
+#ifdef __SSE2__
+            const __m128i s0 = _mm_set1_epi8(specials[0]);
+            const __m128i s1 = _mm_set1_epi8(specials[1]);
+            const __m128i s2 = _mm_set1_epi8(specials[2]);
+            const __m128i s3 = _mm_set1_epi8(specials[3]);
+            while (i + 16 <= size) {
+                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, s0), _mm_cmpeq_epi8(chunk, s1)),
+                                           _mm_or_si128(_mm_cmpeq_epi8(chunk, s2), _mm_cmpeq_epi8(chunk, s3)));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+                if (mask) {
+                    i += __builtin_ctz(mask);
+                    break;
+                }
+                i += 16;
+            }
+            if (i >= size) break;
+#endif
+            std::string_view replacement = escape(data[i]);
+            if (!replacement.empty()) {
+                buffer_.append(data + run, i - run);
+                buffer_.append(replacement.data(), replacement.size());
+                run = i + 1;
+            }
+            ++i;
+        }
+        buffer_.append(data + run, size - run);
+        if (fd_ >= 0 && buffer_.size() >= FLUSH_THRESHOLD) flush();
+        return *this;
+    }
+};
+
 /**
  * @brief Real Lamia Transpiler - Converts AST to target languages
+ *
+ * Emits straight into an OutputBuffer; the string-returning overloads are
+ * conveniences over an in-memory buffer.
  */
 class LamiaTranspiler {
+private:
+    bool template_mode_ = false;
+    std::vector<std::pair<size_t, size_t>> tags_;   // template mode: [begin, end) of each emitted tag
+    
 public:
     /**
      * @brief Transpile AST to HTML
      */
-    std::string transpile_to_html(std::shared_ptr<ASTNode> ast) {
-        std::ostringstream html;
-        
-        html << "<!DOCTYPE html>\n<html lang=\"en\">\n<head>\n";
-        html << "    <meta charset=\"UTF-8\">\n";
-        html << "    <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">\n";
-        html << "    <title>Lamia Application</title>\n";
-        html << "    <style>\n";
-        html << generate_css_from_ast(ast);
-        html << "    </style>\n";
-        html << "</head>\n<body>\n";
-        html << "    <div class=\"lamia-app\">\n";
+    std::string transpile_to_html(const LamiaAst& ast) {
+        OutputBuffer html;
+        transpile_to_html(ast, html);
+        return html.take();
+    }
+    
+    void transpile_to_html(const LamiaAst& ast, OutputBuffer& html) {
+        html.append("<!DOCTYPE html>\n<html lang=\"en\">\n<head>\n");
+        html.append("    <meta charset=\"UTF-8\">\n");
+        html.append("    <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">\n");
+        html.append("    <title>Lamia Application</title>\n");
+        html.append("    <style>\n");
+        generate_css_from_ast(ast, html);
+        html.append("    </style>\n");
+        html.append("</head>\n<body>\n");
+        html.append("    <div class=\"lamia-app\">\n");
         
-        for (const auto& child : ast->children) {
-            html << transpile_node_to_html(child, 2);
-        }
+        // Manifests and startup blocks only group widgets: descend, emit nothing
+        ast.walk(ast.node(ast.root()).first_child, [&](uint32_t node) {
+            NodeType type = ast.node(node).type;
+            if (type == NodeType::MANIFEST || type == NodeType::STARTUP) return true;
+            transpile_node_to_html(ast, node, 2, html);
+            return false;
+        });
         
-        html << "    </div>\n";
-        html << "    <script>\n";
-        html << generate_js_from_ast(ast);
-        html << "    </script>\n";
-        html << "</body>\n</html>\n";
+        html.append("    </div>\n");
+        html.append("    <script>\n");
+        generate_js_from_ast(ast, html);
+        html.append("    </script>\n");
+        html.append("</body>\n</html>\n");
+    }
+    
+    /**
+     * @brief The HTML page as template text for compile_template()
+     *
+     * Widgets with "when: flag" render inside {{#flag}}, and lists whose items
+     * attribute names a list loop over {{#name}}. Every other "{{" in the page
+     * is escaped, so source text never becomes a live tag.
+     */
+    std::string transpile_to_template(const LamiaAst& ast) {
+        OutputBuffer html;
+        template_mode_ = true;
+        tags_.clear();
+        transpile_to_html(ast, html);
+        template_mode_ = false;
         
-        return html.str();
+        const std::string& page = html.str();
+        std::string text;
+        text.reserve(page.size() + page.size() / 64);
+        size_t pos = 0;
+        for (size_t t = 0; t <= tags_.size(); ++t) {
+            size_t end = t < tags_.size() ? tags_[t].first : page.size();
+            // "{" followed by "{" (its own or a tag's) becomes the literal form {{{}}
+            for (size_t brace = page.find('{', pos); brace < end; brace = page.find('{', pos)) {
+                if (brace + 1 < page.size() && page[brace + 1] == '{') {
+                    text.append(page, pos, brace - pos).append("{{{}}");
+                    pos = brace + 1;
+                } else {
+                    text.append(page, pos, brace + 1 - pos);
+                    pos = brace + 1;
+                }
+            }
+            text.append(page, pos, end - pos);
+            if (t < tags_.size()) text.append(page, tags_[t].first, tags_[t].second - tags_[t].first);
+            pos = t < tags_.size() ? tags_[t].second : end;
+        }
+        return text;
     }
     
     /**
      * @brief Transpile AST to JavaScript
      */
-    std::string transpile_to_javascript(std::shared_ptr<ASTNode> ast) {
-        std::ostringstream js;
-        
-        js << "// LAMIA TRANSPILED JAVASCRIPT\n";
-        js << "class LamiaApp {\n";
-        js << "    constructor() {\n";
-        js << "        this.initialized = false;\n";
-        js << "        this.init();\n";
-        js << "    }\n\n";
-        js << "    init() {\n";
+    std::string transpile_to_javascript(const LamiaAst& ast) {
+        OutputBuffer js;
+        transpile_to_javascript(ast, js);
+        return js.take();
+    }
+    
+    void transpile_to_javascript(const LamiaAst& ast, OutputBuffer& js) {
+        js.append("// LAMIA TRANSPILED JAVASCRIPT\n");
+        js.append("class LamiaApp {\n");
+        js.append("    constructor() {\n");
+        js.append("        this.initialized = false;\n");
+        js.append("        this.init();\n");
+        js.append("    }\n\n");
+        js.append("    init() {\n");
         
-        for (const auto& child : ast->children) {
-            js << transpile_node_to_js(child, 2);
-        }
+        uint32_t first = ast.node(ast.root()).first_child;
+        transpile_nodes_to_js(ast, first, 2, js);
         
-        js << "        this.initialized = true;\n";
-        js << "    }\n";
+        js.append("        this.initialized = true;\n");
+        js.append("    }\n");
         
         // Generate methods for manifests
-        for (const auto& child : ast->children) {
-            if (child->type == NodeType::MANIFEST || child->type == NodeType::STARTUP) {
-                js << generate_manifest_method(child);
+        for (uint32_t child = first; child != LamiaAst::NONE; child = ast.node(child).next_sibling) {
+            NodeType type = ast.node(child).type;
+            if (type == NodeType::MANIFEST || type == NodeType::STARTUP) {
+                generate_manifest_method(ast, child, js);
             }
         }
         
-        js << "}\n\n";
-        js << "// Initialize Lamia application\n";
-        js << "document.addEventListener('DOMContentLoaded', () => {\n";
-        js << "    new LamiaApp();\n";
-        js << "});\n";
-        
-        return js.str();
+        js.append("}\n\n");
+        js.append("// Initialize Lamia application\n");
+        js.append("document.addEventListener('DOMContentLoaded', () => {\n");
+        js.append("    new LamiaApp();\n");
+        js.append("});\n");
     }
     
 private:
-    std::string transpile_node_to_html(std::shared_ptr<ASTNode> node, int indent) {
-        std::string spaces(indent, ' ');
-        std::ostringstream html;
-        
-        switch (node->type) {
-            case NodeType::MANIFEST:
-            case NodeType::STARTUP:
-                for (const auto& child : node->children) {
-                    html << transpile_node_to_html(child, indent);
-                }
-                break;
-                
+    // One widget's markup; the caller walks the tree
+    void transpile_node_to_html(const LamiaAst& ast, uint32_t node, size_t indent, OutputBuffer& html) {
+        std::string_view condition = template_mode_ ? ast.attribute(node, SymbolTable::WHEN) : std::string_view();
+        if (!template_name(condition)) condition = std::string_view();
+        if (!condition.empty()) {
+            append_tag(html.indent(indent), "#", condition).append('\n');
+        }
+        transpile_widget_to_html(ast, node, indent, html);
+        if (!condition.empty()) {
+            append_tag(html.indent(indent), "/", condition).append('\n');
+        }
+    }
+    
+    // Names the compiler may turn into tags: [A-Za-z0-9_-]+
+    static bool template_name(std::string_view name) {
+        if (name.empty()) return false;
+        for (char c : name) {
+            if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_' && c != '-') return false;
+        }
+        return true;
+    }
+    
+    OutputBuffer& append_tag(OutputBuffer& html, std::string_view sigil, std::string_view name) {
+        size_t begin = html.size();
+        html.append("{{").append(sigil).append(name).append("}}");
+        tags_.emplace_back(begin, html.size());
+        return html;
+    }
+    
+    void transpile_widget_to_html(const LamiaAst& ast, uint32_t node, size_t indent, OutputBuffer& html) {
+        switch (ast.node(node).type) {
             case NodeType::RADIANT_HEADING:
-                html << spaces << "<div class=\"radiant-heading\">\n";
-                html << spaces << "  <h1>" << escape_html(node->attributes["content"]) << "</h1>\n";
-                html << spaces << "</div>\n";
+                html.indent(indent).append("<div class=\"radiant-heading\">\n");
+                html.indent(indent).append("  <h1>").append_escaped_html(ast.attribute(node, SymbolTable::CONTENT)).append("</h1>\n");
+                html.indent(indent).append("</div>\n");
                 break;
                 
             case NodeType::RADIANT_TEXT:
-                html << spaces << "<div class=\"radiant-text\">\n";
-                html << spaces << "  <p>" << escape_html(node->attributes["content"]) << "</p>\n";
-                html << spaces << "</div>\n";
+                html.indent(indent).append("<div class=\"radiant-text\">\n");
+                html.indent(indent).append("  <p>").append_escaped_html(ast.attribute(node, SymbolTable::CONTENT)).append("</p>\n");
+                html.indent(indent).append("</div>\n");
                 break;
                 
             case NodeType::RADIANT_BUTTON:
-                html << spaces << "<div class=\"radiant-button\">\n";
-                html << spaces << "  <button onclick=\"" << node->attributes["action"] << "\">";
-                html << escape_html(node->attributes["content"]) << "</button>\n";
-                html << spaces << "</div>\n";
+                html.indent(indent).append("<div class=\"radiant-button\">\n");
+                html.indent(indent).append("  <button onclick=\"").append_escaped_html(ast.attribute(node, SymbolTable::ACTION)).append("\">");
+                html.append_escaped_html(ast.attribute(node, SymbolTable::CONTENT)).append("</button>\n");
+                html.indent(indent).append("</div>\n");
                 break;
                 
             case NodeType::CONSTELLATION_LIST:
                 {
-                    html << spaces << "<div class=\"constellation-list\">\n";
-                    html << spaces << "  <h3>" << escape_html(node->attributes["title"]) << "</h3>\n";
-                    html << spaces << "  <ul>\n";
+                    html.indent(indent).append("<div class=\"constellation-list\">\n");
+                    html.indent(indent).append("  <h3>").append_escaped_html(ast.attribute(node, SymbolTable::TITLE)).append("</h3>\n");
+                    html.indent(indent).append("  <ul>\n");
                     
-                    // Parse items array
-                    std::string items = node->attributes["items"];
-                    if (!items.empty() && items.front() == '[' && items.back() == ']') {
-                        items = items.substr(1, items.length() - 2); // Remove brackets
-                        std::istringstream ss(items);
-                        std::string item;
-                        while (std::getline(ss, item, ',')) {
-                            // Remove quotes and whitespace
-                            item.erase(0, item.find_first_not_of(" \t\""));
-                            item.erase(item.find_last_not_of(" \t\"") + 1);
-                            html << spaces << "    <li>" << escape_html(item) << "</li>\n";
+                    // Items of a closed array, trimmed as the joined form always was
+                    const LamiaAst::Value* items = ast.find_attribute(node, SymbolTable::ITEMS);
+                    if (items && items->is_array && items->closed) {
+                        for (uint32_t i = 0; i < items->item_count; ++i) {
+                            std::string_view item = ast.text(ast.item(*items, i).text);
+                            size_t begin = item.find_first_not_of(" \t\"");
+                            item = begin == std::string_view::npos ? std::string_view() : item.substr(begin);
+                            item = item.substr(0, item.find_last_not_of(" \t\"") + 1);
+                            html.indent(indent).append("    <li>").append_escaped_html(item).append("</li>\n");
                         }
+                    } else if (items && !items->is_array && template_mode_ && template_name(ast.text(items->text))) {
+                        // Named list, supplied per request
+                        std::string_view name = ast.text(items->text);
+                        append_tag(html.indent(indent + 4), "#", name).append("<li>");
+                        append_tag(html, "", ".").append("</li>");
+                        append_tag(html, "/", name).append('\n');
                     }
                     
-                    html << spaces << "  </ul>\n";
-                    html << spaces << "</div>\n";
+                    html.indent(indent).append("  </ul>\n");
+                    html.indent(indent).append("</div>\n");
                     break;
                 }
                 
             case NodeType::RADIANT_QUOTE:
-                html << spaces << "<div class=\"radiant-quote\">\n";
-                html << spaces << "  <blockquote>" << escape_html(node->attributes["content"]) << "</blockquote>\n";
-                if (!node->attributes["attribution"].empty()) {
-                    html << spaces << "  <cite>" << escape_html(node->attributes["attribution"]) << "</cite>\n";
+                {
+                    html.indent(indent).append("<div class=\"radiant-quote\">\n");
+                    html.indent(indent).append("  <blockquote>").append_escaped_html(ast.attribute(node, SymbolTable::CONTENT)).append("</blockquote>\n");
+                    std::string_view attribution = ast.attribute(node, SymbolTable::ATTRIBUTION);
+                    if (!attribution.empty()) {
+                        html.indent(indent).append("  <cite>").append_escaped_html(attribution).append("</cite>\n");
+                    }
+                    html.indent(indent).append("</div>\n");
+                    break;
                 }
-                html << spaces << "</div>\n";
-                break;
                 
             case NodeType::GCODE_BLOCK:
-                html << spaces << "<div class=\"gcode-block\">\n";
-                html << spaces << "  <h4>G-Code Block</h4>\n";
-                html << spaces << "  <pre>" << escape_html(node->attributes["commands"]) << "</pre>\n";
-                html << spaces << "</div>\n";
+                html.indent(indent).append("<div class=\"gcode-block\">\n");
+                html.indent(indent).append("  <h4>G-Code Block</h4>\n");
+                html.indent(indent).append("  <pre>").append_escaped_html(ast.attribute(node, SymbolTable::COMMANDS)).append("</pre>\n");
+                html.indent(indent).append("</div>\n");
                 break;
                 
             default:
                 // Skip other node types for HTML output
                 break;
         }
-        
-        return html.str();
     }
     
-    std::string transpile_node_to_js(std::shared_ptr<ASTNode> node, int indent) {
-        std::string spaces(indent * 4, ' ');
-        std::ostringstream js;
+    // Statements for first and its siblings, descending into nested manifests
+    void transpile_nodes_to_js(const LamiaAst& ast, uint32_t first, size_t indent, OutputBuffer& js) {
+        ast.walk(first, [&](uint32_t node) {
+            transpile_node_to_js(ast, node, indent, js);
+            return ast.node(node).type == NodeType::MANIFEST;
+        });
+    }
+    
+    void transpile_node_to_js(const LamiaAst& ast, uint32_t node, size_t indent, OutputBuffer& js) {
+        size_t spaces = indent * 4;
         
-        switch (node->type) {
+        switch (ast.node(node).type) {
             case NodeType::MANIFEST:
-                js << spaces << "// Manifest: " << node->name << "\n";
-                for (const auto& child : node->children) {
-                    js << transpile_node_to_js(child, indent);
-                }
+                js.indent(spaces).append("// Manifest: ").append(ast.text(ast.node(node).name)).append('\n');
                 break;
                 
             case NodeType::RADIANT_HEADING:
-                js << spaces << "this.createRadiantHeading('" << escape_js(node->attributes["content"]) << "');\n";
+                js.indent(spaces).append("this.createRadiantHeading('").append_escaped_js(ast.attribute(node, SymbolTable::CONTENT)).append("');\n");
                 break;
                 
             case NodeType::RADIANT_TEXT:
-                js << spaces << "this.createRadiantText('" << escape_js(node->attributes["content"]) << "');\n";
+                js.indent(spaces).append("this.createRadiantText('").append_escaped_js(ast.attribute(node, SymbolTable::CONTENT)).append("');\n");
                 break;
                 
             case NodeType::RADIANT_BUTTON:
-                js << spaces << "this.createRadiantButton('" << escape_js(node->attributes["content"]) << "', '" << node->attributes["action"] << "');\n";
+                js.indent(spaces).append("this.createRadiantButton('").append_escaped_js(ast.attribute(node, SymbolTable::CONTENT));
+                js.append("', '").append_escaped_js(ast.attribute(node, SymbolTable::ACTION)).append("');\n");
                 break;
                 
             case NodeType::NEURAL:
-                js << spaces << "const " << node->name << " = this.neuralAnalysis('" << escape_js(node->attributes["expression"]) << "');\n";
+                js.indent(spaces).append("const ").append(ast.text(ast.node(node).name)).append(" = this.neuralAnalysis('");
+                js.append_escaped_js(ast.attribute(node, SymbolTable::EXPRESSION)).append("');\n");
                 break;
                 
             case NodeType::RETURN_LIGHT:
-                js << spaces << "return " << node->attributes["value"] << ";\n";
+                js.indent(spaces).append("return ").append(ast.attribute(node, SymbolTable::VALUE)).append(";\n");
                 break;
                 
             default:
                 // Skip other node types
                 break;
         }
-        
-        return js.str();
     }
     
-    std::string generate_css_from_ast(std::shared_ptr<ASTNode> ast) {
-        return R"(
+    // Widget rules; every document carries the full stylesheet
+    void generate_css_from_ast(const LamiaAst&, OutputBuffer& css) {
+        css.append(R"(
         .lamia-app { max-width: 1200px; margin: 0 auto; padding: 2rem; font-family: Arial, sans-serif; }
         .radiant-heading h1 { color: #ffd700; text-align: center; font-size: 2.5rem; margin-bottom: 2rem; }
         .radiant-text p { color: #333; line-height: 1.6; margin-bottom: 1rem; }
@@ -685,11 +1333,12 @@ private:
         .radiant-quote { background: rgba(255, 215, 0, 0.1); padding: 1.5rem; margin: 1rem 0; border-left: 4px solid #ffd700; }
         .gcode-block { background: #2c3e50; color: #ecf0f1; padding: 1rem; margin: 1rem 0; border-radius: 5px; }
         .gcode-block pre { margin: 0; font-family: 'Courier New', monospace; }
-        )";
+        )");
     }
     
-    std::string generate_js_from_ast(std::shared_ptr<ASTNode> ast) {
-        return R"(
+    // Runtime helpers; LamiaApp always exposes all of them
+    void generate_js_from_ast(const LamiaAst&, OutputBuffer& js) {
+        js.append(R"(
         createRadiantHeading(content) {
             console.log('Creating radiant heading:', content);
         }
@@ -706,52 +1355,20 @@ private:
             console.log('Neural analysis:', expression);
             return { result: 'analyzed', superior: true };
         }
-        )";
+        )");
     }
     
-    std::string generate_manifest_method(std::shared_ptr<ASTNode> node) {
-        std::ostringstream js;
+    void generate_manifest_method(const LamiaAst& ast, uint32_t node, OutputBuffer& js) {
+        std::string_view name = ast.text(ast.node(node).name);
         
-        if (!node->name.empty()) {
-            js << "\n    " << node->name << "() {\n";
-            js << "        console.log('Executing manifest: " << node->name << "');\n";
+        if (!name.empty()) {
+            js.append("\n    ").append(name).append("() {\n");
+            js.append("        console.log('Executing manifest: ").append_escaped_js(name).append("');\n");
             
-            for (const auto& child : node->children) {
-                js << transpile_node_to_js(child, 2);
-            }
+            transpile_nodes_to_js(ast, ast.node(node).first_child, 2, js);
             
-            js << "    }\n";
-        }
-        
-        return js.str();
-    }
-    
-    std::string escape_html(const std::string& input) {
-        std::string output = input;
-        std::regex html_chars(R"([<>&"])");
-        std::map<char, std::string> replacements = {
-            {'<', "&lt;"}, {'>', "&gt;"}, {'&', "&amp;"}, {'"', "&quot;"}
-        };
-        
-        for (const auto& pair : replacements) {
-            size_t pos = 0;
-            while ((pos = output.find(pair.first, pos)) != std::string::npos) {
-                output.replace(pos, 1, pair.second);
-                pos += pair.second.length();
-            }
-        }
-        
-        return output;
-    }
-    
-    std::string escape_js(const std::string& input) {
-        std::string output = input;
-        size_t pos = 0;
-        while ((pos = output.find("'", pos)) != std::string::npos) {
-            output.replace(pos, 1, "\\'");
-            pos += 2;
+            js.append("    }\n");
         }
-        return output;
     }
 };
 
@@ -759,8 +1376,31 @@ private:
  * @brief Real Lamia Compiler - No shortcuts, actual parsing and transpilation
  */
 class RealLamiaCompiler {
+public:
+    /**
+     * @brief Outcome of a project build
+     */
+    struct ProjectReport {
+        size_t sources = 0;
+        size_t compiled = 0;
+        size_t up_to_date = 0;
+        size_t removed = 0;                     // outputs of deleted sources
+        std::vector<std::string> failures;      // "path: reason"
+        std::chrono::milliseconds elapsed{0};
+        
+        bool success() const { return failures.empty(); }
+    };
+    
 private:
     std::string version_ = "0.3.0";
+    SymbolTable symbols_;   // shared by every file compile_file sees
+    
+    static constexpr const char* CACHE_MANIFEST = ".lamia-cache";
+    
+    struct CacheEntry {
+        uint64_t hash = 0;
+        std::string compiler;
+    };
     
 public:
     RealLamiaCompiler() {
@@ -771,45 +1411,34 @@ public:
         std::cout << "Parsing and transpiling: " << input_file << std::endl;
         
         try {
-            // Read source file
-            std::ifstream file(input_file);
-            if (!file.is_open()) {
+            // Map source file
+            SourceBuffer source;
+            if (!source.open(input_file)) {
                 std::cerr << "Cannot open file: " << input_file << std::endl;
                 return false;
             }
             
-            std::string source((std::istreambuf_iterator<char>(file)),
-                             std::istreambuf_iterator<char>());
-            file.close();
-            
-            // Tokenize
-            LamiaLexer lexer(source);
-            auto tokens = lexer.tokenize();
-            
-            std::cout << "Tokenized " << tokens.size() << " tokens" << std::endl;
-            
-            // Parse
-            LamiaParser parser(tokens);
-            auto ast = parser.parse();
+            // Tokenize and parse (tokens are produced as the parser asks for them)
+            LamiaLexer lexer(source.view(), &symbols_);
+            LamiaParser parser(lexer);
+            LamiaAst ast = parser.parse();
             
-            std::cout << "Built AST with " << ast->children.size() << " top-level nodes" << std::endl;
-            
-            // Transpile
-            LamiaTranspiler transpiler;
-            
-            // Generate HTML
-            std::string html = transpiler.transpile_to_html(ast);
-            std::ofstream html_file(output_dir + "/index.html");
-            html_file << html;
-            html_file.close();
+            std::cout << "Tokenized " << lexer.tokens_produced() << " tokens" << std::endl;
+            size_t top_level = 0;
+            for (uint32_t child = ast.node(ast.root()).first_child; child != LamiaAst::NONE; child = ast.node(child).next_sibling) {
+                ++top_level;
+            }
+            std::cout << "Built AST with " << top_level << " top-level nodes (" << ast.node_count() << " nodes, "
+                      << ast.memory_bytes() << " bytes)" << std::endl;
             
-            // Generate JavaScript
-            std::string js = transpiler.transpile_to_javascript(ast);
-            std::ofstream js_file(output_dir + "/app.js");
-            js_file << js;
-            js_file.close();
+            // Generate HTML and JavaScript, streamed straight to the output files
+            std::string error;
+            if (!write_outputs(ast, output_dir, error)) {
+                std::cerr << error << std::endl;
+                return false;
+            }
             
-            std::cout << "Transpilation complete! Generated real HTML and JavaScript." << std::endl;
+            std::cout << "Transpilation complete! Generated real HTML, JavaScript and template bytecode." << std::endl;
             return true;
             
         } catch (const std::exception& e) {
@@ -817,6 +1446,300 @@ public:
             return false;
         }
     }
+    
+    /**
+     * @brief Compile every .lamia file under source_dir in parallel
+     *
+     * source_dir/a/b.lamia produces output_dir/a/b/index.html, app.js and index.lbc.
+     * Files whose content hash and compiler build match the cache manifest
+     * (output_dir/.lamia-cache) and whose outputs still exist are skipped.
+     * Outputs of sources deleted since the last run are removed.
+     * Outputs and the manifest are replaced atomically.
+     *
+     * @param threads worker count; 0 = one per core
+     */
+    ProjectReport compile_project(const std::string& source_dir, const std::string& output_dir, size_t threads = 0) {
+        namespace fs = std::filesystem;
+        auto started = std::chrono::steady_clock::now();
+        ProjectReport report;
+        
+        std::vector<std::string> sources;   // relative to source_dir, '/'-separated
+        std::error_code ec;
+        fs::path root(source_dir);
+        for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, ec), end;
+             !ec && it != end; it.increment(ec)) {
+            if (it->is_regular_file(ec) && it->path().extension() == ".lamia") {
+                sources.push_back(it->path().lexically_relative(root).generic_string());
+            }
+        }
+        std::sort(sources.begin(), sources.end());
+        report.sources = sources.size();
+        
+        fs::create_directories(output_dir, ec);
+        std::unordered_map<std::string, CacheEntry> cache = load_cache(output_dir);
+        const std::string compiler = compiler_fingerprint();
+        
+        struct Result {
+            CacheEntry entry;
+            bool compiled = false;
+            bool failed = false;
+            std::string error;
+        };
+        std::vector<Result> results(sources.size());
+        std::atomic<size_t> next{0};
+        
+        // Each worker owns a symbol table: interning is not shared across threads
+        auto worker = [&] {
+            SymbolTable symbols;
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < sources.size();) {
+                Result& result = results[i];
+                result.entry.compiler = compiler;
+                try {
+                    SourceBuffer source;
+                    if (!source.open((root / sources[i]).string())) {
+                        result.failed = true;
+                        result.error = "cannot open file";
+                        continue;
+                    }
+                    result.entry.hash = content_hash(source.view());
+                    
+                    std::string target = (fs::path(output_dir) / output_stem(sources[i])).string();
+                    auto cached = cache.find(sources[i]);
+                    if (cached != cache.end() && cached->second.hash == result.entry.hash &&
+                        cached->second.compiler == compiler && outputs_exist(target)) {
+                        continue;
+                    }
+                    
+                    std::error_code dir_error;
+                    fs::create_directories(target, dir_error);
+                    LamiaLexer lexer(source.view(), &symbols);
+                    LamiaParser parser(lexer);
+                    LamiaAst ast = parser.parse();
+                    result.compiled = write_outputs(ast, target, result.error);
+                    result.failed = !result.compiled;
+                } catch (const std::exception& e) {
+                    result.failed = true;
+                    result.error = e.what();
+                }
+            }
+        };
+        
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, std::max<size_t>(sources.size(), 1));
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& thread : pool) thread.join();
+        
+        // Failed files are left out of the manifest so the next run retries them
+        std::unordered_map<std::string, CacheEntry> updated;
+        for (size_t i = 0; i < sources.size(); ++i) {
+            const Result& result = results[i];
+            if (result.failed) {
+                report.failures.push_back(sources[i] + ": " + result.error);
+                continue;
+            }
+            if (result.compiled) ++report.compiled;
+            else ++report.up_to_date;
+            updated.emplace(sources[i], result.entry);
+        }
+        // Sources deleted since the last run take their outputs with them
+        for (const auto& [path, entry] : cache) {
+            fs::path stale(path);
+            bool inside = path.size() > std::strlen(".lamia") && stale.extension() == ".lamia" && stale.is_relative() &&
+                          std::find(stale.begin(), stale.end(), fs::path("..")) == stale.end();
+            if (inside && !std::binary_search(sources.begin(), sources.end(), path)) {
+                remove_outputs(output_dir, path);
+                ++report.removed;
+            }
+        }
+        if (report.compiled || !report.failures.empty() || report.removed || updated.size() != cache.size()) {
+            std::string error;
+            if (!save_cache(output_dir, sources, updated, error)) report.failures.push_back(error);
+        }
+        
+        report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        return report;
+    }
+    
+private:
+    /**
+     * @brief Cache key for the compiler itself
+     *
+     * The version plus a hash of what the code generator makes of a probe
+     * source covering every widget and output, so relinking an unchanged
+     * compiler keeps the cache and a codegen change invalidates it.
+     * Builds may pin it with -DLAMIA_BUILD_ID="...".
+     */
+    std::string compiler_fingerprint() const {
+#ifdef LAMIA_BUILD_ID
+        return version_ + " " LAMIA_BUILD_ID;
+#else
+        static const std::string codegen = [] {
+            static const char probe[] =
+                "@startup\n"
+                "manifest Probe -> Page @radiant {\n"
+                "    create RADIANT_HEADING { content: \"<h> & {{x}}\", when: flag }\n"
+                "    create RADIANT_TEXT { content: \"t'\\n\" }\n"
+                "    create RADIANT_BUTTON { content: \"b\", action: \"go()\" }\n"
+                "    create CONSTELLATION_LIST { title: \"l\", items: [a, \"b\", 3] }\n"
+                "    create CONSTELLATION_LIST { title: \"n\", items: names }\n"
+                "    create RADIANT_QUOTE { content: \"q\", attribution: \"a\" }\n"
+                "    create GCODE_BLOCK { commands: \"G28\" }\n"
+                "    create BAMBU_PRINTER { value: 1 }\n"
+                "    create SOCIAL_EMBED { value: 2 }\n"
+                "    create 3D_EMOTION { value: 3 }\n"
+                "    neural mood: \"m\"\n"
+                "    return_light 1\n"
+                "}\n";
+            SymbolTable symbols;
+            LamiaLexer lexer(std::string_view(probe, sizeof(probe) - 1), &symbols);
+            LamiaParser parser(lexer);
+            LamiaAst ast = parser.parse();
+            LamiaTranspiler transpiler;
+            std::string output = transpiler.transpile_to_html(ast);
+            output += transpiler.transpile_to_javascript(ast);
+            output += transpiler.transpile_to_template(ast);
+            char hex[17];
+            std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(content_hash(output)));
+            return std::string(hex);
+        }();
+        return version_ + " " + codegen;
+#endif
+    }
+    
+    /**
+     * @brief Remove the outputs of a source that no longer exists
+     * Only the files compile_project writes go; the directory follows once empty
+     * (it may still hold outputs of nested sources), and so do emptied parents.
+     */
+    static void remove_outputs(const std::string& output_dir, const std::string& relative) {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        fs::path target = fs::path(output_dir) / output_stem(relative);
+        for (const char* name : {"index.html", "app.js", "index.lbc"}) {
+            fs::remove(target / name, ec);
+        }
+        for (fs::path dir = target; dir != fs::path(output_dir) && !dir.empty(); dir = dir.parent_path()) {
+            if (!fs::is_empty(dir, ec) || ec || !fs::remove(dir, ec)) break;
+        }
+    }
+    
+    // FNV-1a, 64-bit
+    static uint64_t content_hash(std::string_view data) {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (unsigned char c : data) {
+            hash ^= c;
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+    
+    // "a/b.lamia" -> "a/b"
+    static std::string output_stem(const std::string& relative) {
+        return relative.substr(0, relative.size() - std::strlen(".lamia"));
+    }
+    
+    static bool outputs_exist(const std::string& target) {
+        std::error_code ec;
+        return std::filesystem::exists(target + "/index.html", ec) && std::filesystem::exists(target + "/app.js", ec) &&
+               std::filesystem::exists(target + "/index.lbc", ec);
+    }
+    
+    // index.html and app.js, plus index.lbc: the page as template bytecode for request-time rendering
+    // (ComponentRenderer::installCompiledTemplates copies it into the Lightspeed cache)
+    static bool write_outputs(const LamiaAst& ast, const std::string& output_dir, std::string& error) {
+        LamiaTranspiler transpiler;
+        if (!write_output(output_dir + "/index.html", [&](OutputBuffer& out) { transpiler.transpile_to_html(ast, out); }, error) ||
+            !write_output(output_dir + "/app.js", [&](OutputBuffer& out) { transpiler.transpile_to_javascript(ast, out); }, error)) {
+            return false;
+        }
+        // The static page stands on its own; a template that will not compile only loses index.lbc
+        std::string template_error;
+        auto compiled = compile_template(transpiler.transpile_to_template(ast), &template_error);
+        if (!compiled) {
+            std::error_code ec;
+            std::filesystem::remove(output_dir + "/index.lbc", ec);
+            std::cerr << "Template skipped for " << output_dir << ": " << template_error << std::endl;
+            return true;
+        }
+        return write_output(output_dir + "/index.lbc", [&](OutputBuffer& out) { out.append(compiled->serialize()); }, error);
+    }
+    
+    /**
+     * @brief Write path atomically: stream into a sibling temporary, then rename over path
+     * Readers (a server, a deploy sync) see the old file or the new one, never a partial one.
+     */
+    template <typename Emit>
+    static bool write_output(const std::string& path, Emit emit, std::string& error) {
+        static std::atomic<uint64_t> sequence{0};
+        std::string temporary = path + ".tmp." + std::to_string(static_cast<long>(::getpid())) + "." +
+                                std::to_string(sequence.fetch_add(1, std::memory_order_relaxed));
+        bool ok;
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            error = "Cannot write file: " + path;
+            return false;
+        }
+        {
+            OutputBuffer out(fd);
+            emit(out);
+            ok = out.flush();
+        }
+        ok = ::close(fd) == 0 && ok;
+#else
+        OutputBuffer out;
+        emit(out);
+        {
+            std::ofstream file(temporary, std::ios::binary);
+            file << out.str();
+            ok = static_cast<bool>(file);
+        }
+#endif
+        std::error_code ec;
+        if (ok) {
+            std::filesystem::rename(temporary, path, ec);
+            ok = !ec;
+        }
+        if (!ok) {
+            std::filesystem::remove(temporary, ec);
+            error = "Cannot write file: " + path;
+        }
+        return ok;
+    }
+    
+    // Manifest lines: <hash hex> TAB <compiler> TAB <relative path>
+    static std::unordered_map<std::string, CacheEntry> load_cache(const std::string& output_dir) {
+        std::unordered_map<std::string, CacheEntry> cache;
+        std::ifstream file(output_dir + "/" + CACHE_MANIFEST);
+        std::string line;
+        if (!std::getline(file, line) || line != "lamia-cache 1") return cache;
+        while (std::getline(file, line)) {
+            size_t first = line.find('\t');
+            size_t second = first == std::string::npos ? first : line.find('\t', first + 1);
+            if (second == std::string::npos) continue;
+            CacheEntry entry;
+            entry.hash = std::strtoull(line.substr(0, first).c_str(), nullptr, 16);
+            entry.compiler = line.substr(first + 1, second - first - 1);
+            cache[line.substr(second + 1)] = std::move(entry);
+        }
+        return cache;
+    }
+    
+    static bool save_cache(const std::string& output_dir, const std::vector<std::string>& order,
+                           const std::unordered_map<std::string, CacheEntry>& cache, std::string& error) {
+        return write_output(output_dir + "/" + CACHE_MANIFEST, [&](OutputBuffer& out) {
+            out.append("lamia-cache 1\n");
+            char hash[17];
+            for (const auto& path : order) {
+                auto entry = cache.find(path);
+                if (entry == cache.end()) continue;
+                std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(entry->second.hash));
+                out.append(hash).append('\t').append(entry->second.compiler).append('\t').append(path).append('\n');
+            }
+        }, error);
+    }
 };
 
 } // namespace Lamia
@@ -825,6 +1748,9 @@ public:
 
 /**
  * @brief Main function - Real compiler demonstration
+ *
+ * lamia_real_compiler <file.lamia> [output_dir]
+ * lamia_real_compiler <source_dir> [output_dir] [threads]   (project mode)
  */
 int main(int argc, char* argv[]) {
     std::cout << "🔮 REAL LAMIA COMPILER v0.3.0" << std::endl;
@@ -839,7 +1765,27 @@ int main(int argc, char* argv[]) {
     std::string output_dir = (argc > 2) ? argv[2] : "lamia_real_output";
     
     // Create output directory
-    system(("mkdir -p " + output_dir).c_str());
+    std::error_code ec;
+    std::filesystem::create_directories(output_dir, ec);
+    
+    if (std::filesystem::is_directory(input_file, ec)) {
+        size_t threads = (argc > 3) ? std::strtoul(argv[3], nullptr, 10) : 0;
+        auto report = compiler.compile_project(input_file, output_dir, threads);
+        std::cout << "Project: " << report.sources << " sources, " << report.compiled << " compiled, "
+                  << report.up_to_date << " up to date, " << report.removed << " removed, "
+                  << report.failures.size() << " failed in "
+                  << report.elapsed.count() << " ms" << std::endl;
+        for (const auto& failure : report.failures) {
+            std::cerr << "  " << failure << std::endl;
+        }
+        if (report.success()) {
+            std::cout << std::endl << "🏆 REAL COMPILATION SUCCESS!" << std::endl;
+            std::cout << "Output directory: " << output_dir << std::endl;
+            return 0;
+        }
+        std::cout << std::endl << "❌ COMPILATION FAILED!" << std::endl;
+        return 1;
+    }
     
     if (compiler.compile_file(input_file, output_dir)) {
         std::cout << std::endl << "🏆 REAL COMPILATION SUCCESS!" << std::endl;
@@ -850,4 +1796,4 @@ int main(int argc, char* argv[]) {
         std::cout << std::endl << "❌ COMPILATION FAILED!" << std::endl;
         return 1;
     }
-}
\ No newline at end of file
+}
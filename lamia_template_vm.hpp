@@ -0,0 +1,486 @@
+/**
+ * © 2025 The Medusa Project | Roylepython | D Hargreaves - All Rights Reserved
+ */
+
+/**
+ * LAMIA TEMPLATE BYTECODE AND RENDER VM
+ * =====================================
+ *
+ * Request-time rendering of compiled Lamia pages. The compiler emits the
+ * page as template text; compile_template() turns it into bytecode once,
+ * and render_template() replays it against per-request data.
+ *
+ * TEMPLATE SYNTAX
+ *   {{name}}             value, HTML-escaped
+ *   {{&name}}            value, raw
+ *   {{#name}}...{{/name}} loop over a list, or once if a scalar is non-empty
+ *   {{^name}}...{{/name}} once if name is missing or empty
+ *   {{.}}                current item of the innermost section
+ *   {{{}}                a literal "{" (how "{{" in page text is written)
+ * Section tags alone on a line do not leave the line behind.
+ *
+ * BYTECODE
+ *   Static text is coalesced into runs of one constant pool. Names resolve
+ *   to slots when compiling, and slots bind to the request's data once per
+ *   render. Open sections occupy registers: list, position, current value.
+ */
+
+#ifndef LAMIA_TEMPLATE_VM_HPP
+#define LAMIA_TEMPLATE_VM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MedusaServ {
+namespace Language {
+namespace Lamia {
+
+/**
+ * @brief Per-request data a template renders against
+ */
+struct TemplateData {
+    std::unordered_map<std::string, std::string> values;
+    std::unordered_map<std::string, std::vector<std::string>> lists;
+};
+
+/**
+ * @brief Compiled template: instructions, text constants and slot names
+ */
+struct CompiledTemplate {
+    enum Op : uint8_t {
+        TEXT,           // append constants[a, a + b)
+        VALUE,          // append slot a
+        ITEM,           // append the current value of register reg
+        SECTION,        // open register reg over slot a; skip to b when empty
+        END_SECTION     // advance register reg; loop back to a + 1 while items remain
+    };
+    enum Flags : uint8_t { ESCAPE = 1, INVERTED = 2 };
+
+    struct Instruction {
+        Op op;
+        uint8_t flags;
+        uint16_t reg;
+        uint32_t a;
+        uint32_t b;
+    };
+
+    std::vector<Instruction> code;
+    std::string constants;
+    std::vector<std::string> slots;
+    uint16_t registers = 0;       // deepest section nesting
+    uint64_t hash = 0;            // of the template text
+
+    /**
+     * @brief Serialize for the compiler's output directory (.lbc)
+     */
+    std::string serialize() const {
+        std::string out("LBC1", 4);
+        put(out, hash);
+        put(out, static_cast<uint32_t>(registers));
+        put(out, static_cast<uint32_t>(code.size()));
+        for (const auto& instruction : code) {
+            out.push_back(static_cast<char>(instruction.op));
+            out.push_back(static_cast<char>(instruction.flags));
+            put(out, instruction.reg);
+            put(out, instruction.a);
+            put(out, instruction.b);
+        }
+        put(out, static_cast<uint32_t>(constants.size()));
+        out += constants;
+        put(out, static_cast<uint32_t>(slots.size()));
+        for (const auto& slot : slots) {
+            put(out, static_cast<uint32_t>(slot.size()));
+            out += slot;
+        }
+        return out;
+    }
+
+    /**
+     * @brief Load and validate serialized bytecode
+     * @return false on truncated or inconsistent input (never renders out of bounds)
+     */
+    bool deserialize(std::string_view in) {
+        *this = CompiledTemplate();
+        if (in.substr(0, 4) != "LBC1") return false;
+        in.remove_prefix(4);
+        uint32_t register_count, count;
+        if (!get(in, hash) || !get(in, register_count) || register_count > UINT16_MAX || !get(in, count)) return false;
+        registers = static_cast<uint16_t>(register_count);
+        if (count > in.size() / 12) return false;
+        code.resize(count);
+        for (auto& instruction : code) {
+            if (in.size() < 2) return false;
+            instruction.op = static_cast<Op>(in[0]);
+            instruction.flags = static_cast<uint8_t>(in[1]);
+            in.remove_prefix(2);
+            if (!get(in, instruction.reg) || !get(in, instruction.a) || !get(in, instruction.b)) return false;
+        }
+        uint32_t length;
+        if (!get(in, length) || length > in.size()) return false;
+        constants.assign(in.data(), length);
+        in.remove_prefix(length);
+        if (!get(in, count) || count > in.size() / 4) return false;
+        slots.resize(count);
+        for (auto& slot : slots) {
+            if (!get(in, length) || length > in.size()) return false;
+            slot.assign(in.data(), length);
+            in.remove_prefix(length);
+        }
+        return in.empty() && valid();
+    }
+
+private:
+    template <typename T>
+    static void put(std::string& out, T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    template <typename T>
+    static bool get(std::string_view& in, T& value) {
+        if (in.size() < sizeof(T)) return false;
+        std::memcpy(&value, in.data(), sizeof(T));
+        in.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    // Bounds, plus properly nested SECTION/END_SECTION pairs (so every loop terminates)
+    bool valid() const {
+        std::vector<uint32_t> open;
+        for (size_t pc = 0; pc < code.size(); ++pc) {
+            const Instruction& instruction = code[pc];
+            switch (instruction.op) {
+                case TEXT:
+                    if (instruction.a > constants.size() || instruction.b > constants.size() - instruction.a) return false;
+                    break;
+                case VALUE:
+                    if (instruction.a >= slots.size()) return false;
+                    break;
+                case ITEM:
+                    if (open.empty() || instruction.reg >= open.size()) return false;
+                    break;
+                case SECTION:
+                    if (instruction.a >= slots.size() || instruction.reg != open.size() || instruction.reg >= registers ||
+                        instruction.b <= pc || instruction.b > code.size()) {
+                        return false;
+                    }
+                    open.push_back(static_cast<uint32_t>(pc));
+                    break;
+                case END_SECTION:
+                    if (open.empty() || instruction.a != open.back() || code[open.back()].b != pc + 1 ||
+                        instruction.reg != code[open.back()].reg) {
+                        return false;
+                    }
+                    open.pop_back();
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return open.empty();
+    }
+};
+
+namespace template_detail {
+
+// FNV-1a, 64-bit (the compiler's content hash)
+inline uint64_t hash(std::string_view text) {
+    uint64_t value = 0xcbf29ce484222325ull;
+    for (unsigned char c : text) {
+        value ^= c;
+        value *= 0x100000001b3ull;
+    }
+    return value;
+}
+
+inline std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+    return text;
+}
+
+// Copies runs of safe bytes in one append
+inline void append_html_escaped(std::string& out, std::string_view text) {
+    size_t run = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const char* replacement;
+        switch (text[i]) {
+            case '<': replacement = "&lt;"; break;
+            case '>': replacement = "&gt;"; break;
+            case '&': replacement = "&amp;"; break;
+            case '"': replacement = "&quot;"; break;
+            case '\'': replacement = "&#39;"; break;
+            default: continue;
+        }
+        out.append(text.data() + run, i - run);
+        out.append(replacement);
+        run = i + 1;
+    }
+    out.append(text.data() + run, text.size() - run);
+}
+
+} // namespace template_detail
+
+/**
+ * @brief Compile template text to bytecode
+ * @return nullptr with error set on unbalanced sections
+ */
+inline std::shared_ptr<CompiledTemplate> compile_template(std::string_view text, std::string* error = nullptr) {
+    auto compiled = std::make_shared<CompiledTemplate>();
+    CompiledTemplate& t = *compiled;
+    t.hash = template_detail::hash(text);
+    std::unordered_map<std::string, uint32_t> slot_ids;
+    std::vector<uint32_t> open;    // pc of each open SECTION
+
+    auto slot = [&](std::string_view name) {
+        auto found = slot_ids.find(std::string(name));
+        if (found != slot_ids.end()) return found->second;
+        uint32_t id = static_cast<uint32_t>(t.slots.size());
+        t.slots.emplace_back(name);
+        slot_ids.emplace(t.slots.back(), id);
+        return id;
+    };
+    auto emit = [&](CompiledTemplate::Op op, uint8_t flags, uint16_t reg, uint32_t a, uint32_t b) {
+        t.code.push_back(CompiledTemplate::Instruction{op, flags, reg, a, b});
+    };
+    auto fail = [&](const std::string& message) -> std::shared_ptr<CompiledTemplate> {
+        if (error) *error = message;
+        return nullptr;
+    };
+    // Adjacent text merges into one run
+    auto emit_text = [&](std::string_view run) {
+        if (run.empty()) return;
+        if (!t.code.empty() && t.code.back().op == CompiledTemplate::TEXT &&
+            t.code.back().a + t.code.back().b == t.constants.size()) {
+            t.code.back().b += static_cast<uint32_t>(run.size());
+        } else {
+            emit(CompiledTemplate::TEXT, 0, 0, static_cast<uint32_t>(t.constants.size()), static_cast<uint32_t>(run.size()));
+        }
+        t.constants.append(run.data(), run.size());
+    };
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t tag = text.find("{{", pos);
+        size_t close = tag == std::string_view::npos ? tag : text.find("}}", tag + 2);
+        if (close == std::string_view::npos) {
+            emit_text(text.substr(pos));
+            break;
+        }
+        std::string_view body = template_detail::trim(text.substr(tag + 2, close - tag - 2));
+        char sigil = body.empty() ? '\0' : body.front();
+
+        // A section tag alone on its line takes the whole line with it
+        size_t line = tag;
+        while (line > pos && (text[line - 1] == ' ' || text[line - 1] == '\t')) --line;
+        size_t end = close + 2;
+        if (end < text.size() && text[end] == '\r') ++end;
+        bool standalone = (sigil == '#' || sigil == '^' || sigil == '/') && (line == 0 || text[line - 1] == '\n') &&
+                          (end == text.size() || text[end] == '\n');
+        emit_text(text.substr(pos, (standalone ? line : tag) - pos));
+        pos = standalone ? std::min(end + 1, text.size()) : close + 2;
+
+        std::string_view name = template_detail::trim(sigil == '#' || sigil == '^' || sigil == '/' || sigil == '&'
+                                                          ? body.substr(1) : body);
+        if (body == "{") {
+            emit_text("{");
+            continue;
+        }
+        if (name.empty()) {
+            emit_text(text.substr(tag, pos - tag));    // "{{}}" is just text
+            continue;
+        }
+        switch (sigil) {
+            case '#':
+            case '^':
+                if (open.size() >= UINT16_MAX) return fail("sections nested too deeply");
+                open.push_back(static_cast<uint32_t>(t.code.size()));
+                emit(CompiledTemplate::SECTION, sigil == '^' ? CompiledTemplate::INVERTED : 0,
+                     static_cast<uint16_t>(open.size() - 1), slot(name), 0);
+                t.registers = std::max<uint16_t>(t.registers, static_cast<uint16_t>(open.size()));
+                break;
+            case '/': {
+                if (open.empty() || t.slots[t.code[open.back()].a] != name) {
+                    return fail("unexpected {{/" + std::string(name) + "}}");
+                }
+                uint32_t begin = open.back();
+                open.pop_back();
+                emit(CompiledTemplate::END_SECTION, t.code[begin].flags, t.code[begin].reg, begin, 0);
+                t.code[begin].b = static_cast<uint32_t>(t.code.size());
+                break;
+            }
+            default: {
+                uint8_t flags = sigil == '&' ? 0 : CompiledTemplate::ESCAPE;
+                if (name == ".") {
+                    if (open.empty()) return fail("{{.}} outside a section");
+                    emit(CompiledTemplate::ITEM, flags, static_cast<uint16_t>(open.size() - 1), 0, 0);
+                } else {
+                    emit(CompiledTemplate::VALUE, flags, 0, slot(name), 0);
+                }
+                break;
+            }
+        }
+    }
+    if (!open.empty()) return fail("unclosed {{#" + t.slots[t.code[open.back()].a] + "}}");
+    return compiled;
+}
+
+/**
+ * @brief Run a compiled template against data, appending to out
+ *
+ * Binds every slot once, then executes straight-line code; the only
+ * allocations are out's growth.
+ */
+inline void render_template(const CompiledTemplate& t, const TemplateData& data, std::string& out) {
+    struct Binding {
+        const std::string* value = nullptr;
+        const std::vector<std::string>* list = nullptr;
+    };
+    struct Register {
+        const std::vector<std::string>* list = nullptr;
+        const std::string* value = nullptr;
+        size_t index = 0;
+    };
+    thread_local std::vector<Binding> bindings;
+    thread_local std::vector<Register> registers;
+    bindings.assign(t.slots.size(), Binding());
+    registers.assign(t.registers, Register());
+
+    for (size_t i = 0; i < t.slots.size(); ++i) {
+        auto list = data.lists.find(t.slots[i]);
+        if (list != data.lists.end()) bindings[i].list = &list->second;
+        auto value = data.values.find(t.slots[i]);
+        if (value != data.values.end()) bindings[i].value = &value->second;
+    }
+
+    const std::string_view constants(t.constants);
+    size_t pc = 0;
+    while (pc < t.code.size()) {
+        const CompiledTemplate::Instruction& instruction = t.code[pc];
+        switch (instruction.op) {
+            case CompiledTemplate::TEXT:
+                out.append(constants.data() + instruction.a, instruction.b);
+                break;
+
+            case CompiledTemplate::VALUE:
+            case CompiledTemplate::ITEM: {
+                const std::string* value = instruction.op == CompiledTemplate::VALUE
+                    ? bindings[instruction.a].value : registers[instruction.reg].value;
+                if (value) {
+                    if (instruction.flags & CompiledTemplate::ESCAPE) template_detail::append_html_escaped(out, *value);
+                    else out += *value;
+                }
+                break;
+            }
+
+            case CompiledTemplate::SECTION: {
+                const Binding& binding = bindings[instruction.a];
+                bool has_list = binding.list && !binding.list->empty();
+                bool has_value = binding.value && !binding.value->empty();
+                if (instruction.flags & CompiledTemplate::INVERTED) {
+                    if (has_list || has_value) {
+                        pc = instruction.b;
+                        continue;
+                    }
+                    registers[instruction.reg] = Register();
+                } else if (has_list) {
+                    registers[instruction.reg] = Register{binding.list, &binding.list->front(), 0};
+                } else if (has_value) {
+                    registers[instruction.reg] = Register{nullptr, binding.value, 0};
+                } else {
+                    pc = instruction.b;
+                    continue;
+                }
+                break;
+            }
+
+            case CompiledTemplate::END_SECTION: {
+                Register& reg = registers[instruction.reg];
+                if (reg.list && ++reg.index < reg.list->size()) {
+                    reg.value = &(*reg.list)[reg.index];
+                    pc = instruction.a + 1;
+                    continue;
+                }
+                break;
+            }
+        }
+        ++pc;
+    }
+}
+
+/**
+ * @brief Compiled templates shared across requests, keyed by text hash
+ */
+class TemplateCache {
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<uint64_t, std::shared_ptr<const CompiledTemplate>> templates_;
+    std::deque<uint64_t> order_;       // insertion order, oldest evicted first
+    size_t capacity_;
+
+public:
+    explicit TemplateCache(size_t capacity = 1024) : capacity_(capacity ? capacity : 1) {}
+
+    std::shared_ptr<const CompiledTemplate> find(uint64_t hash) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = templates_.find(hash);
+        return found == templates_.end() ? nullptr : found->second;
+    }
+
+    void insert(std::shared_ptr<const CompiledTemplate> compiled) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t hash = compiled->hash;
+        if (templates_.emplace(hash, std::move(compiled)).second) {
+            order_.push_back(hash);
+            while (order_.size() > capacity_) {
+                templates_.erase(order_.front());
+                order_.pop_front();
+            }
+        }
+    }
+
+    /**
+     * @brief Compiled form of text, compiling only on the first sight of its hash
+     */
+    std::shared_ptr<const CompiledTemplate> get_or_compile(std::string_view text, std::string* error = nullptr) {
+        if (auto cached = find(template_detail::hash(text))) return cached;
+        std::shared_ptr<const CompiledTemplate> compiled = compile_template(text, error);
+        if (compiled) insert(compiled);
+        return compiled;
+    }
+
+    /**
+     * @brief Load serialized bytecode (.lbc) through the cache
+     */
+    std::shared_ptr<const CompiledTemplate> load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return nullptr;
+        std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto compiled = std::make_shared<CompiledTemplate>();
+        if (!compiled->deserialize(bytes)) return nullptr;
+        if (auto cached = find(compiled->hash)) return cached;
+        insert(compiled);
+        return compiled;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return templates_.size();
+    }
+};
+
+} // namespace Lamia
+} // namespace Language
+} // namespace MedusaServ
+
+#endif // LAMIA_TEMPLATE_VM_HPP
@@ -10,6 +10,9 @@
 #include <atomic>
 #include <functional>
 #include <chrono>
+#include <string_view>
+#include "medusa_http_stream_parser.hpp"
+#include "medusa_work_stealing_executor.hpp"
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
@@ -175,8 +178,90 @@ private:
 public:
     /**
      * @brief Parse HTTP request from raw data
+     * @details Runs HTTPStreamParser over the buffer and copies the result into
+     *          owned strings; hot paths should drive an HTTPStreamParser
+     *          directly and work on the HTTPRequestView. An incomplete or
+     *          malformed request comes back with an empty path.
      */
-    static HTTPRequest parseRequest(const std::string& raw_request, const std::string& client_ip, int client_port);
+    static HTTPRequest parseRequest(const std::string& raw_request, const std::string& client_ip, int client_port) {
+        HTTPRequest request;
+        request.method = HTTPMethod::GET;
+        request.version = HTTPVersion::HTTP_1_1;
+        request.client_ip = client_ip;
+        request.client_port = client_port;
+        request.timestamp = std::chrono::system_clock::now();
+        request.is_secure = false;
+        
+        HTTPStreamParser parser;
+        HTTPRequestView view;
+        if (parser.parse(raw_request.data(), raw_request.size(), view) != ParseStatus::COMPLETE ||
+            !materializeRequest(view, client_ip, client_port, request)) {
+            request.path.clear();
+        }
+        return request;
+    }
+    
+    /**
+     * @brief Map a borrowed method token to HTTPMethod without allocating
+     * @return false for unknown methods
+     */
+    static bool methodFromView(std::string_view method_text, HTTPMethod& method) {
+        switch (method_text.size()) {
+            case 3:
+                if (method_text == "GET") { method = HTTPMethod::GET; return true; }
+                if (method_text == "PUT") { method = HTTPMethod::PUT; return true; }
+                return false;
+            case 4:
+                if (method_text == "POST") { method = HTTPMethod::POST; return true; }
+                if (method_text == "HEAD") { method = HTTPMethod::HEAD; return true; }
+                return false;
+            case 5:
+                if (method_text == "PATCH") { method = HTTPMethod::PATCH; return true; }
+                if (method_text == "TRACE") { method = HTTPMethod::TRACE; return true; }
+                return false;
+            case 6:
+                if (method_text == "DELETE") { method = HTTPMethod::DELETE; return true; }
+                return false;
+            case 7:
+                if (method_text == "OPTIONS") { method = HTTPMethod::OPTIONS; return true; }
+                if (method_text == "CONNECT") { method = HTTPMethod::CONNECT; return true; }
+                return false;
+            default:
+                return false;
+        }
+    }
+    
+    /**
+     * @brief Build an owning HTTPRequest from a parsed view for legacy route handlers
+     * @return false when the chunked body does not decode (answer 400)
+     */
+    static bool materializeRequest(const HTTPRequestView& view, const std::string& client_ip, int client_port,
+                                   HTTPRequest& request) {
+        if (!methodFromView(view.method_text, request.method)) {
+            request.method = HTTPMethod::GET;
+        }
+        request.version = view.version_minor == 0 ? HTTPVersion::HTTP_1_0 : HTTPVersion::HTTP_1_1;
+        request.path.assign(view.path.data(), view.path.size());
+        request.query_string.assign(view.query_string.data(), view.query_string.size());
+        request.headers.reserve(view.header_count);
+        for (size_t i = 0; i < view.header_count; ++i) {
+            request.headers[std::string(view.headers[i].name)] = std::string(view.headers[i].value);
+        }
+        if (view.chunked) {
+            if (!decodeChunkedBody(view.body, request.body)) {
+                return false;
+            }
+        } else {
+            request.body.assign(view.body.data(), view.body.size());
+        }
+        request.client_ip = client_ip;
+        request.client_port = client_port;
+        request.timestamp = std::chrono::system_clock::now();
+        request.is_secure = false;
+        request.user_agent = std::string(view.header("User-Agent"));
+        request.referer = std::string(view.header("Referer"));
+        return true;
+    }
     
     /**
      * @brief Parse HTTP response from raw data
@@ -209,9 +294,10 @@ private:
     SSL_CTX* ssl_ctx_;
     std::atomic<bool> running_;
     std::thread listener_thread_;
-    mutable std::mutex connection_mutex_;
-    std::vector<std::thread> worker_threads_;
-    std::vector<int> client_sockets_;
+    
+    // Accepted sockets are handed to the shared work-stealing executor
+    MedusaServ::Executor::WorkStealingExecutor* executor_;
+    std::atomic<size_t> active_connections_;
     
     // Security
     std::unique_ptr<AES256GCMSecurity> security_;
@@ -248,6 +334,11 @@ public:
     HTTPListener(int port = 8080, int max_connections = 1000, int thread_pool_size = 10);
     ~HTTPListener();
     
+    /**
+     * @brief Submit connections to a specific executor instead of WorkStealingExecutor::shared()
+     */
+    void setExecutor(MedusaServ::Executor::WorkStealingExecutor& executor) { executor_ = &executor; }
+    
     /**
      * @brief Initialize the HTTP listener
      */
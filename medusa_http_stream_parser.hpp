@@ -0,0 +1,701 @@
+#ifndef MEDUSA_HTTP_STREAM_PARSER_HPP
+#define MEDUSA_HTTP_STREAM_PARSER_HPP
+
+#include <string>
+#include <string_view>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
+
+/**
+ * @file medusa_http_stream_parser.hpp
+ * @brief Zero-copy, resumable HTTP/1.1 request parser
+ * @details GROUND UP PHILOSOPHY - No external libraries (picohttpparser, llhttp, etc.)
+ *
+ * - Works on a borrowed byte buffer; never copies or allocates
+ * - Resumable across partial reads: bytes already scanned are not rescanned
+ * - Pipelining: each COMPLETE result reports how many bytes the request used
+ * - Content-Length and chunked bodies are framed (chunked bodies stay encoded)
+ * - SSE4.2 / AVX2 scanning for CRLF and header delimiters when compiled in
+ */
+
+namespace MedusaHTTP {
+
+/**
+ * @enum ParseStatus
+ * @brief Result of feeding bytes to HTTPStreamParser
+ */
+enum class ParseStatus {
+    NEED_MORE,
+    COMPLETE,
+    INVALID
+};
+
+/**
+ * @struct HeaderView
+ * @brief One header line, borrowed from the parse buffer
+ */
+struct HeaderView {
+    std::string_view name;
+    std::string_view value;
+};
+
+/**
+ * @struct HTTPRequestView
+ * @brief Parsed request whose fields all point into the caller's buffer
+ * @details Valid only while that buffer is alive and unmodified.
+ */
+struct HTTPRequestView {
+    static constexpr size_t kMaxHeaders = 64;
+
+    std::string_view method_text;
+    std::string_view target;
+    std::string_view path;
+    std::string_view query_string;
+    std::string_view body;
+    int version_minor;
+    std::array<HeaderView, kMaxHeaders> headers;
+    size_t header_count;
+    size_t content_length;
+    size_t total_length;
+    bool keep_alive;
+    bool chunked;
+
+    /**
+     * @brief Case-insensitive header lookup; empty view when absent
+     */
+    std::string_view header(std::string_view name) const;
+};
+
+namespace Scan {
+
+inline char lowerAscii(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+}
+
+inline bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (lowerAscii(a[i]) != lowerAscii(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool containsTokenIgnoreCase(std::string_view value, std::string_view token) {
+    for (size_t i = 0; i + token.size() <= value.size(); ++i) {
+        if (equalsIgnoreCase(value.substr(i, token.size()), token)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief RFC 9110 tchar: the only bytes allowed in a header name
+ */
+inline bool isTokenChar(char c) {
+    static const std::array<bool, 256> table = [] {
+        std::array<bool, 256> t{};
+        for (int c = '0'; c <= '9'; ++c) t[c] = true;
+        for (int c = 'a'; c <= 'z'; ++c) t[c] = true;
+        for (int c = 'A'; c <= 'Z'; ++c) t[c] = true;
+        for (char c : std::string_view("!#$%&'*+-.^_`|~")) t[static_cast<unsigned char>(c)] = true;
+        return t;
+    }();
+    return table[static_cast<unsigned char>(c)];
+}
+
+/**
+ * @brief Offset of the first '\r' or '\n' in [p, end), or end - p
+ */
+inline size_t findLineBreak(const char* p, const char* end) {
+    const char* start = p;
+#if defined(__AVX2__)
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, cr), _mm256_cmpeq_epi8(block, lf))));
+        if (mask != 0) {
+            return static_cast<size_t>(p - start) + static_cast<size_t>(__builtin_ctz(mask));
+        }
+        p += 32;
+    }
+#endif
+#if defined(__SSE4_2__)
+    const __m128i set = _mm_setr_epi8('\r', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int idx = _mm_cmpestri(set, 2, block, 16,
+                               _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+        if (idx != 16) {
+            return static_cast<size_t>(p - start) + static_cast<size_t>(idx);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != '\r' && *p != '\n') {
+        ++p;
+    }
+    return static_cast<size_t>(p - start);
+}
+
+/**
+ * @brief Offset of the first ':', '\r' or '\n' in [p, end), or end - p
+ */
+inline size_t findHeaderDelimiter(const char* p, const char* end) {
+    const char* start = p;
+#if defined(__AVX2__)
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    while (end - p >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(block, colon),
+                                       _mm256_or_si256(_mm256_cmpeq_epi8(block, cr),
+                                                       _mm256_cmpeq_epi8(block, lf)));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return static_cast<size_t>(p - start) + static_cast<size_t>(__builtin_ctz(mask));
+        }
+        p += 32;
+    }
+#endif
+#if defined(__SSE4_2__)
+    const __m128i set = _mm_setr_epi8(':', '\r', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        int idx = _mm_cmpestri(set, 3, block, 16,
+                               _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+        if (idx != 16) {
+            return static_cast<size_t>(p - start) + static_cast<size_t>(idx);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != ':' && *p != '\r' && *p != '\n') {
+        ++p;
+    }
+    return static_cast<size_t>(p - start);
+}
+
+inline std::string_view trimOws(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+} // namespace Scan
+
+inline std::string_view HTTPRequestView::header(std::string_view name) const {
+    for (size_t i = 0; i < header_count; ++i) {
+        if (Scan::equalsIgnoreCase(headers[i].name, name)) {
+            return headers[i].value;
+        }
+    }
+    return {};
+}
+
+/**
+ * @class HTTPStreamParser
+ * @brief Resumable state-machine parser over a borrowed buffer
+ *
+ * Feed the buffer holding the current request from its first byte; when more
+ * bytes arrive, call parse() again with the grown buffer (it may have moved).
+ * Internal state is kept as offsets, so reallocation between calls is safe.
+ * After COMPLETE, totalLength() bytes belong to this request: advance past
+ * them and call reset() to parse the next pipelined request.
+ */
+class HTTPStreamParser {
+public:
+    static constexpr size_t kDefaultMaxHeaderBytes = 64 * 1024;
+    static constexpr size_t kDefaultMaxBodyBytes = 8 * 1024 * 1024;
+
+    explicit HTTPStreamParser(size_t max_header_bytes = kDefaultMaxHeaderBytes,
+                              size_t max_body_bytes = kDefaultMaxBodyBytes)
+        : max_header_bytes_(max_header_bytes), max_body_bytes_(max_body_bytes) {
+        reset();
+    }
+
+    /**
+     * @brief Forget the current request and start over at offset zero
+     */
+    void reset() {
+        state_ = State::REQUEST_LINE;
+        cursor_ = 0;
+        request_start_ = 0;
+        header_count_ = 0;
+        header_end_ = 0;
+        body_start_ = 0;
+        body_end_ = 0;
+        content_length_ = 0;
+        chunk_remaining_ = 0;
+        trailer_start_ = 0;
+        method_len_ = target_off_ = target_len_ = 0;
+        version_minor_ = 1;
+        keep_alive_ = true;
+        chunked_ = false;
+        have_content_length_ = false;
+        error_status_ = 0;
+    }
+
+    /**
+     * @brief Advance the state machine over data[0, length)
+     */
+    ParseStatus parse(const char* data, size_t length, HTTPRequestView& out) {
+        if (state_ == State::FAILED) {
+            return ParseStatus::INVALID;
+        }
+
+        while (state_ != State::DONE) {
+            ParseStatus step = ParseStatus::NEED_MORE;
+            switch (state_) {
+                case State::REQUEST_LINE: step = parseRequestLine(data, length); break;
+                case State::HEADERS:      step = parseHeaderLine(data, length); break;
+                case State::BODY:         step = parseFixedBody(length); break;
+                case State::CHUNK_SIZE:   step = parseChunkSize(data, length); break;
+                case State::CHUNK_DATA:   step = parseChunkData(data, length); break;
+                case State::TRAILERS:     step = parseTrailer(data, length); break;
+                default: break;
+            }
+            if (step == ParseStatus::INVALID) {
+                state_ = State::FAILED;
+                return step;
+            }
+            if (step == ParseStatus::NEED_MORE) {
+                // Every line-oriented state is bounded, so an unterminated line cannot grow the buffer forever
+                switch (state_) {
+                    case State::REQUEST_LINE:
+                    case State::HEADERS:
+                        if (length - request_start_ > max_header_bytes_) return fail(431);
+                        break;
+                    case State::CHUNK_SIZE:
+                        if (length - cursor_ > max_header_bytes_) return fail(400);
+                        break;
+                    case State::TRAILERS:
+                        if (length - trailer_start_ > max_header_bytes_) return fail(431);
+                        break;
+                    default:
+                        break;
+                }
+                return step;
+            }
+        }
+
+        fillView(data, out);
+        return ParseStatus::COMPLETE;
+    }
+
+    /**
+     * @brief Bytes used by the completed request (including body)
+     */
+    size_t totalLength() const { return body_end_; }
+
+    /**
+     * @brief Suggested HTTP status for the last INVALID result (400, 413, 431 or 501)
+     */
+    int errorStatus() const { return error_status_; }
+
+private:
+    enum class State {
+        REQUEST_LINE,
+        HEADERS,
+        BODY,
+        CHUNK_SIZE,
+        CHUNK_DATA,
+        TRAILERS,
+        DONE,
+        FAILED
+    };
+
+    struct HeaderSpan {
+        uint32_t name_off;
+        uint32_t name_len;
+        uint32_t value_off;
+        uint32_t value_len;
+    };
+
+    ParseStatus fail(int status) {
+        error_status_ = status;
+        state_ = State::FAILED;
+        return ParseStatus::INVALID;
+    }
+
+    // Finds the CRLF-terminated line starting at cursor_. Returns false when incomplete.
+    bool nextLine(const char* data, size_t length, size_t& line_len, bool& malformed) {
+        malformed = false;
+        size_t off = Scan::findLineBreak(data + cursor_, data + length);
+        if (cursor_ + off >= length) {
+            return false;
+        }
+        if (data[cursor_ + off] != '\r') {
+            malformed = true;  // bare LF
+            return true;
+        }
+        if (cursor_ + off + 1 >= length) {
+            return false;
+        }
+        if (data[cursor_ + off + 1] != '\n') {
+            malformed = true;
+            return true;
+        }
+        line_len = off;
+        return true;
+    }
+
+    ParseStatus parseRequestLine(const char* data, size_t length) {
+        // Tolerate stray CRLFs between pipelined requests (RFC 9112 §2.2)
+        while (cursor_ + 1 < length && data[cursor_] == '\r' && data[cursor_ + 1] == '\n') {
+            cursor_ += 2;
+        }
+        request_start_ = cursor_;
+
+        size_t line_len = 0;
+        bool malformed = false;
+        if (!nextLine(data, length, line_len, malformed)) {
+            return ParseStatus::NEED_MORE;
+        }
+        if (malformed) {
+            return fail(400);
+        }
+
+        std::string_view line(data + cursor_, line_len);
+        size_t sp1 = line.find(' ');
+        size_t sp2 = sp1 == std::string_view::npos ? sp1 : line.find(' ', sp1 + 1);
+        if (sp1 == 0 || sp2 == std::string_view::npos || sp2 == sp1 + 1) {
+            return fail(400);
+        }
+        std::string_view version = line.substr(sp2 + 1);
+        if (version.size() != 8 || version.compare(0, 7, "HTTP/1.") != 0 ||
+            (version[7] != '0' && version[7] != '1')) {
+            return fail(version.compare(0, 5, "HTTP/") == 0 ? 501 : 400);
+        }
+
+        method_len_ = sp1;
+        target_off_ = cursor_ + sp1 + 1;
+        target_len_ = sp2 - sp1 - 1;
+        version_minor_ = version[7] - '0';
+        keep_alive_ = version_minor_ == 1;
+
+        cursor_ += line_len + 2;
+        state_ = State::HEADERS;
+        return ParseStatus::COMPLETE;
+    }
+
+    ParseStatus parseHeaderLine(const char* data, size_t length) {
+        if (cursor_ + 1 < length && data[cursor_] == '\r' && data[cursor_ + 1] == '\n') {
+            cursor_ += 2;
+            header_end_ = cursor_;
+            // The limit holds however the head arrived, in pieces or in one read
+            if (header_end_ - request_start_ > max_header_bytes_) {
+                return fail(431);
+            }
+            return beginBody();
+        }
+        if (cursor_ < length && data[cursor_] == '\r' && cursor_ + 1 >= length) {
+            return ParseStatus::NEED_MORE;
+        }
+
+        size_t name_len = Scan::findHeaderDelimiter(data + cursor_, data + length);
+        if (cursor_ + name_len >= length) {
+            return ParseStatus::NEED_MORE;
+        }
+        if (data[cursor_ + name_len] != ':' || name_len == 0) {
+            return fail(400);
+        }
+        // No whitespace (or anything else outside tchar) before the colon: RFC 9112 section 5.1
+        for (size_t i = 0; i < name_len; ++i) {
+            if (!Scan::isTokenChar(data[cursor_ + i])) {
+                return fail(400);
+            }
+        }
+
+        size_t value_start = cursor_ + name_len + 1;
+        size_t saved = cursor_;
+        cursor_ = value_start;
+        size_t value_len = 0;
+        bool malformed = false;
+        if (!nextLine(data, length, value_len, malformed)) {
+            cursor_ = saved;
+            return ParseStatus::NEED_MORE;
+        }
+        if (malformed) {
+            return fail(400);
+        }
+        if (header_count_ == HTTPRequestView::kMaxHeaders) {
+            return fail(431);
+        }
+
+        std::string_view name(data + saved, name_len);
+        std::string_view value = Scan::trimOws(std::string_view(data + value_start, value_len));
+        if (!applyHeader(name, value)) {
+            return ParseStatus::INVALID;
+        }
+
+        HeaderSpan& span = headers_[header_count_++];
+        span.name_off = static_cast<uint32_t>(saved);
+        span.name_len = static_cast<uint32_t>(name_len);
+        span.value_off = static_cast<uint32_t>(value.data() - data);
+        span.value_len = static_cast<uint32_t>(value.size());
+
+        cursor_ = value_start + value_len + 2;
+        return ParseStatus::COMPLETE;
+    }
+
+    bool applyHeader(std::string_view name, std::string_view value) {
+        if (Scan::equalsIgnoreCase(name, "content-length")) {
+            if (value.empty() || value.size() > 18) {
+                fail(400);
+                return false;
+            }
+            size_t parsed = 0;
+            for (char c : value) {
+                if (c < '0' || c > '9') {
+                    fail(400);
+                    return false;
+                }
+                parsed = parsed * 10 + static_cast<size_t>(c - '0');
+            }
+            if (have_content_length_ && parsed != content_length_) {
+                fail(400);
+                return false;
+            }
+            content_length_ = parsed;
+            have_content_length_ = true;
+        } else if (Scan::equalsIgnoreCase(name, "transfer-encoding")) {
+            // chunked must be the final coding and applied once (RFC 9112 section 6.3), so any
+            // second Transfer-Encoding line or a coding after chunked is a framing error;
+            // codings before it (gzip, chunked) would need decoding we do not do
+            if (chunked_ || value.empty()) {
+                fail(400);
+                return false;
+            }
+            std::string_view rest = value;
+            while (!rest.empty()) {
+                size_t comma = rest.find(',');
+                std::string_view coding = Scan::trimOws(rest.substr(0, comma));
+                bool last = comma == std::string_view::npos;
+                rest = last ? std::string_view() : rest.substr(comma + 1);
+                if (!Scan::equalsIgnoreCase(coding, "chunked")) {
+                    fail(last ? 400 : 501);
+                    return false;
+                }
+                if (!last) {
+                    fail(400);  // chunked before another coding
+                    return false;
+                }
+            }
+            chunked_ = true;
+        } else if (Scan::equalsIgnoreCase(name, "connection")) {
+            if (Scan::containsTokenIgnoreCase(value, "close")) {
+                keep_alive_ = false;
+            } else if (Scan::containsTokenIgnoreCase(value, "keep-alive")) {
+                keep_alive_ = true;
+            }
+        }
+        return true;
+    }
+
+    ParseStatus beginBody() {
+        body_start_ = cursor_;
+        if (chunked_) {
+            if (have_content_length_) {
+                return fail(400);  // request smuggling guard
+            }
+            content_length_ = 0;
+            state_ = State::CHUNK_SIZE;
+            return ParseStatus::COMPLETE;
+        }
+        if (content_length_ > max_body_bytes_) {
+            return fail(413);
+        }
+        state_ = State::BODY;
+        return ParseStatus::COMPLETE;
+    }
+
+    ParseStatus parseFixedBody(size_t length) {
+        if (length - body_start_ < content_length_) {
+            return ParseStatus::NEED_MORE;
+        }
+        body_end_ = body_start_ + content_length_;
+        state_ = State::DONE;
+        return ParseStatus::COMPLETE;
+    }
+
+    ParseStatus parseChunkSize(const char* data, size_t length) {
+        size_t line_len = 0;
+        bool malformed = false;
+        if (!nextLine(data, length, line_len, malformed)) {
+            return ParseStatus::NEED_MORE;
+        }
+        if (malformed || line_len == 0) {
+            return fail(400);
+        }
+
+        size_t size = 0;
+        size_t digits = 0;
+        for (size_t i = 0; i < line_len; ++i) {
+            char c = data[cursor_ + i];
+            int nibble = (c >= '0' && c <= '9') ? c - '0'
+                       : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                       : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (nibble < 0) {
+                if (c == ';' || c == ' ' || c == '\t') {
+                    break;  // chunk extensions are ignored
+                }
+                return fail(400);
+            }
+            if (++digits > 15) {
+                return fail(413);
+            }
+            size = (size << 4) | static_cast<size_t>(nibble);
+        }
+        if (digits == 0) {
+            return fail(400);
+        }
+
+        cursor_ += line_len + 2;
+        content_length_ += size;
+        if (content_length_ > max_body_bytes_) {
+            return fail(413);
+        }
+        chunk_remaining_ = size;
+        trailer_start_ = cursor_;
+        state_ = size == 0 ? State::TRAILERS : State::CHUNK_DATA;
+        return ParseStatus::COMPLETE;
+    }
+
+    ParseStatus parseChunkData(const char* data, size_t length) {
+        if (length - cursor_ < chunk_remaining_ + 2) {
+            return ParseStatus::NEED_MORE;
+        }
+        cursor_ += chunk_remaining_;
+        if (data[cursor_] != '\r' || data[cursor_ + 1] != '\n') {
+            return fail(400);
+        }
+        cursor_ += 2;
+        chunk_remaining_ = 0;
+        state_ = State::CHUNK_SIZE;
+        return ParseStatus::COMPLETE;
+    }
+
+    ParseStatus parseTrailer(const char* data, size_t length) {
+        size_t line_len = 0;
+        bool malformed = false;
+        if (!nextLine(data, length, line_len, malformed)) {
+            return ParseStatus::NEED_MORE;
+        }
+        if (malformed) {
+            return fail(400);
+        }
+        cursor_ += line_len + 2;
+        if (cursor_ - trailer_start_ > max_header_bytes_) {
+            return fail(431);  // trailer section shares the header budget
+        }
+        if (line_len == 0) {
+            body_end_ = cursor_;
+            state_ = State::DONE;
+        }
+        return ParseStatus::COMPLETE;
+    }
+
+    void fillView(const char* data, HTTPRequestView& out) const {
+        out.method_text = std::string_view(data + request_start_, method_len_);
+        out.target = std::string_view(data + target_off_, target_len_);
+        size_t query = out.target.find('?');
+        out.path = out.target.substr(0, query);
+        out.query_string = query == std::string_view::npos ? std::string_view()
+                                                            : out.target.substr(query + 1);
+        out.version_minor = version_minor_;
+        out.header_count = header_count_;
+        for (size_t i = 0; i < header_count_; ++i) {
+            const HeaderSpan& span = headers_[i];
+            out.headers[i].name = std::string_view(data + span.name_off, span.name_len);
+            out.headers[i].value = std::string_view(data + span.value_off, span.value_len);
+        }
+        out.body = std::string_view(data + body_start_, body_end_ - body_start_);
+        out.content_length = content_length_;
+        out.total_length = body_end_;
+        out.keep_alive = keep_alive_;
+        out.chunked = chunked_;
+    }
+
+    size_t max_header_bytes_;
+    size_t max_body_bytes_;
+
+    State state_;
+    size_t cursor_;
+    size_t request_start_;
+    size_t method_len_;
+    size_t target_off_;
+    size_t target_len_;
+    int version_minor_;
+    std::array<HeaderSpan, HTTPRequestView::kMaxHeaders> headers_;
+    size_t header_count_;
+    size_t header_end_;
+    size_t body_start_;
+    size_t body_end_;
+    size_t content_length_;
+    size_t chunk_remaining_;
+    size_t trailer_start_;
+    bool keep_alive_;
+    bool chunked_;
+    bool have_content_length_;
+    int error_status_;
+};
+
+/**
+ * @brief Decode a chunked body produced by HTTPStreamParser into out
+ * @return false when the encoding is malformed
+ */
+inline bool decodeChunkedBody(std::string_view raw, std::string& out) {
+    out.clear();
+    while (!raw.empty()) {
+        size_t line_end = raw.find("\r\n");
+        if (line_end == std::string_view::npos) {
+            return false;
+        }
+        size_t size = 0;
+        size_t i = 0;
+        for (; i < line_end; ++i) {
+            char c = raw[i];
+            int nibble = (c >= '0' && c <= '9') ? c - '0'
+                       : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                       : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (nibble < 0) {
+                break;
+            }
+            size = (size << 4) | static_cast<size_t>(nibble);
+        }
+        if (i == 0) {
+            return false;
+        }
+        raw.remove_prefix(line_end + 2);
+        if (size == 0) {
+            return true;
+        }
+        if (raw.size() < size + 2) {
+            return false;
+        }
+        out.append(raw.data(), size);
+        raw.remove_prefix(size + 2);
+    }
+    return false;
+}
+
+} // namespace MedusaHTTP
+
+#endif // MEDUSA_HTTP_STREAM_PARSER_HPP
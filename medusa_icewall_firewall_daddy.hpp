@@ -48,6 +48,12 @@
 #include <functional>
 #include <future>
 #include <variant>
+#include <optional>
+#include <cctype>
+#include <cstdlib>
+#include "medusa_icewall_pattern_engine.hpp"
+#include "medusa_icewall_rate_limiter.hpp"
+#include "medusa_icewall_ip_set.hpp"
 
 namespace MedusaServ {
 namespace Icewall {
@@ -185,7 +191,7 @@ struct IPListEntry {
     
     // Statistics
     std::atomic<size_t> hit_count{0};
-    std::chrono::system_clock::time_point last_hit;
+    std::atomic<std::chrono::system_clock::rep> last_hit_ticks{0}; // system_clock ticks; stamped by lock-free readers
 };
 
 /**
@@ -216,8 +222,6 @@ struct ConnectionTracker {
     std::chrono::system_clock::time_point last_activity;
     std::atomic<size_t> request_count{0};
     std::atomic<size_t> failed_requests{0};
-    std::queue<std::chrono::system_clock::time_point> request_timestamps;
-    std::mutex request_mutex;
     
     // Behavioral analysis
     std::vector<std::string> user_agents;
@@ -250,9 +254,82 @@ private:
     
     // Core security data structures
     std::vector<SecurityPolicy> security_policies_;
-    std::unordered_map<std::string, IPListEntry> whitelist_ips_;
-    std::unordered_map<std::string, IPListEntry> blacklist_ips_;
-    std::unordered_map<std::string, IPAddressInfo> ip_intelligence_;
+    
+    /**
+     * @brief Enabled policies compiled into one automaton per scan target
+     * @details Rebuilt under policy_mutex_ whenever the policy list changes and
+     *          published with std::atomic_store, so request threads scan a
+     *          consistent snapshot without holding the policy lock.
+     */
+    struct CompiledPolicySet {
+        enum ScanTarget { REQUEST_DATA = 0, URL = 1, USER_AGENT = 2, TARGET_COUNT = 3 };
+        
+        struct Entry {
+            std::string policy_id;
+            PolicyType type;
+        };
+        
+        struct TargetMatcher {
+            std::shared_ptr<const PatternEngine::MultiPatternMatcher> matcher;
+            std::vector<size_t> entry_for_pattern;                  // matcher pattern -> entries index
+            std::vector<std::pair<size_t, std::regex>> fallback;    // patterns the engine rejected
+        };
+        
+        std::vector<Entry> entries;  // in policy order
+        std::array<TargetMatcher, TARGET_COUNT> targets;
+        
+        // RATE_LIMITING / DDoS_MITIGATION policies; a pattern scopes the limit to matching URLs
+        struct RateRule {
+            uint32_t rule_id;  // stable across rebuilds so client state survives
+            RateLimit::Limit limit;
+        };
+        std::vector<RateRule> rate_rules;
+        std::vector<size_t> global_rate_rules;
+        TargetMatcher rate_routes;  // entry_for_pattern indexes rate_rules
+    };
+    std::shared_ptr<const CompiledPolicySet> compiled_policies_;
+    
+    // Used when no rate policy is configured
+    static constexpr uint32_t kDefaultRateRuleId = 0;
+    RateLimit::GcraRateLimiter rate_limiter_;
+    // Master IP lists keyed by canonical prefix text ("10.0.0.0/8", "2001:db8::1");
+    // writers hold ip_list_mutex_ and republish ip_snapshot_ afterwards.
+    // Each value keeps the prefix parsed when it was staged, so a publish never re-parses.
+    template<typename T>
+    struct ListedPrefix {
+        IPSet::Prefix prefix;
+        std::shared_ptr<T> entry;
+    };
+    std::unordered_map<std::string, ListedPrefix<IPListEntry>> whitelist_ips_;
+    std::unordered_map<std::string, ListedPrefix<IPListEntry>> blacklist_ips_;
+    std::unordered_map<std::string, ListedPrefix<const IPAddressInfo>> ip_intelligence_;
+
+    // Which master lists a change touched; publish_ip_lists() rebuilds only those
+    enum IPListMask : unsigned { WHITELIST_MASK = 1, BLACKLIST_MASK = 2, INTELLIGENCE_MASK = 4, ALL_IP_LISTS = 7 };
+
+    /**
+     * @brief Read-only radix trie for one master list
+     */
+    template<typename T>
+    struct IPListIndex {
+        IPSet::PrefixTrie trie;
+        std::vector<std::shared_ptr<T>> entries;
+    };
+
+    /**
+     * @brief Read-only radix tries built from the master lists
+     * @details Published RCU-style with std::atomic_store: check_ip_lists
+     *          reads whichever snapshot is current without taking
+     *          ip_list_mutex_, and an old snapshot lives until its last
+     *          reader drops it. Lists a publish did not touch are shared
+     *          with the previous snapshot.
+     */
+    struct IPListSnapshot {
+        std::shared_ptr<const IPListIndex<IPListEntry>> whitelist;
+        std::shared_ptr<const IPListIndex<IPListEntry>> blacklist;
+        std::shared_ptr<const IPListIndex<const IPAddressInfo>> intelligence;
+    };
+    std::shared_ptr<const IPListSnapshot> ip_snapshot_;
     std::unordered_map<std::string, ConnectionTracker> active_connections_;
     std::queue<SecurityEvent> security_events_;
     
@@ -406,13 +483,15 @@ public:
             }
             
             // Phase 2: Rate limiting analysis
-            if (!check_rate_limits(client_ip, url)) {
+            std::chrono::milliseconds retry_after{0};
+            if (!check_rate_limits(client_ip, url, &retry_after)) {
                 metrics_.rate_limited_requests++;
                 decision.action = SecurityAction::RATE_LIMIT;
                 decision.threat_level = ThreatSeverity::MEDIUM;
                 decision.reason = "Rate limit exceeded";
                 decision.processing_delay = std::chrono::milliseconds(5000);
                 decision.response_headers["X-RateLimit-Exceeded"] = "true";
+                decision.response_headers["Retry-After"] = std::to_string((retry_after.count() + 999) / 1000);
                 
                 record_security_event(client_ip, method, url, headers, body,
                                     ThreatSeverity::MEDIUM, {"RATE_LIMITING"}, SecurityAction::RATE_LIMIT,
@@ -504,6 +583,7 @@ public:
         }
         
         security_policies_.push_back(policy);
+        rebuild_policy_matchers();
         log_security_event("POLICY ADDED: " + policy.name + " (" + policy.policy_id + ")", 
                           ThreatSeverity::INFO);
         return true;
@@ -519,6 +599,7 @@ public:
         if (it != security_policies_.end()) {
             *it = updated_policy;
             it->last_modified = std::chrono::system_clock::now();
+            rebuild_policy_matchers();
             log_security_event("POLICY UPDATED: " + updated_policy.name, ThreatSeverity::INFO);
             return true;
         }
@@ -534,6 +615,7 @@ public:
         
         if (it != security_policies_.end()) {
             security_policies_.erase(it, security_policies_.end());
+            rebuild_policy_matchers();
             log_security_event("POLICY REMOVED: " + policy_id, ThreatSeverity::INFO);
             return true;
         }
@@ -550,66 +632,52 @@ public:
      * @brief IP List Management Interface 🌐
      */
     
-    // Add IP to whitelist
+    // Add IP or CIDR range to whitelist
     bool add_ip_to_whitelist(const std::string& ip, const std::string& reason, 
                            bool permanent = false, std::chrono::hours expiry_hours = std::chrono::hours(24)) {
-        std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
-        
-        IPListEntry entry;
-        entry.ip_address = ip;
-        entry.action = SecurityAction::ALLOW;
-        entry.reason = reason;
-        entry.source = "manual";
-        entry.added_at = std::chrono::system_clock::now();
-        entry.expires_at = permanent ? std::chrono::system_clock::time_point::max() : 
-                          entry.added_at + expiry_hours;
-        entry.permanent = permanent;
-        entry.tags.push_back("whitelist");
-        
-        whitelist_ips_[ip] = entry;
+        IPSet::Prefix prefix;
+        if (!IPSet::parsePrefix(ip, prefix)) {
+            return false;
+        }
         
-        // Remove from blacklist if present
-        blacklist_ips_.erase(ip);
+        std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
+        publish_ip_lists(stage_ip_entry(prefix, make_ip_list_entry(prefix, SecurityAction::ALLOW, reason, "manual",
+                                                                   permanent, expiry_hours, {"whitelist"}), true));
         
         log_security_event("IP WHITELISTED: " + ip + " - Reason: " + reason, ThreatSeverity::INFO);
         return true;
     }
     
-    // Add IP to blacklist
+    // Add IP or CIDR range to blacklist
     bool add_ip_to_blacklist(const std::string& ip, const std::string& reason,
                            ThreatSeverity severity = ThreatSeverity::HIGH,
                            bool permanent = false, std::chrono::hours expiry_hours = std::chrono::hours(24)) {
-        std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
-        
-        IPListEntry entry;
-        entry.ip_address = ip;
-        entry.action = SecurityAction::BLOCK;
-        entry.reason = reason;
-        entry.source = "manual";
-        entry.added_at = std::chrono::system_clock::now();
-        entry.expires_at = permanent ? std::chrono::system_clock::time_point::max() : 
-                          entry.added_at + expiry_hours;
-        entry.permanent = permanent;
-        entry.tags.push_back("blacklist");
-        entry.tags.push_back("threat_level_" + std::to_string(static_cast<int>(severity)));
-        
-        blacklist_ips_[ip] = entry;
+        IPSet::Prefix prefix;
+        if (!IPSet::parsePrefix(ip, prefix)) {
+            return false;
+        }
         
-        // Remove from whitelist if present
-        whitelist_ips_.erase(ip);
+        std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
+        publish_ip_lists(stage_ip_entry(prefix, make_ip_list_entry(prefix, SecurityAction::BLOCK, reason, "manual",
+                                                                   permanent, expiry_hours, {"blacklist", "threat_level_" +
+                                                                   std::to_string(static_cast<int>(severity))}), false));
         
         log_security_event("IP BLACKLISTED: " + ip + " - Reason: " + reason, severity);
         return true;
     }
     
-    // Remove IP from all lists
+    // Remove IP or CIDR range from all lists
     bool remove_ip_from_lists(const std::string& ip) {
+        IPSet::Prefix prefix;
+        std::string key = IPSet::parsePrefix(ip, prefix) ? prefix.toString() : ip;
+        
         std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
         
-        bool removed_whitelist = whitelist_ips_.erase(ip) > 0;
-        bool removed_blacklist = blacklist_ips_.erase(ip) > 0;
+        bool removed_whitelist = whitelist_ips_.erase(key) > 0;
+        bool removed_blacklist = blacklist_ips_.erase(key) > 0;
         
         if (removed_whitelist || removed_blacklist) {
+            publish_ip_lists((removed_whitelist ? WHITELIST_MASK : 0u) | (removed_blacklist ? BLACKLIST_MASK : 0u));
             log_security_event("IP REMOVED: " + ip, ThreatSeverity::INFO);
             return true;
         }
@@ -620,8 +688,8 @@ public:
     std::vector<IPListEntry> get_whitelist_ips() const {
         std::shared_lock<std::shared_mutex> lock(ip_list_mutex_);
         std::vector<IPListEntry> result;
-        for (const auto& [ip, entry] : whitelist_ips_) {
-            result.push_back(entry);
+        for (const auto& [ip, listed] : whitelist_ips_) {
+            result.push_back(*listed.entry);
         }
         return result;
     }
@@ -630,45 +698,100 @@ public:
     std::vector<IPListEntry> get_blacklist_ips() const {
         std::shared_lock<std::shared_mutex> lock(ip_list_mutex_);
         std::vector<IPListEntry> result;
-        for (const auto& [ip, entry] : blacklist_ips_) {
-            result.push_back(entry);
+        for (const auto& [ip, listed] : blacklist_ips_) {
+            result.push_back(*listed.entry);
         }
         return result;
     }
     
-    // Bulk import IPs (CSV format support)
+    // Bulk import IPs (CSV format support: ip_or_cidr,reason[,severity])
     size_t bulk_import_ips(const std::string& csv_data, bool is_whitelist = false) {
         std::istringstream stream(csv_data);
-        std::string line;
-        size_t imported = 0;
+        size_t imported = import_ip_list_stream(stream, is_whitelist, "manual", std::chrono::hours(24));
         
-        while (std::getline(stream, line)) {
-            if (line.empty() || line[0] == '#') continue; // Skip empty lines and comments
+        log_security_event("BULK IMPORT: Imported " + std::to_string(imported) + " IP addresses", 
+                          ThreatSeverity::INFO);
+        return imported;
+    }
+    
+    /**
+     * @brief Load a blocklist/allowlist file (one IP or CIDR per line)
+     * @details Accepts "prefix[,reason[,severity]]" as well as the common
+     *          "prefix ; comment" feed layout; '#' and ';' start comments.
+     *          The whole file is staged under one lock and published as a
+     *          single snapshot, so readers never see a half-loaded feed.
+     * @return Number of entries loaded
+     */
+    size_t load_ip_list_file(const std::string& path, bool is_whitelist = false,
+                             const std::string& source = "threat-intelligence",
+                             std::chrono::hours expiry_hours = std::chrono::hours(24)) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            log_security_event("IP LIST LOAD FAILED: " + path, ThreatSeverity::MEDIUM);
+            return 0;
+        }
+        size_t loaded = import_ip_list_stream(file, is_whitelist, source, expiry_hours);
+        log_security_event("IP LIST LOADED: " + std::to_string(loaded) + " entries from " + path,
+                          ThreatSeverity::INFO);
+        return loaded;
+    }
+    
+    /**
+     * @brief Load threat-intelligence indicators (one IP or CIDR per line, optional tag column)
+     */
+    size_t load_threat_intelligence_file(const std::string& path, int reputation_score = 10) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            log_security_event("THREAT FEED LOAD FAILED: " + path, ThreatSeverity::MEDIUM);
+            return 0;
+        }
+        
+        std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
+        auto now = std::chrono::system_clock::now();
+        size_t loaded = 0;
+        std::string line;
+        while (std::getline(file, line)) {
+            std::string_view prefix_text;
+            std::string_view rest;
+            if (!split_ip_list_line(line, prefix_text, rest)) continue;
             
-            std::istringstream line_stream(line);
-            std::string ip, reason, severity_str;
+            IPSet::Prefix prefix;
+            if (!IPSet::parsePrefix(prefix_text, prefix)) continue;
             
-            if (std::getline(line_stream, ip, ',') && 
-                std::getline(line_stream, reason, ',')) {
-                
-                if (is_whitelist) {
-                    if (add_ip_to_whitelist(ip, reason)) {
-                        imported++;
-                    }
-                } else {
-                    std::getline(line_stream, severity_str, ',');
-                    ThreatSeverity severity = severity_str.empty() ? ThreatSeverity::MEDIUM :
-                                            static_cast<ThreatSeverity>(std::stoi(severity_str));
-                    if (add_ip_to_blacklist(ip, reason, severity)) {
-                        imported++;
-                    }
-                }
+            auto info = std::make_shared<IPAddressInfo>();
+            info->ip_address = prefix.toString();
+            info->is_malicious = true;
+            info->reputation_score = reputation_score;
+            info->threat_tags.push_back("threat_intelligence");
+            if (!rest.empty()) {
+                info->threat_tags.emplace_back(rest.substr(0, rest.find(',')));
             }
+            info->first_seen = now;
+            ip_intelligence_[info->ip_address] = {prefix, std::move(info)};
+            loaded++;
         }
+        publish_ip_lists(INTELLIGENCE_MASK);
         
-        log_security_event("BULK IMPORT: Imported " + std::to_string(imported) + " IP addresses", 
+        log_security_event("THREAT FEED LOADED: " + std::to_string(loaded) + " indicators from " + path,
                           ThreatSeverity::INFO);
-        return imported;
+        return loaded;
+    }
+    
+    /**
+     * @brief Most specific threat-intelligence record covering ip, if any
+     */
+    std::optional<IPAddressInfo> lookup_threat_intelligence(const std::string& ip) {
+        metrics_.threat_intelligence_queries++;
+        auto snapshot = std::atomic_load(&ip_snapshot_);
+        IPSet::Address address;
+        if (!snapshot || !IPSet::parseAddress(ip, address)) {
+            return std::nullopt;
+        }
+        int32_t index = snapshot->intelligence->trie.longestMatch(address);
+        if (index == IPSet::PrefixTrie::kNone) {
+            return std::nullopt;
+        }
+        return *snapshot->intelligence->entries[index];
     }
     
     /**
@@ -689,6 +812,8 @@ public:
         status["allowed_requests"] = std::to_string(metrics_.requests_allowed.load());
         status["blocked_requests"] = std::to_string(metrics_.requests_blocked.load());
         status["rate_limited"] = std::to_string(metrics_.rate_limited_requests.load());
+        status["rate_limiter_tracked_clients"] = std::to_string(rate_limiter_.trackedClients());
+        status["rate_limiter_evictions"] = std::to_string(rate_limiter_.getStats().evictions);
         
         // Threat statistics
         status["malicious_ips_blocked"] = std::to_string(metrics_.malicious_ips_blocked.load());
@@ -709,6 +834,7 @@ public:
             status["total_policies"] = std::to_string(security_policies_.size());
             status["whitelisted_ips"] = std::to_string(whitelist_ips_.size());
             status["blacklisted_ips"] = std::to_string(blacklist_ips_.size());
+            status["threat_intel_indicators"] = std::to_string(ip_intelligence_.size());
         }
         
         // Performance metrics
@@ -949,18 +1075,23 @@ private:
             "172.16.0.0/12"   // Private network (for demo)
         };
         
+        std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
         for (const auto& ip_range : known_malicious_ips) {
-            // In production, this would load from external threat intelligence feeds
-            IPAddressInfo info;
-            info.ip_address = ip_range;
-            info.is_malicious = true;
-            info.reputation_score = 10; // Low reputation
-            info.threat_tags.push_back("threat_intelligence");
-            info.first_seen = std::chrono::system_clock::now();
+            // Full feeds are loaded with load_threat_intelligence_file()
+            IPSet::Prefix prefix;
+            if (!IPSet::parsePrefix(ip_range, prefix)) continue;
             
-            // Store in intelligence database (simplified)
-            ip_intelligence_[ip_range] = info;
+            auto info = std::make_shared<IPAddressInfo>();
+            info->ip_address = prefix.toString();
+            info->is_malicious = true;
+            info->reputation_score = 10; // Low reputation
+            info->threat_tags.push_back("threat_intelligence");
+            info->first_seen = std::chrono::system_clock::now();
+            
+            ip_intelligence_[info->ip_address] = {prefix, std::move(info)};
         }
+        publish_ip_lists(INTELLIGENCE_MASK);
+        lock.unlock();
         
         log_security_event("SUCCESS: Threat intelligence initialized with " + 
                           std::to_string(known_malicious_ips.size()) + " indicators", 
@@ -971,50 +1102,51 @@ private:
      * @brief Check IP against whitelist/blacklist
      */
     FirewallDecision check_ip_lists(const std::string& client_ip) {
-        std::shared_lock<std::shared_mutex> lock(ip_list_mutex_);
         FirewallDecision decision;
+        auto snapshot = std::atomic_load(&ip_snapshot_);
+        IPSet::Address address;
         
-        // Check whitelist first
-        auto whitelist_it = whitelist_ips_.find(client_ip);
-        if (whitelist_it != whitelist_ips_.end()) {
-            const auto& entry = whitelist_it->second;
+        if (snapshot && IPSet::parseAddress(client_ip, address)) {
+            metrics_.ip_lookups_performed++;
+            auto now = std::chrono::system_clock::now();
+            IPListEntry* hit = nullptr;
             
-            // Check if entry has expired
-            if (!entry.permanent && std::chrono::system_clock::now() > entry.expires_at) {
-                // Remove expired entry (const_cast for modification)
-                const_cast<std::unordered_map<std::string, IPListEntry>&>(whitelist_ips_).erase(whitelist_it);
-            } else {
+            // Most specific unexpired entry wins; expired ones are swept by cleanup_worker
+            auto live_entry = [&](const std::vector<std::shared_ptr<IPListEntry>>& entries) {
+                return [&entries, &hit, now](uint32_t index) {
+                    IPListEntry& entry = *entries[index];
+                    if (!entry.permanent && now > entry.expires_at) {
+                        return false;
+                    }
+                    hit = &entry;
+                    return true;
+                };
+            };
+            
+            // Check whitelist first
+            if (snapshot->whitelist->trie.forEachMatch(address, live_entry(snapshot->whitelist->entries))) {
                 decision.action = SecurityAction::ALLOW;
                 decision.threat_level = ThreatSeverity::INFO;
-                decision.reason = "IP whitelisted: " + entry.reason;
+                decision.reason = "IP whitelisted: " + hit->reason;
                 decision.triggered_policies.push_back("IP_WHITELIST");
                 
                 // Update hit count
-                const_cast<IPListEntry&>(entry).hit_count++;
-                const_cast<IPListEntry&>(entry).last_hit = std::chrono::system_clock::now();
+                hit->hit_count.fetch_add(1, std::memory_order_relaxed);
+                hit->last_hit_ticks.store(now.time_since_epoch().count(), std::memory_order_relaxed);
                 
                 return decision;
             }
-        }
-        
-        // Check blacklist
-        auto blacklist_it = blacklist_ips_.find(client_ip);
-        if (blacklist_it != blacklist_ips_.end()) {
-            const auto& entry = blacklist_it->second;
             
-            // Check if entry has expired
-            if (!entry.permanent && std::chrono::system_clock::now() > entry.expires_at) {
-                // Remove expired entry
-                const_cast<std::unordered_map<std::string, IPListEntry>&>(blacklist_ips_).erase(blacklist_it);
-            } else {
+            // Check blacklist
+            if (snapshot->blacklist->trie.forEachMatch(address, live_entry(snapshot->blacklist->entries))) {
                 decision.action = SecurityAction::BLOCK;
                 decision.threat_level = ThreatSeverity::HIGH;
-                decision.reason = "IP blacklisted: " + entry.reason;
+                decision.reason = "IP blacklisted: " + hit->reason;
                 decision.triggered_policies.push_back("IP_BLACKLIST");
                 
                 // Update hit count
-                const_cast<IPListEntry&>(entry).hit_count++;
-                const_cast<IPListEntry&>(entry).last_hit = std::chrono::system_clock::now();
+                hit->hit_count.fetch_add(1, std::memory_order_relaxed);
+                hit->last_hit_ticks.store(now.time_since_epoch().count(), std::memory_order_relaxed);
                 
                 return decision;
             }
@@ -1029,33 +1161,51 @@ private:
     
     /**
      * @brief Check rate limits for client
+     * @details O(1) and lock-free per rule: the client's address is hashed
+     *          once and each applicable rule is one GCRA check.
      */
-    bool check_rate_limits(const std::string& client_ip, const std::string& url) {
-        std::lock_guard<std::mutex> lock(connections_mutex_);
+    bool check_rate_limits(const std::string& client_ip, const std::string& url,
+                           std::chrono::milliseconds* retry_after = nullptr) {
+        auto compiled = std::atomic_load(&compiled_policies_);
+        uint64_t client = RateLimit::hashClientAddress(client_ip);
+        auto now = std::chrono::steady_clock::now();
+        
+        auto admit = [&](uint32_t rule_id, const RateLimit::Limit& limit) {
+            auto decision = rate_limiter_.check(client, rule_id, limit, now);
+            if (!decision.allowed && retry_after) {
+                *retry_after = decision.retry_after;
+            }
+            return decision.allowed;
+        };
         
-        auto& tracker = active_connections_[client_ip];
-        if (tracker.client_ip.empty()) {
-            tracker.client_ip = client_ip;
-            tracker.first_connection = std::chrono::system_clock::now();
+        if (!compiled || compiled->rate_rules.empty()) {
+            return admit(kDefaultRateRuleId, RateLimit::Limit{});
         }
         
-        tracker.last_activity = std::chrono::system_clock::now();
-        tracker.request_count++;
+        for (size_t index : compiled->global_rate_rules) {
+            const auto& rule = compiled->rate_rules[index];
+            if (!admit(rule.rule_id, rule.limit)) {
+                return false;
+            }
+        }
         
-        // Add timestamp to sliding window
-        {
-            std::lock_guard<std::mutex> req_lock(tracker.request_mutex);
-            tracker.request_timestamps.push(tracker.last_activity);
-            
-            // Clean old timestamps (older than 1 minute)
-            auto one_minute_ago = std::chrono::system_clock::now() - std::chrono::minutes(1);
-            while (!tracker.request_timestamps.empty() && 
-                   tracker.request_timestamps.front() < one_minute_ago) {
-                tracker.request_timestamps.pop();
+        const auto& routes = compiled->rate_routes;
+        if (routes.matcher) {
+            thread_local PatternEngine::MatchSet matches;
+            matches.reset(routes.matcher->patternCount());
+            routes.matcher->match(url, matches);
+            bool allowed = true;
+            matches.forEach([&](uint32_t pattern) {
+                const auto& rule = compiled->rate_rules[routes.entry_for_pattern[pattern]];
+                allowed = allowed && admit(rule.rule_id, rule.limit);
+            });
+            if (!allowed) {
+                return false;
             }
-            
-            // Check rate limit (50 requests per minute)
-            if (tracker.request_timestamps.size() > 50) {
+        }
+        for (const auto& [index, regex] : routes.fallback) {
+            const auto& rule = compiled->rate_rules[index];
+            if (std::regex_search(url, regex) && !admit(rule.rule_id, rule.limit)) {
                 return false;
             }
         }
@@ -1079,76 +1229,97 @@ private:
                                                       const std::string& body) {
         ThreatAnalysisResult result;
         
-        std::lock_guard<std::mutex> lock(policy_mutex_);
+        auto compiled = std::atomic_load(&compiled_policies_);
         metrics_.policies_evaluated++;
+        if (!compiled) {
+            result.threat_score += analyze_behavioral_patterns(client_ip, method, url, headers);
+            return result;
+        }
         
-        // Build combined analysis string
-        std::string analysis_data = method + " " + url + " " + body;
+        // Build combined analysis string; the buffer is reused across requests
+        thread_local std::string analysis_data;
+        analysis_data.clear();
+        analysis_data.append(method).append(" ").append(url).append(" ").append(body);
         for (const auto& [key, value] : headers) {
-            analysis_data += " " + key + ":" + value;
+            analysis_data.append(" ").append(key).append(":").append(value);
         }
         
-        // Evaluate all security policies
-        for (const auto& policy : security_policies_) {
-            if (!policy.enabled) continue;
+        std::array<std::string_view, CompiledPolicySet::TARGET_COUNT> inputs;
+        std::array<bool, CompiledPolicySet::TARGET_COUNT> present = {true, true, false};
+        inputs[CompiledPolicySet::REQUEST_DATA] = analysis_data;
+        inputs[CompiledPolicySet::URL] = url;
+        auto ua_it = headers.find("User-Agent");
+        if (ua_it != headers.end()) {
+            inputs[CompiledPolicySet::USER_AGENT] = ua_it->second;
+            present[CompiledPolicySet::USER_AGENT] = true;
+        }
+        
+        // One pass per target reports every matching policy at once
+        thread_local PatternEngine::MatchSet matches;
+        thread_local std::vector<size_t> triggered;
+        triggered.clear();
+        for (size_t t = 0; t < CompiledPolicySet::TARGET_COUNT; ++t) {
+            const auto& target = compiled->targets[t];
+            if (!present[t] || !target.matcher) continue;
             
-            bool policy_triggered = false;
+            matches.reset(target.matcher->patternCount());
+            target.matcher->match(inputs[t], matches);
+            matches.forEach([&](uint32_t pattern) {
+                triggered.push_back(target.entry_for_pattern[pattern]);
+            });
+            for (const auto& [entry, regex] : target.fallback) {
+                std::string subject(inputs[t]);
+                if (std::regex_search(subject, regex)) {
+                    triggered.push_back(entry);
+                }
+            }
+        }
+        std::sort(triggered.begin(), triggered.end());
+        
+        for (size_t index : triggered) {
+            const auto& entry = compiled->entries[index];
             int policy_score = 0;
             
-            switch (policy.type) {
+            switch (entry.type) {
                 case PolicyType::SQL_INJECTION_PREVENTION:
-                    if (std::regex_search(analysis_data, policy.compiled_pattern)) {
-                        policy_triggered = true;
-                        policy_score = 30; // High score for SQL injection
-                        result.threat_components["sql_injection"] = policy_score;
-                    }
+                    policy_score = 30; // High score for SQL injection
+                    result.threat_components["sql_injection"] = policy_score;
                     break;
                     
                 case PolicyType::XSS_PROTECTION:
-                    if (std::regex_search(analysis_data, policy.compiled_pattern)) {
-                        policy_triggered = true;
-                        policy_score = 25; // High score for XSS
-                        result.threat_components["xss"] = policy_score;
-                    }
+                    policy_score = 25; // High score for XSS
+                    result.threat_components["xss"] = policy_score;
                     break;
                     
                 case PolicyType::URL_PATTERN_BLOCKING:
-                    if (std::regex_search(url, policy.compiled_pattern)) {
-                        policy_triggered = true;
-                        policy_score = 15; // Medium score for URL patterns
-                        result.threat_components["url_pattern"] = policy_score;
-                    }
+                    policy_score = 15; // Medium score for URL patterns
+                    result.threat_components["url_pattern"] = policy_score;
                     break;
                     
                 case PolicyType::USER_AGENT_FILTERING:
-                    {
-                        auto ua_it = headers.find("User-Agent");
-                        if (ua_it != headers.end() && 
-                            std::regex_search(ua_it->second, policy.compiled_pattern)) {
-                            policy_triggered = true;
-                            policy_score = 10; // Lower score for UA filtering
-                            result.threat_components["user_agent"] = policy_score;
-                        }
-                    }
+                    policy_score = 10; // Lower score for UA filtering
+                    result.threat_components["user_agent"] = policy_score;
                     break;
                     
                 default:
                     // Generic pattern matching for other policy types
-                    if (!policy.pattern.empty() && 
-                        std::regex_search(analysis_data, policy.compiled_pattern)) {
-                        policy_triggered = true;
-                        policy_score = 10;
-                        result.threat_components["generic"] += policy_score;
-                    }
+                    policy_score = 10;
+                    result.threat_components["generic"] += policy_score;
                     break;
             }
             
-            if (policy_triggered) {
-                result.triggered_policies.push_back(policy.policy_id);
-                result.threat_score += policy_score;
-                
-                // Update policy statistics
-                const_cast<SecurityPolicy&>(policy).matches_count++;
+            result.triggered_policies.push_back(entry.policy_id);
+            result.threat_score += policy_score;
+        }
+        
+        // Update policy statistics (only taken when something matched)
+        if (!triggered.empty()) {
+            std::lock_guard<std::mutex> lock(policy_mutex_);
+            for (auto& policy : security_policies_) {
+                if (std::find(result.triggered_policies.begin(), result.triggered_policies.end(),
+                              policy.policy_id) != result.triggered_policies.end()) {
+                    policy.matches_count++;
+                }
             }
         }
         
@@ -1323,7 +1494,12 @@ private:
         std::lock_guard<std::mutex> lock(connections_mutex_);
         
         auto& tracker = active_connections_[client_ip];
+        if (tracker.client_ip.empty()) {
+            tracker.client_ip = client_ip;
+            tracker.first_connection = std::chrono::system_clock::now();
+        }
         tracker.last_activity = std::chrono::system_clock::now();
+        tracker.request_count++;
         
         // Update user agent tracking
         auto ua_it = headers.find("User-Agent");
@@ -1352,6 +1528,204 @@ private:
         }
     }
     
+    /**
+     * @brief Build a list entry for a parsed prefix
+     */
+    std::shared_ptr<IPListEntry> make_ip_list_entry(const IPSet::Prefix& prefix, SecurityAction action,
+                                                    const std::string& reason, const std::string& source,
+                                                    bool permanent, std::chrono::hours expiry_hours,
+                                                    std::vector<std::string> tags) {
+        auto entry = std::make_shared<IPListEntry>();
+        entry->ip_address = prefix.toString();
+        entry->subnet_mask = std::to_string(prefix.cidrLength());
+        entry->action = action;
+        entry->reason = reason;
+        entry->source = source;
+        entry->added_at = std::chrono::system_clock::now();
+        entry->expires_at = permanent ? std::chrono::system_clock::time_point::max() : 
+                           entry->added_at + expiry_hours;
+        entry->permanent = permanent;
+        entry->tags = std::move(tags);
+        return entry;
+    }
+    
+    /**
+     * @brief Put an entry on one list and take the same prefix off the other
+     * @details Caller holds ip_list_mutex_ exclusively and publishes afterwards.
+     * @return IPListMask of the lists that changed
+     */
+    unsigned stage_ip_entry(const IPSet::Prefix& prefix, std::shared_ptr<IPListEntry> entry, bool whitelist) {
+        std::string key = entry->ip_address;
+        bool moved = (whitelist ? blacklist_ips_ : whitelist_ips_).erase(key) > 0;
+        (whitelist ? whitelist_ips_ : blacklist_ips_)[key] = {prefix, std::move(entry)};
+        unsigned target = whitelist ? WHITELIST_MASK : BLACKLIST_MASK;
+        unsigned other = whitelist ? BLACKLIST_MASK : WHITELIST_MASK;
+        return moved ? target | other : target;
+    }
+    
+    /**
+     * @brief Split "prefix[,;\s]rest" and skip blanks and comments
+     */
+    static bool split_ip_list_line(const std::string& line, std::string_view& prefix, std::string_view& rest) {
+        std::string_view text(line);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+        while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+        if (text.empty() || text.front() == '#' || text.front() == ';') {
+            return false;
+        }
+        size_t end = text.find_first_of(",; \t");
+        prefix = text.substr(0, end);
+        rest = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        while (!rest.empty() && (std::isspace(static_cast<unsigned char>(rest.front())) || rest.front() == ';')) {
+            rest.remove_prefix(1);
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Stage every line of a list under one lock, then publish once
+     */
+    size_t import_ip_list_stream(std::istream& stream, bool is_whitelist, const std::string& source,
+                                 std::chrono::hours expiry_hours) {
+        std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
+        size_t imported = 0;
+        unsigned changed = 0;
+        std::string line;
+        
+        while (std::getline(stream, line)) {
+            std::string_view prefix_text;
+            std::string_view rest;
+            if (!split_ip_list_line(line, prefix_text, rest)) continue;
+            
+            IPSet::Prefix prefix;
+            if (!IPSet::parsePrefix(prefix_text, prefix)) continue;
+            
+            size_t comma = rest.find(',');
+            std::string reason(rest.substr(0, comma));
+            std::vector<std::string> tags{is_whitelist ? "whitelist" : "blacklist"};
+            if (!is_whitelist) {
+                int severity = static_cast<int>(ThreatSeverity::MEDIUM);
+                if (comma != std::string_view::npos) {
+                    severity = std::atoi(std::string(rest.substr(comma + 1)).c_str());
+                }
+                tags.push_back("threat_level_" + std::to_string(severity));
+            }
+            
+            changed |= stage_ip_entry(prefix, make_ip_list_entry(prefix,
+                                                                 is_whitelist ? SecurityAction::ALLOW : SecurityAction::BLOCK,
+                                                                 reason, source, false, expiry_hours, std::move(tags)),
+                                      is_whitelist);
+            imported++;
+        }
+        
+        if (changed != 0) {
+            publish_ip_lists(changed);
+        }
+        return imported;
+    }
+    
+    /**
+     * @brief Rebuild the tries of the changed lists and swap in a new snapshot
+     * @details Caller holds ip_list_mutex_ exclusively. Untouched lists keep
+     *          the previous snapshot's trie, so adding one blacklist entry
+     *          does not rebuild the threat-intelligence feed.
+     */
+    void publish_ip_lists(unsigned changed = ALL_IP_LISTS) {
+        auto previous = std::atomic_load(&ip_snapshot_);
+        auto snapshot = previous ? std::make_shared<IPListSnapshot>(*previous) : std::make_shared<IPListSnapshot>();
+        
+        auto build = [](const auto& source, auto& index) {
+            using Index = typename std::decay_t<decltype(index)>::element_type;
+            auto built = std::make_shared<std::remove_const_t<Index>>();
+            built->trie.reserve(source.size());
+            built->entries.reserve(source.size());
+            for (const auto& [key, listed] : source) {
+                built->trie.insert(listed.prefix, static_cast<uint32_t>(built->entries.size()));
+                built->entries.push_back(listed.entry);
+            }
+            index = std::move(built);
+        };
+        if ((changed & WHITELIST_MASK) || !snapshot->whitelist) build(whitelist_ips_, snapshot->whitelist);
+        if ((changed & BLACKLIST_MASK) || !snapshot->blacklist) build(blacklist_ips_, snapshot->blacklist);
+        if ((changed & INTELLIGENCE_MASK) || !snapshot->intelligence) build(ip_intelligence_, snapshot->intelligence);
+        
+        std::atomic_store(&ip_snapshot_, std::shared_ptr<const IPListSnapshot>(std::move(snapshot)));
+    }
+    
+    /**
+     * @brief Recompile enabled policies into the per-target automata
+     * @details Caller holds policy_mutex_. Patterns the engine cannot express
+     *          keep their std::regex and are evaluated after the automaton.
+     */
+    void rebuild_policy_matchers() {
+        auto compiled = std::make_shared<CompiledPolicySet>();
+        std::array<std::vector<PatternEngine::PatternSpec>, CompiledPolicySet::TARGET_COUNT> specs;
+        
+        std::vector<PatternEngine::PatternSpec> rate_specs;
+        std::vector<const SecurityPolicy*> rate_route_policies;
+        
+        for (const auto& policy : security_policies_) {
+            if (!policy.enabled) continue;
+            
+            if (policy.type == PolicyType::RATE_LIMITING || policy.type == PolicyType::DDoS_MITIGATION) {
+                RateLimit::Limit limit;
+                limit.requests = static_cast<uint32_t>(std::max<size_t>(policy.rate_limit_requests, 1));
+                limit.window = policy.rate_limit_window;
+                uint32_t rule_id = RateLimit::ruleIdFor(policy.policy_id);
+                size_t index = compiled->rate_rules.size();
+                compiled->rate_rules.push_back({rule_id, limit});
+                if (policy.pattern.empty()) {
+                    compiled->global_rate_rules.push_back(index);
+                } else {
+                    compiled->rate_routes.entry_for_pattern.push_back(index);
+                    rate_specs.push_back({policy.pattern, (policy.compiled_pattern.flags() & std::regex::icase) != 0});
+                    rate_route_policies.push_back(&policy);
+                }
+                continue;
+            }
+            if (policy.pattern.empty()) continue;
+            
+            size_t target = CompiledPolicySet::REQUEST_DATA;
+            if (policy.type == PolicyType::URL_PATTERN_BLOCKING) {
+                target = CompiledPolicySet::URL;
+            } else if (policy.type == PolicyType::USER_AGENT_FILTERING) {
+                target = CompiledPolicySet::USER_AGENT;
+            }
+            
+            compiled->targets[target].entry_for_pattern.push_back(compiled->entries.size());
+            compiled->entries.push_back({policy.policy_id, policy.type});
+            bool icase = (policy.compiled_pattern.flags() & std::regex::icase) != 0;
+            specs[target].push_back({policy.pattern, icase});
+        }
+        
+        for (size_t t = 0; t < CompiledPolicySet::TARGET_COUNT; ++t) {
+            auto& target = compiled->targets[t];
+            if (specs[t].empty()) continue;
+            
+            std::vector<PatternEngine::MultiPatternMatcher::Rejection> rejected;
+            target.matcher = PatternEngine::MultiPatternMatcher::compile(specs[t], &rejected);
+            for (const auto& [pattern, reason] : rejected) {
+                size_t entry = target.entry_for_pattern[pattern];
+                auto it = std::find_if(security_policies_.begin(), security_policies_.end(),
+                    [&](const SecurityPolicy& p) { return p.policy_id == compiled->entries[entry].policy_id; });
+                target.fallback.emplace_back(entry, it->compiled_pattern);
+                log_security_event("POLICY PATTERN FALLBACK: " + compiled->entries[entry].policy_id +
+                                   " uses std::regex (" + reason + ")", ThreatSeverity::LOW);
+            }
+        }
+        
+        if (!rate_specs.empty()) {
+            std::vector<PatternEngine::MultiPatternMatcher::Rejection> rejected;
+            compiled->rate_routes.matcher = PatternEngine::MultiPatternMatcher::compile(rate_specs, &rejected);
+            for (const auto& [pattern, reason] : rejected) {
+                compiled->rate_routes.fallback.emplace_back(compiled->rate_routes.entry_for_pattern[pattern],
+                                                            rate_route_policies[pattern]->compiled_pattern);
+            }
+        }
+        
+        std::atomic_store(&compiled_policies_, std::shared_ptr<const CompiledPolicySet>(std::move(compiled)));
+    }
+    
     /**
      * @brief Update threat-specific metrics
      */
@@ -1598,25 +1972,23 @@ private:
         std::unique_lock<std::shared_mutex> lock(ip_list_mutex_);
         
         auto now = std::chrono::system_clock::now();
-        
-        // Clean whitelist
-        auto it = whitelist_ips_.begin();
-        while (it != whitelist_ips_.end()) {
-            if (!it->second.permanent && now > it->second.expires_at) {
-                it = whitelist_ips_.erase(it);
-            } else {
-                ++it;
+        unsigned changed = 0;
+        
+        for (auto [list, mask] : {std::make_pair(&whitelist_ips_, WHITELIST_MASK),
+                                  std::make_pair(&blacklist_ips_, BLACKLIST_MASK)}) {
+            auto it = list->begin();
+            while (it != list->end()) {
+                if (!it->second.entry->permanent && now > it->second.entry->expires_at) {
+                    it = list->erase(it);
+                    changed |= mask;
+                } else {
+                    ++it;
+                }
             }
         }
         
-        // Clean blacklist
-        auto bit = blacklist_ips_.begin();
-        while (bit != blacklist_ips_.end()) {
-            if (!bit->second.permanent && now > bit->second.expires_at) {
-                bit = blacklist_ips_.erase(bit);
-            } else {
-                ++bit;
-            }
+        if (changed != 0) {
+            publish_ip_lists(changed);
         }
     }
     
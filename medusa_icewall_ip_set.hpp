@@ -0,0 +1,296 @@
+/**
+ * MEDUSASERV ICEWALL IP SET
+ * =========================
+ * CIDR-aware address sets for Icewall IP lists and threat intelligence
+ * Path-compressed binary radix (Patricia) trie over a unified 128-bit
+ * address space: IPv4 lives at ::ffff:0:0/96, so one trie answers
+ * longest-prefix match for both families in at most one node per bit
+ * © 2025 The Medusa Project | Roylepython | D Hargreaves
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <arpa/inet.h>
+
+namespace MedusaServ {
+namespace Icewall {
+namespace IPSet {
+
+/**
+ * @brief 128-bit address, IPv4 stored IPv4-mapped (::ffff:a.b.c.d)
+ */
+struct Address {
+    uint64_t high = 0;
+    uint64_t low = 0;
+
+    bool isV4() const { return high == 0 && (low >> 32) == 0xffffull; }
+    bool operator==(const Address& other) const { return high == other.high && low == other.low; }
+};
+
+/**
+ * @brief Address plus prefix length in the 128-bit space (IPv4 /n is 96 + n)
+ */
+struct Prefix {
+    Address address;
+    uint8_t length = 128;
+
+    // Family-relative length as written in CIDR notation
+    unsigned cidrLength() const { return address.isV4() ? length - 96u : length; }
+
+    std::string toString() const {
+        char text[INET6_ADDRSTRLEN + 8];
+        unsigned char bytes[16];
+        for (int i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<unsigned char>(address.high >> (56 - 8 * i));
+            bytes[8 + i] = static_cast<unsigned char>(address.low >> (56 - 8 * i));
+        }
+        bool v4 = address.isV4() && length >= 96;
+        if (v4) {
+            inet_ntop(AF_INET, bytes + 12, text, sizeof(text));
+        } else {
+            inet_ntop(AF_INET6, bytes, text, sizeof(text));
+        }
+        std::string result(text);
+        if (length != 128) {
+            result += "/" + std::to_string(v4 ? length - 96 : length);
+        }
+        return result;
+    }
+};
+
+namespace detail {
+
+inline bool bitAt(const Address& address, unsigned index) {
+    return index < 64 ? (address.high >> (63 - index)) & 1 : (address.low >> (127 - index)) & 1;
+}
+
+inline Address truncated(Address address, unsigned length) {
+    if (length < 64) {
+        address.high = length == 0 ? 0 : address.high & (~0ull << (64 - length));
+        address.low = 0;
+    } else if (length < 128) {
+        address.low = length == 64 ? 0 : address.low & (~0ull << (128 - length));
+    }
+    return address;
+}
+
+inline unsigned commonLength(const Address& a, const Address& b, unsigned limit) {
+    unsigned common;
+    if (uint64_t diff = a.high ^ b.high) {
+        common = static_cast<unsigned>(__builtin_clzll(diff));
+    } else if (uint64_t diff_low = a.low ^ b.low) {
+        common = 64 + static_cast<unsigned>(__builtin_clzll(diff_low));
+    } else {
+        common = 128;
+    }
+    return common < limit ? common : limit;
+}
+
+inline Address fromBytes(const unsigned char* bytes) {
+    Address address;
+    for (int i = 0; i < 8; ++i) {
+        address.high = (address.high << 8) | bytes[i];
+        address.low = (address.low << 8) | bytes[8 + i];
+    }
+    return address;
+}
+
+} // namespace detail
+
+/**
+ * @brief Parse a textual IPv4/IPv6 address (brackets and zone ids tolerated)
+ */
+inline bool parseAddress(std::string_view text, Address& out) {
+    if (!text.empty() && text.front() == '[') {
+        text.remove_prefix(1);
+        text = text.substr(0, text.find(']'));
+    }
+    text = text.substr(0, text.find('%'));
+    char buffer[INET6_ADDRSTRLEN + 1];
+    if (text.empty() || text.size() >= sizeof(buffer)) {
+        return false;
+    }
+    std::memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+
+    unsigned char bytes[16] = {0};
+    if (inet_pton(AF_INET, buffer, bytes + 12) == 1) {
+        bytes[10] = bytes[11] = 0xff;
+    } else if (inet_pton(AF_INET6, buffer, bytes) != 1) {
+        return false;
+    }
+    out = detail::fromBytes(bytes);
+    return true;
+}
+
+/**
+ * @brief Parse "address" or "address/length"; host bits are cleared
+ */
+inline bool parsePrefix(std::string_view text, Prefix& out) {
+    size_t slash = text.find('/');
+    Address address;
+    if (!parseAddress(text.substr(0, slash), address)) {
+        return false;
+    }
+    // "::ffff:a.b.c.d/n" is written in IPv6 terms even though it maps into IPv4
+    bool ipv6_text = text.substr(0, slash).find(':') != std::string_view::npos;
+    unsigned family_bits = ipv6_text ? 128 : 32;
+    unsigned length = family_bits;
+    if (slash != std::string_view::npos) {
+        std::string_view digits = text.substr(slash + 1);
+        if (digits.empty() || digits.size() > 3) {
+            return false;
+        }
+        length = 0;
+        for (char c : digits) {
+            if (c < '0' || c > '9') return false;
+            length = length * 10 + static_cast<unsigned>(c - '0');
+        }
+        if (length > family_bits) {
+            return false;
+        }
+    }
+    out.length = static_cast<uint8_t>(family_bits == 32 ? length + 96 : length);
+    out.address = detail::truncated(address, out.length);
+    return true;
+}
+
+/**
+ * @brief Patricia trie mapping prefixes to caller-defined value indices
+ * @details Built once and then only read, so a published trie can be shared
+ *          by any number of reader threads without synchronisation.
+ */
+class PrefixTrie {
+public:
+    static constexpr int32_t kNone = -1;
+
+    void reserve(size_t prefixes) { nodes_.reserve(prefixes * 2); }
+
+    /**
+     * @brief Map prefix to value; re-inserting a prefix replaces its value
+     */
+    void insert(const Prefix& prefix, uint32_t value) {
+        Address key = detail::truncated(prefix.address, prefix.length);
+        // Track the incoming link by (parent, side): addNode() may reallocate nodes_
+        int32_t parent = kNone;
+        int side = 0;
+        auto link = [&]() -> int32_t& { return parent == kNone ? root_ : nodes_[parent].child[side]; };
+        while (true) {
+            int32_t index = link();
+            if (index == kNone) {
+                int32_t leaf = addNode(key, prefix.length, static_cast<int32_t>(value));
+                link() = leaf;
+                ++size_;
+                return;
+            }
+            unsigned node_length = nodes_[index].length;
+            unsigned common = detail::commonLength(key, nodes_[index].key, std::min<unsigned>(node_length, prefix.length));
+
+            if (common < node_length) {
+                // Split: the new prefix diverges inside this node's label
+                Address node_key = nodes_[index].key;
+                int32_t branch;
+                if (common == prefix.length) {
+                    branch = addNode(key, prefix.length, static_cast<int32_t>(value));
+                    ++size_;
+                } else {
+                    branch = addNode(detail::truncated(key, common), common, kNone);
+                    int32_t leaf = addNode(key, prefix.length, static_cast<int32_t>(value));
+                    ++size_;
+                    nodes_[branch].child[detail::bitAt(key, common)] = leaf;
+                }
+                nodes_[branch].child[detail::bitAt(node_key, common)] = index;
+                link() = branch;
+                return;
+            }
+            if (node_length == prefix.length) {
+                if (nodes_[index].value == kNone) {
+                    ++size_;
+                }
+                nodes_[index].value = static_cast<int32_t>(value);
+                return;
+            }
+            parent = index;
+            side = detail::bitAt(key, node_length);
+        }
+    }
+
+    /**
+     * @brief Visit values of every prefix containing address, most specific first
+     * @details Stops as soon as visit returns true; returns whether it did.
+     */
+    template<typename Visit>
+    bool forEachMatch(const Address& address, Visit&& visit) const {
+        std::array<int32_t, 129> path;
+        size_t depth = 0;
+        int32_t index = root_;
+        while (index != kNone) {
+            const Node& node = nodes_[index];
+            if (detail::commonLength(address, node.key, node.length) < node.length) {
+                break;
+            }
+            if (node.value != kNone) {
+                path[depth++] = node.value;
+            }
+            if (node.length == 128) {
+                break;
+            }
+            index = node.child[detail::bitAt(address, node.length)];
+        }
+        while (depth > 0) {
+            if (visit(static_cast<uint32_t>(path[--depth]))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Value of the longest prefix containing address, or kNone
+     */
+    int32_t longestMatch(const Address& address) const {
+        int32_t found = kNone;
+        forEachMatch(address, [&](uint32_t value) {
+            found = static_cast<int32_t>(value);
+            return true;
+        });
+        return found;
+    }
+
+    size_t size() const { return size_; }
+    size_t memoryBytes() const { return nodes_.capacity() * sizeof(Node); }
+
+private:
+    struct Node {
+        Address key;
+        uint8_t length = 0;
+        int32_t child[2] = {kNone, kNone};
+        int32_t value = kNone;
+    };
+
+    int32_t addNode(const Address& key, unsigned length, int32_t value) {
+        Node node;
+        node.key = key;
+        node.length = static_cast<uint8_t>(length);
+        node.value = value;
+        nodes_.push_back(node);
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+
+    std::vector<Node> nodes_;
+    int32_t root_ = kNone;
+    size_t size_ = 0;
+};
+
+} // namespace IPSet
+} // namespace Icewall
+} // namespace MedusaServ
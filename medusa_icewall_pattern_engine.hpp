@@ -0,0 +1,1084 @@
+/**
+ * MEDUSASERV ICEWALL PATTERN ENGINE
+ * =================================
+ * Multi-pattern matcher for Icewall security policies
+ * Aho-Corasick literal prefilter in front of a lazily built combined DFA:
+ * one pass over the request reports every matching policy, however many
+ * policies are loaded
+ * © 2025 The Medusa Project | Roylepython | D Hargreaves
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace MedusaServ {
+namespace Icewall {
+namespace PatternEngine {
+
+/**
+ * @brief One ECMAScript-style pattern to compile into the automaton
+ * @details Supported: literals, escapes, '.', classes, groups, alternation,
+ *          * + ? {n,m} (lazy forms match the same set), ^ $ \b \B.
+ *          Backreferences and lookaround are rejected at compile time.
+ */
+struct PatternSpec {
+    std::string expression;
+    bool case_insensitive = false;
+};
+
+/**
+ * @brief Set of pattern indices reported by a scan
+ */
+class MatchSet {
+public:
+    void reset(size_t pattern_count) {
+        words_.assign((pattern_count + 63) / 64, 0);
+        count_ = 0;
+    }
+
+    bool insert(uint32_t id) {
+        uint64_t bit = uint64_t(1) << (id & 63);
+        uint64_t& word = words_[id >> 6];
+        if (word & bit) {
+            return false;
+        }
+        word |= bit;
+        ++count_;
+        return true;
+    }
+
+    bool contains(uint32_t id) const {
+        return (id >> 6) < words_.size() && (words_[id >> 6] >> (id & 63)) & 1;
+    }
+
+    size_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    // Visits ids in ascending order
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (size_t w = 0; w < words_.size(); ++w) {
+            uint64_t word = words_[w];
+            while (word) {
+                int bit = __builtin_ctzll(word);
+                fn(static_cast<uint32_t>(w * 64 + bit));
+                word &= word - 1;
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> words_;
+    size_t count_ = 0;
+};
+
+namespace detail {
+
+using ByteSet = std::bitset<256>;
+
+enum Assertion : uint8_t {
+    ASSERT_NONE = 0,
+    ASSERT_BEGIN,
+    ASSERT_END,
+    ASSERT_WORD_BOUNDARY,
+    ASSERT_NOT_WORD_BOUNDARY
+};
+
+inline bool isWordByte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+inline unsigned char foldByte(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c + 32) : c;
+}
+
+inline ByteSet wordBytes() {
+    ByteSet set;
+    for (int c = 0; c < 256; ++c) {
+        if (isWordByte(static_cast<unsigned char>(c))) set.set(c);
+    }
+    return set;
+}
+
+inline ByteSet caseFolded(const ByteSet& set) {
+    ByteSet folded = set;
+    for (int c = 'a'; c <= 'z'; ++c) {
+        if (set.test(c) || set.test(c - 32)) {
+            folded.set(c);
+            folded.set(c - 32);
+        }
+    }
+    return folded;
+}
+
+struct AstNode {
+    enum Kind : uint8_t { CHARSET, CONCAT, ALTERNATE, REPEAT, ASSERT, EMPTY };
+    Kind kind = EMPTY;
+    ByteSet bytes;
+    std::vector<int> children;
+    int min = 0;
+    int max = -1;   // REPEAT upper bound, -1 = unbounded
+    Assertion assertion = ASSERT_NONE;
+};
+
+struct PatternError : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Recursive-descent parser producing an AST in a flat pool
+ */
+class Parser {
+public:
+    static constexpr int kMaxRepeat = 100;
+
+    Parser(std::string_view expression, bool case_insensitive, std::vector<AstNode>& pool)
+        : text_(expression), icase_(case_insensitive), pool_(pool) {}
+
+    int parse() {
+        int root = parseAlternation();
+        if (pos_ != text_.size()) {
+            throw PatternError("unbalanced ')' at offset " + std::to_string(pos_));
+        }
+        return root;
+    }
+
+private:
+    int add(AstNode node) {
+        pool_.push_back(std::move(node));
+        return static_cast<int>(pool_.size() - 1);
+    }
+
+    int addSet(ByteSet bytes) {
+        AstNode node;
+        node.kind = AstNode::CHARSET;
+        node.bytes = icase_ ? caseFolded(bytes) : bytes;
+        return add(std::move(node));
+    }
+
+    bool atEnd() const { return pos_ >= text_.size(); }
+    char peek() const { return text_[pos_]; }
+
+    int parseAlternation() {
+        std::vector<int> branches{parseConcat()};
+        while (!atEnd() && peek() == '|') {
+            ++pos_;
+            branches.push_back(parseConcat());
+        }
+        if (branches.size() == 1) {
+            return branches[0];
+        }
+        AstNode node;
+        node.kind = AstNode::ALTERNATE;
+        node.children = std::move(branches);
+        return add(std::move(node));
+    }
+
+    int parseConcat() {
+        std::vector<int> items;
+        while (!atEnd() && peek() != '|' && peek() != ')') {
+            items.push_back(parseRepeat());
+        }
+        if (items.size() == 1) {
+            return items[0];
+        }
+        AstNode node;
+        node.kind = items.empty() ? AstNode::EMPTY : AstNode::CONCAT;
+        node.children = std::move(items);
+        return add(std::move(node));
+    }
+
+    int parseRepeat() {
+        int atom = parseAtom();
+        while (!atEnd()) {
+            int min = 0;
+            int max = -1;
+            char c = peek();
+            if (c == '*') {
+                ++pos_;
+            } else if (c == '+') {
+                min = 1;
+                ++pos_;
+            } else if (c == '?') {
+                max = 1;
+                ++pos_;
+            } else if (c == '{') {
+                if (!parseBraces(min, max)) {
+                    break;
+                }
+            } else {
+                break;
+            }
+            if (pool_[atom].kind == AstNode::ASSERT) {
+                throw PatternError("quantifier applied to an assertion");
+            }
+            // Lazy and greedy quantifiers accept the same strings
+            if (!atEnd() && peek() == '?') {
+                ++pos_;
+            }
+            AstNode node;
+            node.kind = AstNode::REPEAT;
+            node.children = {atom};
+            node.min = min;
+            node.max = max;
+            atom = add(std::move(node));
+        }
+        return atom;
+    }
+
+    bool parseBraces(int& min, int& max) {
+        size_t start = pos_;
+        ++pos_;
+        auto number = [&](int& value) {
+            size_t digits = 0;
+            value = 0;
+            while (!atEnd() && peek() >= '0' && peek() <= '9') {
+                value = value * 10 + (peek() - '0');
+                if (value > kMaxRepeat) {
+                    throw PatternError("repeat count above " + std::to_string(kMaxRepeat));
+                }
+                ++pos_;
+                ++digits;
+            }
+            return digits > 0;
+        };
+        if (!number(min)) {
+            pos_ = start;
+            throw PatternError("malformed '{' quantifier");
+        }
+        max = min;
+        if (!atEnd() && peek() == ',') {
+            ++pos_;
+            if (!number(max)) {
+                max = -1;
+            }
+        }
+        if (atEnd() || peek() != '}' || (max >= 0 && max < min)) {
+            throw PatternError("malformed '{' quantifier");
+        }
+        ++pos_;
+        return true;
+    }
+
+    int parseAtom() {
+        char c = peek();
+        switch (c) {
+            case '(': {
+                ++pos_;
+                if (!atEnd() && peek() == '?') {
+                    if (pos_ + 1 < text_.size() && text_[pos_ + 1] == ':') {
+                        pos_ += 2;
+                    } else {
+                        throw PatternError("lookaround is not supported");
+                    }
+                }
+                int inner = parseAlternation();
+                if (atEnd() || peek() != ')') {
+                    throw PatternError("missing ')'");
+                }
+                ++pos_;
+                return inner;
+            }
+            case '[':
+                return addSet(parseClass());
+            case '.': {
+                ++pos_;
+                ByteSet any;
+                any.set();
+                any.reset('\n');
+                any.reset('\r');
+                return addSet(any);
+            }
+            case '^':
+            case '$': {
+                ++pos_;
+                AstNode node;
+                node.kind = AstNode::ASSERT;
+                node.assertion = c == '^' ? ASSERT_BEGIN : ASSERT_END;
+                return add(std::move(node));
+            }
+            case '\\': {
+                ++pos_;
+                Assertion assertion = ASSERT_NONE;
+                ByteSet bytes = parseEscape(false, assertion);
+                if (assertion != ASSERT_NONE) {
+                    AstNode node;
+                    node.kind = AstNode::ASSERT;
+                    node.assertion = assertion;
+                    return add(std::move(node));
+                }
+                return addSet(bytes);
+            }
+            case '*':
+            case '+':
+            case '?':
+            case '{':
+                throw PatternError("nothing to repeat at offset " + std::to_string(pos_));
+            default: {
+                ++pos_;
+                ByteSet single;
+                single.set(static_cast<unsigned char>(c));
+                return addSet(single);
+            }
+        }
+    }
+
+    ByteSet parseEscape(bool in_class, Assertion& assertion) {
+        if (atEnd()) {
+            throw PatternError("trailing backslash");
+        }
+        char c = text_[pos_++];
+        ByteSet set;
+        auto range = [&](int lo, int hi) { for (int b = lo; b <= hi; ++b) set.set(b); };
+        switch (c) {
+            case 'd': range('0', '9'); return set;
+            case 'D': range('0', '9'); return set.flip();
+            case 'w': return wordBytes();
+            case 'W': return wordBytes().flip();
+            case 's': case 'S':
+                for (char s : {' ', '\t', '\n', '\v', '\f', '\r'}) set.set(static_cast<unsigned char>(s));
+                return c == 's' ? set : set.flip();
+            case 'n': set.set('\n'); return set;
+            case 'r': set.set('\r'); return set;
+            case 't': set.set('\t'); return set;
+            case 'f': set.set('\f'); return set;
+            case 'v': set.set('\v'); return set;
+            case '0': set.set(0); return set;
+            case 'b':
+                if (in_class) { set.set('\b'); return set; }
+                assertion = ASSERT_WORD_BOUNDARY;
+                return set;
+            case 'B':
+                if (in_class) throw PatternError("\\B inside a class");
+                assertion = ASSERT_NOT_WORD_BOUNDARY;
+                return set;
+            case 'x': {
+                int value = 0;
+                for (int i = 0; i < 2; ++i) {
+                    if (atEnd() || !std::isxdigit(static_cast<unsigned char>(peek()))) {
+                        throw PatternError("malformed \\x escape");
+                    }
+                    char h = text_[pos_++];
+                    value = value * 16 + (h <= '9' ? h - '0' : (h | 0x20) - 'a' + 10);
+                }
+                set.set(value);
+                return set;
+            }
+            default:
+                if ((c >= '1' && c <= '9') || c == 'k') {
+                    throw PatternError("backreferences are not supported");
+                }
+                if (c == 'u' || c == 'c' || c == 'p' || c == 'P') {
+                    throw PatternError(std::string("unsupported escape \\") + c);
+                }
+                set.set(static_cast<unsigned char>(c));
+                return set;
+        }
+    }
+
+    ByteSet parseClass() {
+        ++pos_;  // '['
+        bool negated = false;
+        if (!atEnd() && peek() == '^') {
+            negated = true;
+            ++pos_;
+        }
+        ByteSet set;
+        while (true) {
+            if (atEnd()) {
+                throw PatternError("missing ']'");
+            }
+            if (peek() == ']') {
+                ++pos_;
+                break;
+            }
+            int low = -1;
+            ByteSet item = classItem(low);
+            if (low >= 0 && pos_ + 1 < text_.size() && peek() == '-' && text_[pos_ + 1] != ']') {
+                ++pos_;
+                int high = -1;
+                classItem(high);
+                if (high < low) {
+                    throw PatternError("invalid class range");
+                }
+                for (int b = low; b <= high; ++b) set.set(b);
+            } else {
+                set |= item;
+            }
+        }
+        // Fold before negating so [^a] with icase excludes both cases
+        if (icase_) {
+            set = caseFolded(set);
+        }
+        return negated ? ~set : set;
+    }
+
+    // Returns the item's bytes; single_byte is set when the item is one byte (usable in a range)
+    ByteSet classItem(int& single_byte) {
+        ByteSet item;
+        if (peek() == '\\') {
+            ++pos_;
+            Assertion assertion = ASSERT_NONE;
+            item = parseEscape(true, assertion);
+        } else {
+            item.set(static_cast<unsigned char>(text_[pos_++]));
+        }
+        if (item.count() == 1) {
+            for (int b = 0; b < 256; ++b) {
+                if (item.test(b)) { single_byte = b; break; }
+            }
+        }
+        return item;
+    }
+
+    std::string_view text_;
+    bool icase_;
+    std::vector<AstNode>& pool_;
+    size_t pos_ = 0;
+};
+
+/**
+ * @brief Literal factors: a match must contain at least one of these
+ *        (lower-cased) strings, or nullopt when no such set is known
+ */
+class FactorExtractor {
+public:
+    static constexpr size_t kMaxFactors = 64;
+
+    explicit FactorExtractor(const std::vector<AstNode>& pool) : pool_(pool) {}
+
+    std::optional<std::vector<std::string>> required(int index) const {
+        const AstNode& node = pool_[index];
+        switch (node.kind) {
+            case AstNode::CHARSET: {
+                int literal = singleLiteral(node);
+                if (literal < 0) return std::nullopt;
+                return std::vector<std::string>{std::string(1, static_cast<char>(literal))};
+            }
+            case AstNode::ALTERNATE: {
+                std::vector<std::string> all;
+                for (int child : node.children) {
+                    auto factors = required(child);
+                    if (!factors) return std::nullopt;
+                    all.insert(all.end(), factors->begin(), factors->end());
+                    if (all.size() > kMaxFactors) return std::nullopt;
+                }
+                std::sort(all.begin(), all.end());
+                all.erase(std::unique(all.begin(), all.end()), all.end());
+                return all;
+            }
+            case AstNode::REPEAT:
+                if (node.min == 0) return std::nullopt;
+                return required(node.children[0]);
+            case AstNode::CONCAT:
+                return fromConcat(node);
+            default:
+                return std::nullopt;
+        }
+    }
+
+private:
+    // Lower-cased byte when the set is a single byte up to ASCII case, else -1
+    static int singleLiteral(const AstNode& node) {
+        size_t count = node.bytes.count();
+        if (count == 0 || count > 2) return -1;
+        int first = -1;
+        for (int b = 0; b < 256; ++b) {
+            if (!node.bytes.test(b)) continue;
+            int folded = foldByte(static_cast<unsigned char>(b));
+            if (first < 0) {
+                first = folded;
+            } else if (folded != first) {
+                return -1;
+            }
+        }
+        return first;
+    }
+
+    static bool better(const std::vector<std::string>& a, const std::optional<std::vector<std::string>>& b) {
+        if (!b) return true;
+        auto shortest = [](const std::vector<std::string>& set) {
+            size_t len = SIZE_MAX;
+            for (const auto& s : set) len = std::min(len, s.size());
+            return len;
+        };
+        size_t la = shortest(a);
+        size_t lb = shortest(*b);
+        return la > lb || (la == lb && a.size() < b->size());
+    }
+
+    std::optional<std::vector<std::string>> fromConcat(const AstNode& node) const {
+        std::optional<std::vector<std::string>> best;
+        std::string run;
+        auto close_run = [&]() {
+            if (!run.empty()) {
+                std::vector<std::string> candidate{run};
+                if (better(candidate, best)) best = std::move(candidate);
+                run.clear();
+            }
+        };
+        for (int child : node.children) {
+            const AstNode& item = pool_[child];
+            if (item.kind == AstNode::ASSERT) {
+                continue;  // zero width, literal runs continue across it
+            }
+            int literal = item.kind == AstNode::CHARSET ? singleLiteral(item) : -1;
+            if (literal >= 0) {
+                run.push_back(static_cast<char>(literal));
+                continue;
+            }
+            close_run();
+            auto factors = required(child);
+            if (factors && better(*factors, best)) best = std::move(factors);
+        }
+        close_run();
+        return best;
+    }
+
+    const std::vector<AstNode>& pool_;
+};
+
+struct NfaState {
+    enum Kind : uint8_t { CHARSET, EPSILON, SPLIT, ASSERT, MATCH };
+    Kind kind = EPSILON;
+    Assertion assertion = ASSERT_NONE;
+    int out = -1;
+    int out1 = -1;
+    int set_index = -1;
+    uint32_t pattern = 0;
+};
+
+/**
+ * @brief Thompson construction of one combined NFA for every pattern
+ */
+class NfaBuilder {
+public:
+    static constexpr size_t kMaxStates = 1 << 16;
+
+    NfaBuilder(std::vector<NfaState>& states, std::vector<ByteSet>& sets) : states_(states), sets_(sets) {}
+
+    // Returns the entry state; the fragment ends in a MATCH state for pattern
+    int addPattern(const std::vector<AstNode>& pool, int root, uint32_t pattern) {
+        Fragment fragment = build(pool, root);
+        int match = newState(NfaState::MATCH);
+        states_[match].pattern = pattern;
+        patch(fragment, match);
+        return fragment.start;
+    }
+
+private:
+    struct Fragment {
+        int start;
+        std::vector<std::pair<int, bool>> outs;  // (state, uses out1)
+    };
+
+    int newState(NfaState::Kind kind) {
+        if (states_.size() >= kMaxStates) {
+            throw PatternError("pattern set too large");
+        }
+        NfaState state;
+        state.kind = kind;
+        states_.push_back(state);
+        return static_cast<int>(states_.size() - 1);
+    }
+
+    void patch(const Fragment& fragment, int target) {
+        for (const auto& [state, second] : fragment.outs) {
+            (second ? states_[state].out1 : states_[state].out) = target;
+        }
+    }
+
+    Fragment build(const std::vector<AstNode>& pool, int index) {
+        const AstNode& node = pool[index];
+        switch (node.kind) {
+            case AstNode::CHARSET: {
+                int s = newState(NfaState::CHARSET);
+                sets_.push_back(node.bytes);
+                states_[s].set_index = static_cast<int>(sets_.size() - 1);
+                return {s, {{s, false}}};
+            }
+            case AstNode::ASSERT: {
+                int s = newState(NfaState::ASSERT);
+                states_[s].assertion = node.assertion;
+                return {s, {{s, false}}};
+            }
+            case AstNode::EMPTY: {
+                int s = newState(NfaState::EPSILON);
+                return {s, {{s, false}}};
+            }
+            case AstNode::CONCAT: {
+                Fragment result = build(pool, node.children[0]);
+                for (size_t i = 1; i < node.children.size(); ++i) {
+                    Fragment next = build(pool, node.children[i]);
+                    patch(result, next.start);
+                    result.outs = std::move(next.outs);
+                }
+                return result;
+            }
+            case AstNode::ALTERNATE: {
+                Fragment result = build(pool, node.children.back());
+                for (size_t i = node.children.size() - 1; i-- > 0;) {
+                    Fragment branch = build(pool, node.children[i]);
+                    int split = newState(NfaState::SPLIT);
+                    states_[split].out = branch.start;
+                    states_[split].out1 = result.start;
+                    branch.outs.insert(branch.outs.end(), result.outs.begin(), result.outs.end());
+                    result = {split, std::move(branch.outs)};
+                }
+                return result;
+            }
+            case AstNode::REPEAT:
+                return buildRepeat(pool, node);
+        }
+        throw PatternError("unknown node");
+    }
+
+    Fragment buildRepeat(const std::vector<AstNode>& pool, const AstNode& node) {
+        int child = node.children[0];
+        int entry = newState(NfaState::EPSILON);
+        Fragment result{entry, {{entry, false}}};
+        for (int i = 0; i < node.min; ++i) {
+            Fragment copy = build(pool, child);
+            patch(result, copy.start);
+            result.outs = std::move(copy.outs);
+        }
+        if (node.max < 0) {
+            int split = newState(NfaState::SPLIT);
+            Fragment body = build(pool, child);
+            states_[split].out = body.start;
+            patch(body, split);
+            patch(result, split);
+            result.outs = {{split, true}};
+        } else {
+            std::vector<std::pair<int, bool>> exits;
+            for (int i = node.min; i < node.max; ++i) {
+                int split = newState(NfaState::SPLIT);
+                Fragment body = build(pool, child);
+                states_[split].out = body.start;
+                patch(result, split);
+                exits.push_back({split, true});
+                result.outs = std::move(body.outs);
+            }
+            result.outs.insert(result.outs.end(), exits.begin(), exits.end());
+        }
+        return result;
+    }
+
+    std::vector<NfaState>& states_;
+    std::vector<ByteSet>& sets_;
+};
+
+} // namespace detail
+
+/**
+ * @brief Compiled, immutable pattern set
+ * @details The DFA is built lazily: transitions are computed on first use
+ *          under a mutex and published through atomics, so concurrent scans
+ *          read the table without locking. Past max_dfa_states the scan
+ *          falls back to NFA simulation instead of growing further.
+ */
+class MultiPatternMatcher {
+public:
+    static constexpr size_t kDefaultMaxDfaStates = 4096;
+
+    using Rejection = std::pair<size_t, std::string>;  // pattern index, reason
+
+    /**
+     * @brief Compile every pattern into one automaton
+     * @param rejected receives patterns the engine cannot express; they are
+     *        never reported as matches and the caller should fall back for them
+     */
+    static std::shared_ptr<const MultiPatternMatcher> compile(const std::vector<PatternSpec>& patterns,
+                                                              std::vector<Rejection>* rejected = nullptr,
+                                                              size_t max_dfa_states = kDefaultMaxDfaStates) {
+        std::shared_ptr<MultiPatternMatcher> matcher(new MultiPatternMatcher());
+        matcher->pattern_count_ = patterns.size();
+        matcher->max_states_ = std::max<size_t>(max_dfa_states, 2);
+
+        detail::NfaBuilder builder(matcher->nfa_, matcher->sets_);
+        std::vector<int> entries;
+        std::vector<std::pair<std::string, uint32_t>> factors;
+
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            std::vector<detail::AstNode> pool;
+            size_t nfa_mark = matcher->nfa_.size();
+            size_t set_mark = matcher->sets_.size();
+            try {
+                detail::Parser parser(patterns[i].expression, patterns[i].case_insensitive, pool);
+                int root = parser.parse();
+                entries.push_back(builder.addPattern(pool, root, static_cast<uint32_t>(i)));
+
+                auto required = detail::FactorExtractor(pool).required(root);
+                if (required) {
+                    for (auto& literal : *required) {
+                        factors.emplace_back(std::move(literal), static_cast<uint32_t>(i));
+                    }
+                } else {
+                    matcher->unfiltered_.push_back(static_cast<uint32_t>(i));
+                }
+            } catch (const detail::PatternError& error) {
+                matcher->nfa_.resize(nfa_mark);
+                matcher->sets_.resize(set_mark);
+                if (rejected) {
+                    rejected->emplace_back(i, error.what());
+                }
+            }
+        }
+
+        // Start state: a split chain fanning out to every pattern
+        if (entries.empty()) {
+            matcher->start_ = -1;
+        } else {
+            int start = entries.back();
+            for (size_t i = entries.size() - 1; i-- > 0;) {
+                detail::NfaState split;
+                split.kind = detail::NfaState::SPLIT;
+                split.out = entries[i];
+                split.out1 = start;
+                matcher->nfa_.push_back(split);
+                start = static_cast<int>(matcher->nfa_.size() - 1);
+            }
+            matcher->start_ = start;
+        }
+
+        matcher->buildByteClasses();
+        matcher->buildPrefilter(factors);
+        matcher->initDfa();
+        return matcher;
+    }
+
+    /**
+     * @brief Scan input once and add every matching pattern index to matches
+     * @details matches must have been reset() for patternCount() patterns
+     */
+    void match(std::string_view input, MatchSet& matches) const {
+        if (start_ < 0) {
+            return;
+        }
+        if (unfiltered_.empty() && !prefilterHit(input)) {
+            return;  // no required literal present, nothing can match
+        }
+        scanDfa(input, matches);
+    }
+
+    size_t patternCount() const { return pattern_count_; }
+    size_t byteClassCount() const { return class_count_; }
+
+    size_t dfaStateCount() const {
+        std::lock_guard<std::mutex> lock(build_mutex_);
+        return state_keys_.size();
+    }
+
+private:
+    static constexpr int32_t kUnknown = -1;
+    static constexpr int32_t kOverflow = -2;
+    static constexpr uint8_t kAtStart = 1;
+    static constexpr uint8_t kPrevWord = 2;
+
+    struct DfaKey {
+        std::vector<int> kernel;        // NFA states reached by the last byte
+        uint8_t flags = 0;
+        std::vector<uint32_t> accepts;  // patterns that matched just before the last byte
+
+        bool operator<(const DfaKey& other) const {
+            if (flags != other.flags) return flags < other.flags;
+            if (kernel != other.kernel) return kernel < other.kernel;
+            return accepts < other.accepts;
+        }
+    };
+
+    // Scratch space for closure(); one per builder or per fallback scan
+    struct Workspace {
+        std::vector<uint32_t> marks;
+        uint32_t generation = 0;
+        std::vector<int> stack;
+        std::vector<int> consuming;
+    };
+
+    MultiPatternMatcher() = default;
+
+    void buildByteClasses() {
+        // Refine bytes by membership in every set, plus word-ness for \b
+        std::array<uint16_t, 256> classes{};
+        std::vector<detail::ByteSet> partitioners = sets_;
+        partitioners.push_back(detail::wordBytes());
+        size_t count = 1;
+        for (const auto& set : partitioners) {
+            std::map<std::pair<uint16_t, bool>, uint16_t> remap;
+            for (int b = 0; b < 256; ++b) {
+                auto key = std::make_pair(classes[b], static_cast<bool>(set.test(b)));
+                auto it = remap.find(key);
+                if (it == remap.end()) {
+                    it = remap.emplace(key, static_cast<uint16_t>(remap.size())).first;
+                }
+                classes[b] = it->second;
+            }
+            count = remap.size();
+        }
+        class_count_ = count;
+        class_is_word_.assign(class_count_, false);
+        for (int b = 0; b < 256; ++b) {
+            byte_class_[b] = static_cast<uint8_t>(classes[b]);
+            class_is_word_[classes[b]] = detail::isWordByte(static_cast<unsigned char>(b));
+        }
+        class_sets_.resize(sets_.size());
+        for (size_t s = 0; s < sets_.size(); ++s) {
+            for (int b = 0; b < 256; ++b) {
+                if (sets_[s].test(b)) class_sets_[s].set(classes[b]);
+            }
+        }
+        stride_ = class_count_ + 1;  // last column is end-of-input
+    }
+
+    void buildPrefilter(const std::vector<std::pair<std::string, uint32_t>>& factors) {
+        ac_goto_.assign(1, {});
+        ac_goto_[0].fill(-1);
+        ac_outputs_.assign(1, {});
+        for (const auto& [literal, pattern] : factors) {
+            int state = 0;
+            for (unsigned char c : literal) {
+                if (ac_goto_[state][c] < 0) {
+                    ac_goto_[state][c] = static_cast<int32_t>(ac_goto_.size());
+                    ac_goto_.emplace_back();
+                    ac_goto_.back().fill(-1);
+                    ac_outputs_.emplace_back();
+                }
+                state = ac_goto_[state][c];
+            }
+            ac_outputs_[state].push_back(pattern);
+        }
+
+        // Breadth-first failure links, folded into a full transition table
+        std::vector<int32_t> fail(ac_goto_.size(), 0);
+        std::vector<int32_t> queue;
+        for (int c = 0; c < 256; ++c) {
+            int32_t& next = ac_goto_[0][c];
+            if (next < 0) {
+                next = 0;
+            } else {
+                queue.push_back(next);
+            }
+        }
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int32_t state = queue[head];
+            const auto& inherited = ac_outputs_[fail[state]];
+            ac_outputs_[state].insert(ac_outputs_[state].end(), inherited.begin(), inherited.end());
+            for (int c = 0; c < 256; ++c) {
+                int32_t& next = ac_goto_[state][c];
+                if (next < 0) {
+                    next = ac_goto_[fail[state]][c];
+                } else {
+                    fail[next] = ac_goto_[fail[state]][c];
+                    queue.push_back(next);
+                }
+            }
+        }
+    }
+
+    bool prefilterHit(std::string_view input) const {
+        int32_t state = 0;
+        for (unsigned char c : input) {
+            state = ac_goto_[state][detail::foldByte(c)];
+            if (!ac_outputs_[state].empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void initDfa() {
+        table_.reset(new std::atomic<int32_t>[max_states_ * stride_]);
+        for (size_t i = 0; i < max_states_ * stride_; ++i) {
+            table_[i].store(kUnknown, std::memory_order_relaxed);
+        }
+        accepts_.resize(max_states_);
+        build_workspace_.marks.assign(nfa_.size(), 0);
+
+        DfaKey initial;
+        initial.flags = kAtStart;
+        state_index_.emplace(initial, 0);
+        state_keys_.push_back(std::move(initial));
+    }
+
+    // Epsilon closure of kernel (plus the unanchored start) under the given context
+    void closure(const std::vector<int>& kernel, uint8_t flags, bool next_word, bool at_end,
+                 Workspace& ws, std::vector<uint32_t>& accepts) const {
+        if (++ws.generation == 0) {
+            std::fill(ws.marks.begin(), ws.marks.end(), 0);
+            ws.generation = 1;
+        }
+        ws.consuming.clear();
+        ws.stack.assign(kernel.begin(), kernel.end());
+        ws.stack.push_back(start_);
+        bool prev_word = flags & kPrevWord;
+
+        while (!ws.stack.empty()) {
+            int s = ws.stack.back();
+            ws.stack.pop_back();
+            if (s < 0 || ws.marks[s] == ws.generation) {
+                continue;
+            }
+            ws.marks[s] = ws.generation;
+            const detail::NfaState& state = nfa_[s];
+            switch (state.kind) {
+                case detail::NfaState::CHARSET:
+                    ws.consuming.push_back(s);
+                    break;
+                case detail::NfaState::MATCH:
+                    accepts.push_back(state.pattern);
+                    break;
+                case detail::NfaState::SPLIT:
+                    ws.stack.push_back(state.out1);
+                    ws.stack.push_back(state.out);
+                    break;
+                case detail::NfaState::EPSILON:
+                    ws.stack.push_back(state.out);
+                    break;
+                case detail::NfaState::ASSERT: {
+                    bool holds = false;
+                    switch (state.assertion) {
+                        case detail::ASSERT_BEGIN: holds = flags & kAtStart; break;
+                        case detail::ASSERT_END: holds = at_end; break;
+                        case detail::ASSERT_WORD_BOUNDARY: holds = prev_word != next_word; break;
+                        case detail::ASSERT_NOT_WORD_BOUNDARY: holds = prev_word == next_word; break;
+                        default: break;
+                    }
+                    if (holds) ws.stack.push_back(state.out);
+                    break;
+                }
+            }
+        }
+        std::sort(accepts.begin(), accepts.end());
+        accepts.erase(std::unique(accepts.begin(), accepts.end()), accepts.end());
+    }
+
+    // Successor of (kernel, flags) on byte class cls, or on end of input when cls == class_count_
+    DfaKey step(const DfaKey& from, size_t cls, Workspace& ws) const {
+        bool at_end = cls == class_count_;
+        bool next_word = !at_end && class_is_word_[cls];
+        DfaKey next;
+        closure(from.kernel, from.flags, next_word, at_end, ws, next.accepts);
+        if (!at_end) {
+            for (int s : ws.consuming) {
+                if (class_sets_[nfa_[s].set_index].test(cls)) {
+                    next.kernel.push_back(nfa_[s].out);
+                }
+            }
+            std::sort(next.kernel.begin(), next.kernel.end());
+            next.kernel.erase(std::unique(next.kernel.begin(), next.kernel.end()), next.kernel.end());
+            next.flags = next_word ? kPrevWord : 0;
+        }
+        return next;
+    }
+
+    int32_t buildTransition(int32_t from, size_t cls) const {
+        std::lock_guard<std::mutex> lock(build_mutex_);
+        int32_t known = table_[from * stride_ + cls].load(std::memory_order_relaxed);
+        if (known >= 0) {
+            return known;
+        }
+        DfaKey next = step(state_keys_[from], cls, build_workspace_);
+        auto it = state_index_.find(next);
+        int32_t target;
+        if (it != state_index_.end()) {
+            target = it->second;
+        } else {
+            if (state_keys_.size() >= max_states_) {
+                return kOverflow;
+            }
+            target = static_cast<int32_t>(state_keys_.size());
+            accepts_[target] = next.accepts;
+            state_index_.emplace(next, target);
+            state_keys_.push_back(std::move(next));
+        }
+        table_[from * stride_ + cls].store(target, std::memory_order_release);
+        return target;
+    }
+
+    bool report(const std::vector<uint32_t>& accepts, MatchSet& matches) const {
+        for (uint32_t id : accepts) {
+            matches.insert(id);
+        }
+        return matches.count() == pattern_count_;
+    }
+
+    void scanDfa(std::string_view input, MatchSet& matches) const {
+        int32_t state = 0;
+        for (size_t i = 0; i <= input.size(); ++i) {
+            size_t cls = i < input.size() ? byte_class_[static_cast<unsigned char>(input[i])] : class_count_;
+            int32_t next = table_[state * stride_ + cls].load(std::memory_order_acquire);
+            if (next < 0) {
+                next = buildTransition(state, cls);
+                if (next == kOverflow) {
+                    simulate(state, input.substr(i), matches);
+                    return;
+                }
+            }
+            state = next;
+            if (!accepts_[state].empty() && report(accepts_[state], matches)) {
+                return;
+            }
+        }
+    }
+
+    // Uncached NFA simulation for the rest of the input once the DFA is full
+    void simulate(int32_t from, std::string_view rest, MatchSet& matches) const {
+        Workspace ws;
+        ws.marks.assign(nfa_.size(), 0);
+        DfaKey current;
+        {
+            std::lock_guard<std::mutex> lock(build_mutex_);
+            current = state_keys_[from];
+        }
+        for (size_t i = 0; i <= rest.size(); ++i) {
+            size_t cls = i < rest.size() ? byte_class_[static_cast<unsigned char>(rest[i])] : class_count_;
+            current = step(current, cls, ws);
+            if (report(current.accepts, matches)) {
+                return;
+            }
+        }
+    }
+
+    size_t pattern_count_ = 0;
+    int start_ = -1;
+    std::vector<detail::NfaState> nfa_;
+    std::vector<detail::ByteSet> sets_;
+    std::vector<uint32_t> unfiltered_;   // patterns with no required literal
+
+    std::array<uint8_t, 256> byte_class_{};
+    size_t class_count_ = 0;
+    size_t stride_ = 0;
+    std::vector<bool> class_is_word_;
+    std::vector<detail::ByteSet> class_sets_;  // per NFA set, indexed by byte class
+
+    std::vector<std::array<int32_t, 256>> ac_goto_;
+    std::vector<std::vector<uint32_t>> ac_outputs_;
+
+    size_t max_states_ = kDefaultMaxDfaStates;
+    std::unique_ptr<std::atomic<int32_t>[]> table_;
+    mutable std::vector<std::vector<uint32_t>> accepts_;  // sized up front, written before publication
+    mutable std::mutex build_mutex_;
+    mutable std::vector<DfaKey> state_keys_;
+    mutable std::map<DfaKey, int32_t> state_index_;
+    mutable Workspace build_workspace_;
+};
+
+} // namespace PatternEngine
+} // namespace Icewall
+} // namespace MedusaServ
@@ -0,0 +1,262 @@
+/**
+ * MEDUSASERV ICEWALL RATE LIMITER
+ * ===============================
+ * Lock-free per-client rate limiting for Icewall
+ * GCRA (virtual scheduling) over a fixed-size table of packed 64-bit slots:
+ * every check is a bounded probe plus one compare-and-swap, memory never
+ * grows with the number of clients, and idle entries are reclaimed in place
+ * © 2025 The Medusa Project | Roylepython | D Hargreaves
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <arpa/inet.h>
+
+namespace MedusaServ {
+namespace Icewall {
+namespace RateLimit {
+
+/**
+ * @brief Allowed rate: `requests` per `window`, with up to `burst` back to back
+ */
+struct Limit {
+    uint32_t requests = 50;
+    std::chrono::milliseconds window{60000};
+    uint32_t burst = 0;  // 0 = requests (same allowance as a sliding window)
+};
+
+struct Decision {
+    bool allowed = true;
+    std::chrono::milliseconds retry_after{0};
+};
+
+inline uint64_t mix64(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ * @brief Hash a textual IPv4/IPv6 client address without allocating
+ * @details IPv4 and IPv4-mapped IPv6 hash identically. IPv6 clients are
+ *          keyed by their leading ipv6_prefix_bits (a /64 is normally one
+ *          subscriber). Unparseable text is hashed as-is.
+ */
+inline uint64_t hashClientAddress(std::string_view address, unsigned ipv6_prefix_bits = 64) {
+    char text[INET6_ADDRSTRLEN + 1];
+    if (!address.empty() && address.front() == '[') {
+        address.remove_prefix(1);
+        address = address.substr(0, address.find(']'));
+    }
+    address = address.substr(0, address.find('%'));  // drop IPv6 zone id
+
+    unsigned char bytes[16] = {0};
+    bool parsed = false;
+    if (address.size() < sizeof(text)) {
+        std::memcpy(text, address.data(), address.size());
+        text[address.size()] = '\0';
+        if (inet_pton(AF_INET, text, bytes + 12) == 1) {
+            bytes[10] = bytes[11] = 0xff;
+            parsed = true;
+        } else if (inet_pton(AF_INET6, text, bytes) == 1) {
+            static const unsigned char kMappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+            if (std::memcmp(bytes, kMappedPrefix, sizeof(kMappedPrefix)) != 0) {
+                unsigned keep = std::min(ipv6_prefix_bits, 128u);
+                for (unsigned bit = keep; bit < 128; ++bit) {
+                    bytes[bit / 8] &= static_cast<unsigned char>(~(0x80u >> (bit % 8)));
+                }
+            }
+            parsed = true;
+        }
+    }
+
+    if (!parsed) {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (unsigned char c : address) {
+            hash = (hash ^ c) * 0x100000001b3ull;
+        }
+        return mix64(hash);
+    }
+    uint64_t high;
+    uint64_t low;
+    std::memcpy(&high, bytes, 8);
+    std::memcpy(&low, bytes + 8, 8);
+    return mix64(high ^ mix64(low + 0x9e3779b97f4a7c15ull));
+}
+
+/**
+ * @brief Stable rule id for a policy name; 0 is left free for a default rule
+ */
+inline uint32_t ruleIdFor(std::string_view name) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : name) {
+        hash = (hash ^ c) * 0x100000001b3ull;
+    }
+    return static_cast<uint32_t>(mix64(hash)) | 1;
+}
+
+/**
+ * @brief Fixed-capacity GCRA limiter shared by all request threads
+ * @details Each slot packs a 22-bit key fingerprint with a 42-bit theoretical
+ *          arrival time (TAT) in 1/16 ms ticks, so a check updates a client
+ *          with a single CAS and never takes a lock. A slot whose TAT is in
+ *          the past holds no state worth keeping and is simply reused. When
+ *          every slot in a probe group is busy the least-loaded one is
+ *          evicted, which bounds memory at the cost of forgetting a client.
+ */
+class GcraRateLimiter {
+public:
+    static constexpr size_t kDefaultCapacity = 1 << 17;  // 1 MiB of slots
+    static constexpr size_t kProbeGroup = 8;              // one cache line
+
+    struct Stats {
+        size_t allowed;
+        size_t limited;
+        size_t evictions;
+    };
+
+    explicit GcraRateLimiter(size_t capacity = kDefaultCapacity)
+        : epoch_(std::chrono::steady_clock::now()) {
+        size_t slots = kProbeGroup;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+        slot_count_ = slots;
+        group_mask_ = slots / kProbeGroup - 1;
+        slots_.reset(new std::atomic<uint64_t>[slots]);
+        for (size_t i = 0; i < slots; ++i) {
+            slots_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Charge one request for (client, rule) and decide whether it may proceed
+     */
+    Decision check(uint64_t client_hash, uint32_t rule_id, const Limit& limit,
+                   std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) {
+        uint64_t key = mix64(client_hash ^ (static_cast<uint64_t>(rule_id) * 0x9e3779b97f4a7c15ull));
+        uint64_t fingerprint = (key >> kTatBits) & kFingerprintMask;
+        if (fingerprint == 0) {
+            fingerprint = 1;  // 0 marks an empty slot
+        }
+        std::atomic<uint64_t>* group = &slots_[(key & group_mask_) * kProbeGroup];
+
+        uint64_t now_ticks = toTicks(now);
+        uint64_t requests = std::max<uint32_t>(limit.requests, 1);
+        uint64_t window_ticks = std::max<uint64_t>(toTicks(limit.window), 1);
+        uint64_t interval = std::max<uint64_t>(window_ticks / requests, 1);
+        uint64_t burst = limit.burst ? limit.burst : requests;
+        uint64_t tolerance = interval * (burst - 1);
+
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            // Existing entry for this key?
+            for (size_t i = 0; i < kProbeGroup; ++i) {
+                uint64_t word = group[i].load(std::memory_order_relaxed);
+                while (fingerprintOf(word) == fingerprint) {
+                    uint64_t tat = std::max(tatOf(word), now_ticks);
+                    if (tat - now_ticks > tolerance) {
+                        limited_.fetch_add(1, std::memory_order_relaxed);
+                        return {false, fromTicks(tat - now_ticks - tolerance)};
+                    }
+                    if (group[i].compare_exchange_weak(word, pack(fingerprint, tat + interval),
+                                                       std::memory_order_relaxed)) {
+                        allowed_.fetch_add(1, std::memory_order_relaxed);
+                        return {true, std::chrono::milliseconds(0)};
+                    }
+                }
+            }
+
+            // New key: take an empty slot, else an idle one, else the least loaded
+            size_t victim = 0;
+            uint64_t victim_word = 0;
+            uint64_t victim_tat = UINT64_MAX;
+            for (size_t i = 0; i < kProbeGroup; ++i) {
+                uint64_t word = group[i].load(std::memory_order_relaxed);
+                uint64_t tat = word == 0 ? 0 : tatOf(word);
+                if (tat < victim_tat) {
+                    victim = i;
+                    victim_word = word;
+                    victim_tat = tat;
+                }
+            }
+            if (group[victim].compare_exchange_strong(victim_word, pack(fingerprint, now_ticks + interval),
+                                                      std::memory_order_relaxed)) {
+                if (victim_word != 0 && victim_tat > now_ticks) {
+                    evictions_.fetch_add(1, std::memory_order_relaxed);
+                }
+                allowed_.fetch_add(1, std::memory_order_relaxed);
+                return {true, std::chrono::milliseconds(0)};
+            }
+        }
+        // Sustained contention on one probe group; let the request through
+        allowed_.fetch_add(1, std::memory_order_relaxed);
+        return {true, std::chrono::milliseconds(0)};
+    }
+
+    /**
+     * @brief Number of slots still holding live (non-idle) state
+     */
+    size_t trackedClients(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const {
+        uint64_t now_ticks = toTicks(now);
+        size_t live = 0;
+        for (size_t i = 0; i < slot_count_; ++i) {
+            uint64_t word = slots_[i].load(std::memory_order_relaxed);
+            live += word != 0 && tatOf(word) > now_ticks;
+        }
+        return live;
+    }
+
+    Stats getStats() const {
+        return {allowed_.load(std::memory_order_relaxed),
+                limited_.load(std::memory_order_relaxed),
+                evictions_.load(std::memory_order_relaxed)};
+    }
+
+    size_t capacity() const { return slot_count_; }
+
+private:
+    static constexpr unsigned kTatBits = 42;  // 1/16 ms ticks: ~8.9 years from construction
+    static constexpr uint64_t kTatMask = (uint64_t(1) << kTatBits) - 1;
+    static constexpr uint64_t kFingerprintMask = (uint64_t(1) << (64 - kTatBits)) - 1;
+    static constexpr int64_t kTicksPerMs = 16;
+
+    static uint64_t pack(uint64_t fingerprint, uint64_t tat) {
+        return (fingerprint << kTatBits) | (tat & kTatMask);
+    }
+    static uint64_t fingerprintOf(uint64_t word) { return word >> kTatBits; }
+    static uint64_t tatOf(uint64_t word) { return word & kTatMask; }
+
+    uint64_t toTicks(std::chrono::steady_clock::time_point when) const {
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(when - epoch_).count();
+        return micros <= 0 ? 0 : static_cast<uint64_t>(micros) * kTicksPerMs / 1000;
+    }
+    static uint64_t toTicks(std::chrono::milliseconds duration) {
+        return duration.count() <= 0 ? 0 : static_cast<uint64_t>(duration.count()) * kTicksPerMs;
+    }
+    static std::chrono::milliseconds fromTicks(uint64_t ticks) {
+        return std::chrono::milliseconds((ticks + kTicksPerMs - 1) / kTicksPerMs);
+    }
+
+    std::chrono::steady_clock::time_point epoch_;
+    size_t slot_count_ = 0;
+    size_t group_mask_ = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+    std::atomic<size_t> allowed_{0};
+    std::atomic<size_t> limited_{0};
+    std::atomic<size_t> evictions_{0};
+};
+
+} // namespace RateLimit
+} // namespace Icewall
+} // namespace MedusaServ
@@ -0,0 +1,987 @@
+/**
+ * MEDUSA JSON - Arena Document
+ * ============================
+ * Allocation-light JSON DOM for hot paths (audit events, API responses)
+ * Every node, key and decoded string of a document lives in one arena that
+ * is released in a single step. Parsed strings without escapes are views
+ * into the input buffer, and parsing runs a SIMD structural-index pass
+ * (simdjson-style) before building the tree from the index.
+ */
+
+#ifndef MEDUSA_JSON_ARENA_HPP
+#define MEDUSA_JSON_ARENA_HPP
+
+#include "medusa_json_standalone.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace MedusaJSONArena {
+
+/**
+ * @brief Bump allocator; memory is only returned when the arena is reset or destroyed
+ */
+class Arena {
+public:
+    static constexpr size_t kFirstBlock = 4096;
+    static constexpr size_t kMaxBlock = 1 << 20;
+
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        uintptr_t current = reinterpret_cast<uintptr_t>(cursor_);
+        uintptr_t aligned = (current + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        if (!cursor_ || aligned + bytes > reinterpret_cast<uintptr_t>(limit_)) {
+            grow(bytes + align);
+            current = reinterpret_cast<uintptr_t>(cursor_);
+            aligned = (current + align - 1) & ~static_cast<uintptr_t>(align - 1);
+        }
+        cursor_ = reinterpret_cast<char*>(aligned + bytes);
+        used_ += bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    template<typename T>
+    T* allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena memory is never destructed");
+        return static_cast<T*>(allocate(sizeof(T) * (count ? count : 1), alignof(T)));
+    }
+
+    std::string_view copy(std::string_view text) {
+        if (text.empty()) {
+            return {};
+        }
+        char* data = static_cast<char*>(allocate(text.size(), 1));
+        std::memcpy(data, text.data(), text.size());
+        return {data, text.size()};
+    }
+
+    // Keep the largest block for reuse, drop the rest
+    void reset() {
+        if (blocks_.size() > 1) {
+            auto largest = std::max_element(blocks_.begin(), blocks_.end(),
+                                            [](const Block& a, const Block& b) { return a.size < b.size; });
+            Block keep = std::move(*largest);
+            blocks_.clear();
+            blocks_.push_back(std::move(keep));
+        }
+        if (!blocks_.empty()) {
+            cursor_ = blocks_.front().data.get();
+            limit_ = cursor_ + blocks_.front().size;
+        }
+        used_ = 0;
+    }
+
+    size_t bytesUsed() const { return used_; }
+    size_t bytesReserved() const {
+        size_t total = 0;
+        for (const auto& block : blocks_) {
+            total += block.size;
+        }
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    void grow(size_t minimum) {
+        size_t size = blocks_.empty() ? kFirstBlock : std::min(blocks_.back().size * 2, kMaxBlock);
+        size = std::max(size, minimum);
+        blocks_.push_back(Block{std::unique_ptr<char[]>(new char[size]), size});
+        cursor_ = blocks_.back().data.get();
+        limit_ = cursor_ + size;
+    }
+
+    std::vector<Block> blocks_;
+    char* cursor_ = nullptr;
+    char* limit_ = nullptr;
+    size_t used_ = 0;
+};
+
+struct Node;
+
+struct Member {
+    std::string_view key;
+    Node* value;
+};
+
+/**
+ * @brief One JSON value; containers point at arena arrays that grow by doubling
+ */
+struct Node {
+    JsonType type = JsonType::NULL_VALUE;
+    uint32_t size = 0;      // bytes for strings, entries for containers
+    uint32_t capacity = 0;
+    union {
+        double number;
+        bool boolean;
+        const char* chars;
+        Member* members;
+        Node** elements;
+    };
+
+    Node() : number(0.0) {}
+};
+
+static_assert(std::is_trivially_destructible<Node>::value, "arena nodes are never destructed");
+
+namespace detail {
+
+inline void appendEscaped(std::string& out, std::string_view text) {
+    static const char kHex[] = "0123456789abcdef";
+    out.push_back('"');
+    size_t run = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(text.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"': out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            case '\b': out.append("\\b"); break;
+            case '\f': out.append("\\f"); break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xf]};
+                out.append(escape, sizeof(escape));
+            }
+        }
+    }
+    out.append(text.data() + run, text.size() - run);
+    out.push_back('"');
+}
+
+inline void appendNumber(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        out.append("null");
+        return;
+    }
+    char buffer[32];
+    std::to_chars_result result;
+    if (value == std::trunc(value) && std::fabs(value) < 9007199254740992.0) {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<int64_t>(value));
+    } else {
+        result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    }
+    out.append(buffer, static_cast<size_t>(result.ptr - buffer));
+}
+
+inline void serialize(const Node* node, std::string& out) {
+    switch (node->type) {
+        case JsonType::OBJECT:
+            out.push_back('{');
+            for (uint32_t i = 0; i < node->size; ++i) {
+                if (i) out.push_back(',');
+                appendEscaped(out, node->members[i].key);
+                out.push_back(':');
+                serialize(node->members[i].value, out);
+            }
+            out.push_back('}');
+            break;
+        case JsonType::ARRAY:
+            out.push_back('[');
+            for (uint32_t i = 0; i < node->size; ++i) {
+                if (i) out.push_back(',');
+                serialize(node->elements[i], out);
+            }
+            out.push_back(']');
+            break;
+        case JsonType::STRING:
+            appendEscaped(out, std::string_view(node->chars, node->size));
+            break;
+        case JsonType::NUMBER:
+            appendNumber(out, node->number);
+            break;
+        case JsonType::BOOLEAN:
+            out.append(node->boolean ? "true" : "false");
+            break;
+        case JsonType::NULL_VALUE:
+            out.append("null");
+            break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Stage 1: structural index
+// ---------------------------------------------------------------------------
+
+struct BlockMasks {
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t op;          // { } [ ] : ,
+    uint64_t whitespace;
+};
+
+inline BlockMasks classifyBlock(const unsigned char* block) {
+    BlockMasks masks{0, 0, 0, 0};
+#if defined(__SSE2__)
+    for (int lane = 0; lane < 4; ++lane) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * lane));
+        auto eq = [&](__m128i v, char c) {
+            return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(c)))));
+        };
+        // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+        __m128i folded = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+        unsigned shift = 16 * lane;
+        masks.quote |= eq(bytes, '"') << shift;
+        masks.backslash |= eq(bytes, '\\') << shift;
+        masks.op |= (eq(folded, '{') | eq(folded, '}') | eq(bytes, ':') | eq(bytes, ',')) << shift;
+        masks.whitespace |= (eq(bytes, ' ') | eq(bytes, '\t') | eq(bytes, '\n') | eq(bytes, '\r')) << shift;
+    }
+#else
+    for (unsigned i = 0; i < 64; ++i) {
+        uint64_t bit = uint64_t(1) << i;
+        switch (block[i]) {
+            case '"': masks.quote |= bit; break;
+            case '\\': masks.backslash |= bit; break;
+            case '{': case '}': case '[': case ']': case ':': case ',': masks.op |= bit; break;
+            case ' ': case '\t': case '\n': case '\r': masks.whitespace |= bit; break;
+            default: break;
+        }
+    }
+#endif
+    return masks;
+}
+
+// Bits preceded by an odd run of backslashes (carry = previous block ended mid-escape)
+inline uint64_t escapedBits(uint64_t backslash, uint64_t& carry) {
+    const uint64_t even_bits = 0x5555555555555555ull;
+    backslash &= ~carry;
+    uint64_t follows_escape = (backslash << 1) | carry;
+    uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+    unsigned long long even_starts;
+    carry = __builtin_uaddll_overflow(odd_starts, backslash, &even_starts) ? 1 : 0;
+    uint64_t invert = static_cast<uint64_t>(even_starts) << 1;
+    return (even_bits ^ invert) & follows_escape;
+}
+
+inline uint64_t prefixXor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+/**
+ * @brief Positions of every structural character, opening quote and scalar start
+ * @return false if a string is left unterminated
+ */
+inline bool buildStructuralIndex(std::string_view input, std::vector<uint32_t>& index) {
+    index.resize(input.size() + 1);
+    uint32_t* out = index.data();
+    size_t count = 0;
+
+    uint64_t escape_carry = 0;
+    uint64_t in_string_carry = 0;
+    uint64_t scalar_carry = 0;
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(input.data());
+
+    for (size_t base = 0; base < input.size(); base += 64) {
+        unsigned char padded[64];
+        const unsigned char* block = data + base;
+        if (input.size() - base < 64) {
+            std::memset(padded, ' ', sizeof(padded));
+            std::memcpy(padded, block, input.size() - base);
+            block = padded;
+        }
+
+        BlockMasks masks = classifyBlock(block);
+        uint64_t escaped = (masks.backslash | escape_carry) ? escapedBits(masks.backslash, escape_carry) : 0;
+        uint64_t quote = masks.quote & ~escaped;
+        uint64_t in_string = prefixXor(quote) ^ in_string_carry;
+        in_string_carry = static_cast<uint64_t>(static_cast<int64_t>(in_string) >> 63);
+
+        uint64_t scalar = ~(masks.op | masks.whitespace | quote) & ~in_string;
+        uint64_t scalar_start = scalar & ~((scalar << 1) | scalar_carry);
+        scalar_carry = scalar >> 63;
+
+        uint64_t structurals = (masks.op & ~in_string) | (quote & in_string) | scalar_start;
+        while (structurals) {
+            out[count++] = static_cast<uint32_t>(base + static_cast<size_t>(__builtin_ctzll(structurals)));
+            structurals &= structurals - 1;
+        }
+    }
+    index.resize(count);
+    return in_string_carry == 0;
+}
+
+// ---------------------------------------------------------------------------
+// Stage 2: tree construction
+// ---------------------------------------------------------------------------
+
+class TreeBuilder {
+public:
+    static constexpr unsigned kMaxDepth = 1024;
+
+    TreeBuilder(std::string_view input, const std::vector<uint32_t>& index, Arena& arena,
+                std::vector<Member>& member_scratch, std::vector<Node*>& element_scratch)
+        : input_(input), index_(index), arena_(arena),
+          member_scratch_(member_scratch), element_scratch_(element_scratch) {}
+
+    Node* parseDocument() {
+        if (index_.empty()) {
+            fail("empty document", input_.size());
+        }
+        Node* root = parseValue(0);
+        if (position_ != index_.size()) {
+            fail("trailing content after JSON value", index_[position_]);
+        }
+        return root;
+    }
+
+private:
+    [[noreturn]] void fail(const char* message, size_t offset) const {
+        throw JSONParseException(std::string(message) + " at offset " + std::to_string(offset));
+    }
+
+    Node* newNode(JsonType type) {
+        Node* node = new (arena_.allocate(sizeof(Node), alignof(Node))) Node();
+        node->type = type;
+        return node;
+    }
+
+    char peek() const {
+        return position_ < index_.size() ? input_[index_[position_]] : '\0';
+    }
+
+    Node* parseValue(unsigned depth) {
+        if (position_ >= index_.size()) {
+            fail("unexpected end of input", input_.size());
+        }
+        size_t offset = index_[position_];
+        switch (input_[offset]) {
+            case '{': return parseObject(depth + 1);
+            case '[': return parseArray(depth + 1);
+            case '"': {
+                ++position_;
+                Node* node = newNode(JsonType::STRING);
+                std::string_view text = parseString(offset);
+                node->chars = text.data();
+                node->size = static_cast<uint32_t>(text.size());
+                return node;
+            }
+            case 't': return parseLiteral(offset, "true", JsonType::BOOLEAN, true);
+            case 'f': return parseLiteral(offset, "false", JsonType::BOOLEAN, false);
+            case 'n': return parseLiteral(offset, "null", JsonType::NULL_VALUE, false);
+            default: return parseNumber(offset);
+        }
+    }
+
+    Node* parseObject(unsigned depth) {
+        if (depth > kMaxDepth) {
+            fail("document nested too deeply", index_[position_]);
+        }
+        ++position_;  // '{'
+        Node* node = newNode(JsonType::OBJECT);
+        size_t first = member_scratch_.size();
+
+        if (peek() == '}') {
+            ++position_;
+            return node;
+        }
+        while (true) {
+            if (peek() != '"') {
+                fail("expected object key", position_ < index_.size() ? index_[position_] : input_.size());
+            }
+            std::string_view key = parseString(index_[position_++]);
+            if (peek() != ':') {
+                fail("expected ':' after object key", position_ < index_.size() ? index_[position_] : input_.size());
+            }
+            ++position_;
+            Node* value = parseValue(depth);
+            member_scratch_.push_back(Member{key, value});
+
+            char next = peek();
+            ++position_;
+            if (next == '}') break;
+            if (next != ',') {
+                fail("expected ',' or '}' in object", position_ <= index_.size() ? index_[position_ - 1] : input_.size());
+            }
+        }
+
+        size_t count = member_scratch_.size() - first;
+        node->members = arena_.allocateArray<Member>(count);
+        std::copy(member_scratch_.begin() + static_cast<std::ptrdiff_t>(first), member_scratch_.end(), node->members);
+        node->size = node->capacity = static_cast<uint32_t>(count);
+        member_scratch_.resize(first);
+        return node;
+    }
+
+    Node* parseArray(unsigned depth) {
+        if (depth > kMaxDepth) {
+            fail("document nested too deeply", index_[position_]);
+        }
+        ++position_;  // '['
+        Node* node = newNode(JsonType::ARRAY);
+        size_t first = element_scratch_.size();
+
+        if (peek() == ']') {
+            ++position_;
+            return node;
+        }
+        while (true) {
+            element_scratch_.push_back(parseValue(depth));
+            char next = peek();
+            ++position_;
+            if (next == ']') break;
+            if (next != ',') {
+                fail("expected ',' or ']' in array", position_ <= index_.size() ? index_[position_ - 1] : input_.size());
+            }
+        }
+
+        size_t count = element_scratch_.size() - first;
+        node->elements = arena_.allocateArray<Node*>(count);
+        std::copy(element_scratch_.begin() + static_cast<std::ptrdiff_t>(first), element_scratch_.end(), node->elements);
+        node->size = node->capacity = static_cast<uint32_t>(count);
+        element_scratch_.resize(first);
+        return node;
+    }
+
+    // Zero-copy when the string has no escapes; otherwise decoded into the arena
+    std::string_view parseString(size_t quote) {
+        const char* begin = input_.data() + quote + 1;
+        const char* end = input_.data() + input_.size();
+        const char* close = begin;
+        while (true) {
+            close = static_cast<const char*>(std::memchr(close, '"', static_cast<size_t>(end - close)));
+            if (!close) {
+                fail("unterminated string", quote);
+            }
+            size_t backslashes = 0;
+            while (close - backslashes > begin && close[-1 - static_cast<std::ptrdiff_t>(backslashes)] == '\\') {
+                ++backslashes;
+            }
+            if ((backslashes & 1) == 0) break;
+            ++close;
+        }
+
+        size_t length = static_cast<size_t>(close - begin);
+        if (!std::memchr(begin, '\\', length)) {
+            return {begin, length};
+        }
+        char* decoded = static_cast<char*>(arena_.allocate(length, 1));
+        size_t written = decodeEscapes(begin, close, decoded, quote);
+        return {decoded, written};
+    }
+
+    static int hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    uint32_t readHex4(const char*& p, const char* end, size_t quote) const {
+        if (end - p < 4) {
+            fail("truncated \\u escape", quote);
+        }
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            int digit = hexValue(p[i]);
+            if (digit < 0) {
+                fail("invalid \\u escape", quote);
+            }
+            value = (value << 4) | static_cast<uint32_t>(digit);
+        }
+        p += 4;
+        return value;
+    }
+
+    size_t decodeEscapes(const char* p, const char* end, char* out, size_t quote) const {
+        char* start = out;
+        while (p < end) {
+            if (*p != '\\') {
+                *out++ = *p++;
+                continue;
+            }
+            ++p;
+            switch (*p++) {
+                case '"': *out++ = '"'; break;
+                case '\\': *out++ = '\\'; break;
+                case '/': *out++ = '/'; break;
+                case 'b': *out++ = '\b'; break;
+                case 'f': *out++ = '\f'; break;
+                case 'n': *out++ = '\n'; break;
+                case 'r': *out++ = '\r'; break;
+                case 't': *out++ = '\t'; break;
+                case 'u': {
+                    uint32_t code = readHex4(p, end, quote);
+                    if (code >= 0xd800 && code < 0xdc00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                        const char* low_start = p + 2;
+                        uint32_t low = readHex4(low_start, end, quote);
+                        if (low >= 0xdc00 && low < 0xe000) {
+                            code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                            p = low_start;
+                        }
+                    }
+                    if (code < 0x80) {
+                        *out++ = static_cast<char>(code);
+                    } else if (code < 0x800) {
+                        *out++ = static_cast<char>(0xc0 | (code >> 6));
+                        *out++ = static_cast<char>(0x80 | (code & 0x3f));
+                    } else if (code < 0x10000) {
+                        *out++ = static_cast<char>(0xe0 | (code >> 12));
+                        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                        *out++ = static_cast<char>(0x80 | (code & 0x3f));
+                    } else {
+                        *out++ = static_cast<char>(0xf0 | (code >> 18));
+                        *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+                        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+                        *out++ = static_cast<char>(0x80 | (code & 0x3f));
+                    }
+                    break;
+                }
+                default:
+                    fail("invalid escape sequence", quote);
+            }
+        }
+        return static_cast<size_t>(out - start);
+    }
+
+    bool atTokenBoundary(size_t offset) const {
+        if (offset >= input_.size()) return true;
+        switch (input_[offset]) {
+            case ' ': case '\t': case '\n': case '\r':
+            case ',': case ':': case '{': case '}': case '[': case ']':
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    Node* parseLiteral(size_t offset, std::string_view literal, JsonType type, bool value) {
+        if (input_.compare(offset, literal.size(), literal) != 0 || !atTokenBoundary(offset + literal.size())) {
+            fail("invalid literal", offset);
+        }
+        ++position_;
+        Node* node = newNode(type);
+        node->boolean = value;
+        return node;
+    }
+
+    Node* parseNumber(size_t offset) {
+        // Grammar check first: std::from_chars also accepts forms JSON does not
+        size_t p = offset;
+        auto digits = [&]() {
+            size_t start = p;
+            while (p < input_.size() && input_[p] >= '0' && input_[p] <= '9') ++p;
+            return p - start;
+        };
+        if (p < input_.size() && input_[p] == '-') ++p;
+        size_t int_start = p;
+        size_t int_digits = digits();
+        if (int_digits == 0 || (int_digits > 1 && input_[int_start] == '0')) {
+            fail("invalid number", offset);
+        }
+        if (p < input_.size() && input_[p] == '.') {
+            ++p;
+            if (digits() == 0) fail("invalid number", offset);
+        }
+        if (p < input_.size() && (input_[p] == 'e' || input_[p] == 'E')) {
+            ++p;
+            if (p < input_.size() && (input_[p] == '+' || input_[p] == '-')) ++p;
+            if (digits() == 0) fail("invalid number", offset);
+        }
+        if (!atTokenBoundary(p)) {
+            fail("invalid number", offset);
+        }
+
+        Node* node = newNode(JsonType::NUMBER);
+        auto result = std::from_chars(input_.data() + offset, input_.data() + p, node->number);
+        if (result.ec == std::errc::result_out_of_range) {
+            node->number = input_[offset] == '-' ? -HUGE_VAL : HUGE_VAL;
+        } else if (result.ec != std::errc()) {
+            fail("invalid number", offset);
+        }
+        ++position_;
+        return node;
+    }
+
+    std::string_view input_;
+    const std::vector<uint32_t>& index_;
+    Arena& arena_;
+    size_t position_ = 0;
+    std::vector<Member>& member_scratch_;   // open containers' entries, stack-ordered
+    std::vector<Node*>& element_scratch_;
+};
+
+} // namespace detail
+
+class Document;
+
+/**
+ * @brief Non-owning handle to a node; valid while its Document lives
+ * @details Mirrors the MedusaJSON API (set/push/get/serialize/value/isX, and
+ *          operator-> so `json->set(...)` call sites compile unchanged) so
+ *          builders can move to an arena document by swapping the factory.
+ */
+class Value {
+public:
+    Value() = default;
+    Value(Node* node, Arena* arena) : node_(node), arena_(arena) {}
+
+    explicit operator bool() const { return node_ != nullptr; }
+    Value* operator->() { return this; }
+    const Value* operator->() const { return this; }
+
+    JsonType type() const { return node_ ? node_->type : JsonType::NULL_VALUE; }
+    bool isObject() const { return type() == JsonType::OBJECT; }
+    bool isArray() const { return type() == JsonType::ARRAY; }
+    bool isString() const { return node_ && node_->type == JsonType::STRING; }
+    bool isNumber() const { return type() == JsonType::NUMBER; }
+    bool isBoolean() const { return type() == JsonType::BOOLEAN; }
+    bool isNull() const { return type() == JsonType::NULL_VALUE; }
+
+    std::string_view asString() const { return isString() ? std::string_view(node_->chars, node_->size) : std::string_view(); }
+    double asNumber() const { return isNumber() ? node_->number : 0.0; }
+    bool asBoolean() const { return isBoolean() && node_->boolean; }
+    size_t size() const { return isObject() || isArray() ? node_->size : 0; }
+
+    Value get(std::string_view key) const {
+        if (!isObject()) return {};
+        for (uint32_t i = 0; i < node_->size; ++i) {
+            if (node_->members[i].key == key) {
+                return Value(node_->members[i].value, arena_);
+            }
+        }
+        return {};
+    }
+
+    Value at(size_t index) const {
+        return isArray() && index < node_->size ? Value(node_->elements[index], arena_) : Value();
+    }
+
+    std::string_view keyAt(size_t index) const {
+        return isObject() && index < node_->size ? node_->members[index].key : std::string_view();
+    }
+
+    Value valueAt(size_t index) const {
+        return isObject() && index < node_->size ? Value(node_->members[index].value, arena_) : Value();
+    }
+
+    // Object member access; inserts null for a missing key like MedusaJSON::operator[]
+    Value operator[](std::string_view key) {
+        if (!isObject()) return {};
+        Value existing = get(key);
+        if (existing) return existing;
+        Value created(newNode(JsonType::NULL_VALUE), arena_);
+        appendMember(arena_->copy(key), created.node_);
+        return created;
+    }
+
+    /**
+     * @brief Set (or replace) a member; the key is copied into the arena
+     */
+    Value& set(std::string_view key, Value value) {
+        if (!isObject() || !value.node_) return *this;
+        for (uint32_t i = 0; i < node_->size; ++i) {
+            if (node_->members[i].key == key) {
+                node_->members[i].value = value.node_;
+                return *this;
+            }
+        }
+        appendMember(arena_->copy(key), value.node_);
+        return *this;
+    }
+    Value& set(std::string_view key, std::string_view text) { return set(key, makeString(text)); }
+    Value& set(std::string_view key, const std::string& text) { return set(key, makeString(text)); }
+    Value& set(std::string_view key, const char* text) { return set(key, makeString(text ? text : "")); }
+    Value& set(std::string_view key, bool flag) { return set(key, makeBoolean(flag)); }
+    template<typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    Value& set(std::string_view key, T number) { return set(key, makeNumber(static_cast<double>(number))); }
+    Value& setNull(std::string_view key) { return set(key, Value(newNode(JsonType::NULL_VALUE), arena_)); }
+
+    Value& push(Value value) {
+        if (!isArray() || !value.node_) return *this;
+        if (node_->size == node_->capacity) {
+            uint32_t capacity = node_->capacity ? node_->capacity * 2 : 4;
+            Node** elements = arena_->allocateArray<Node*>(capacity);
+            std::copy(node_->elements, node_->elements + node_->size, elements);
+            node_->elements = elements;
+            node_->capacity = capacity;
+        }
+        node_->elements[node_->size++] = value.node_;
+        return *this;
+    }
+    Value& push(std::string_view text) { return push(makeString(text)); }
+    Value& push(const std::string& text) { return push(makeString(text)); }
+    Value& push(const char* text) { return push(makeString(text ? text : "")); }
+    Value& push(bool flag) { return push(makeBoolean(flag)); }
+    template<typename T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    Value& push(T number) { return push(makeNumber(static_cast<double>(number))); }
+
+    // MedusaJSON-style convenience accessors
+    std::string value(std::string_view key, const std::string& default_val) const {
+        Value val = get(key);
+        return val.isString() ? std::string(val.asString()) : default_val;
+    }
+    std::string value(std::string_view key, const char* default_val) const {
+        return value(key, std::string(default_val));
+    }
+    bool value(std::string_view key, bool default_val) const {
+        Value val = get(key);
+        return val.isBoolean() ? val.asBoolean() : default_val;
+    }
+    double value(std::string_view key, double default_val) const {
+        Value val = get(key);
+        return val.isNumber() ? val.asNumber() : default_val;
+    }
+
+    void serializeTo(std::string& out) const {
+        if (node_) {
+            detail::serialize(node_, out);
+        } else {
+            out.append("null");
+        }
+    }
+
+    std::string serialize() const {
+        std::string out;
+        out.reserve(256);
+        serializeTo(out);
+        return out;
+    }
+
+    /**
+     * @brief Deep copy into a refcounted MedusaJSON for APIs that still take one
+     */
+    std::shared_ptr<MedusaJSON> toShared() const {
+        switch (type()) {
+            case JsonType::OBJECT: {
+                auto object = MedusaJSON::createObject();
+                for (uint32_t i = 0; i < node_->size; ++i) {
+                    object->object_value[std::string(node_->members[i].key)] =
+                        Value(node_->members[i].value, arena_).toShared();
+                }
+                return object;
+            }
+            case JsonType::ARRAY: {
+                auto array = MedusaJSON::createArray();
+                array->array_value.reserve(node_->size);
+                for (uint32_t i = 0; i < node_->size; ++i) {
+                    array->array_value.push_back(Value(node_->elements[i], arena_).toShared());
+                }
+                return array;
+            }
+            case JsonType::STRING: return MedusaJSON::createString(std::string(asString()));
+            case JsonType::NUMBER: return MedusaJSON::createNumber(node_->number);
+            case JsonType::BOOLEAN: return MedusaJSON::createBoolean(node_->boolean);
+            case JsonType::NULL_VALUE: break;
+        }
+        return MedusaJSON::createNull();
+    }
+
+    Node* node() const { return node_; }
+
+private:
+    friend class Document;
+
+    Node* newNode(JsonType type) const {
+        Node* node = new (arena_->allocate(sizeof(Node), alignof(Node))) Node();
+        node->type = type;
+        return node;
+    }
+
+    Value makeString(std::string_view text) const {
+        Node* node = newNode(JsonType::STRING);
+        std::string_view stored = arena_->copy(text);
+        node->chars = stored.data();
+        node->size = static_cast<uint32_t>(stored.size());
+        return Value(node, arena_);
+    }
+
+    Value makeNumber(double number) const {
+        Node* node = newNode(JsonType::NUMBER);
+        node->number = number;
+        return Value(node, arena_);
+    }
+
+    Value makeBoolean(bool flag) const {
+        Node* node = newNode(JsonType::BOOLEAN);
+        node->boolean = flag;
+        return Value(node, arena_);
+    }
+
+    void appendMember(std::string_view key, Node* value) {
+        if (node_->size == node_->capacity) {
+            uint32_t capacity = node_->capacity ? node_->capacity * 2 : 4;
+            Member* members = arena_->allocateArray<Member>(capacity);
+            std::copy(node_->members, node_->members + node_->size, members);
+            node_->members = members;
+            node_->capacity = capacity;
+        }
+        node_->members[node_->size++] = Member{key, value};
+    }
+
+    Node* node_ = nullptr;
+    Arena* arena_ = nullptr;
+};
+
+/**
+ * @brief Owns the arena (and optionally the input text) behind a tree of Values
+ * @details Moving a Document keeps every Value handle valid. Not thread-safe:
+ *          build or mutate a document from one thread at a time.
+ */
+class Document {
+public:
+    Document() : state_(new State()) { state_->root = newNode(JsonType::NULL_VALUE); }
+
+    /**
+     * @brief Parse text that outlives the document (unescaped strings are views into it)
+     * @throws JSONParseException on malformed input
+     */
+    static Document parse(std::string_view text) {
+        Document document;
+        document.parseInto(text);
+        return document;
+    }
+
+    /**
+     * @brief Parse a C string that outlives the document (literals included)
+     * @details Without this, a literal is ambiguous between the two overloads around it.
+     */
+    static Document parse(const char* text) { return parse(std::string_view(text)); }
+
+    /**
+     * @brief Parse text the document takes ownership of
+     */
+    static Document parse(std::string&& text) {
+        Document document;
+        document.state_->owned_input = std::move(text);
+        document.parseInto(document.state_->owned_input);
+        return document;
+    }
+
+    Value root() const { return Value(state_->root, &state_->arena); }
+    void setRoot(Value value) {
+        if (value.node_) state_->root = value.node_;
+    }
+
+    Value createObject() { return Value(newNode(JsonType::OBJECT), &state_->arena); }
+    Value createArray() { return Value(newNode(JsonType::ARRAY), &state_->arena); }
+    Value createString(std::string_view text) { return root().makeString(text); }
+    Value createNumber(double number) { return root().makeNumber(number); }
+    Value createBoolean(bool flag) { return root().makeBoolean(flag); }
+    Value createNull() { return Value(newNode(JsonType::NULL_VALUE), &state_->arena); }
+
+    /**
+     * @brief String that refers to caller-owned text instead of copying it
+     */
+    Value createStringView(std::string_view text) {
+        Node* node = newNode(JsonType::STRING);
+        node->chars = text.data();
+        node->size = static_cast<uint32_t>(text.size());
+        return Value(node, &state_->arena);
+    }
+
+    /**
+     * @brief Deep copy a refcounted MedusaJSON tree into this document
+     */
+    Value import(const MedusaJSON& source) {
+        switch (source.type) {
+            case JsonType::OBJECT: {
+                Value object = createObject();
+                for (const auto& [key, child] : source.object_value) {
+                    if (child) object.set(key, import(*child));
+                }
+                return object;
+            }
+            case JsonType::ARRAY: {
+                Value array = createArray();
+                for (const auto& child : source.array_value) {
+                    if (child) array.push(import(*child));
+                }
+                return array;
+            }
+            case JsonType::STRING: return createString(source.string_value);
+            case JsonType::NUMBER: return createNumber(source.number_value);
+            case JsonType::BOOLEAN: return createBoolean(source.boolean_value);
+            case JsonType::NULL_VALUE: break;
+        }
+        return createNull();
+    }
+
+    std::string serialize() const { return root().serialize(); }
+    void serializeTo(std::string& out) const { root().serializeTo(out); }
+
+    // Drop every node but keep the arena's largest block for the next document
+    void clear() {
+        state_->arena.reset();
+        state_->owned_input.clear();
+        state_->root = newNode(JsonType::NULL_VALUE);
+    }
+
+    size_t arenaBytesUsed() const { return state_->arena.bytesUsed(); }
+    size_t arenaBytesReserved() const { return state_->arena.bytesReserved(); }
+
+private:
+    struct State {
+        Arena arena;
+        std::string owned_input;
+        Node* root = nullptr;
+    };
+
+    Node* newNode(JsonType type) {
+        Node* node = new (state_->arena.allocate(sizeof(Node), alignof(Node))) Node();
+        node->type = type;
+        return node;
+    }
+
+    void parseInto(std::string_view text) {
+        if (text.size() >= UINT32_MAX) {
+            throw JSONParseException("document too large");
+        }
+        // Index and scratch buffers are per thread and reused, so steady-state
+        // parsing allocates nothing outside the arena
+        thread_local std::vector<uint32_t> structural_index;
+        thread_local std::vector<Member> member_scratch;
+        thread_local std::vector<Node*> element_scratch;
+        member_scratch.clear();
+        element_scratch.clear();
+        if (!detail::buildStructuralIndex(text, structural_index)) {
+            throw JSONParseException("unterminated string");
+        }
+        detail::TreeBuilder builder(text, structural_index, state_->arena, member_scratch, element_scratch);
+        state_->root = builder.parseDocument();
+    }
+
+    std::unique_ptr<State> state_;
+};
+
+/**
+ * @brief Parse into the refcounted MedusaJSON type (arena parse, then deep copy)
+ */
+inline std::shared_ptr<MedusaJSON> parseMedusaJSON(std::string_view text) {
+    return Document::parse(text).root().toShared();
+}
+
+} // namespace MedusaJSONArena
+
+#endif // MEDUSA_JSON_ARENA_HPP
@@ -0,0 +1,187 @@
+/*
+ * MEDUSA JWT COMPILED PERMISSION MATRIX
+ * =====================================
+ *
+ * Immutable, integer-indexed form of the PermissionMatrix:
+ * - every permission and role gets a dense id at compile time
+ * - each role's grants become a bitset, so a check is one word test
+ * - a new matrix is compiled and swapped in on change; readers never lock
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace medusa {
+namespace portal {
+namespace jwt {
+
+using PermissionId = uint32_t;
+using RoleId = uint32_t;
+constexpr uint32_t kUnknownPermissionId = UINT32_MAX;
+// Matrix versions count up from 0 (the empty default); this one is never published
+constexpr uint64_t kUncompiledPermissionVersion = UINT64_MAX;
+
+/**
+ * @brief Dynamic bitset over PermissionIds
+ */
+class PermissionSet {
+public:
+    void set(PermissionId id) {
+        if (id == kUnknownPermissionId) return;
+        size_t word = id / 64;
+        if (word >= words_.size()) {
+            words_.resize(word + 1, 0);
+        }
+        words_[word] |= uint64_t(1) << (id % 64);
+    }
+
+    bool test(PermissionId id) const {
+        size_t word = id / 64;
+        return word < words_.size() && ((words_[word] >> (id % 64)) & 1);
+    }
+
+    // All of required's bits present
+    bool containsAll(const PermissionSet& required) const {
+        for (size_t i = 0; i < required.words_.size(); ++i) {
+            uint64_t have = i < words_.size() ? words_[i] : 0;
+            if ((required.words_[i] & ~have) != 0) return false;
+        }
+        return true;
+    }
+
+    bool intersects(const PermissionSet& other) const {
+        size_t common = words_.size() < other.words_.size() ? words_.size() : other.words_.size();
+        for (size_t i = 0; i < common; ++i) {
+            if (words_[i] & other.words_[i]) return true;
+        }
+        return false;
+    }
+
+    PermissionSet& operator|=(const PermissionSet& other) {
+        if (other.words_.size() > words_.size()) {
+            words_.resize(other.words_.size(), 0);
+        }
+        for (size_t i = 0; i < other.words_.size(); ++i) {
+            words_[i] |= other.words_[i];
+        }
+        return *this;
+    }
+
+    size_t count() const {
+        size_t total = 0;
+        for (uint64_t word : words_) {
+            total += static_cast<size_t>(__builtin_popcountll(word));
+        }
+        return total;
+    }
+
+    bool empty() const { return count() == 0; }
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+/**
+ * @brief Compiled role -> permission grants
+ */
+class CompiledPermissionMatrix {
+public:
+    /**
+     * @brief Compile from a PermissionMatrix-shaped source
+     * @details Grants come from both role_permissions and each Role's own
+     *          permissions list; ids referenced only by grants still get
+     *          an id so they can be checked.
+     */
+    template<typename Matrix>
+    static CompiledPermissionMatrix compile(const Matrix& matrix, uint64_t version) {
+        CompiledPermissionMatrix compiled;
+        compiled.version_ = version;
+        for (const auto& [permission_id, permission] : matrix.permissions) {
+            compiled.internPermission(permission_id);
+        }
+        for (const auto& [role_id, role] : matrix.roles) {
+            RoleId id = compiled.internRole(role_id);
+            compiled.role_levels_[id] = role.hierarchy_level;
+            for (const auto& permission : role.permissions) {
+                compiled.role_grants_[id].set(compiled.internPermission(permission.id));
+            }
+        }
+        for (const auto& [role_id, permission_ids] : matrix.role_permissions) {
+            RoleId id = compiled.internRole(role_id);
+            for (const auto& permission_id : permission_ids) {
+                compiled.role_grants_[id].set(compiled.internPermission(permission_id));
+            }
+        }
+        return compiled;
+    }
+
+    PermissionId permissionId(const std::string& permission) const {
+        auto it = permission_ids_.find(permission);
+        return it == permission_ids_.end() ? kUnknownPermissionId : it->second;
+    }
+
+    RoleId roleId(const std::string& role) const {
+        auto it = role_ids_.find(role);
+        return it == role_ids_.end() ? kUnknownPermissionId : it->second;
+    }
+
+    bool roleHas(RoleId role, PermissionId permission) const {
+        return role < role_grants_.size() && role_grants_[role].test(permission);
+    }
+
+    const PermissionSet& roleGrants(RoleId role) const {
+        static const PermissionSet kEmpty;
+        return role < role_grants_.size() ? role_grants_[role] : kEmpty;
+    }
+
+    int roleLevel(RoleId role) const {
+        return role < role_levels_.size() ? role_levels_[role] : 0;
+    }
+
+    /**
+     * @brief Bitset for a list of permission names; unknown names are ignored
+     */
+    template<typename Names>
+    PermissionSet toSet(const Names& names) const {
+        PermissionSet set;
+        for (const auto& name : names) {
+            set.set(permissionId(name));
+        }
+        return set;
+    }
+
+    uint64_t version() const { return version_; }
+    size_t permissionCount() const { return permission_ids_.size(); }
+    size_t roleCount() const { return role_ids_.size(); }
+
+private:
+    PermissionId internPermission(const std::string& permission) {
+        auto [it, inserted] = permission_ids_.emplace(permission, static_cast<PermissionId>(permission_ids_.size()));
+        return it->second;
+    }
+
+    RoleId internRole(const std::string& role) {
+        auto [it, inserted] = role_ids_.emplace(role, static_cast<RoleId>(role_ids_.size()));
+        if (inserted) {
+            role_grants_.emplace_back();
+            role_levels_.push_back(0);
+        }
+        return it->second;
+    }
+
+    uint64_t version_ = 0;
+    std::unordered_map<std::string, PermissionId> permission_ids_;
+    std::unordered_map<std::string, RoleId> role_ids_;
+    std::vector<PermissionSet> role_grants_;
+    std::vector<int> role_levels_;
+};
+
+} // namespace jwt
+} // namespace portal
+} // namespace medusa
@@ -45,10 +45,14 @@
 #pragma once
 
 #include "medusa_portal_authentication_system.hpp"
+#include "medusa_jwt_token_cache.hpp"
+#include "medusa_jwt_permission_bits.hpp"
+#include "medusa_jwt_session_store.hpp"
 #include <jwt-cpp/jwt.h>
 #include <openssl/hmac.h>
 #include <openssl/sha.h>
 #include <openssl/rand.h>
+#include <algorithm>
 #include <chrono>
 #include <string>
 #include <map>
@@ -56,6 +60,8 @@
 #include <memory>
 #include <atomic>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <future>
@@ -96,6 +102,10 @@ struct JWTConfig {
     bool enable_realtime_permission_validation = true;
     bool cache_permissions = true;
     std::chrono::seconds permission_cache_ttl{300};  // 5 minutes
+    
+    // Verified-token cache (skips signature + decode for repeat tokens)
+    bool enable_verified_token_cache = true;
+    size_t verified_token_cache_size = 65536;
 };
 
 // ========================================
@@ -167,6 +177,11 @@ struct SessionInfo {
     // Permission cache
     std::vector<std::string> cached_permissions;
     std::chrono::system_clock::time_point permissions_cached_at;
+    
+    // Role grants + cached_permissions + token permissions compiled against
+    // the permission matrix version they were built from (none yet for a new session)
+    PermissionSet effective_permissions;
+    uint64_t effective_permissions_version = kUncompiledPermissionVersion;
 };
 
 struct AuthenticationAttempt {
@@ -187,19 +202,30 @@ private:
     JWTConfig config_;
     std::shared_ptr<TriforceAuthenticationManager> auth_manager_;
     
-    // Session storage
-    std::unordered_map<std::string, SessionInfo> active_sessions_;
-    std::unordered_map<std::string, std::vector<std::string>> user_sessions_;  // user_id -> session_ids
-    mutable std::shared_mutex sessions_mutex_;
+    // Session storage: 64 independently locked shards, each expiring its own
+    // sessions from a timer wheel; user_id -> session_ids index kept alongside
+    ShardedSessionStore<SessionInfo> sessions_;
+    
+    // Batched, coalesced save_session_to_database / delete_session_from_database;
+    // started by the first persist_session*(), drained by session_writer_drain_
+    SessionWriteBehind<SessionInfo> session_writer_;
+    std::once_flag session_writer_started_;
     
-    // Permission system
+    // Permission system: permission_matrix_ is the editable source, compiled_permissions_
+    // the lock-free snapshot every check reads (republished on each change)
     PermissionMatrix permission_matrix_;
     mutable std::shared_mutex permissions_mutex_;
+    std::shared_ptr<const CompiledPermissionMatrix> compiled_permissions_ =
+        std::make_shared<const CompiledPermissionMatrix>();
+    std::atomic<uint64_t> permission_matrix_version_{0};
     
-    // Rate limiting and security
-    std::unordered_map<std::string, std::vector<AuthenticationAttempt>> auth_attempts_;  // ip -> attempts
+    // Tokens already verified, expiring at their exp claim
+    VerifiedTokenCache<JWTClaims> verified_tokens_{config_.verified_token_cache_size};
+    
+    // Rate limiting and security: per-IP windows and lockouts released by timer wheels
+    AuthAttemptThrottle<AuthenticationAttempt> auth_throttle_{
+        std::chrono::seconds(60), static_cast<size_t>(config_.max_auth_attempts_per_minute), config_.lockout_duration};
     std::unordered_set<std::string> blacklisted_tokens_;
-    std::unordered_map<std::string, std::chrono::system_clock::time_point> ip_lockouts_;
     mutable std::shared_mutex security_mutex_;
     
     // Background maintenance
@@ -212,12 +238,21 @@ private:
     std::atomic<uint64_t> tokens_rejected_{0};
     std::atomic<uint64_t> permissions_checked_{0};
     
+    // Declared last so it is destroyed first: flushes queued session writes
+    // while everything the writer's sink touches is still alive
+    struct SessionWriterDrain {
+        SessionWriteBehind<SessionInfo>& writer;
+        ~SessionWriterDrain() { writer.stop(); }
+    };
+    SessionWriterDrain session_writer_drain_{session_writer_};
+    
 public:
     JWTSessionManager(std::shared_ptr<TriforceAuthenticationManager> auth_manager, 
                      const JWTConfig& config = JWTConfig());
     ~JWTSessionManager();
     
-    // System lifecycle
+    // System lifecycle (shutdown drains the session write-behind thread
+    // before the database connection is released)
     bool initialize();
     void shutdown();
     
@@ -227,7 +262,35 @@ public:
     std::string generate_refresh_token(const std::string& session_id);
     
     // Token validation
-    bool validate_access_token(const std::string& token, JWTClaims& claims);
+    /**
+     * Cached tokens return their verified claims without re-decoding; a miss
+     * runs the full parse + signature check and remembers the result until exp.
+     * A hit whose session is no longer active takes the full path again.
+     */
+    bool validate_access_token(const std::string& token, JWTClaims& claims) {
+        auto now = std::chrono::system_clock::now();
+        if (config_.enable_verified_token_cache) {
+            if (auto cached = verified_tokens_.find(token, now)) {
+                if (cached->session_id.empty() || is_session_active(cached->session_id)) {
+                    claims = *cached;
+                    tokens_validated_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        
+        uint64_t epoch = verified_tokens_.epoch();
+        if (is_token_blacklisted(token) || !parse_jwt_token(token, claims) || claims.expires_at <= now) {
+            tokens_rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        if (config_.enable_verified_token_cache) {
+            verified_tokens_.insert(token, std::make_shared<const JWTClaims>(claims), claims.expires_at, epoch);
+        }
+        tokens_validated_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
     bool validate_refresh_token(const std::string& refresh_token, std::string& session_id);
     bool validate_session(const std::string& session_id, SessionInfo& session_info);
     
@@ -239,38 +302,170 @@ public:
     bool invalidate_session(const std::string& session_id);
     bool invalidate_all_user_sessions(const std::string& user_id);
     
-    // Permission validation
-    bool check_permission(const std::string& session_id, const std::string& permission);
-    bool check_permissions(const std::string& session_id, const std::vector<std::string>& permissions);
+    // Permission validation (bitset tests against the compiled matrix)
+    bool check_permission(const std::string& session_id, const std::string& permission) {
+        return check_permission(session_id, resolve_permission_id(permission));
+    }
+    
+    bool check_permission(const std::string& session_id, PermissionId permission) {
+        permissions_checked_.fetch_add(1, std::memory_order_relaxed);
+        if (permission == kUnknownPermissionId) {
+            return false;
+        }
+        return with_session_permissions(session_id, [permission](const PermissionSet& granted) {
+            return granted.test(permission);
+        });
+    }
+    
+    bool check_permissions(const std::string& session_id, const std::vector<std::string>& permissions) {
+        permissions_checked_.fetch_add(1, std::memory_order_relaxed);
+        auto matrix = std::atomic_load(&compiled_permissions_);
+        PermissionSet required;
+        for (const auto& permission : permissions) {
+            PermissionId id = matrix->permissionId(permission);
+            if (id == kUnknownPermissionId) {
+                return false;
+            }
+            required.set(id);
+        }
+        return with_session_permissions(session_id, [&required](const PermissionSet& granted) {
+            return granted.containsAll(required);
+        });
+    }
+    
+    /**
+     * Resolve a permission name once (e.g. at route registration) for the id overload
+     */
+    PermissionId resolve_permission_id(const std::string& permission) const {
+        return std::atomic_load(&compiled_permissions_)->permissionId(permission);
+    }
     bool check_role_access(const std::string& session_id, const std::string& required_role);
     std::vector<std::string> get_user_permissions(const std::string& session_id);
     
     // Permission matrix management
     bool load_permission_matrix();
-    bool update_permission_matrix(const PermissionMatrix& matrix);
-    PermissionMatrix get_permission_matrix() const;
-    bool add_permission_to_role(const std::string& role_id, const std::string& permission_id);
-    bool remove_permission_from_role(const std::string& role_id, const std::string& permission_id);
+    
+    bool update_permission_matrix(const PermissionMatrix& matrix) {
+        std::unique_lock<std::shared_mutex> lock(permissions_mutex_);
+        permission_matrix_ = matrix;
+        permission_matrix_.last_updated = std::chrono::system_clock::now();
+        publish_permission_matrix();
+        return true;
+    }
+    
+    PermissionMatrix get_permission_matrix() const {
+        std::shared_lock<std::shared_mutex> lock(permissions_mutex_);
+        return permission_matrix_;
+    }
+    
+    bool add_permission_to_role(const std::string& role_id, const std::string& permission_id) {
+        std::unique_lock<std::shared_mutex> lock(permissions_mutex_);
+        auto& granted = permission_matrix_.role_permissions[role_id];
+        if (std::find(granted.begin(), granted.end(), permission_id) != granted.end()) {
+            return false;
+        }
+        granted.push_back(permission_id);
+        permission_matrix_.last_updated = std::chrono::system_clock::now();
+        publish_permission_matrix();
+        return true;
+    }
+    
+    bool remove_permission_from_role(const std::string& role_id, const std::string& permission_id) {
+        std::unique_lock<std::shared_mutex> lock(permissions_mutex_);
+        auto role = permission_matrix_.role_permissions.find(role_id);
+        if (role == permission_matrix_.role_permissions.end()) {
+            return false;
+        }
+        auto& granted = role->second;
+        auto it = std::find(granted.begin(), granted.end(), permission_id);
+        if (it == granted.end()) {
+            return false;
+        }
+        granted.erase(it);
+        permission_matrix_.last_updated = std::chrono::system_clock::now();
+        publish_permission_matrix();
+        return true;
+    }
     
     // Security features
-    bool is_ip_rate_limited(const std::string& ip_address);
+    bool is_ip_rate_limited(const std::string& ip_address) {
+        return auth_throttle_.isLocked(ip_address);
+    }
+    
     bool is_user_rate_limited(const std::string& username);
+    
     void record_authentication_attempt(const std::string& ip_address, const std::string& username, 
-                                     bool success, const std::string& failure_reason = "");
-    void blacklist_token(const std::string& token);
-    bool is_token_blacklisted(const std::string& token) const;
+                                     bool success, const std::string& failure_reason = "") {
+        AuthenticationAttempt attempt;
+        attempt.ip_address = ip_address;
+        attempt.username = username;
+        attempt.timestamp = std::chrono::system_clock::now();
+        attempt.success = success;
+        attempt.failure_reason = failure_reason;
+        auth_throttle_.record(ip_address, std::move(attempt));
+    }
+    
+    void blacklist_token(const std::string& token) {
+        {
+            std::unique_lock<std::shared_mutex> lock(security_mutex_);
+            blacklisted_tokens_.insert(token);
+        }
+        verified_tokens_.invalidate(token);
+    }
+    
+    bool is_token_blacklisted(const std::string& token) const {
+        std::shared_lock<std::shared_mutex> lock(security_mutex_);
+        return blacklisted_tokens_.count(token) > 0;
+    }
     
     // Session information
     std::vector<SessionInfo> get_user_sessions(const std::string& user_id);
     std::vector<SessionInfo> get_active_sessions();
     SessionInfo get_session_info(const std::string& session_id);
-    int get_active_session_count() const;
+    int get_active_session_count() const {
+        return static_cast<int>(sessions_.size());
+    }
     
     // Administrative functions
     bool force_logout_user(const std::string& user_id);
     bool force_logout_session(const std::string& session_id);
-    void cleanup_expired_sessions();
-    void cleanup_old_auth_attempts();
+    
+    /**
+     * Advance the session expiry wheels; only sessions actually due are
+     * touched, one shard lock at a time, so validators are never blocked by
+     * a full sweep. Expired sessions are removed from the database too.
+     */
+    void cleanup_expired_sessions() {
+        sessions_.expire(std::chrono::system_clock::now(), [this](const SessionInfo& session) {
+            persist_session_removal(session.session_id);
+        });
+    }
+    
+    void cleanup_old_auth_attempts() {
+        auth_throttle_.expire(std::chrono::system_clock::now());
+    }
+    
+    /**
+     * Queue a session for persistence; saves within one flush interval
+     * coalesce to the latest state and reach the database in one batch.
+     * When the queue is full (or already shut down) the write happens here,
+     * after flushing, so it cannot be overtaken by an older queued write.
+     */
+    void persist_session(const SessionInfo& session) {
+        start_session_writer();
+        if (!session_writer_.save(session)) {
+            session_writer_.flush();
+            save_session_to_database(session);
+        }
+    }
+    
+    void persist_session_removal(const std::string& session_id) {
+        start_session_writer();
+        if (!session_writer_.remove(session_id)) {
+            session_writer_.flush();
+            delete_session_from_database(session_id);
+        }
+    }
     
     // Metrics and monitoring
     struct JWTMetrics {
@@ -292,6 +487,24 @@ private:
     std::string generate_secure_random(size_t length = 32);
     std::string generate_device_fingerprint(const std::string& user_agent, const std::string& ip);
     
+    /**
+     * Start the write-behind thread once, on first use; shutdown() calls
+     * stop(), which drains the queue, and later writes go straight through
+     */
+    void start_session_writer() {
+        std::call_once(session_writer_started_, [this] {
+            session_writer_.start([this](std::vector<SessionWriteBehind<SessionInfo>::Write>& batch) {
+                for (auto& write : batch) {
+                    if (write.remove) {
+                        delete_session_from_database(write.session_id);
+                    } else {
+                        save_session_to_database(write.session);
+                    }
+                }
+            });
+        });
+    }
+    
     // Database operations
     bool save_session_to_database(const SessionInfo& session);
     bool load_session_from_database(const std::string& session_id, SessionInfo& session);
@@ -300,6 +513,59 @@ private:
     bool save_auth_attempt_to_database(const AuthenticationAttempt& attempt);
     
     // Permission system operations
+    /**
+     * Compile permission_matrix_ and swap it in; caller holds permissions_mutex_.
+     * load_permission_matrix() finishes by calling this as well.
+     */
+    void publish_permission_matrix() {
+        uint64_t version = permission_matrix_version_.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto compiled = std::make_shared<const CompiledPermissionMatrix>(
+            CompiledPermissionMatrix::compile(permission_matrix_, version));
+        std::atomic_store(&compiled_permissions_, std::move(compiled));
+    }
+    
+    /**
+     * Run test against a session's effective permission bits, recompiling them
+     * only when the matrix changed since they were last built
+     */
+    template<typename Test>
+    bool with_session_permissions(const std::string& session_id, Test&& test) {
+        auto matrix = std::atomic_load(&compiled_permissions_);
+        bool current = false;
+        bool allowed = false;
+        if (!sessions_.read(session_id, [&](const SessionInfo& session) {
+                if (session.is_active && session.effective_permissions_version == matrix->version()) {
+                    current = true;
+                    allowed = test(session.effective_permissions);
+                }
+            })) {
+            return false;
+        }
+        if (current) {
+            return allowed;
+        }
+        
+        sessions_.update(session_id, [&](SessionInfo& session) {
+            if (!session.is_active) {
+                allowed = false;
+                return;
+            }
+            PermissionSet bits = matrix->roleGrants(matrix->roleId(session.claims.role_id));
+            bits |= matrix->toSet(session.claims.permissions);
+            bits |= matrix->toSet(session.cached_permissions);
+            session.effective_permissions = std::move(bits);
+            session.effective_permissions_version = matrix->version();
+            allowed = test(session.effective_permissions);
+        });
+        return allowed;
+    }
+    
+    bool is_session_active(const std::string& session_id) const {
+        bool active = false;
+        sessions_.read(session_id, [&](const SessionInfo& session) { active = session.is_active; });
+        return active;
+    }
+    
     bool load_permissions_from_database();
     bool load_roles_from_database();
     bool load_role_permissions_from_database();
@@ -0,0 +1,568 @@
+/*
+ * MEDUSA JWT SESSION STORE
+ * ========================
+ *
+ * Sharded in-memory state behind JWTSessionManager:
+ * - ShardedSessionStore: sessions split across independently locked shards,
+ *   each with its own hierarchical timer wheel, so expiry work is
+ *   proportional to what is actually due and never stalls other shards
+ * - AuthAttemptThrottle: per-IP attempt windows and lockouts, released by
+ *   the same kind of wheel instead of periodic full sweeps
+ * - SessionWriteBehind: coalescing queue that batches session persistence
+ *   onto a background thread, off the request path
+ */
+
+#pragma once
+
+#include "medusaserv_timer_wheel.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace medusa {
+namespace portal {
+namespace jwt {
+
+using WallClockWheelKey = std::pair<std::string, uint64_t>;  // (id, generation)
+template<typename Key>
+using WallClockWheel = MedusaServ::HierarchicalTimerWheel<Key, std::chrono::system_clock>;
+
+/**
+ * @brief Session table sharded by session id
+ * @details Session needs `session_id`, `user_id` and `expires_at`
+ *          (system_clock). Each shard owns a timer wheel; rescheduling bumps
+ *          the entry's generation so earlier wheel entries are ignored.
+ */
+template<typename Session>
+class ShardedSessionStore {
+public:
+    static constexpr size_t kShards = 64;
+    using Clock = std::chrono::system_clock;
+
+    ShardedSessionStore() {
+        for (auto& shard : shards_) {
+            shard.reset(new Shard());
+        }
+        for (auto& shard : user_shards_) {
+            shard.reset(new UserShard());
+        }
+    }
+
+    /**
+     * @brief Insert or replace a session and schedule its expiry
+     */
+    void insert(Session session) {
+        std::string id = session.session_id;
+        std::string user_id = session.user_id;
+        Clock::time_point expires_at = session.expires_at;
+        bool added;
+        {
+            Shard& shard = shardFor(id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto [it, inserted] = shard.sessions.try_emplace(id);
+            added = inserted;
+            it->second.session = std::move(session);
+            it->second.generation = ++shard.next_generation;
+            shard.expiry.schedule(WallClockWheelKey{id, it->second.generation}, expires_at);
+        }
+        if (added) {
+            size_.fetch_add(1, std::memory_order_relaxed);
+            UserShard& users = userShardFor(user_id);
+            std::lock_guard<std::mutex> lock(users.mutex);
+            users.sessions[user_id].push_back(id);
+        }
+    }
+
+    /**
+     * @brief Call read(const Session&) under the shard's shared lock
+     */
+    template<typename Read>
+    bool read(const std::string& id, Read&& read) const {
+        const Shard& shard = shardFor(id);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.sessions.find(id);
+        if (it == shard.sessions.end()) {
+            return false;
+        }
+        read(it->second.session);
+        return true;
+    }
+
+    bool find(const std::string& id, Session& out) const {
+        return read(id, [&out](const Session& session) { out = session; });
+    }
+
+    bool contains(const std::string& id) const {
+        return read(id, [](const Session&) {});
+    }
+
+    /**
+     * @brief Call update(Session&) under the shard's exclusive lock
+     * @details A changed expires_at is rescheduled automatically.
+     */
+    template<typename Update>
+    bool update(const std::string& id, Update&& update) {
+        Shard& shard = shardFor(id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.sessions.find(id);
+        if (it == shard.sessions.end()) {
+            return false;
+        }
+        Clock::time_point before = it->second.session.expires_at;
+        update(it->second.session);
+        if (it->second.session.expires_at != before) {
+            it->second.generation = ++shard.next_generation;
+            shard.expiry.schedule(WallClockWheelKey{id, it->second.generation}, it->second.session.expires_at);
+        }
+        return true;
+    }
+
+    bool erase(const std::string& id) {
+        std::string user_id;
+        {
+            Shard& shard = shardFor(id);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.sessions.find(id);
+            if (it == shard.sessions.end()) {
+                return false;
+            }
+            user_id = it->second.session.user_id;
+            shard.sessions.erase(it);  // its wheel entry is dropped when it fires
+        }
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        forgetUserSession(user_id, id);
+        return true;
+    }
+
+    std::vector<std::string> sessionsForUser(const std::string& user_id) const {
+        const UserShard& users = userShardFor(user_id);
+        std::lock_guard<std::mutex> lock(users.mutex);
+        auto it = users.sessions.find(user_id);
+        return it == users.sessions.end() ? std::vector<std::string>() : it->second;
+    }
+
+    size_t eraseUser(const std::string& user_id) {
+        size_t removed = 0;
+        for (const auto& id : sessionsForUser(user_id)) {
+            removed += erase(id) ? 1 : 0;
+        }
+        return removed;
+    }
+
+    /**
+     * @brief Visit every session (shard by shard, shared locks)
+     */
+    template<typename Visit>
+    void forEach(Visit&& visit) const {
+        for (const auto& shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard->mutex);
+            for (const auto& [id, entry] : shard->sessions) {
+                visit(entry.session);
+            }
+        }
+    }
+
+    /**
+     * @brief Drop sessions whose expiry has come due, calling on_expired for each
+     * @details Each shard is locked only while its own wheel advances, and the
+     *          wheel only visits due entries, so this never sweeps the table.
+     */
+    template<typename OnExpired>
+    size_t expire(Clock::time_point now, OnExpired&& on_expired) {
+        size_t expired = 0;
+        std::vector<Session> removed;
+        for (auto& shard : shards_) {
+            {
+                std::unique_lock<std::shared_mutex> lock(shard->mutex);
+                if (now < shard->expiry.nextTick()) {
+                    continue;
+                }
+                shard->expiry.advance(now, [&](const WallClockWheelKey& key) {
+                    auto it = shard->sessions.find(key.first);
+                    if (it != shard->sessions.end() && it->second.generation == key.second) {
+                        removed.push_back(std::move(it->second.session));
+                        shard->sessions.erase(it);
+                    }
+                });
+            }
+            for (auto& session : removed) {
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                forgetUserSession(session.user_id, session.session_id);
+                on_expired(session);
+                ++expired;
+            }
+            removed.clear();
+        }
+        return expired;
+    }
+
+    size_t expire(Clock::time_point now = Clock::now()) {
+        return expire(now, [](const Session&) {});
+    }
+
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        Session session;
+        uint64_t generation = 0;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, Entry> sessions;
+        WallClockWheel<WallClockWheelKey> expiry{std::chrono::seconds(1)};
+        uint64_t next_generation = 0;
+    };
+
+    struct UserShard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, std::vector<std::string>> sessions;
+    };
+
+    Shard& shardFor(const std::string& id) { return *shards_[std::hash<std::string>{}(id) % kShards]; }
+    const Shard& shardFor(const std::string& id) const { return *shards_[std::hash<std::string>{}(id) % kShards]; }
+    UserShard& userShardFor(const std::string& id) { return *user_shards_[std::hash<std::string>{}(id) % kShards]; }
+    const UserShard& userShardFor(const std::string& id) const {
+        return *user_shards_[std::hash<std::string>{}(id) % kShards];
+    }
+
+    void forgetUserSession(const std::string& user_id, const std::string& session_id) {
+        UserShard& users = userShardFor(user_id);
+        std::lock_guard<std::mutex> lock(users.mutex);
+        auto it = users.sessions.find(user_id);
+        if (it == users.sessions.end()) {
+            return;
+        }
+        auto& ids = it->second;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] == session_id) {
+                ids[i] = std::move(ids.back());
+                ids.pop_back();
+                break;
+            }
+        }
+        if (ids.empty()) {
+            users.sessions.erase(it);
+        }
+    }
+
+    std::array<std::unique_ptr<Shard>, kShards> shards_;
+    std::array<std::unique_ptr<UserShard>, kShards> user_shards_;
+    std::atomic<size_t> size_{0};
+};
+
+/**
+ * @brief Per-IP authentication attempt windows and lockouts
+ * @details Attempt is stored as-is (AuthenticationAttempt); only its
+ *          `timestamp` and `success` fields are interpreted. Windows are
+ *          trimmed, and lockouts released, by per-shard timer wheels.
+ */
+template<typename Attempt>
+class AuthAttemptThrottle {
+public:
+    static constexpr size_t kShards = 32;
+    using Clock = std::chrono::system_clock;
+
+    AuthAttemptThrottle(std::chrono::seconds window, size_t max_failures, std::chrono::seconds lockout)
+        : window_(window), max_failures_(max_failures ? max_failures : 1), lockout_(lockout) {
+        for (auto& shard : shards_) {
+            shard.reset(new Shard());
+        }
+    }
+
+    /**
+     * @brief Record an attempt; returns true if the IP is (now) locked out
+     */
+    bool record(const std::string& ip, Attempt attempt) {
+        Shard& shard = shardFor(ip);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Clock::time_point now = attempt.timestamp;
+        State& state = shard.ips[ip];
+        trim(state, now);
+        bool failed = !attempt.success;
+        state.attempts.push_back(std::move(attempt));
+        shard.wheel.schedule(WallClockWheelKey{ip, 0}, now + window_);
+        if (failed && ++state.failures >= max_failures_ && state.locked_until <= now) {
+            state.locked_until = now + lockout_;
+            shard.wheel.schedule(WallClockWheelKey{ip, 0}, state.locked_until);
+        }
+        return state.locked_until > now;
+    }
+
+    bool isLocked(const std::string& ip, Clock::time_point now = Clock::now()) const {
+        const Shard& shard = shardFor(ip);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ips.find(ip);
+        return it != shard.ips.end() && it->second.locked_until > now;
+    }
+
+    std::vector<Attempt> recentAttempts(const std::string& ip) const {
+        const Shard& shard = shardFor(ip);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ips.find(ip);
+        return it == shard.ips.end() ? std::vector<Attempt>()
+                                     : std::vector<Attempt>(it->second.attempts.begin(), it->second.attempts.end());
+    }
+
+    void unlock(const std::string& ip) {
+        Shard& shard = shardFor(ip);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.ips.find(ip);
+        if (it != shard.ips.end()) {
+            it->second.locked_until = Clock::time_point();
+            it->second.failures = 0;
+        }
+    }
+
+    /**
+     * @brief Trim windows and release lockouts that have come due
+     */
+    size_t expire(Clock::time_point now = Clock::now()) {
+        size_t released = 0;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            if (now < shard->wheel.nextTick()) {
+                continue;
+            }
+            shard->wheel.advance(now, [&](const WallClockWheelKey& key) {
+                auto it = shard->ips.find(key.first);
+                if (it == shard->ips.end()) {
+                    return;
+                }
+                trim(it->second, now);
+                if (it->second.attempts.empty() && it->second.locked_until <= now) {
+                    shard->ips.erase(it);
+                    ++released;
+                }
+            });
+        }
+        return released;
+    }
+
+    size_t trackedAddresses() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            total += shard->ips.size();
+        }
+        return total;
+    }
+
+private:
+    struct State {
+        std::deque<Attempt> attempts;
+        size_t failures = 0;
+        Clock::time_point locked_until;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, State> ips;
+        WallClockWheel<WallClockWheelKey> wheel{std::chrono::seconds(1)};
+    };
+
+    void trim(State& state, Clock::time_point now) const {
+        while (!state.attempts.empty() && state.attempts.front().timestamp + window_ <= now) {
+            if (!state.attempts.front().success && state.failures > 0) {
+                --state.failures;
+            }
+            state.attempts.pop_front();
+        }
+        if (state.locked_until != Clock::time_point() && state.locked_until <= now) {
+            state.locked_until = Clock::time_point();
+            state.failures = 0;
+        }
+    }
+
+    Shard& shardFor(const std::string& ip) { return *shards_[std::hash<std::string>{}(ip) % kShards]; }
+    const Shard& shardFor(const std::string& ip) const { return *shards_[std::hash<std::string>{}(ip) % kShards]; }
+
+    std::chrono::seconds window_;
+    size_t max_failures_;
+    std::chrono::seconds lockout_;
+    std::array<std::unique_ptr<Shard>, kShards> shards_;
+};
+
+/**
+ * @brief Coalescing write-behind queue for session persistence
+ * @details Repeated saves of one session inside a flush interval collapse
+ *          to its latest state, and a delete supersedes pending saves. The
+ *          sink receives whole batches on the writer thread. At most
+ *          max_pending distinct sessions wait; save()/remove() return false
+ *          when a write was not queued (full, or not running) and the caller
+ *          must write it itself.
+ */
+template<typename Session>
+class SessionWriteBehind {
+public:
+    struct Write {
+        std::string session_id;
+        bool remove = false;
+        Session session;
+    };
+    using Sink = std::function<void(std::vector<Write>&)>;
+
+    explicit SessionWriteBehind(size_t max_batch = 256,
+                                std::chrono::milliseconds interval = std::chrono::milliseconds(50),
+                                size_t max_pending = 65536)
+        : max_batch_(max_batch ? max_batch : 1), interval_(interval),
+          max_pending_(std::max(max_pending, max_batch_)) {}
+
+    ~SessionWriteBehind() { stop(); }
+
+    SessionWriteBehind(const SessionWriteBehind&) = delete;
+    SessionWriteBehind& operator=(const SessionWriteBehind&) = delete;
+
+    void start(Sink sink) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            return;
+        }
+        sink_ = std::move(sink);
+        running_ = true;
+        worker_ = std::thread([this] { run(); });
+    }
+
+    // Flushes everything still queued before returning
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+            running_ = false;
+        }
+        wake_.notify_all();
+        if (worker_.joinable()) {
+            worker_.join();
+        }
+    }
+
+    bool save(const Session& session) { return enqueue(Write{session.session_id, false, session}); }
+    bool remove(const std::string& session_id) { return enqueue(Write{session_id, true, Session()}); }
+
+    /**
+     * @brief Hand the current batch to the sink now (blocks until written)
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!running_) {
+            drainLocked(lock);
+            return;
+        }
+        uint64_t target = enqueued_generation_;
+        flush_requested_ = true;
+        wake_.notify_all();
+        flushed_.wait(lock, [&] { return flushed_generation_ >= target || !running_; });
+    }
+
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return pending_.size();
+    }
+
+    uint64_t batchesWritten() const { return batches_written_.load(std::memory_order_relaxed); }
+    uint64_t writesCoalesced() const { return writes_coalesced_.load(std::memory_order_relaxed); }
+    uint64_t writesRejected() const { return writes_rejected_.load(std::memory_order_relaxed); }
+
+private:
+    bool enqueue(Write write) {
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return false;
+            }
+            auto it = index_.find(write.session_id);
+            if (it != index_.end()) {
+                pending_[it->second] = std::move(write);
+                writes_coalesced_.fetch_add(1, std::memory_order_relaxed);
+            } else if (pending_.size() >= max_pending_) {
+                writes_rejected_.fetch_add(1, std::memory_order_relaxed);
+                wake_.notify_one();
+                return false;
+            } else {
+                index_.emplace(write.session_id, pending_.size());
+                pending_.push_back(std::move(write));
+            }
+            ++enqueued_generation_;
+            wake = pending_.size() >= max_batch_;
+        }
+        if (wake) {
+            wake_.notify_one();
+        }
+        return true;
+    }
+
+    // Called with mutex_ held; releases it while the sink runs
+    void drainLocked(std::unique_lock<std::mutex>& lock) {
+        if (pending_.empty()) {
+            flushed_generation_ = enqueued_generation_;
+            return;
+        }
+        std::vector<Write> batch;
+        batch.swap(pending_);
+        index_.clear();
+        uint64_t generation = enqueued_generation_;
+        Sink sink = sink_;
+        lock.unlock();
+        if (sink) {
+            sink(batch);
+        }
+        batches_written_.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+        flushed_generation_ = std::max(flushed_generation_, generation);
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            wake_.wait_for(lock, interval_, [&] {
+                return !running_ || flush_requested_ || pending_.size() >= max_batch_;
+            });
+            flush_requested_ = false;
+            drainLocked(lock);
+            flushed_.notify_all();
+        }
+        drainLocked(lock);
+        flushed_.notify_all();
+    }
+
+    size_t max_batch_;
+    std::chrono::milliseconds interval_;
+    size_t max_pending_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable flushed_;
+    std::vector<Write> pending_;
+    std::unordered_map<std::string, size_t> index_;
+    Sink sink_;
+    std::thread worker_;
+    bool running_ = false;
+    bool flush_requested_ = false;
+    uint64_t enqueued_generation_ = 0;
+    uint64_t flushed_generation_ = 0;
+    std::atomic<uint64_t> batches_written_{0};
+    std::atomic<uint64_t> writes_coalesced_{0};
+    std::atomic<uint64_t> writes_rejected_{0};
+};
+
+} // namespace jwt
+} // namespace portal
+} // namespace medusa
@@ -0,0 +1,213 @@
+/*
+ * MEDUSA JWT VERIFIED-TOKEN CACHE
+ * ===============================
+ *
+ * Remembers tokens whose signature and claims have already been verified so
+ * repeat requests with the same bearer token skip base64 + HMAC + JSON work.
+ *
+ * - Sharded by token hash; a hit also compares the full token, so a hash
+ *   collision can never hand one token another token's claims
+ * - Entries expire at the token's own `exp` and are bounded per shard
+ * - Invalidation bumps an epoch, so a verification that raced with
+ *   blacklisting cannot re-insert the token afterwards
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace medusa {
+namespace portal {
+namespace jwt {
+
+template<typename Claims>
+class VerifiedTokenCache {
+public:
+    static constexpr size_t kShards = 16;
+    using Clock = std::chrono::system_clock;
+
+    explicit VerifiedTokenCache(size_t capacity = 65536)
+        : shard_capacity_(capacity / kShards ? capacity / kShards : 1) {}
+
+    /**
+     * @brief Epoch to capture before verifying a token and pass to insert()
+     */
+    uint64_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Verified claims for token, or nullptr if absent or past exp
+     */
+    std::shared_ptr<const Claims> find(std::string_view token, Clock::time_point now = Clock::now()) const {
+        uint64_t hash = hashToken(token);
+        const Shard& shard = shardFor(hash);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(hash);
+        if (it == shard.entries.end() || it->second.token != token || now >= it->second.expires_at) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second.claims;
+    }
+
+    /**
+     * @brief Remember a verified token until expires_at
+     * @return false if an invalidation happened since verified_at_epoch
+     */
+    bool insert(const std::string& token, std::shared_ptr<const Claims> claims,
+                Clock::time_point expires_at, uint64_t verified_at_epoch) {
+        uint64_t hash = hashToken(token);
+        Shard& shard = shardFor(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // Checked under the shard lock: invalidate() bumps the epoch before taking it
+        if (epoch_.load(std::memory_order_acquire) != verified_at_epoch) {
+            return false;
+        }
+        auto [it, inserted] = shard.entries.try_emplace(hash);
+        it->second = Entry{token, std::move(claims), expires_at};
+        if (inserted) {
+            shard.order.push_back(hash);
+            evictOverflow(shard);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Drop one token (blacklisting, logout)
+     */
+    void invalidate(std::string_view token) {
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+        uint64_t hash = hashToken(token);
+        Shard& shard = shardFor(hash);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.entries.find(hash);
+        if (it != shard.entries.end() && it->second.token == token) {
+            shard.entries.erase(it);
+        }
+    }
+
+    /**
+     * @brief Drop every token whose claims match (session or user revocation)
+     */
+    size_t invalidateIf(const std::function<bool(const Claims&)>& predicate) {
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+        size_t removed = 0;
+        for (auto& shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (predicate(*it->second.claims)) {
+                    it = shard.entries.erase(it);
+                    ++removed;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        return removed;
+    }
+
+    void clear() {
+        epoch_.fetch_add(1, std::memory_order_acq_rel);
+        for (auto& shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.entries.clear();
+            shard.order.clear();
+        }
+    }
+
+    /**
+     * @brief Remove entries past exp (maintenance thread)
+     */
+    size_t purgeExpired(Clock::time_point now = Clock::now()) {
+        size_t removed = 0;
+        for (auto& shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (now >= it->second.expires_at) {
+                    it = shard.entries.erase(it);
+                    ++removed;
+                } else {
+                    ++it;
+                }
+            }
+            compactOrder(shard);
+        }
+        return removed;
+    }
+
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            total += shard.entries.size();
+        }
+        return total;
+    }
+
+    uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+    uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+
+private:
+    struct Entry {
+        std::string token;
+        std::shared_ptr<const Claims> claims;
+        Clock::time_point expires_at;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<uint64_t, Entry> entries;
+        std::deque<uint64_t> order;  // insertion order for FIFO eviction
+    };
+
+    static uint64_t hashToken(std::string_view token) {
+        // Tokens end in an HMAC, so their tail bytes are already uniformly distributed
+        return static_cast<uint64_t>(std::hash<std::string_view>{}(token));
+    }
+
+    Shard& shardFor(uint64_t hash) { return shards_[(hash >> 56) % kShards]; }
+    const Shard& shardFor(uint64_t hash) const { return shards_[(hash >> 56) % kShards]; }
+
+    void evictOverflow(Shard& shard) {
+        while (shard.entries.size() > shard_capacity_ && !shard.order.empty()) {
+            shard.entries.erase(shard.order.front());
+            shard.order.pop_front();
+        }
+        if (shard.order.size() > shard_capacity_ * 2) {
+            compactOrder(shard);
+        }
+    }
+
+    // Forget order slots whose entries were erased by invalidation or expiry
+    void compactOrder(Shard& shard) {
+        std::deque<uint64_t> live;
+        for (uint64_t hash : shard.order) {
+            if (shard.entries.count(hash)) {
+                live.push_back(hash);
+            }
+        }
+        shard.order.swap(live);
+    }
+
+    size_t shard_capacity_;
+    std::array<Shard, kShards> shards_;
+    std::atomic<uint64_t> epoch_{0};
+    mutable std::atomic<uint64_t> hits_{0};
+    mutable std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace jwt
+} // namespace portal
+} // namespace medusa
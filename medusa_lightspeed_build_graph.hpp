@@ -0,0 +1,862 @@
+/*
+ * MEDUSA LIGHTSPEED BUILD GRAPH
+ * Incremental builds for the ParallelBuildExecutor
+ * - BuildGraph: tasks declare inputs/outputs; edges come from who produces
+ *   what, plus explicit ordering
+ * - BuildArtifactCache: xxHash64 content hashes, a stat cache so unchanged
+ *   files are not re-read, and a content-addressed store of outputs under
+ *   .medusa/build
+ * - WorkStealingPool: per-worker queues ordered by critical-path length
+ * - runBuildGraph: skips tasks whose input hashes match the last build,
+ *   restores outputs seen before from the store, runs only what is left
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace MedusaLightspeed {
+namespace Engine {
+
+/**
+ * xxHash64, streaming
+ * Not cryptographic: it identifies build content, it does not defend against it
+ */
+class ContentHasher {
+public:
+    explicit ContentHasher(uint64_t seed = 0) : seed_(seed) {
+        acc_[0] = seed + kPrime1 + kPrime2;
+        acc_[1] = seed + kPrime2;
+        acc_[2] = seed;
+        acc_[3] = seed - kPrime1;
+    }
+
+    ContentHasher& update(const void* data, size_t length) {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        total_ += length;
+        if (buffered_ + length < 32) {
+            std::memcpy(buffer_ + buffered_, p, length);
+            buffered_ += length;
+            return *this;
+        }
+        if (buffered_) {
+            size_t fill = 32 - buffered_;
+            std::memcpy(buffer_ + buffered_, p, fill);
+            stripe(buffer_);
+            p += fill;
+            length -= fill;
+            buffered_ = 0;
+        }
+        for (; length >= 32; p += 32, length -= 32) {
+            stripe(p);
+        }
+        std::memcpy(buffer_, p, length);
+        buffered_ = length;
+        return *this;
+    }
+
+    ContentHasher& update(std::string_view text) { return update(text.data(), text.size()); }
+
+    // Length-prefixed, so ("ab","c") and ("a","bc") differ
+    ContentHasher& field(std::string_view text) {
+        uint64_t size = text.size();
+        update(&size, sizeof(size));
+        return update(text);
+    }
+
+    uint64_t digest() const {
+        uint64_t h;
+        if (total_ >= 32) {
+            h = rotl(acc_[0], 1) + rotl(acc_[1], 7) + rotl(acc_[2], 12) + rotl(acc_[3], 18);
+            for (uint64_t acc : acc_) {
+                h ^= round(0, acc);
+                h = h * kPrime1 + kPrime4;
+            }
+        } else {
+            h = seed_ + kPrime5;
+        }
+        h += total_;
+
+        const unsigned char* p = buffer_;
+        size_t length = buffered_;
+        for (; length >= 8; p += 8, length -= 8) {
+            h ^= round(0, read64(p));
+            h = rotl(h, 27) * kPrime1 + kPrime4;
+        }
+        if (length >= 4) {
+            h ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+            h = rotl(h, 23) * kPrime2 + kPrime3;
+            p += 4;
+            length -= 4;
+        }
+        for (; length; ++p, --length) {
+            h ^= (*p) * kPrime5;
+            h = rotl(h, 11) * kPrime1;
+        }
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        h *= kPrime3;
+        h ^= h >> 32;
+        return h;
+    }
+
+    static uint64_t hash(std::string_view text, uint64_t seed = 0) { return ContentHasher(seed).update(text).digest(); }
+
+    static std::string hex(uint64_t value) {
+        static const char digits[] = "0123456789abcdef";
+        std::string out(16, '0');
+        for (int i = 15; i >= 0; --i, value >>= 4) {
+            out[i] = digits[value & 0xf];
+        }
+        return out;
+    }
+
+private:
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+    static uint64_t round(uint64_t acc, uint64_t input) { return rotl(acc + input * kPrime2, 31) * kPrime1; }
+    // Little-endian hosts only, like the rest of the engine
+    static uint64_t read64(const unsigned char* p) { uint64_t v; std::memcpy(&v, p, 8); return v; }
+    static uint32_t read32(const unsigned char* p) { uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+    void stripe(const unsigned char* p) {
+        for (int lane = 0; lane < 4; ++lane) {
+            acc_[lane] = round(acc_[lane], read64(p + lane * 8));
+        }
+    }
+
+    uint64_t seed_;
+    uint64_t acc_[4];
+    unsigned char buffer_[32];
+    size_t buffered_ = 0;
+    uint64_t total_ = 0;
+};
+
+/**
+ * Build Task
+ * Outputs of one task consumed as inputs of another create the edge between them
+ */
+struct BuildTask {
+    std::string name;
+    std::vector<std::filesystem::path> inputs;
+    std::vector<std::filesystem::path> outputs;
+    std::vector<std::string> after;   // ordering-only dependencies, by task name
+    std::string fingerprint;          // command line, tool version...: part of the cache key
+    std::function<bool(const BuildTask&)> action;
+};
+
+/**
+ * Build Graph
+ * Add every task, then finalize() to resolve edges and reject cycles
+ */
+class BuildGraph {
+public:
+    bool addTask(BuildTask task) {
+        if (task.name.empty() || index_.count(task.name)) {
+            error_ = "duplicate or unnamed task: " + task.name;
+            return false;
+        }
+        index_.emplace(task.name, tasks_.size());
+        tasks_.push_back(std::move(task));
+        finalized_ = false;
+        return true;
+    }
+
+    bool finalize() {
+        size_t count = tasks_.size();
+        successors_.assign(count, {});
+        predecessors_.assign(count, {});
+        order_.clear();
+
+        std::unordered_map<std::string, size_t> producers;
+        for (size_t i = 0; i < count; ++i) {
+            for (const auto& output : tasks_[i].outputs) {
+                auto inserted = producers.emplace(normalize(output), i);
+                if (!inserted.second) {
+                    error_ = output.string() + " is produced by both " + tasks_[inserted.first->second].name +
+                             " and " + tasks_[i].name;
+                    return false;
+                }
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            std::unordered_set<size_t> from;
+            for (const auto& input : tasks_[i].inputs) {
+                auto producer = producers.find(normalize(input));
+                if (producer != producers.end() && producer->second != i) from.insert(producer->second);
+            }
+            for (const auto& name : tasks_[i].after) {
+                auto dependency = index_.find(name);
+                if (dependency == index_.end()) {
+                    error_ = tasks_[i].name + " depends on unknown task " + name;
+                    return false;
+                }
+                from.insert(dependency->second);
+            }
+            for (size_t dependency : from) {
+                predecessors_[i].push_back(dependency);
+                successors_[dependency].push_back(i);
+            }
+        }
+
+        // Kahn's algorithm: a short order means a cycle
+        std::vector<size_t> pending(count);
+        for (size_t i = 0; i < count; ++i) {
+            pending[i] = predecessors_[i].size();
+            if (!pending[i]) order_.push_back(i);
+        }
+        for (size_t at = 0; at < order_.size(); ++at) {
+            for (size_t next : successors_[order_[at]]) {
+                if (--pending[next] == 0) order_.push_back(next);
+            }
+        }
+        if (order_.size() != count) {
+            for (size_t i = 0; i < count; ++i) {
+                if (pending[i]) {
+                    error_ = "dependency cycle through " + tasks_[i].name;
+                    break;
+                }
+            }
+            order_.clear();
+            return false;
+        }
+        finalized_ = true;
+        return true;
+    }
+
+    bool isFinalized() const { return finalized_; }
+    size_t size() const { return tasks_.size(); }
+    const BuildTask& task(size_t i) const { return tasks_[i]; }
+    const std::vector<size_t>& successors(size_t i) const { return successors_[i]; }
+    const std::vector<size_t>& predecessors(size_t i) const { return predecessors_[i]; }
+    const std::vector<size_t>& topologicalOrder() const { return order_; }
+    const std::string& lastError() const { return error_; }
+
+    static std::string normalize(const std::filesystem::path& path) {
+        return path.lexically_normal().generic_string();
+    }
+
+private:
+    std::vector<BuildTask> tasks_;
+    std::unordered_map<std::string, size_t> index_;
+    std::vector<std::vector<size_t>> successors_;
+    std::vector<std::vector<size_t>> predecessors_;
+    std::vector<size_t> order_;
+    std::string error_;
+    bool finalized_ = false;
+};
+
+/**
+ * Build Artifact Cache
+ * Lives in <cache root>/build: a manifest plus cas/<2 hex>/<hash> blobs.
+ * Thread-safe; hashing happens outside the lock.
+ */
+class BuildArtifactCache {
+public:
+    static constexpr size_t kKeysPerTask = 4;  // older keys (and their blobs) are collected on save
+
+    explicit BuildArtifactCache(const std::filesystem::path& cache_root)
+        : root_(cache_root / "build"), manifest_path_(root_ / "manifest") {
+        std::error_code ec;
+        std::filesystem::create_directories(root_ / "cas", ec);
+        load();
+    }
+
+    /**
+     * Content hash of a file, or 0 if it is missing
+     * Re-read only when size or mtime moved, or the mtime is too close to
+     * the last hash to rule out a same-tick edit. Entries for missing files,
+     * or files no build asked about since the previous save(), are dropped.
+     */
+    uint64_t hashFile(const std::filesystem::path& path) {
+        std::string key = BuildGraph::normalize(path);
+        std::error_code ec;
+        auto size = std::filesystem::file_size(path, ec);
+        if (ec) return forgetFile(key);
+        auto mtime = std::filesystem::last_write_time(path, ec);
+        if (ec) return forgetFile(key);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            touched_ = true;
+            auto it = files_.find(key);
+            if (it != files_.end() && it->second.size == size && it->second.mtime == mtime &&
+                mtime + kRacyWindow < it->second.checked) {
+                it->second.generation = generation_;
+                return it->second.hash;
+            }
+        }
+        auto checked = std::filesystem::file_time_type::clock::now();
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return forgetFile(key);
+        ContentHasher hasher;
+        char chunk[64 * 1024];
+        while (in.read(chunk, sizeof(chunk)) || in.gcount() > 0) {
+            hasher.update(chunk, static_cast<size_t>(in.gcount()));
+        }
+        // Never 0, which means "missing"
+        uint64_t hash = hasher.digest() | 1;
+        std::lock_guard<std::mutex> lock(mutex_);
+        files_[key] = FileEntry{size, mtime, checked, hash, generation_};
+        dirty_ = true;
+        return hash;
+    }
+
+    // Cache key: what the task runs plus the content of everything it reads
+    uint64_t taskKey(const BuildTask& task) {
+        std::vector<std::pair<std::string, uint64_t>> inputs;
+        inputs.reserve(task.inputs.size());
+        for (const auto& input : task.inputs) {
+            inputs.emplace_back(BuildGraph::normalize(input), hashFile(input));
+        }
+        std::sort(inputs.begin(), inputs.end());
+        ContentHasher hasher;
+        hasher.field(task.name).field(task.fingerprint);
+        for (const auto& input : inputs) {
+            hasher.field(input.first).update(&input.second, sizeof(input.second));
+        }
+        return hasher.digest();
+    }
+
+    // The last build of this task used this key and its outputs are untouched
+    bool isUpToDate(const BuildTask& task, uint64_t key) {
+        std::vector<Artifact> outputs;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = tasks_.find(task.name);
+            if (it == tasks_.end() || it->second.keys.empty() || it->second.keys.front() != key) return false;
+            auto action = actions_.find(key);
+            if (action == actions_.end()) return false;
+            outputs = action->second;
+        }
+        for (const auto& output : outputs) {
+            if (hashFile(output.path) != output.hash) return false;
+        }
+        return true;
+    }
+
+    // Outputs for this key were stored before (e.g. an edit was reverted): copy them back
+    bool restore(const BuildTask& task, uint64_t key) {
+        std::vector<Artifact> outputs;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto action = actions_.find(key);
+            if (action == actions_.end()) return false;
+            outputs = action->second;
+        }
+        std::error_code ec;
+        for (const auto& output : outputs) {
+            if (!std::filesystem::exists(blobPath(output.hash), ec)) return false;
+        }
+        for (const auto& output : outputs) {
+            std::filesystem::path target(output.path);
+            if (target.has_parent_path()) std::filesystem::create_directories(target.parent_path(), ec);
+            std::filesystem::copy_file(blobPath(output.hash), target,
+                                       std::filesystem::copy_options::overwrite_existing, ec);
+            if (ec) return false;
+        }
+        record(task, key, outputs, 0, false);
+        return true;
+    }
+
+    // After a successful run: hash and store the outputs under this key
+    bool commit(const BuildTask& task, uint64_t key, std::chrono::nanoseconds cost) {
+        std::vector<Artifact> outputs;
+        for (const auto& path : task.outputs) {
+            uint64_t hash = hashFile(path);
+            if (!hash) return false;  // the task claimed an output it did not write
+            storeBlob(path, hash);
+            outputs.push_back(Artifact{BuildGraph::normalize(path), hash});
+        }
+        record(task, key, outputs, cost.count(), true);
+        return true;
+    }
+
+    // Last measured run time, for critical-path ordering (1ms when unknown)
+    int64_t estimatedCost(const std::string& task_name) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = tasks_.find(task_name);
+        return it != tasks_.end() && it->second.cost_ns > 0 ? it->second.cost_ns : 1000000;
+    }
+
+    /**
+     * Write the manifest (temp file + rename) and drop blobs no longer referenced
+     * A no-op build writes nothing
+     */
+    bool save() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (touched_) {
+            // Stat entries the build since the last save never asked about
+            for (auto it = files_.begin(); it != files_.end();) {
+                if (it->second.generation != generation_) {
+                    it = files_.erase(it);
+                    dirty_ = true;
+                } else {
+                    ++it;
+                }
+            }
+            touched_ = false;
+            ++generation_;
+        }
+        if (!dirty_) return true;
+        std::ostringstream out;
+        out << kMagic << '\n';
+        for (const auto& file : files_) {
+            out << "F\t" << ContentHasher::hex(file.second.hash) << '\t' << file.second.size << '\t'
+                << file.second.mtime.time_since_epoch().count() << '\t'
+                << file.second.checked.time_since_epoch().count() << '\t' << file.first << '\n';
+        }
+        std::unordered_set<uint64_t> live_keys;
+        for (const auto& task : tasks_) {
+            out << "T\t" << task.second.cost_ns;
+            for (uint64_t key : task.second.keys) {
+                out << '\t' << ContentHasher::hex(key);
+                live_keys.insert(key);
+            }
+            out << '\t' << task.first << '\n';
+        }
+        std::unordered_set<std::string> live_blobs;
+        for (auto it = actions_.begin(); it != actions_.end();) {
+            if (!live_keys.count(it->first)) {
+                it = actions_.erase(it);
+                continue;
+            }
+            out << "A\t" << ContentHasher::hex(it->first) << '\t' << it->second.size() << '\n';
+            for (const auto& output : it->second) {
+                out << "O\t" << ContentHasher::hex(output.hash) << '\t' << output.path << '\n';
+                live_blobs.insert(ContentHasher::hex(output.hash));
+            }
+            ++it;
+        }
+
+        std::filesystem::path temp = manifest_path_;
+        temp += ".tmp";
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            file << out.str();
+            if (!file.flush()) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp, manifest_path_, ec);
+        if (ec) return false;
+        dirty_ = false;
+
+        for (auto it = std::filesystem::recursive_directory_iterator(root_ / "cas", ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (it->is_regular_file() && !live_blobs.count(it->path().filename().string())) {
+                std::error_code remove_ec;
+                std::filesystem::remove(it->path(), remove_ec);
+            }
+        }
+        return true;
+    }
+
+    const std::filesystem::path& root() const { return root_; }
+
+private:
+    static constexpr const char* kMagic = "MEDUSA-BUILD 1";
+    static constexpr std::chrono::seconds kRacyWindow{2};
+
+    struct FileEntry {
+        uintmax_t size;
+        std::filesystem::file_time_type mtime;
+        std::filesystem::file_time_type checked;
+        uint64_t hash;
+        uint64_t generation = 0;   // last save() period that used it; not persisted
+    };
+    struct Artifact {
+        std::string path;
+        uint64_t hash;
+    };
+    struct TaskEntry {
+        std::vector<uint64_t> keys;  // most recent first
+        int64_t cost_ns = 0;
+    };
+
+    std::filesystem::path blobPath(uint64_t hash) const {
+        std::string name = ContentHasher::hex(hash);
+        return root_ / "cas" / name.substr(0, 2) / name;
+    }
+
+    uint64_t forgetFile(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (files_.erase(key)) dirty_ = true;
+        return 0;
+    }
+
+    void storeBlob(const std::filesystem::path& source, uint64_t hash) {
+        std::filesystem::path blob = blobPath(hash);
+        std::error_code ec;
+        if (std::filesystem::exists(blob, ec)) return;
+        std::filesystem::create_directories(blob.parent_path(), ec);
+        std::filesystem::path temp = blob;
+        temp += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        std::filesystem::copy_file(source, temp, std::filesystem::copy_options::overwrite_existing, ec);
+        if (!ec) std::filesystem::rename(temp, blob, ec);
+        if (ec) std::filesystem::remove(temp, ec);
+    }
+
+    void record(const BuildTask& task, uint64_t key, std::vector<Artifact> outputs, int64_t cost_ns, bool measured) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        TaskEntry& entry = tasks_[task.name];
+        entry.keys.erase(std::remove(entry.keys.begin(), entry.keys.end(), key), entry.keys.end());
+        entry.keys.insert(entry.keys.begin(), key);
+        if (entry.keys.size() > kKeysPerTask) entry.keys.resize(kKeysPerTask);
+        if (measured) entry.cost_ns = cost_ns;
+        actions_[key] = std::move(outputs);
+        dirty_ = true;
+    }
+
+    static bool parseHex(const std::string& text, uint64_t& value) {
+        if (text.size() != 16) return false;
+        value = 0;
+        for (char c : text) {
+            int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+            if (digit < 0) return false;
+            value = (value << 4) | static_cast<uint64_t>(digit);
+        }
+        return true;
+    }
+
+    // A missing or unreadable manifest just means a cold build
+    void load() {
+        std::ifstream in(manifest_path_, std::ios::binary);
+        std::string line;
+        if (!std::getline(in, line) || line != kMagic) return;
+        uint64_t current_action = 0;
+        std::vector<std::string> fields;
+        while (std::getline(in, line)) {
+            fields.clear();
+            std::istringstream stream(line);
+            for (std::string field; std::getline(stream, field, '\t');) fields.push_back(field);
+            if (fields.empty()) continue;
+            try {
+                if (fields[0] == "F" && fields.size() == 6) {
+                    FileEntry entry{};
+                    if (!parseHex(fields[1], entry.hash)) continue;
+                    entry.size = std::stoull(fields[2]);
+                    entry.mtime = std::filesystem::file_time_type(
+                        std::filesystem::file_time_type::duration(std::stoll(fields[3])));
+                    entry.checked = std::filesystem::file_time_type(
+                        std::filesystem::file_time_type::duration(std::stoll(fields[4])));
+                    files_[fields[5]] = entry;
+                } else if (fields[0] == "T" && fields.size() >= 3) {
+                    TaskEntry& entry = tasks_[fields.back()];
+                    entry.cost_ns = std::stoll(fields[1]);
+                    for (size_t i = 2; i + 1 < fields.size(); ++i) {
+                        uint64_t key;
+                        if (parseHex(fields[i], key)) entry.keys.push_back(key);
+                    }
+                } else if (fields[0] == "A" && fields.size() == 3) {
+                    if (parseHex(fields[1], current_action)) actions_[current_action];
+                } else if (fields[0] == "O" && fields.size() == 3) {
+                    Artifact artifact{fields[2], 0};
+                    if (parseHex(fields[1], artifact.hash)) actions_[current_action].push_back(artifact);
+                }
+            } catch (const std::exception&) {
+                continue;  // a damaged line only costs a rebuild
+            }
+        }
+    }
+
+    std::filesystem::path root_;
+    std::filesystem::path manifest_path_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, FileEntry> files_;
+    std::unordered_map<std::string, TaskEntry> tasks_;
+    std::unordered_map<uint64_t, std::vector<Artifact>> actions_;
+    bool dirty_ = false;
+    bool touched_ = false;       // hashFile() ran since the last save()
+    uint64_t generation_ = 1;    // loaded entries start at 0, i.e. unseen
+};
+
+/**
+ * Work-Stealing Pool
+ * Each worker pops the highest-priority job from its own queue and, when
+ * that is empty, steals the highest-priority job from another worker.
+ * Jobs submitted from a worker stay on that worker (their inputs are warm).
+ */
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t thread_count) {
+        if (thread_count == 0) thread_count = 1;
+        for (size_t i = 0; i < thread_count; ++i) workers_.emplace_back(new Worker());
+        for (size_t i = 0; i < thread_count; ++i) workers_[i]->thread = std::thread([this, i] { run(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+            running_ = false;
+        }
+        idle_condition_.notify_all();
+        for (auto& worker : workers_) {
+            if (worker->thread.joinable()) worker->thread.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> job, int64_t priority = 0) {
+        size_t target = current_pool_ == this ? current_worker_
+                                              : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+        outstanding_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+            workers_[target]->jobs.push_back(Job{priority, sequence_.fetch_add(1, std::memory_order_relaxed), std::move(job)});
+            std::push_heap(workers_[target]->jobs.begin(), workers_[target]->jobs.end());
+        }
+        queued_.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> lock(idle_mutex_);
+        }
+        idle_condition_.notify_one();
+    }
+
+    // Block until every submitted job (including jobs they submit) has finished
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        done_condition_.wait(lock, [this] { return outstanding_.load(std::memory_order_acquire) == 0; });
+    }
+
+    size_t threadCount() const { return workers_.size(); }
+    size_t activeJobs() const { return active_.load(std::memory_order_relaxed); }
+    uint64_t stolenJobs() const { return stolen_.load(std::memory_order_relaxed); }
+
+private:
+    struct Job {
+        int64_t priority;
+        uint64_t sequence;
+        std::function<void()> run;
+        // Max-heap: higher priority first, then submission order
+        bool operator<(const Job& other) const {
+            return priority != other.priority ? priority < other.priority : sequence > other.sequence;
+        }
+    };
+    struct Worker {
+        std::mutex mutex;
+        std::vector<Job> jobs;
+        std::thread thread;
+    };
+
+    bool pop(size_t index, Job& job) {
+        Worker& worker = *workers_[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.jobs.empty()) return false;
+        std::pop_heap(worker.jobs.begin(), worker.jobs.end());
+        job = std::move(worker.jobs.back());
+        worker.jobs.pop_back();
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void run(size_t index) {
+        current_pool_ = this;
+        current_worker_ = index;
+        for (;;) {
+            Job job;
+            bool found = pop(index, job);
+            for (size_t offset = 1; !found && offset < workers_.size(); ++offset) {
+                found = pop((index + offset) % workers_.size(), job);
+                if (found) stolen_.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (!found) {
+                std::unique_lock<std::mutex> lock(idle_mutex_);
+                idle_condition_.wait(lock, [this] { return !running_ || queued_.load(std::memory_order_acquire) > 0; });
+                if (!running_ && queued_.load(std::memory_order_acquire) == 0) return;
+                continue;
+            }
+            active_.fetch_add(1, std::memory_order_relaxed);
+            job.run();
+            active_.fetch_sub(1, std::memory_order_relaxed);
+            if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(idle_mutex_);
+                done_condition_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex idle_mutex_;
+    std::condition_variable idle_condition_;
+    std::condition_variable done_condition_;
+    bool running_ = true;  // guarded by idle_mutex_
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> outstanding_{0};
+    std::atomic<size_t> active_{0};
+    std::atomic<size_t> next_worker_{0};
+    std::atomic<uint64_t> sequence_{0};
+    std::atomic<uint64_t> stolen_{0};
+
+    static thread_local WorkStealingPool* current_pool_;
+    static thread_local size_t current_worker_;
+};
+
+inline thread_local WorkStealingPool* WorkStealingPool::current_pool_ = nullptr;
+inline thread_local size_t WorkStealingPool::current_worker_ = 0;
+
+/**
+ * Build Report
+ */
+struct BuildReport {
+    size_t up_to_date = 0;   // key unchanged, outputs untouched
+    size_t restored = 0;     // outputs copied back from the artifact store
+    size_t built = 0;
+    size_t failed = 0;
+    size_t blocked = 0;      // not attempted because a dependency failed
+    std::vector<std::string> failed_tasks;
+    std::chrono::nanoseconds elapsed{0};
+
+    bool success() const { return failed == 0 && blocked == 0; }
+};
+
+/**
+ * Run a finalized graph on the pool
+ * A task is keyed once its dependencies finish, so a dependency that rebuilt
+ * to identical bytes leaves its dependents up to date.
+ * Ready tasks are prioritised by the longest remaining path (estimated from
+ * the last measured run times) so the critical path starts first.
+ */
+inline BuildReport runBuildGraph(const BuildGraph& graph, BuildArtifactCache& cache, WorkStealingPool& pool,
+                                 const std::function<void(size_t done, size_t total)>& progress = nullptr) {
+    enum class Outcome : uint8_t { PENDING, DONE, FAILED };
+    struct Run {
+        std::vector<int64_t> priority;
+        std::unique_ptr<std::atomic<size_t>[]> waiting;
+        std::unique_ptr<std::atomic<Outcome>[]> outcome;
+        std::atomic<size_t> up_to_date{0}, restored{0}, built{0}, failed{0}, blocked{0}, finished{0};
+        std::mutex mutex;
+        std::condition_variable finished_condition;
+        std::vector<std::string> failed_tasks;
+        std::function<void(size_t)> process;
+        std::function<void(size_t, size_t)> progress;
+        std::weak_ptr<Run> self;
+    };
+
+    auto started = std::chrono::steady_clock::now();
+    size_t count = graph.size();
+    BuildReport report;
+    if (!graph.isFinalized() || count == 0) return report;
+
+    auto state = std::make_shared<Run>();
+    state->priority.assign(count, 0);
+    state->waiting.reset(new std::atomic<size_t>[count]);
+    state->outcome.reset(new std::atomic<Outcome>[count]);
+    const auto& order = graph.topologicalOrder();
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int64_t longest = 0;
+        for (size_t next : graph.successors(*it)) longest = std::max(longest, state->priority[next]);
+        state->priority[*it] = cache.estimatedCost(graph.task(*it).name) + longest;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        state->waiting[i].store(graph.predecessors(i).size(), std::memory_order_relaxed);
+        state->outcome[i].store(Outcome::PENDING, std::memory_order_relaxed);
+    }
+
+    // Jobs hold the run state alive: the last one may still be unwinding when this call returns
+    state->progress = progress;
+    state->self = state;
+    auto schedule = [&pool](const std::shared_ptr<Run>& run, size_t i) {
+        pool.submit([run, i] { run->process(i); }, run->priority[i]);
+    };
+    Run* raw = state.get();
+    state->process = [&graph, &cache, schedule, raw, count](size_t i) {
+        Run* state = raw;
+        const BuildTask& task = graph.task(i);
+        bool dependency_failed = false;
+        for (size_t dependency : graph.predecessors(i)) {
+            dependency_failed |= state->outcome[dependency].load(std::memory_order_acquire) == Outcome::FAILED;
+        }
+
+        Outcome outcome = Outcome::DONE;
+        if (dependency_failed) {
+            state->blocked.fetch_add(1);
+            outcome = Outcome::FAILED;
+        } else {
+            uint64_t key = cache.taskKey(task);
+            if (cache.isUpToDate(task, key)) {
+                state->up_to_date.fetch_add(1);
+            } else if (cache.restore(task, key)) {
+                state->restored.fetch_add(1);
+            } else {
+                auto run_started = std::chrono::steady_clock::now();
+                bool ok = false;
+                try {
+                    ok = !task.action || task.action(task);
+                } catch (const std::exception&) {
+                    ok = false;
+                }
+                ok = ok && cache.commit(task, key, std::chrono::steady_clock::now() - run_started);
+                if (ok) {
+                    state->built.fetch_add(1);
+                } else {
+                    state->failed.fetch_add(1);
+                    outcome = Outcome::FAILED;
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->failed_tasks.push_back(task.name);
+                }
+            }
+        }
+        state->outcome[i].store(outcome, std::memory_order_release);
+
+        for (size_t next : graph.successors(i)) {
+            if (state->waiting[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                schedule(state->self.lock(), next);
+            }
+        }
+        size_t done = state->finished.fetch_add(1, std::memory_order_acq_rel) + 1;
+        if (state->progress) state->progress(done, count);
+        if (done == count) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished_condition.notify_all();
+        }
+    };
+
+    // Roots, most critical first
+    std::vector<size_t> roots;
+    for (size_t i = 0; i < count; ++i) {
+        if (graph.predecessors(i).empty()) roots.push_back(i);
+    }
+    std::sort(roots.begin(), roots.end(), [&](size_t a, size_t b) { return state->priority[a] > state->priority[b]; });
+    for (size_t root : roots) schedule(state, root);
+    {
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished_condition.wait(lock, [&] { return state->finished.load(std::memory_order_acquire) == count; });
+    }
+    cache.save();
+
+    report.up_to_date = state->up_to_date;
+    report.restored = state->restored;
+    report.built = state->built;
+    report.failed = state->failed;
+    report.blocked = state->blocked;
+    report.failed_tasks = std::move(state->failed_tasks);
+    report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started);
+    return report;
+}
+
+} // namespace Engine
+} // namespace MedusaLightspeed
@@ -40,7 +40,9 @@
 #include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <iostream>
 #include <sstream>
+#include <unordered_set>
 
 // Foundation system includes
 #include "../theme/core/foundation/colors/medusa_color_system.hpp"
@@ -48,6 +50,10 @@
 #include "../theme/core/foundation/shadows/medusa_shadow_system.hpp"
 #include "../theme/core/foundation/spacing/medusa_spacing_system.hpp"
 #include "../theme/core/foundation/icons/iconify/medusa_iconify_system.hpp"
+#include "medusa_lightspeed_inotify.hpp"
+#include "medusa_lightspeed_build_graph.hpp"
+#include "medusa_lightspeed_profiler.hpp"
+#include "lamia_template_vm.hpp"
 
 namespace MedusaLightspeed {
 namespace Engine {
@@ -150,8 +156,12 @@ public:
     void warmCache(const std::vector<std::string>& keys);
     void preloadComponents();
     
+    const std::filesystem::path& getCacheRoot() const { return cache_root_; }
+    
     // Content-addressable storage
-    std::string generateContentHash(const std::string& content) const;
+    std::string generateContentHash(const std::string& content) const {
+        return ContentHasher::hex(ContentHasher::hash(content));
+    }
     bool storeByHash(const std::string& content, std::string& hash);
     bool retrieveByHash(const std::string& hash, std::string& content);
 };
@@ -159,85 +169,359 @@ public:
 /**
  * File Watcher System
  * Real-time file change detection with intelligent batching
+ * Linux uses inotify (no per-file polling); other platforms fall back to
+ * comparing file_timestamps_ every batch interval
  */
 class FileWatcher {
 private:
     std::vector<std::filesystem::path> watched_paths_;
-    std::unordered_map<std::string, std::chrono::system_clock::time_point> file_timestamps_;
+    std::unordered_map<std::string, std::filesystem::file_time_type> file_timestamps_;  // polling fallback only
     std::queue<std::string> change_queue_;
-    std::mutex queue_mutex_;
+    mutable std::mutex queue_mutex_;
     std::condition_variable queue_condition_;
     std::atomic<bool> running_;
     std::thread watcher_thread_;
+    InotifyWatchBackend inotify_;
+    bool use_inotify_ = false;
+    std::function<void(const std::vector<std::string>&)> on_change_callback_;
+    // Immutable snapshot swapped with std::atomic_store; read lock-free by the watcher thread
+    std::shared_ptr<const std::vector<std::string>> ignore_patterns_ =
+        std::make_shared<const std::vector<std::string>>();
     
     // Change batching
     std::chrono::milliseconds batch_interval_{50}; // 50ms batching
     std::unordered_set<std::string> pending_changes_;
     
 public:
-    FileWatcher();
-    ~FileWatcher();
+    FileWatcher() : running_(false) {}
+    ~FileWatcher() { stop(); }
     
     // Watch management
-    void addPath(const std::filesystem::path& path);
-    void removePath(const std::filesystem::path& path);
-    void start();
-    void stop();
+    void addPath(const std::filesystem::path& path) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        watched_paths_.push_back(path);
+        if (use_inotify_) {
+            inotify_.addTree(path);
+        } else if (running_) {
+            scanForChanges(path, nullptr);
+        }
+    }
+    
+    void removePath(const std::filesystem::path& path) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        watched_paths_.erase(std::remove(watched_paths_.begin(), watched_paths_.end(), path), watched_paths_.end());
+        if (use_inotify_) {
+            inotify_.removeTree(path);
+        }
+        std::string prefix = path.string();
+        for (auto it = file_timestamps_.begin(); it != file_timestamps_.end();) {
+            it = it->first.compare(0, prefix.size(), prefix) == 0 ? file_timestamps_.erase(it) : std::next(it);
+        }
+    }
+    
+    void start() {
+        if (running_.exchange(true)) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            use_inotify_ = inotify_.open();
+            if (use_inotify_) {
+                inotify_.setFilter([this](const std::filesystem::path& file) { return shouldIgnoreFile(file); });
+            }
+            for (const auto& path : watched_paths_) {
+                if (use_inotify_) {
+                    inotify_.addTree(path);
+                } else {
+                    scanForChanges(path, nullptr);
+                }
+            }
+        }
+        watcher_thread_ = std::thread(&FileWatcher::watchLoop, this);
+    }
+    
+    void stop() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        inotify_.wake();
+        queue_condition_.notify_all();
+        if (watcher_thread_.joinable()) {
+            watcher_thread_.join();
+        }
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        inotify_.close();
+        use_inotify_ = false;
+    }
     
     // Change handling
-    std::vector<std::string> getChanges();
-    bool hasChanges() const;
-    void setOnChangeCallback(std::function<void(const std::vector<std::string>&)> callback);
+    std::vector<std::string> getChanges() {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        std::vector<std::string> changes;
+        changes.reserve(change_queue_.size());
+        while (!change_queue_.empty()) {
+            changes.push_back(std::move(change_queue_.front()));
+            change_queue_.pop();
+        }
+        return changes;
+    }
+    
+    bool hasChanges() const {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        return !change_queue_.empty();
+    }
+    
+    // Called on the watcher thread with each coalesced batch (each path once)
+    void setOnChangeCallback(std::function<void(const std::vector<std::string>&)> callback) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        on_change_callback_ = std::move(callback);
+    }
     
     // Watch configuration
-    void setBatchInterval(std::chrono::milliseconds interval);
-    void setIgnorePatterns(const std::vector<std::string>& patterns);
+    void setBatchInterval(std::chrono::milliseconds interval) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        batch_interval_ = interval;
+    }
+    
+    // "*.ext" matches an extension, anything else a path component (".git", "node_modules")
+    void setIgnorePatterns(const std::vector<std::string>& patterns) {
+        std::atomic_store(&ignore_patterns_, std::make_shared<const std::vector<std::string>>(patterns));
+    }
     
 private:
-    void watchLoop();
-    bool shouldIgnoreFile(const std::filesystem::path& file) const;
-    void processPendingChanges();
+    /**
+     * Collect events until the first change of a batch is batch_interval_ old,
+     * then hand the whole de-duplicated set over at once
+     */
+    void watchLoop() {
+        using Clock = std::chrono::steady_clock;
+        Clock::time_point batch_deadline;
+        auto collect = [&](const std::string& path) {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            if (pending_changes_.empty()) {
+                batch_deadline = Clock::now() + batch_interval_;
+            }
+            pending_changes_.insert(path);
+        };
+        
+        while (running_) {
+            bool pending;
+            std::chrono::milliseconds interval;
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                pending = !pending_changes_.empty();
+                interval = batch_interval_;
+            }
+            auto now = Clock::now();
+            std::chrono::milliseconds timeout = pending
+                ? std::chrono::duration_cast<std::chrono::milliseconds>(std::max(batch_deadline - now, Clock::duration::zero()))
+                : std::chrono::milliseconds(1000);
+            
+            if (use_inotify_) {
+                inotify_.wait(timeout, collect);
+            } else {
+                std::this_thread::sleep_for(interval);
+                std::vector<std::filesystem::path> paths;
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex_);
+                    paths = watched_paths_;
+                }
+                for (const auto& path : paths) {
+                    scanForChanges(path, &collect);
+                }
+            }
+            
+            if (Clock::now() >= batch_deadline) {
+                processPendingChanges();
+            }
+        }
+        processPendingChanges();
+    }
+    
+    bool shouldIgnoreFile(const std::filesystem::path& file) const {
+        auto patterns = std::atomic_load(&ignore_patterns_);
+        for (const auto& pattern : *patterns) {
+            if (pattern.size() > 1 && pattern[0] == '*') {
+                const std::string suffix = pattern.substr(1);
+                const std::string name = file.filename().string();
+                if (name.size() >= suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+                    return true;
+                }
+            } else {
+                for (const auto& component : file) {
+                    if (component == pattern) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+    
+    void processPendingChanges() {
+        std::vector<std::string> batch;
+        std::function<void(const std::vector<std::string>&)> callback;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            if (pending_changes_.empty()) {
+                return;
+            }
+            batch.assign(pending_changes_.begin(), pending_changes_.end());
+            pending_changes_.clear();
+            std::sort(batch.begin(), batch.end());
+            for (const auto& path : batch) {
+                change_queue_.push(path);
+            }
+            callback = on_change_callback_;
+        }
+        queue_condition_.notify_all();
+        if (callback) {
+            callback(batch);
+        }
+    }
+    
+    // Polling fallback: compare modification times; nullptr collector just records the baseline
+    template<typename Collect>
+    void scanForChanges(const std::filesystem::path& root, Collect* collect) {
+        std::error_code ec;
+        auto visit = [&](const std::filesystem::path& file) {
+            auto modified = std::filesystem::last_write_time(file, ec);
+            if (ec) return;
+            std::string key = file.string();
+            std::unique_lock<std::mutex> lock(queue_mutex_, std::defer_lock);
+            if (collect) lock.lock();
+            auto [it, inserted] = file_timestamps_.emplace(key, modified);
+            if (!inserted && it->second != modified) {
+                it->second = modified;
+                if (collect) {
+                    lock.unlock();
+                    (*collect)(key);
+                }
+            }
+        };
+        if (!std::filesystem::is_directory(root, ec)) {
+            visit(root);
+            return;
+        }
+        for (auto it = std::filesystem::recursive_directory_iterator(
+                 root, std::filesystem::directory_options::skip_permission_denied, ec);
+             !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (shouldIgnoreFile(it->path())) {
+                if (it->is_directory(ec)) it.disable_recursion_pending();
+                continue;
+            }
+            if (it->is_regular_file(ec)) {
+                visit(it->path());
+            }
+        }
+    }
+    
+    void scanForChanges(const std::filesystem::path& root, std::nullptr_t) {
+        scanForChanges<void (*)(const std::string&)>(root, nullptr);
+    }
 };
 
 /**
  * Parallel Build Executor
  * Multi-threaded compilation with C++, Python, JavaScript orchestration
+ * Loose tasks and build graphs share one work-stealing pool; graphs rebuild
+ * only what their content hashes say changed (see medusa_lightspeed_build_graph.hpp)
  */
 class ParallelBuildExecutor {
 private:
     size_t thread_count_;
-    std::vector<std::thread> worker_threads_;
-    std::queue<std::function<void()>> task_queue_;
-    std::mutex queue_mutex_;
-    std::condition_variable queue_condition_;
-    std::atomic<bool> running_;
-    std::atomic<size_t> active_tasks_;
+    // Shared so a graph run keeps its pool alive across a concurrent stop()
+    std::shared_ptr<WorkStealingPool> pool_;
+    mutable std::mutex pool_mutex_;
     
     // Progress tracking
-    std::atomic<size_t> completed_tasks_;
-    std::atomic<size_t> total_tasks_;
+    std::atomic<size_t> completed_tasks_{0};
+    std::atomic<size_t> total_tasks_{0};
     std::function<void(double)> progress_callback_;
     
 public:
-    ParallelBuildExecutor(size_t thread_count = std::thread::hardware_concurrency());
-    ~ParallelBuildExecutor();
+    ParallelBuildExecutor(size_t thread_count = std::thread::hardware_concurrency())
+        : thread_count_(thread_count ? thread_count : 1) {}
+    ~ParallelBuildExecutor() { stop(); }
     
     // Task management
-    void start();
-    void stop();
-    void submit(std::function<void()> task);
-    void waitForCompletion();
+    void start() {
+        acquirePool();
+    }
+    
+    // Finishes queued tasks, then joins the workers
+    void stop() {
+        std::shared_ptr<WorkStealingPool> pool;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            pool = std::move(pool_);
+        }
+        if (pool) pool->waitIdle();
+    }
+    
+    void submit(std::function<void()> task) {
+        total_tasks_.fetch_add(1, std::memory_order_relaxed);
+        // Queued under pool_mutex_ so a concurrent stop() either drains it or never sees it
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (!pool_) pool_ = std::make_shared<WorkStealingPool>(thread_count_);
+        pool_->submit([this, task = std::move(task)] {
+            try {
+                task();
+            } catch (...) {
+                // A failing task must not take the worker down with it
+            }
+            completed_tasks_.fetch_add(1, std::memory_order_relaxed);
+            reportProgress();
+        });
+    }
+    
+    void waitForCompletion() {
+        std::shared_ptr<WorkStealingPool> pool;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            pool = pool_;
+        }
+        if (pool) pool->waitIdle();
+    }
+    
+    /**
+     * Incremental build of a finalized graph
+     * Hashes and artifacts are kept under <cache root>/build
+     */
+    BuildReport executeGraph(const BuildGraph& graph, BuildArtifactCache& cache) {
+        std::shared_ptr<WorkStealingPool> pool = acquirePool();
+        total_tasks_.fetch_add(graph.size(), std::memory_order_relaxed);
+        return runBuildGraph(graph, cache, *pool, [this](size_t, size_t) {
+            completed_tasks_.fetch_add(1, std::memory_order_relaxed);
+            reportProgress();
+        });
+    }
     
     // Progress tracking
-    double getProgress() const;
-    void setProgressCallback(std::function<void(double)> callback);
+    double getProgress() const {
+        size_t total = total_tasks_.load(std::memory_order_relaxed);
+        return total ? static_cast<double>(completed_tasks_.load(std::memory_order_relaxed)) / total : 1.0;
+    }
+    // Set before submitting work; it is called from worker threads
+    void setProgressCallback(std::function<void(double)> callback) { progress_callback_ = std::move(callback); }
     
     // Performance metrics
-    size_t getCompletedTasks() const;
-    size_t getActiveThreads() const;
+    size_t getCompletedTasks() const { return completed_tasks_.load(std::memory_order_relaxed); }
+    size_t getActiveThreads() const {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        return pool_ ? pool_->activeJobs() : 0;
+    }
     
 private:
-    void workerLoop();
+    std::shared_ptr<WorkStealingPool> acquirePool() {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (!pool_) pool_ = std::make_shared<WorkStealingPool>(thread_count_);
+        return pool_;
+    }
+    
+    void reportProgress() {
+        if (progress_callback_) progress_callback_(getProgress());
+    }
 };
 
 /**
@@ -254,10 +538,100 @@ private:
     std::unordered_map<std::string, size_t> render_counts_;
     std::unordered_map<std::string, std::chrono::nanoseconds> render_times_;
     
+    // Compiled Lamia templates by component name; bytecode shared by hash
+    using CompiledTemplate = MedusaServ::Language::Lamia::CompiledTemplate;
+    using TemplateData = MedusaServ::Language::Lamia::TemplateData;
+    mutable std::mutex templates_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<const CompiledTemplate>> templates_;
+    MedusaServ::Language::Lamia::TemplateCache template_cache_;
+    static constexpr size_t MAX_TEMPLATE_ENTRIES = 4096;
+    
 public:
     ComponentRenderer(MedusaCacheSystem* cache, MemoryManager* memory);
     ~ComponentRenderer();
     
+    /**
+     * Request-time templates
+     * Templates compile once; rendering is a bytecode replay into the caller's buffer.
+     * Components without a registered template load <cache root>/templates/<name>.lbc;
+     * installCompiledTemplates() puts the Lamia compiler's index.lbc files there.
+     */
+    bool registerTemplate(const std::string& component_name, const std::string& text, std::string* error = nullptr) {
+        auto compiled = template_cache_.get_or_compile(text, error);
+        if (!compiled) return false;
+        std::lock_guard<std::mutex> lock(templates_mutex_);
+        templates_[component_name] = std::move(compiled);
+        return true;
+    }
+    
+    bool loadCompiledTemplate(const std::string& component_name, const std::filesystem::path& path) {
+        auto compiled = template_cache_.load(path.string());
+        if (!compiled) return false;
+        std::lock_guard<std::mutex> lock(templates_mutex_);
+        templates_[component_name] = std::move(compiled);
+        return true;
+    }
+    
+    /**
+     * Copy every index.lbc under the compiler's output directory to
+     * <cache root>/templates/<name>.lbc, where name is the page's directory
+     * relative to output_dir with '/' replaced by '.' ("blog/post" -> "blog.post")
+     * and the top-level page is "index". Installed names are invalidated, so the
+     * next render picks up the new bytecode.
+     * @return number of templates installed
+     */
+    size_t installCompiledTemplates(const std::filesystem::path& output_dir) {
+        if (!cache_system_) return 0;
+        std::error_code ec;
+        std::filesystem::path target_dir = cache_system_->getCacheRoot() / "templates";
+        std::filesystem::create_directories(target_dir, ec);
+        if (ec) return 0;
+        size_t installed = 0;
+        std::filesystem::recursive_directory_iterator it(
+            output_dir, std::filesystem::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            if (it->path().filename() != "index.lbc" || !it->is_regular_file(ec)) continue;
+            std::string name = it->path().parent_path().lexically_relative(output_dir).generic_string();
+            if (name.empty() || name == ".") {
+                name = "index";
+            } else {
+                std::replace(name.begin(), name.end(), '/', '.');
+            }
+            if (!isTemplateName(name)) continue;
+            std::error_code copy_ec;
+            std::filesystem::copy_file(it->path(), target_dir / (name + ".lbc"),
+                                       std::filesystem::copy_options::overwrite_existing, copy_ec);
+            if (copy_ec) continue;
+            invalidateTemplate(name);
+            ++installed;
+        }
+        return installed;
+    }
+    
+    // Components that were rendered without a template (remembered misses)
+    std::vector<std::string> getMissingTemplates() const {
+        std::lock_guard<std::mutex> lock(templates_mutex_);
+        std::vector<std::string> missing;
+        for (const auto& [name, compiled] : templates_) {
+            if (!compiled) missing.push_back(name);
+        }
+        return missing;
+    }
+    
+    // Forget a template (or a remembered miss), e.g. after index.lbc is rebuilt
+    void invalidateTemplate(const std::string& component_name) {
+        std::lock_guard<std::mutex> lock(templates_mutex_);
+        templates_.erase(component_name);
+    }
+    
+    // Appends to out; false when the component has no template
+    bool renderTemplate(const std::string& component_name, const TemplateData& data, std::string& out) {
+        auto compiled = findTemplate(component_name);
+        if (!compiled) return false;
+        MedusaServ::Language::Lamia::render_template(*compiled, data, out);
+        return true;
+    }
+    
     // Component rendering
     std::string renderComponent(const std::string& component_name, 
                                const std::map<std::string, std::string>& props = {},
@@ -277,7 +651,69 @@ public:
     void optimizeRenderStrategies();
     
 private:
-    std::string renderSSR(const std::string& component_name, const std::map<std::string, std::string>& props);
+    // A miss is remembered (as nullptr) until the template is registered or invalidated
+    std::shared_ptr<const CompiledTemplate> findTemplate(const std::string& component_name) {
+        {
+            std::lock_guard<std::mutex> lock(templates_mutex_);
+            auto found = templates_.find(component_name);
+            if (found != templates_.end()) return found->second;
+        }
+        std::shared_ptr<const CompiledTemplate> compiled;
+        std::filesystem::path path;
+        if (cache_system_ && isTemplateName(component_name)) {
+            path = cache_system_->getCacheRoot() / "templates" / (component_name + ".lbc");
+            compiled = template_cache_.load(path.string());
+        }
+        bool first_miss;
+        {
+            std::lock_guard<std::mutex> lock(templates_mutex_);
+            if (!compiled && templates_.size() >= MAX_TEMPLATE_ENTRIES) return nullptr;   // don't let unknown names grow the map
+            auto [entry, inserted] = templates_.emplace(component_name, std::move(compiled));
+            if (entry->second) return entry->second;
+            first_miss = inserted;
+        }
+        // Reported once per name; the miss is remembered until invalidated
+        if (first_miss) {
+            std::cerr << "⚠️ No compiled template for component '" << component_name << "'"
+                      << (path.empty() ? std::string(" (invalid name)") : " (expected " + path.string() + ")")
+                      << std::endl;
+        }
+        return nullptr;
+    }
+    
+    // Component names join the cache root: no separators, no parent references
+    static bool isTemplateName(const std::string& component_name) {
+        return !component_name.empty() && component_name.find_first_of("/\\") == std::string::npos &&
+               component_name.find("..") == std::string::npos && component_name.find('\0') == std::string::npos;
+    }
+    
+    // Props become template values; "[a, b]" props become lists
+    std::string renderSSR(const std::string& component_name, const std::map<std::string, std::string>& props) {
+        thread_local TemplateData data;
+        data.values.clear();
+        data.lists.clear();
+        for (const auto& [key, value] : props) {
+            if (value.size() < 2 || value.front() != '[' || value.back() != ']') {
+                data.values[key] = value;
+                continue;
+            }
+            auto& items = data.lists[key];
+            std::string_view rest(value.data() + 1, value.size() - 2);
+            while (!rest.empty()) {
+                size_t comma = rest.find(',');
+                std::string_view item = rest.substr(0, comma);
+                size_t begin = item.find_first_not_of(" \t\"");
+                if (begin != std::string_view::npos) {
+                    item = item.substr(begin, item.find_last_not_of(" \t\"") + 1 - begin);
+                    items.emplace_back(item);
+                }
+                rest = comma == std::string_view::npos ? std::string_view() : rest.substr(comma + 1);
+            }
+        }
+        std::string html;
+        renderTemplate(component_name, data, html);   // empty without a template; findTemplate reports it
+        return html;
+    }
     std::string renderPSR(const std::string& component_name, const std::map<std::string, std::string>& props);
     std::string renderStatic(const std::string& component_name, const std::map<std::string, std::string>& props);
     std::string renderHybrid(const std::string& component_name, const std::map<std::string, std::string>& props);
@@ -328,48 +764,166 @@ private:
 /**
  * Performance Profiler
  * Comprehensive performance monitoring and optimization
+ * Backed by the process-wide zone collector (medusa_lightspeed_profiler.hpp):
+ * hot paths should use MEDUSA_PROFILE_ZONE; startProfile/endProfile remain
+ * for names only known at runtime. Nothing is recorded until start().
  */
 class PerformanceProfiler {
 private:
-    struct ProfilePoint {
-        std::string name;
-        std::chrono::high_resolution_clock::time_point start_time;
-        std::chrono::nanoseconds duration;
-        std::string category;
-    };
-    
-    std::vector<ProfilePoint> profile_points_;
-    std::mutex profile_mutex_;
-    std::unordered_map<std::string, size_t> operation_counts_;
+    SampledProfiler sampler_;
+    std::atomic<bool> started_{false};
     
     // ENIGMA Scale validation (315ms for 315 operations)
     static constexpr size_t ENIGMA_OPERATIONS = 315;
     static constexpr std::chrono::milliseconds ENIGMA_TIME_LIMIT{315};
     
 public:
-    PerformanceProfiler();
-    ~PerformanceProfiler();
+    PerformanceProfiler() = default;
+    ~PerformanceProfiler() { stop(); }
+    
+    // Enable zone recording and the background collector
+    void start(std::chrono::milliseconds collect_interval = std::chrono::milliseconds(50)) {
+        if (started_.exchange(true)) return;
+        ZoneCollector::instance().setEnabled(true);
+        ZoneCollector::instance().startBackground(collect_interval);
+    }
+    // Disable recording and stop collecting; statistics gathered so far are kept
+    void stop() {
+        sampler_.stop();
+        if (!started_.exchange(false)) return;
+        ZoneCollector::instance().setEnabled(false);
+        ZoneCollector::instance().stopBackground();
+    }
+    bool isRunning() const { return started_.load(); }
     
-    // Profiling operations
-    void startProfile(const std::string& operation_name, const std::string& category = "general");
-    void endProfile(const std::string& operation_name);
+    // Profiling operations (nest per thread; ending an outer zone closes any left open inside it)
+    void startProfile(const std::string& operation_name, const std::string& category = "general") {
+        if (!ZoneCollector::instance().isEnabled()) return;
+        uint32_t site = ZoneRegistry::instance().intern(operation_name, category);
+        bool recorded = ZoneCollector::threadBuffer()->begin(site);
+        openZones().push_back(OpenZone{operation_name, site, recorded});
+    }
+    void endProfile(const std::string& operation_name) {
+        auto& open = openZones();
+        auto match = std::find_if(open.rbegin(), open.rend(),
+                                  [&](const OpenZone& zone) { return zone.name == operation_name; });
+        if (match == open.rend()) return;
+        size_t keep = open.size() - 1 - static_cast<size_t>(match - open.rbegin());
+        while (open.size() > keep) {
+            if (open.back().recorded) ZoneCollector::threadBuffer()->end(open.back().site);
+            open.pop_back();
+        }
+    }
+    
+    /**
+     * CPU sampling via perf_event_open for the calling thread (call on each thread of interest)
+     * @return false where the kernel does not allow it; zones keep working regardless
+     */
+    bool enableSampling(uint32_t frequency_hz = 997) {
+        return sampler_.start(frequency_hz) && sampler_.attachThread();
+    }
+    bool attachSamplingThread() { return sampler_.attachThread(); }
     
     // ENIGMA Scale validation
-    bool validateENIGMAScale();
-    double getENIGMAScore() const;
+    bool validateENIGMAScale() {
+        return getENIGMAScore() <= 1.0;
+    }
+    // Projected time for ENIGMA_OPERATIONS operations over the limit (<= 1.0 passes)
+    double getENIGMAScore() const {
+        uint64_t operations = 0;
+        for (const auto& zone : ZoneCollector::instance().stats()) operations += zone.second.count;
+        if (!operations) return 0.0;
+        double per_operation = static_cast<double>(getTotalTime().count()) / operations;
+        return per_operation * ENIGMA_OPERATIONS /
+               std::chrono::duration_cast<std::chrono::nanoseconds>(ENIGMA_TIME_LIMIT).count();
+    }
     
     // Performance analytics
-    std::map<std::string, double> getAverageOperationTimes() const;
-    std::vector<std::string> getBottlenecks() const;
-    void generateFlameGraph(const std::string& filename) const;
+    std::map<std::string, double> getAverageOperationTimes() const {
+        std::map<std::string, double> averages;  // milliseconds
+        for (const auto& zone : ZoneCollector::instance().stats()) {
+            averages[zone.first] = zone.second.total_ns / 1e6 / zone.second.count;
+        }
+        return averages;
+    }
+    // Zones holding at least 10% of all self time, heaviest first
+    std::vector<std::string> getBottlenecks() const {
+        auto stats = ZoneCollector::instance().stats();
+        uint64_t total = 0;
+        std::vector<std::pair<uint64_t, std::string>> ranked;
+        for (const auto& zone : stats) {
+            total += zone.second.self_ns;
+            ranked.emplace_back(zone.second.self_ns, zone.first);
+        }
+        std::sort(ranked.rbegin(), ranked.rend());
+        std::vector<std::string> bottlenecks;
+        for (const auto& zone : ranked) {
+            if (!total || zone.first * 10 < total) break;
+            bottlenecks.push_back(zone.second);
+        }
+        return bottlenecks;
+    }
+    // Folded stacks of zone self time, for flamegraph.pl or speedscope
+    void generateFlameGraph(const std::string& filename) const {
+        ZoneCollector::instance().writeFoldedStacks(filename);
+    }
+    bool generateSampledFlameGraph(const std::string& filename) {
+        return sampler_.writeFoldedStacks(filename);
+    }
+    // Chrome trace event JSON, for chrome://tracing or Perfetto
+    bool exportChromeTrace(const std::string& filename) const {
+        return ZoneCollector::instance().writeChromeTrace(filename);
+    }
     
     // Optimization suggestions
-    std::vector<std::string> getOptimizationSuggestions() const;
-    void clearProfile();
+    std::vector<std::string> getOptimizationSuggestions() const {
+        std::vector<std::string> suggestions;
+        auto stats = ZoneCollector::instance().stats();
+        uint64_t total = 0;
+        for (const auto& zone : stats) total += zone.second.self_ns;
+        for (const auto& name : getBottlenecks()) {
+            const auto& zone = stats[name];
+            char line[256];
+            std::snprintf(line, sizeof(line), "%s: %.0f%% of profiled time, %llu calls, avg %.3fms, max %.3fms",
+                          name.c_str(), 100.0 * zone.self_ns / total, static_cast<unsigned long long>(zone.count),
+                          zone.total_ns / 1e6 / zone.count, zone.max_ns / 1e6);
+            suggestions.push_back(line);
+        }
+        uint64_t dropped = ZoneCollector::instance().droppedZones();
+        if (dropped) {
+            suggestions.push_back(std::to_string(dropped) + " zones dropped: collect more often or profile coarser scopes");
+        }
+        return suggestions;
+    }
+    void clearProfile() { ZoneCollector::instance().clear(); }
     
 private:
-    std::chrono::nanoseconds getTotalTime(const std::string& category = "") const;
-    size_t getOperationCount(const std::string& operation_name) const;
+    struct OpenZone {
+        std::string name;
+        uint32_t site;
+        bool recorded;
+    };
+    static std::vector<OpenZone>& openZones() {
+        thread_local std::vector<OpenZone> open;
+        return open;
+    }
+    
+    // Self time, so nested zones are not counted twice
+    std::chrono::nanoseconds getTotalTime(const std::string& category = "") const {
+        auto& collector = ZoneCollector::instance();
+        auto stats = collector.stats();
+        auto categories = collector.categories();
+        uint64_t total = 0;
+        for (const auto& zone : stats) {
+            if (category.empty() || categories[zone.first] == category) total += zone.second.self_ns;
+        }
+        return std::chrono::nanoseconds(total);
+    }
+    size_t getOperationCount(const std::string& operation_name) const {
+        auto stats = ZoneCollector::instance().stats();
+        auto it = stats.find(operation_name);
+        return it == stats.end() ? 0 : it->second.count;
+    }
 };
 
 /**
@@ -0,0 +1,387 @@
+/*
+ * MEDUSA LIGHTSPEED INOTIFY BACKEND
+ * Kernel change notification for the FileWatcher
+ * - one inotify watch per directory, registered recursively and extended
+ *   as directories appear
+ * - a single file is watched through its parent directory, reporting only
+ *   that file's events
+ * - a blocking read with a wake descriptor instead of a polling loop
+ * - queue overflow is recovered by rescanning only what changed since the
+ *   last consistent point
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace MedusaLightspeed {
+namespace Engine {
+
+/**
+ * Inotify Watch Backend
+ * Reports changed paths; deciding what to do with them is the caller's job
+ */
+class InotifyWatchBackend {
+public:
+    using PathFilter = std::function<bool(const std::filesystem::path&)>;  // true = ignore
+    using ChangeSink = std::function<void(const std::string&)>;
+
+    InotifyWatchBackend() = default;
+    ~InotifyWatchBackend() { close(); }
+
+    InotifyWatchBackend(const InotifyWatchBackend&) = delete;
+    InotifyWatchBackend& operator=(const InotifyWatchBackend&) = delete;
+
+    /**
+     * Create the inotify instance
+     * @return false where inotify is unavailable (caller falls back to polling)
+     */
+    bool open() {
+#ifdef __linux__
+        if (inotify_fd_ >= 0) {
+            return true;
+        }
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (inotify_fd_ < 0 || wake_fd_ < 0) {
+            close();
+            return false;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void close() {
+#ifdef __linux__
+        if (inotify_fd_ >= 0) ::close(inotify_fd_);
+        if (wake_fd_ >= 0) ::close(wake_fd_);
+#endif
+        inotify_fd_ = -1;
+        wake_fd_ = -1;
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        directories_.clear();
+        watch_ids_.clear();
+        roots_.clear();
+        single_files_.clear();
+    }
+
+    bool isOpen() const { return inotify_fd_ >= 0; }
+
+    void setFilter(PathFilter filter) {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        filter_ = std::move(filter);
+    }
+
+    /**
+     * Watch a directory tree, or a single file through its parent directory
+     * @return number of directories registered
+     */
+    size_t addTree(const std::filesystem::path& path) {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        std::error_code ec;
+        std::filesystem::path root = std::filesystem::weakly_canonical(path, ec);
+        if (ec) root = path;
+        roots_.push_back(root);
+        if (std::filesystem::is_directory(root, ec)) {
+            return registerTree(root, nullptr);
+        }
+        single_files_[root.parent_path().string()].insert(root.filename().string());
+        return registerDirectory(root.parent_path()) ? 1 : 0;
+    }
+
+    void removeTree(const std::filesystem::path& path) {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        std::error_code ec;
+        std::filesystem::path root = std::filesystem::weakly_canonical(path, ec);
+        if (ec) root = path;
+        std::string prefix = root.string();
+        roots_.erase(std::remove(roots_.begin(), roots_.end(), root), roots_.end());
+        auto files = single_files_.find(root.parent_path().string());
+        if (files != single_files_.end() && files->second.erase(root.filename().string())) {
+            // A single file: drop its parent's watch once nothing else needs it
+            if (files->second.empty()) {
+                if (!insideTreeRoot(files->first)) {
+                    auto watch = watch_ids_.find(files->first);
+                    if (watch != watch_ids_.end()) {
+#ifdef __linux__
+                        inotify_rm_watch(inotify_fd_, watch->second);
+#endif
+                        directories_.erase(watch->second);
+                        watch_ids_.erase(watch);
+                    }
+                }
+                single_files_.erase(files);
+            }
+            return;
+        }
+        for (auto it = watch_ids_.begin(); it != watch_ids_.end();) {
+            // Directories still holding single-file watches keep theirs
+            if (isWithin(it->first, prefix) && !single_files_.count(it->first)) {
+#ifdef __linux__
+                inotify_rm_watch(inotify_fd_, it->second);
+#endif
+                directories_.erase(it->second);
+                it = watch_ids_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    /**
+     * Wait up to timeout for events and report each changed path once per call
+     * @return false once the backend is closed
+     */
+    bool wait(std::chrono::milliseconds timeout, const ChangeSink& sink) {
+#ifdef __linux__
+        if (inotify_fd_ < 0) {
+            return false;
+        }
+        pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+        int ready = ::poll(fds, 2, static_cast<int>(timeout.count()));
+        if (ready <= 0) {
+            return ready == 0 || errno == EINTR;
+        }
+        if (fds[1].revents & POLLIN) {
+            uint64_t value;
+            ssize_t ignored = ::read(wake_fd_, &value, sizeof(value));
+            (void)ignored;
+        }
+        if (fds[0].revents & POLLIN) {
+            drainEvents(sink);
+        }
+        return true;
+#else
+        (void)timeout;
+        (void)sink;
+        return false;
+#endif
+    }
+
+    // Interrupt a blocked wait() (stop, config change)
+    void wake() {
+#ifdef __linux__
+        if (wake_fd_ >= 0) {
+            uint64_t one = 1;
+            ssize_t ignored = ::write(wake_fd_, &one, sizeof(one));
+            (void)ignored;
+        }
+#endif
+    }
+
+    size_t watchCount() const {
+        std::lock_guard<std::mutex> lock(watch_mutex_);
+        return directories_.size();
+    }
+
+    uint64_t overflowCount() const { return overflows_.load(std::memory_order_relaxed); }
+
+private:
+    static bool isWithin(const std::string& path, const std::string& prefix) {
+        return path.size() >= prefix.size() && path.compare(0, prefix.size(), prefix) == 0 &&
+               (path.size() == prefix.size() || path[prefix.size()] == '/');
+    }
+
+    bool ignored(const std::filesystem::path& path) const { return filter_ && filter_(path); }
+
+    // Caller holds watch_mutex_. True when directory belongs to a watched tree,
+    // not only to single-file watches
+    bool insideTreeRoot(const std::string& directory) const {
+        for (const auto& root : roots_) {
+            auto files = single_files_.find(root.parent_path().string());
+            bool file_root = files != single_files_.end() && files->second.count(root.filename().string());
+            if (!file_root && isWithin(directory, root.string())) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Caller holds watch_mutex_
+    bool registerDirectory(const std::filesystem::path& directory) {
+#ifdef __linux__
+        const uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB |
+                              IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+        int wd = inotify_add_watch(inotify_fd_, directory.c_str(), mask);
+        if (wd < 0) {
+            return false;
+        }
+        std::string key = directory.string();
+        auto previous = directories_.find(wd);
+        if (previous != directories_.end() && previous->second != key) {
+            watch_ids_.erase(previous->second);
+        }
+        directories_[wd] = key;
+        watch_ids_[key] = wd;
+        return true;
+#else
+        (void)directory;
+        return false;
+#endif
+    }
+
+    /**
+     * Register a directory and everything below it
+     * When found is set, every file discovered is added to it: a directory
+     * created (or moved in) may already hold files written before its watch existed.
+     */
+    size_t registerTree(const std::filesystem::path& root, std::vector<std::string>* found) {
+        size_t registered = registerDirectory(root) ? 1 : 0;
+        std::error_code ec;
+        std::filesystem::recursive_directory_iterator it(
+            root, std::filesystem::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+            const auto& entry = *it;
+            if (ignored(entry.path())) {
+                if (entry.is_directory(ec)) it.disable_recursion_pending();
+                continue;
+            }
+            if (entry.is_directory(ec) && !entry.is_symlink(ec)) {
+                registered += registerDirectory(entry.path()) ? 1 : 0;
+            } else if (found) {
+                found->push_back(entry.path().string());
+            }
+        }
+        return registered;
+    }
+
+#ifdef __linux__
+    void drainEvents(const ChangeSink& sink) {
+        alignas(inotify_event) char buffer[64 * 1024];
+        auto started = std::filesystem::file_time_type::clock::now();
+        std::vector<std::string> changed;
+        for (;;) {
+            ssize_t length = ::read(inotify_fd_, buffer, sizeof(buffer));
+            if (length <= 0) {
+                // Anything lost from now on happened after this drain began
+                consistent_since_ = started;
+                break;
+            }
+            std::lock_guard<std::mutex> lock(watch_mutex_);
+            for (char* at = buffer; at < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(at);
+                at += sizeof(inotify_event) + event->len;
+                handleEvent(*event, changed);
+            }
+        }
+        // Report outside watch_mutex_ so the sink may take its own locks
+        for (const auto& path : changed) {
+            sink(path);
+        }
+    }
+
+    // Caller holds watch_mutex_
+    void handleEvent(const inotify_event& event, std::vector<std::string>& changed) {
+        if (event.mask & IN_Q_OVERFLOW) {
+            overflows_.fetch_add(1, std::memory_order_relaxed);
+            recoverOverflow(changed);
+            return;
+        }
+        auto directory = directories_.find(event.wd);
+        if (directory == directories_.end()) {
+            return;
+        }
+        if (event.mask & IN_IGNORED) {
+            watch_ids_.erase(directory->second);
+            directories_.erase(directory);
+            return;
+        }
+        auto files = single_files_.find(directory->second);
+        if (files != single_files_.end() && !insideTreeRoot(directory->second) &&
+            (!event.len || !files->second.count(event.name))) {
+            return;   // a sibling of a file watched on its own
+        }
+
+        std::filesystem::path path = event.len ? std::filesystem::path(directory->second) / event.name
+                                               : std::filesystem::path(directory->second);
+        if (ignored(path)) {
+            return;
+        }
+        if ((event.mask & IN_ISDIR) && (event.mask & (IN_CREATE | IN_MOVED_TO))) {
+            registerTree(path, &changed);
+        } else if ((event.mask & IN_ISDIR) && (event.mask & (IN_DELETE | IN_MOVED_FROM))) {
+            // Watches below it are dropped by the kernel (IN_IGNORED) or must go now if it moved out
+            std::string prefix = path.string();
+            for (auto it = watch_ids_.begin(); it != watch_ids_.end();) {
+                if (isWithin(it->first, prefix)) {
+                    if (event.mask & IN_MOVED_FROM) inotify_rm_watch(inotify_fd_, it->second);
+                    directories_.erase(it->second);
+                    it = watch_ids_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        changed.push_back(path.string());
+    }
+
+    /**
+     * Events were lost: re-register watches and report only entries modified
+     * since the previous drain began (directories included, so deletions and
+     * renames surface as a change to their parent)
+     */
+    void recoverOverflow(std::vector<std::string>& changed) {
+        auto since = consistent_since_ - std::chrono::seconds(1);
+        for (const auto& root : roots_) {
+            std::error_code ec;
+            if (!std::filesystem::is_directory(root, ec)) {
+                changed.push_back(root.string());
+                continue;
+            }
+            registerDirectory(root);
+            std::filesystem::recursive_directory_iterator it(
+                root, std::filesystem::directory_options::skip_permission_denied, ec);
+            for (; !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+                const auto& entry = *it;
+                if (ignored(entry.path())) {
+                    if (entry.is_directory(ec)) it.disable_recursion_pending();
+                    continue;
+                }
+                bool is_directory = entry.is_directory(ec);
+                if (is_directory && !watch_ids_.count(entry.path().string())) {
+                    registerDirectory(entry.path());
+                }
+                auto modified = entry.last_write_time(ec);
+                if (!ec && modified >= since) {
+                    changed.push_back(entry.path().string());
+                }
+            }
+        }
+    }
+#endif
+
+    int inotify_fd_ = -1;
+    int wake_fd_ = -1;
+    mutable std::mutex watch_mutex_;
+    std::unordered_map<int, std::string> directories_;   // watch descriptor -> directory
+    std::unordered_map<std::string, int> watch_ids_;     // directory -> watch descriptor
+    std::vector<std::filesystem::path> roots_;
+    std::unordered_map<std::string, std::unordered_set<std::string>> single_files_;   // parent -> file names
+    PathFilter filter_;
+    std::filesystem::file_time_type consistent_since_ = std::filesystem::file_time_type::clock::now();
+    std::atomic<uint64_t> overflows_{0};
+};
+
+} // namespace Engine
+} // namespace MedusaLightspeed
@@ -0,0 +1,720 @@
+/*
+ * MEDUSA LIGHTSPEED PROFILER
+ * Low-overhead instrumentation behind PerformanceProfiler
+ * - zones: RAII scopes whose names are interned once per call site; entering
+ *   and leaving a zone writes 16 bytes to a per-thread ring, no locks
+ * - ZoneCollector: drains the rings into per-zone statistics, folded stacks
+ *   (flamegraph.pl / speedscope) and Chrome trace events (chrome://tracing,
+ *   Perfetto)
+ * - SampledProfiler: optional perf_event_open CPU sampling of user call
+ *   chains (Linux; needs frame pointers for deep stacks)
+ *
+ * Usage:
+ *   void handle() {
+ *       MEDUSA_PROFILE_FUNCTION();
+ *       { MEDUSA_PROFILE_ZONE("render", "ssr"); ... }
+ *   }
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace MedusaLightspeed {
+namespace Engine {
+
+/**
+ * Zone Site
+ * One per call site (a function-local static); names are never copied
+ */
+struct ZoneSite {
+    const char* name;
+    const char* category;
+    uint32_t id;
+};
+
+/**
+ * Zone Registry
+ * Hands out dense site ids; runs once per call site (or once per distinct
+ * runtime name for the string API)
+ */
+class ZoneRegistry {
+public:
+    static ZoneRegistry& instance() {
+        static ZoneRegistry registry;
+        return registry;
+    }
+
+    uint32_t registerSite(const char* name, const char* category) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sites_.push_back(Site{name, category});
+        return static_cast<uint32_t>(sites_.size() - 1);
+    }
+
+    // For names only known at runtime; each thread keeps its own lookup so repeats stay lock-free
+    uint32_t intern(const std::string& name, const std::string& category) {
+        thread_local std::unordered_map<std::string, uint32_t> local;
+        std::string key = category + '\0' + name;
+        auto cached = local.find(key);
+        if (cached != local.end()) return cached->second;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = runtime_.find(key);
+        if (it == runtime_.end()) {
+            owned_.emplace_back(new std::string(name));
+            owned_.emplace_back(new std::string(category));
+            sites_.push_back(Site{owned_[owned_.size() - 2]->c_str(), owned_.back()->c_str()});
+            it = runtime_.emplace(key, static_cast<uint32_t>(sites_.size() - 1)).first;
+        }
+        local.emplace(key, it->second);
+        return it->second;
+    }
+
+    std::string name(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return id < sites_.size() ? sites_[id].name : "?";
+    }
+
+    std::string category(uint32_t id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return id < sites_.size() ? sites_[id].category : "?";
+    }
+
+private:
+    struct Site {
+        const char* name;
+        const char* category;
+    };
+    mutable std::mutex mutex_;
+    std::vector<Site> sites_;
+    std::unordered_map<std::string, uint32_t> runtime_;
+    std::vector<std::unique_ptr<std::string>> owned_;
+};
+
+inline uint64_t profileNow() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * Per-thread event ring
+ * Single producer (the owning thread), single consumer (the collector).
+ * Every recorded begin keeps a slot reserved for its end, so a full ring
+ * drops whole zones and never leaves one open.
+ */
+class ZoneEventBuffer {
+public:
+    static constexpr size_t kCapacity = 1 << 16;
+
+    struct Event {
+        uint64_t timestamp;
+        uint32_t site;
+        uint32_t begin;  // 1 = enter, 0 = leave
+    };
+
+    explicit ZoneEventBuffer(uint32_t thread_id) : thread_id_(thread_id), events_(new Event[kCapacity]) {}
+
+    bool begin(uint32_t site) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) + reserved_ + 2 > kCapacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        events_[head & (kCapacity - 1)] = Event{profileNow(), site, 1};
+        head_.store(head + 1, std::memory_order_release);
+        ++reserved_;
+        return true;
+    }
+
+    void end(uint32_t site) {
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        events_[head & (kCapacity - 1)] = Event{profileNow(), site, 0};
+        head_.store(head + 1, std::memory_order_release);
+        --reserved_;
+    }
+
+    // Collector side
+    template<typename Fn>
+    void drain(Fn&& fn) {
+        uint64_t tail = tail_.load(std::memory_order_relaxed);
+        uint64_t head = head_.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            fn(events_[tail & (kCapacity - 1)]);
+        }
+        tail_.store(tail, std::memory_order_release);
+    }
+
+    uint32_t threadId() const { return thread_id_; }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    void retire() { retired_.store(true, std::memory_order_release); }
+    bool retired() const { return retired_.load(std::memory_order_acquire); }
+
+private:
+    uint32_t thread_id_;
+    std::unique_ptr<Event[]> events_;
+    alignas(64) std::atomic<uint64_t> head_{0};
+    size_t reserved_ = 0;  // producer only
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> retired_{false};
+};
+
+/**
+ * Zone Collector
+ * Owns every thread's ring and turns drained events into reports
+ */
+class ZoneCollector {
+public:
+    struct ZoneStats {
+        uint64_t count = 0;
+        uint64_t total_ns = 0;
+        uint64_t self_ns = 0;
+        uint64_t min_ns = UINT64_MAX;
+        uint64_t max_ns = 0;
+    };
+
+    static constexpr size_t kMaxTraceEvents = 1 << 20;  // oldest complete events are dropped beyond this
+
+    static ZoneCollector& instance() {
+        static ZoneCollector collector;
+        return collector;
+    }
+
+    ~ZoneCollector() { stopBackground(); }
+
+    // Recording is off until enabled; a disabled zone costs one relaxed load
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    static ZoneEventBuffer* threadBuffer() {
+        thread_local ThreadHandle handle;
+        return handle.buffer.get();
+    }
+
+    // Drain every ring into the aggregates; also done periodically by the background thread
+    void collect() {
+        std::vector<std::shared_ptr<ZoneEventBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(buffers_mutex_);
+            buffers = buffers_;
+        }
+        std::vector<ZoneEventBuffer*> finished;
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        for (const auto& buffer : buffers) {
+            // A thread retires after its last event, so this drain empties it for good
+            bool retired = buffer->retired();
+            ThreadState& thread = threads_[buffer->threadId()];
+            buffer->drain([&](const ZoneEventBuffer::Event& event) { apply(buffer->threadId(), thread, event); });
+            if (retired) {
+                finished.push_back(buffer.get());
+                threads_.erase(buffer->threadId());
+            }
+        }
+        if (finished.empty()) return;
+        std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+        for (ZoneEventBuffer* buffer : finished) {
+            dropped_retired_ += buffer->dropped();
+        }
+        buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                      [&](const std::shared_ptr<ZoneEventBuffer>& buffer) {
+                                          return std::find(finished.begin(), finished.end(), buffer.get()) !=
+                                                 finished.end();
+                                      }),
+                       buffers_.end());
+    }
+
+    void startBackground(std::chrono::milliseconds interval = std::chrono::milliseconds(50)) {
+        std::lock_guard<std::mutex> lock(thread_mutex_);
+        if (collector_thread_.joinable()) return;
+        stop_requested_ = false;
+        collector_thread_ = std::thread([this, interval] {
+            std::unique_lock<std::mutex> lock(thread_mutex_);
+            while (!stop_requested_) {
+                stop_condition_.wait_for(lock, interval, [this] { return stop_requested_; });
+                lock.unlock();
+                collect();
+                lock.lock();
+            }
+        });
+    }
+
+    void stopBackground() {
+        {
+            std::lock_guard<std::mutex> lock(thread_mutex_);
+            stop_requested_ = true;
+        }
+        stop_condition_.notify_all();
+        if (collector_thread_.joinable()) collector_thread_.join();
+    }
+
+    std::map<std::string, ZoneStats> stats() {
+        collect();
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        std::map<std::string, ZoneStats> out;
+        for (const auto& entry : stats_) {
+            // The same name may be interned under several categories
+            ZoneStats& merged = out[ZoneRegistry::instance().name(entry.first)];
+            merged.count += entry.second.count;
+            merged.total_ns += entry.second.total_ns;
+            merged.self_ns += entry.second.self_ns;
+            merged.min_ns = std::min(merged.min_ns, entry.second.min_ns);
+            merged.max_ns = std::max(merged.max_ns, entry.second.max_ns);
+        }
+        return out;
+    }
+
+    std::map<std::string, std::string> categories() {
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        std::map<std::string, std::string> out;
+        for (const auto& entry : stats_) {
+            out[ZoneRegistry::instance().name(entry.first)] = ZoneRegistry::instance().category(entry.first);
+        }
+        return out;
+    }
+
+    /**
+     * Folded stacks, one "outer;inner;leaf <self microseconds>" line each
+     */
+    bool writeFoldedStacks(const std::string& filename) {
+        collect();
+        std::ofstream out(filename, std::ios::trunc);
+        if (!out) return false;
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        for (const auto& stack : folded_) {
+            uint64_t micros = stack.second / 1000;
+            if (!micros) continue;
+            for (size_t i = 0; i < stack.first.size(); ++i) {
+                if (i) out << ';';
+                out << ZoneRegistry::instance().name(stack.first[i]);
+            }
+            out << ' ' << micros << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    // Chrome trace event format ("X" complete events, microsecond timestamps)
+    bool writeChromeTrace(const std::string& filename) {
+        collect();
+        std::ofstream out(filename, std::ios::trunc);
+        if (!out) return false;
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        out << "{\"traceEvents\":[";
+        char line[96];
+        bool first = true;
+        for (const auto& event : trace_) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":\"" << jsonEscape(ZoneRegistry::instance().name(event.site)) << "\",\"cat\":\""
+                << jsonEscape(ZoneRegistry::instance().category(event.site)) << "\",\"ph\":\"X\"";
+            std::snprintf(line, sizeof(line), ",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                          (event.start - epoch_) / 1000.0, event.duration / 1000.0, event.thread);
+            out << line;
+        }
+        out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        return static_cast<bool>(out);
+    }
+
+    uint64_t droppedZones() {
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        uint64_t dropped = dropped_retired_;
+        for (const auto& buffer : buffers_) dropped += buffer->dropped();
+        return dropped;
+    }
+
+    void clear() {
+        collect();
+        std::lock_guard<std::mutex> lock(data_mutex_);
+        stats_.clear();
+        folded_.clear();
+        trace_.clear();
+    }
+
+private:
+    struct Frame {
+        uint32_t site;
+        uint64_t start;
+        uint64_t child_ns;
+    };
+    struct ThreadState {
+        std::vector<Frame> stack;
+        std::vector<uint32_t> path;
+    };
+    struct TraceEvent {
+        uint64_t start;
+        uint64_t duration;
+        uint32_t site;
+        uint32_t thread;
+    };
+    struct PathHash {
+        size_t operator()(const std::vector<uint32_t>& path) const {
+            size_t h = 1469598103934665603ULL;
+            for (uint32_t id : path) h = (h ^ id) * 1099511628211ULL;
+            return h;
+        }
+    };
+
+    // The thread's ring outlives the thread until the collector has drained it
+    struct ThreadHandle {
+        std::shared_ptr<ZoneEventBuffer> buffer;
+        ThreadHandle() {
+            ZoneCollector& collector = instance();
+            buffer = std::make_shared<ZoneEventBuffer>(collector.next_thread_.fetch_add(1) + 1);
+            std::lock_guard<std::mutex> lock(collector.buffers_mutex_);
+            collector.buffers_.push_back(buffer);
+        }
+        ~ThreadHandle() { buffer->retire(); }
+    };
+
+    ZoneCollector() : epoch_(profileNow()) {}
+
+    // Caller holds data_mutex_
+    void apply(uint32_t thread_id, ThreadState& thread, const ZoneEventBuffer::Event& event) {
+        if (event.begin) {
+            thread.stack.push_back(Frame{event.site, event.timestamp, 0});
+            thread.path.push_back(event.site);
+            return;
+        }
+        if (thread.stack.empty() || thread.stack.back().site != event.site) {
+            return;  // zone opened before clear()
+        }
+        Frame frame = thread.stack.back();
+        uint64_t duration = event.timestamp - frame.start;
+        uint64_t self = duration > frame.child_ns ? duration - frame.child_ns : 0;
+
+        ZoneStats& stats = stats_[event.site];
+        ++stats.count;
+        stats.total_ns += duration;
+        stats.self_ns += self;
+        stats.min_ns = std::min(stats.min_ns, duration);
+        stats.max_ns = std::max(stats.max_ns, duration);
+        folded_[thread.path] += self;
+
+        if (trace_.size() >= kMaxTraceEvents) {
+            trace_.erase(trace_.begin(), trace_.begin() + kMaxTraceEvents / 4);
+        }
+        trace_.push_back(TraceEvent{frame.start, duration, event.site, thread_id});
+
+        thread.stack.pop_back();
+        thread.path.pop_back();
+        if (!thread.stack.empty()) thread.stack.back().child_ns += duration;
+    }
+
+    static std::string jsonEscape(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                out += ' ';
+            } else {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint32_t> next_thread_{0};
+    uint64_t epoch_;
+
+    std::mutex buffers_mutex_;
+    std::vector<std::shared_ptr<ZoneEventBuffer>> buffers_;
+    uint64_t dropped_retired_ = 0;
+
+    std::mutex data_mutex_;
+    std::unordered_map<uint32_t, ThreadState> threads_;
+    std::unordered_map<uint32_t, ZoneStats> stats_;
+    std::unordered_map<std::vector<uint32_t>, uint64_t, PathHash> folded_;
+    std::vector<TraceEvent> trace_;
+
+    std::mutex thread_mutex_;
+    std::condition_variable stop_condition_;
+    std::thread collector_thread_;
+    bool stop_requested_ = false;
+};
+
+/**
+ * Scoped Zone
+ * Records nothing (and touches no thread state) while profiling is disabled
+ */
+class ScopedZone {
+public:
+    explicit ScopedZone(const ZoneSite& site) : site_(site.id) {
+        if (ZoneCollector::instance().isEnabled()) {
+            buffer_ = ZoneCollector::threadBuffer();
+            if (!buffer_->begin(site_)) buffer_ = nullptr;
+        }
+    }
+    ~ScopedZone() {
+        if (buffer_) buffer_->end(site_);
+    }
+
+    ScopedZone(const ScopedZone&) = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+
+private:
+    uint32_t site_;
+    ZoneEventBuffer* buffer_ = nullptr;
+};
+
+#define MEDUSA_PROFILE_CONCAT_INNER(a, b) a##b
+#define MEDUSA_PROFILE_CONCAT(a, b) MEDUSA_PROFILE_CONCAT_INNER(a, b)
+#define MEDUSA_PROFILE_ZONE(name, category)                                                          \
+    static const ::MedusaLightspeed::Engine::ZoneSite MEDUSA_PROFILE_CONCAT(_medusa_site_, __LINE__){ \
+        name, category, ::MedusaLightspeed::Engine::ZoneRegistry::instance().registerSite(name, category)}; \
+    ::MedusaLightspeed::Engine::ScopedZone MEDUSA_PROFILE_CONCAT(_medusa_zone_, __LINE__)(           \
+        MEDUSA_PROFILE_CONCAT(_medusa_site_, __LINE__))
+#define MEDUSA_PROFILE_FUNCTION() MEDUSA_PROFILE_ZONE(__func__, "function")
+
+/**
+ * Sampled Profiler
+ * CPU-clock sampling through perf_event_open, one event per attached thread.
+ * Needs perf_event_paranoid <= 2 (the default on most distributions),
+ * -fno-omit-frame-pointer for full user call chains and -rdynamic for the
+ * executable's own symbols (otherwise frames are module+offset).
+ */
+class SampledProfiler {
+public:
+    ~SampledProfiler() { stop(); }
+
+    /**
+     * Start the reader; call attachThread() on each thread to sample
+     */
+    bool start(uint32_t frequency_hz = 997) {
+#ifdef __linux__
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) return true;
+        frequency_hz_ = frequency_hz;
+        running_ = true;
+        reader_ = std::thread([this] { readLoop(); });
+        return true;
+#else
+        (void)frequency_hz;
+        return false;
+#endif
+    }
+
+    // Keeps the collected stacks; closes every attached event
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+        }
+        condition_.notify_all();
+        if (reader_.joinable()) reader_.join();
+#ifdef __linux__
+        std::lock_guard<std::mutex> lock(mutex_);
+        drainAll();
+        for (auto& stream : streams_) {
+            munmap(stream.ring, stream.ring_size);
+            ::close(stream.fd);
+        }
+        streams_.clear();
+#endif
+    }
+
+    // @return false if the kernel refused (no permission, no perf support)
+    bool attachThread() {
+#ifdef __linux__
+        std::unique_lock<std::mutex> lock(mutex_);
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_SOFTWARE;
+        attr.config = PERF_COUNT_SW_TASK_CLOCK;
+        attr.freq = 1;
+        attr.sample_freq = frequency_hz_;
+        attr.sample_type = PERF_SAMPLE_TID | PERF_SAMPLE_CALLCHAIN;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.exclude_callchain_kernel = 1;
+
+        pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+        if (fd < 0) return false;
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t ring_size = page * (1 + kRingPages);
+        void* ring = mmap(nullptr, ring_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (ring == MAP_FAILED) {
+            ::close(fd);
+            return false;
+        }
+        streams_.push_back(Stream{fd, static_cast<perf_event_mmap_page*>(ring), ring_size, page});
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Folded stacks of symbolised frames, "root;...;leaf <samples>"
+     */
+    bool writeFoldedStacks(const std::string& filename) {
+        std::lock_guard<std::mutex> lock(mutex_);
+#ifdef __linux__
+        drainAll();
+#endif
+        std::ofstream out(filename, std::ios::trunc);
+        if (!out) return false;
+        for (const auto& stack : stacks_) {
+            for (size_t i = stack.first.size(); i-- > 0;) {
+                out << symbol(stack.first[i]) << (i ? ";" : "");
+            }
+            out << ' ' << stack.second << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    uint64_t sampleCount() const { return samples_.load(std::memory_order_relaxed); }
+    uint64_t lostCount() const { return lost_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kRingPages = 64;  // power of two, as perf requires
+
+    struct StackHash {
+        size_t operator()(const std::vector<uint64_t>& stack) const {
+            size_t h = 1469598103934665603ULL;
+            for (uint64_t ip : stack) h = (h ^ ip) * 1099511628211ULL;
+            return h;
+        }
+    };
+
+#ifdef __linux__
+    struct Stream {
+        int fd;
+        perf_event_mmap_page* ring;
+        size_t ring_size;
+        size_t page;
+    };
+
+    void readLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            condition_.wait_for(lock, std::chrono::milliseconds(20), [this] { return !running_; });
+            drainAll();
+        }
+    }
+
+    // Caller holds mutex_
+    void drainAll() {
+        std::vector<unsigned char> record;
+        for (auto& stream : streams_) {
+            unsigned char* data = reinterpret_cast<unsigned char*>(stream.ring) + stream.page;
+            uint64_t size = stream.page * kRingPages;
+            uint64_t head = __atomic_load_n(&stream.ring->data_head, __ATOMIC_ACQUIRE);
+            uint64_t tail = stream.ring->data_tail;
+            while (tail + sizeof(perf_event_header) <= head) {
+                perf_event_header header;
+                copyOut(data, size, tail, &header, sizeof(header));
+                if (header.size < sizeof(header) || tail + header.size > head) break;
+                record.resize(header.size);
+                copyOut(data, size, tail, record.data(), header.size);
+                tail += header.size;
+                if (header.type == PERF_RECORD_SAMPLE) {
+                    parseSample(record.data() + sizeof(header), header.size - sizeof(header));
+                } else if (header.type == PERF_RECORD_LOST) {
+                    uint64_t lost;
+                    std::memcpy(&lost, record.data() + sizeof(header) + sizeof(uint64_t), sizeof(lost));
+                    lost_.fetch_add(lost, std::memory_order_relaxed);
+                }
+            }
+            __atomic_store_n(&stream.ring->data_tail, tail, __ATOMIC_RELEASE);
+        }
+    }
+
+    static void copyOut(const unsigned char* data, uint64_t size, uint64_t offset, void* out, size_t length) {
+        size_t start = static_cast<size_t>(offset & (size - 1));
+        size_t first = std::min(length, static_cast<size_t>(size - start));
+        std::memcpy(out, data + start, first);
+        std::memcpy(static_cast<unsigned char*>(out) + first, data, length - first);
+    }
+
+    // PERF_SAMPLE_TID then PERF_SAMPLE_CALLCHAIN: u32 pid, u32 tid, u64 nr, u64 ips[nr]
+    void parseSample(const unsigned char* body, size_t length) {
+        if (length < 16) return;
+        uint64_t count;
+        std::memcpy(&count, body + 8, sizeof(count));
+        if (16 + count * 8 > length) return;
+        std::vector<uint64_t> stack;
+        stack.reserve(count);
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t ip;
+            std::memcpy(&ip, body + 16 + i * 8, sizeof(ip));
+            if (ip >= static_cast<uint64_t>(PERF_CONTEXT_MAX)) continue;  // context markers
+            stack.push_back(ip);
+        }
+        if (stack.empty()) return;
+        ++stacks_[stack];
+        samples_.fetch_add(1, std::memory_order_relaxed);
+    }
+#endif
+
+    // Caller holds mutex_
+    std::string symbol(uint64_t ip) {
+        auto cached = symbols_.find(ip);
+        if (cached != symbols_.end()) return cached->second;
+        char fallback[32];
+        std::snprintf(fallback, sizeof(fallback), "0x%llx", static_cast<unsigned long long>(ip));
+        std::string name = fallback;
+#ifdef __linux__
+        Dl_info info;
+        if (dladdr(reinterpret_cast<void*>(ip), &info) && info.dli_sname) {
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            name = status == 0 && demangled ? demangled : info.dli_sname;
+            std::free(demangled);
+        } else if (dladdr(reinterpret_cast<void*>(ip), &info) && info.dli_fname) {
+            // Module-relative, so addr2line can resolve it offline
+            std::snprintf(fallback, sizeof(fallback), "+0x%llx",
+                          static_cast<unsigned long long>(ip - reinterpret_cast<uint64_t>(info.dli_fbase)));
+            name = std::string(info.dli_fname) + fallback;
+        }
+#endif
+        // ';' separates frames in the folded format
+        std::replace(name.begin(), name.end(), ';', ':');
+        symbols_.emplace(ip, name);
+        return name;
+    }
+
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::thread reader_;
+    bool running_ = false;
+    uint32_t frequency_hz_ = 997;
+#ifdef __linux__
+    std::vector<Stream> streams_;
+#endif
+    std::unordered_map<std::vector<uint64_t>, uint64_t, StackHash> stacks_;  // leaf first
+    std::unordered_map<uint64_t, std::string> symbols_;
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> lost_{0};
+};
+
+} // namespace Engine
+} // namespace MedusaLightspeed
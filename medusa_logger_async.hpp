@@ -0,0 +1,780 @@
+#pragma once
+
+/*
+ * MEDUSA ASYNC LOG BACKEND
+ * ========================
+ *
+ * Low-latency backend for Logger:
+ * - every logging thread owns a lock-free single-producer ring of binary
+ *   records (level, TSC timestamp, format pointer, packed arguments)
+ * - one consumer thread merges the rings by timestamp, does all printf
+ *   formatting and writes in large blocks
+ * - the log file rotates by size and/or age
+ *
+ * Format strings are kept by pointer, so formats with arguments must be
+ * string literals (the LOG_* macros always are). Arguments are copied,
+ * strings included, so they may die as soon as the call returns.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+struct AsyncLogConfig {
+    std::string path;                                   // empty = no file output
+    bool console_output = true;
+    int console_min_level = 0;
+    size_t ring_bytes = 1 << 20;                        // per logging thread
+    size_t write_buffer_bytes = 256 * 1024;
+    size_t max_string_bytes = 16 * 1024;                // longer string arguments are truncated
+    std::chrono::milliseconds flush_interval{5};
+    uint64_t max_file_bytes = 64ull * 1024 * 1024;      // 0 = no size rotation
+    std::chrono::seconds rotate_interval{0};            // 0 = no time rotation
+    unsigned max_rotated_files = 5;                     // path.1 .. path.N
+    int block_level = 3;                                // at or above: wait for ring space instead of dropping
+    int flush_level = 4;                                // at or above: return only once written
+    std::function<void()> on_rotate;                    // consumer thread, after path has been renamed away
+    const char* level_names[8] = {"DEBUG", "INFO", "WARN", "ERROR", "FATAL", "L5", "L6", "L7"};
+};
+
+namespace AsyncLogDetail {
+
+enum ArgTag : uint8_t { kSigned, kUnsigned, kDouble, kString, kPointer };
+
+constexpr uint32_t kWrapMarker = UINT32_MAX;
+
+struct RecordHeader {
+    uint32_t size;          // whole record, 8-byte aligned; kWrapMarker = skip to ring start
+    uint8_t level;
+    uint8_t argc;
+    uint16_t reserved;
+    uint64_t tsc;
+    const char* format;
+};
+
+inline uint64_t readTsc() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/**
+ * @brief Single-producer single-consumer byte ring of variable-length records
+ * @details Positions are monotonically increasing byte counts; a record that
+ *          would straddle the end is preceded by a wrap marker instead.
+ */
+struct Ring {
+    explicit Ring(size_t bytes) {
+        size_t capacity = 4096;
+        while (capacity < bytes) {
+            capacity <<= 1;
+        }
+        data.reset(new char[capacity]);
+        mask = capacity - 1;
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Producer: space for n bytes (multiple of 8), or nullptr if full
+    char* reserve(size_t n) {
+        uint64_t pos = head.load(std::memory_order_relaxed);
+        size_t offset = static_cast<size_t>(pos & mask);
+        size_t contiguous = capacity() - offset;
+        size_t needed = n <= contiguous ? n : contiguous + n;
+        if (pos + needed - cached_tail > capacity()) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (pos + needed - cached_tail > capacity()) {
+                return nullptr;
+            }
+        }
+        if (n > contiguous) {
+            uint32_t marker = kWrapMarker;
+            std::memcpy(data.get() + offset, &marker, sizeof(marker));
+            pos += contiguous;
+            offset = 0;
+        }
+        pending_head = pos + n;
+        return data.get() + offset;
+    }
+
+    void commit() { head.store(pending_head, std::memory_order_release); }
+
+    std::unique_ptr<char[]> data;
+    size_t mask = 0;
+    alignas(64) std::atomic<uint64_t> head{0};
+    uint64_t pending_head = 0;
+    uint64_t cached_tail = 0;
+    alignas(64) std::atomic<uint64_t> tail{0};
+    std::atomic<bool> retired{false};
+};
+
+// Bytes an argument occupies after its tag byte
+template<typename T>
+size_t packedSize(const T& value, size_t max_string) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+        size_t len = value ? std::strlen(value) : 6;
+        return sizeof(uint32_t) + std::min(len, max_string);
+    } else if constexpr (std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>) {
+        return sizeof(uint32_t) + std::min(value.size(), max_string);
+    } else {
+        return sizeof(uint64_t);
+    }
+}
+
+inline char* packString(char* out, const char* s, size_t len, size_t max_string) {
+    uint32_t n = static_cast<uint32_t>(std::min(len, max_string));
+    *out++ = static_cast<char>(kString);
+    std::memcpy(out, &n, sizeof(n));
+    std::memcpy(out + sizeof(n), s, n);
+    return out + sizeof(n) + n;
+}
+
+template<typename T>
+char* packArg(char* out, const T& value, size_t max_string) {
+    using U = std::decay_t<T>;
+    if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>) {
+        return value ? packString(out, value, std::strlen(value), max_string)
+                     : packString(out, "(null)", 6, max_string);
+    } else if constexpr (std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>) {
+        return packString(out, value.data(), value.size(), max_string);
+    } else {
+        uint8_t tag;
+        uint64_t bits;
+        if constexpr (std::is_floating_point_v<U>) {
+            double d = static_cast<double>(value);
+            tag = kDouble;
+            std::memcpy(&bits, &d, sizeof(bits));
+        } else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+            tag = kPointer;
+            bits = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+        } else if constexpr (std::is_enum_v<U>) {
+            tag = kSigned;
+            bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+        } else if constexpr (std::is_signed_v<U>) {
+            tag = kSigned;
+            bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+        } else {
+            static_assert(std::is_integral_v<U>, "unsupported log argument type");
+            tag = kUnsigned;
+            bits = static_cast<uint64_t>(value);
+        }
+        *out++ = static_cast<char>(tag);
+        std::memcpy(out, &bits, sizeof(bits));
+        return out + sizeof(bits);
+    }
+}
+
+/**
+ * @brief Cursor over a record's packed arguments
+ */
+class ArgReader {
+public:
+    ArgReader(const char* data, unsigned count) : data_(data), remaining_(count) {}
+
+    bool next(uint8_t& tag, uint64_t& bits, std::string_view& text) {
+        if (remaining_ == 0) {
+            return false;
+        }
+        --remaining_;
+        tag = static_cast<uint8_t>(*data_++);
+        if (tag == kString) {
+            uint32_t n;
+            std::memcpy(&n, data_, sizeof(n));
+            text = std::string_view(data_ + sizeof(n), n);
+            data_ += sizeof(n) + n;
+        } else {
+            std::memcpy(&bits, data_, sizeof(bits));
+            data_ += sizeof(bits);
+        }
+        return true;
+    }
+
+private:
+    const char* data_;
+    unsigned remaining_;
+};
+
+inline void appendNumber(std::string& out, const char* spec, uint8_t tag, uint64_t bits, char conversion) {
+    char buf[128];
+    int n = 0;
+    if (tag == kDouble) {
+        double d;
+        std::memcpy(&d, &bits, sizeof(d));
+        n = std::snprintf(buf, sizeof(buf), spec, d);
+    } else if (conversion == 'c') {
+        n = std::snprintf(buf, sizeof(buf), spec, static_cast<int>(bits));
+    } else if (conversion == 'p') {
+        n = std::snprintf(buf, sizeof(buf), spec, reinterpret_cast<void*>(static_cast<uintptr_t>(bits)));
+    } else if (tag == kSigned) {
+        n = std::snprintf(buf, sizeof(buf), spec, static_cast<long long>(bits));
+    } else {
+        n = std::snprintf(buf, sizeof(buf), spec, static_cast<unsigned long long>(bits));
+    }
+    if (n > 0) {
+        out.append(buf, std::min(static_cast<size_t>(n), sizeof(buf) - 1));
+    }
+}
+
+/**
+ * @brief printf-style formatting from packed arguments
+ * @details Each conversion is re-issued to snprintf with the length modifier
+ *          rewritten to match the stored type, so a mismatched specifier
+ *          prints the argument in its natural form instead of reading garbage.
+ */
+inline void formatRecord(std::string& out, const char* format, ArgReader args) {
+    const char* p = format;
+    while (*p) {
+        const char* percent = std::strchr(p, '%');
+        if (!percent) {
+            out.append(p);
+            return;
+        }
+        out.append(p, static_cast<size_t>(percent - p));
+        p = percent + 1;
+        if (*p == '%') {
+            out.push_back('%');
+            ++p;
+            continue;
+        }
+
+        // %[flags][width][.precision][length]conversion
+        char spec[64];
+        size_t len = 0;
+        spec[len++] = '%';
+        bool star_failed = false;
+        auto copyRun = [&](const char* accept) {
+            while (*p && std::strchr(accept, *p)) {
+                if (len < 20) spec[len++] = *p;
+                ++p;
+            }
+        };
+        auto copyWidth = [&]() {
+            if (*p == '*') {
+                ++p;
+                uint8_t tag;
+                uint64_t bits;
+                std::string_view text;
+                if (args.next(tag, bits, text) && tag != kString) {
+                    len += static_cast<size_t>(std::snprintf(spec + len, 12, "%d",
+                                                             static_cast<int>(bits)));
+                } else {
+                    star_failed = true;
+                }
+            } else {
+                copyRun("0123456789");
+            }
+        };
+        copyRun("-+ #0");
+        copyWidth();
+        if (*p == '.') {
+            spec[len++] = *p++;
+            copyWidth();
+        }
+        while (*p && std::strchr("hlLqjzt", *p)) {
+            ++p;
+        }
+        char conversion = *p;
+        if (!conversion) {
+            out.append(percent);
+            return;
+        }
+        ++p;
+        if (conversion == 'n' || star_failed) {
+            continue;
+        }
+
+        uint8_t tag;
+        uint64_t bits = 0;
+        std::string_view text;
+        if (!args.next(tag, bits, text)) {
+            out.append(percent, static_cast<size_t>(p - percent));
+            continue;
+        }
+        if (tag == kString) {
+            if (conversion == 's' && len == 1) {
+                out.append(text.data(), text.size());
+            } else {
+                // Width/precision on a string: snprintf needs a terminated copy
+                std::string copy(text);
+                spec[len++] = 's';
+                spec[len] = '\0';
+                int n = std::snprintf(nullptr, 0, spec, copy.c_str());
+                if (n > 0) {
+                    size_t at = out.size();
+                    out.resize(at + static_cast<size_t>(n) + 1);
+                    std::snprintf(&out[at], static_cast<size_t>(n) + 1, spec, copy.c_str());
+                    out.resize(at + static_cast<size_t>(n));
+                }
+            }
+            continue;
+        }
+
+        if (tag == kDouble) {
+            if (!std::strchr("eEfFgGaA", conversion)) conversion = 'g';
+        } else if (tag == kPointer) {
+            conversion = 'p';
+        } else if (!std::strchr("diouxXc", conversion)) {
+            conversion = tag == kSigned ? 'd' : 'u';
+        }
+        if (tag != kDouble && conversion != 'c' && conversion != 'p') {
+            spec[len++] = 'l';
+            spec[len++] = 'l';
+        }
+        spec[len++] = conversion;
+        spec[len] = '\0';
+        appendNumber(out, spec, tag, bits, conversion);
+    }
+}
+
+} // namespace AsyncLogDetail
+
+/**
+ * @brief Per-thread rings drained by one formatting/writing thread
+ */
+class AsyncLogBackend {
+public:
+    explicit AsyncLogBackend(AsyncLogConfig config)
+        : m_config(std::move(config)), m_id(NextId()) {
+        Calibrate();
+    }
+
+    ~AsyncLogBackend() { Stop(); }
+
+    AsyncLogBackend(const AsyncLogBackend&) = delete;
+    AsyncLogBackend& operator=(const AsyncLogBackend&) = delete;
+
+    /**
+     * @brief Open the log file and start the consumer thread
+     * @return false if the file cannot be opened (console output still runs)
+     */
+    bool Start() {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (m_running.load(std::memory_order_acquire)) {
+            return true;
+        }
+        bool opened = m_config.path.empty() || OpenFile();
+        m_running.store(true, std::memory_order_release);
+        m_consumer = std::thread([this]() { Run(); });
+        return opened;
+    }
+
+    /**
+     * @brief Drain every ring, write, and stop the consumer thread
+     */
+    void Stop() {
+        std::lock_guard<std::mutex> lock(m_controlMutex);
+        if (!m_running.load(std::memory_order_acquire)) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> wake(m_wakeMutex);
+            m_running.store(false, std::memory_order_release);
+        }
+        m_wake.notify_all();
+        if (m_consumer.joinable()) {
+            m_consumer.join();
+        }
+        if (m_file) {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+    }
+
+    /**
+     * @brief Queue one record; the caller never formats or touches I/O
+     * @return false if the record was dropped because the ring was full
+     */
+    template<typename... Args>
+    bool Submit(int level, const char* format, const Args&... args) {
+        using namespace AsyncLogDetail;
+        static_assert(sizeof...(Args) < 256, "too many log arguments");
+        AsyncLogDetail::Ring& ring = ThreadRing();
+        size_t max_string = m_config.max_string_bytes;
+        // Decay first: a literal argument must reach the const char* branch as a pointer, not an array
+        size_t size = sizeof(RecordHeader) +
+                      (size_t(0) + ... + (1 + packedSize(static_cast<const std::decay_t<const Args&>&>(args), max_string)));
+        size = (size + 7) & ~size_t(7);
+        if (size > ring.capacity() / 4) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        char* out = ring.reserve(size);
+        while (!out) {
+            if (level < m_config.block_level || !m_running.load(std::memory_order_acquire)) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_wake.notify_one();
+            std::this_thread::yield();
+            out = ring.reserve(size);
+        }
+
+        RecordHeader header{static_cast<uint32_t>(size), static_cast<uint8_t>(level & 7),
+                            static_cast<uint8_t>(sizeof...(Args)), 0, readTsc(), format};
+        std::memcpy(out, &header, sizeof(header));
+        char* cursor = out + sizeof(header);
+        ((cursor = packArg(cursor, static_cast<const std::decay_t<const Args&>&>(args), max_string)), ...);
+        (void)cursor;
+        ring.commit();
+
+        // Past half full: wake the consumer early rather than waiting out flush_interval
+        if (ring.pending_head - ring.cached_tail > ring.capacity() / 2) {
+            ring.cached_tail = ring.tail.load(std::memory_order_acquire);
+            if (ring.pending_head - ring.cached_tail > ring.capacity() / 2 &&
+                !m_wakePending.exchange(true, std::memory_order_acq_rel)) {
+                m_wake.notify_one();
+            }
+        }
+
+        if (level >= m_config.flush_level) {
+            Flush();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Block until everything submitted before the call has been written
+     */
+    void Flush() {
+        if (!m_running.load(std::memory_order_acquire) || std::this_thread::get_id() == m_consumer.get_id()) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        uint64_t target = ++m_flushRequested;
+        m_wake.notify_all();
+        m_flushed.wait(lock, [&]() {
+            return m_flushCompleted >= target || !m_running.load(std::memory_order_acquire);
+        });
+    }
+
+    uint64_t DroppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+    uint64_t WrittenCount() const { return m_written.load(std::memory_order_relaxed); }
+    const AsyncLogConfig& Config() const { return m_config; }
+
+private:
+    struct Pending {
+        uint64_t tsc;
+        const char* record;
+    };
+
+    struct RingSlot {
+        std::shared_ptr<AsyncLogDetail::Ring> ring;
+        uint64_t drain_to = 0;
+    };
+
+    // Marks the thread's ring retired on thread exit so the consumer can reclaim it
+    struct ThreadRingHolder {
+        uint64_t backend_id = 0;
+        std::shared_ptr<AsyncLogDetail::Ring> ring;
+        ~ThreadRingHolder() {
+            if (ring) ring->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    static uint64_t NextId() {
+        static std::atomic<uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    AsyncLogDetail::Ring& ThreadRing() {
+        thread_local ThreadRingHolder holder;
+        if (holder.backend_id != m_id) {
+            if (holder.ring) holder.ring->retired.store(true, std::memory_order_release);
+            holder.ring = std::make_shared<AsyncLogDetail::Ring>(m_config.ring_bytes);
+            holder.backend_id = m_id;
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            m_newRings.push_back(holder.ring);
+        }
+        return *holder.ring;
+    }
+
+    // Anchor TSC ticks to wall-clock time; refined by the consumer as it runs
+    void Calibrate() {
+        m_anchorTsc = AsyncLogDetail::readTsc();
+        m_anchorSteady = std::chrono::steady_clock::now();
+        m_anchorSystem = std::chrono::system_clock::now();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        Recalibrate();
+    }
+
+    void Recalibrate() {
+        uint64_t tsc = AsyncLogDetail::readTsc();
+        auto elapsed = std::chrono::steady_clock::now() - m_anchorSteady;
+        if (tsc > m_anchorTsc) {
+            m_nsPerTick = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+                          static_cast<double>(tsc - m_anchorTsc);
+        }
+    }
+
+    std::chrono::system_clock::time_point ToSystemTime(uint64_t tsc) const {
+        double ticks = tsc >= m_anchorTsc ? static_cast<double>(tsc - m_anchorTsc)
+                                          : -static_cast<double>(m_anchorTsc - tsc);
+        auto offset = std::chrono::nanoseconds(static_cast<int64_t>(ticks * m_nsPerTick));
+        return m_anchorSystem + std::chrono::duration_cast<std::chrono::system_clock::duration>(offset);
+    }
+
+    void Run() {
+        m_out.reserve(m_config.write_buffer_bytes + 4096);
+        for (;;) {
+            uint64_t flush_target;
+            bool running;
+            {
+                std::unique_lock<std::mutex> lock(m_wakeMutex);
+                if (m_flushRequested == m_flushCompleted && m_running.load(std::memory_order_acquire) &&
+                    !m_wakePending.load(std::memory_order_acquire)) {
+                    m_wake.wait_for(lock, m_config.flush_interval);
+                }
+                m_wakePending.store(false, std::memory_order_release);
+                flush_target = m_flushRequested;
+                running = m_running.load(std::memory_order_acquire);
+            }
+
+            Drain();
+
+            {
+                std::lock_guard<std::mutex> lock(m_wakeMutex);
+                m_flushCompleted = flush_target;
+            }
+            m_flushed.notify_all();
+            if (!running) {
+                break;
+            }
+        }
+        // Producers racing with Stop() may have landed one more record
+        Drain();
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_flushCompleted = m_flushRequested;
+        m_flushed.notify_all();
+    }
+
+    void Drain() {
+        using namespace AsyncLogDetail;
+        {
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            for (auto& ring : m_newRings) {
+                m_rings.push_back(RingSlot{std::move(ring), 0});
+            }
+            m_newRings.clear();
+        }
+        if (std::chrono::steady_clock::now() - m_anchorSteady > std::chrono::seconds(1)) {
+            Recalibrate();
+        }
+
+        // Gather every published record, then merge rings by timestamp
+        m_pending.clear();
+        for (auto& slot : m_rings) {
+            Ring& ring = *slot.ring;
+            uint64_t head = ring.head.load(std::memory_order_acquire);
+            uint64_t pos = ring.tail.load(std::memory_order_relaxed);
+            while (pos < head) {
+                size_t offset = static_cast<size_t>(pos & ring.mask);
+                const char* at = ring.data.get() + offset;
+                uint32_t size;
+                std::memcpy(&size, at, sizeof(size));
+                if (size == kWrapMarker) {
+                    pos += ring.capacity() - offset;
+                    continue;
+                }
+                RecordHeader header;
+                std::memcpy(&header, at, sizeof(header));
+                m_pending.push_back(Pending{header.tsc, at});
+                pos += size;
+            }
+            slot.drain_to = pos;
+        }
+        std::stable_sort(m_pending.begin(), m_pending.end(),
+                         [](const Pending& a, const Pending& b) { return a.tsc < b.tsc; });
+
+        for (const Pending& pending : m_pending) {
+            AppendRecord(pending.record);
+            if (m_out.size() >= m_config.write_buffer_bytes) {
+                WriteOut();
+            }
+        }
+        uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != m_reportedDropped) {
+            AppendLine(std::chrono::system_clock::now(), 2, "async logger dropped " +
+                       std::to_string(dropped - m_reportedDropped) + " records (ring full)");
+            m_reportedDropped = dropped;
+        }
+        WriteOut();
+        m_written.fetch_add(m_pending.size(), std::memory_order_relaxed);
+
+        for (auto& slot : m_rings) {
+            slot.ring->tail.store(slot.drain_to, std::memory_order_release);
+        }
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(), [](const RingSlot& slot) {
+                          return slot.ring->retired.load(std::memory_order_acquire) &&
+                                 slot.ring->head.load(std::memory_order_acquire) == slot.drain_to;
+                      }),
+                      m_rings.end());
+    }
+
+    void AppendRecord(const char* at) {
+        AsyncLogDetail::RecordHeader header;
+        std::memcpy(&header, at, sizeof(header));
+        m_line.clear();
+        AsyncLogDetail::formatRecord(m_line, header.format,
+                                     AsyncLogDetail::ArgReader(at + sizeof(header), header.argc));
+        AppendLine(ToSystemTime(header.tsc), header.level, m_line);
+    }
+
+    // "[YYYY-MM-DD HH:MM:SS.mmm] [LEVEL] message\n"; the seconds prefix is cached
+    void AppendLine(std::chrono::system_clock::time_point when, int level, std::string_view message) {
+        auto since_epoch = std::chrono::duration_cast<std::chrono::milliseconds>(when.time_since_epoch()).count();
+        std::time_t seconds = static_cast<std::time_t>(since_epoch / 1000);
+        if (seconds != m_cachedSecond) {
+            std::tm local{};
+#ifdef _WIN32
+            localtime_s(&local, &seconds);
+#else
+            localtime_r(&seconds, &local);
+#endif
+            std::strftime(m_cachedPrefix, sizeof(m_cachedPrefix), "[%Y-%m-%d %H:%M:%S", &local);
+            m_cachedSecond = seconds;
+        }
+        char millis[8];
+        std::snprintf(millis, sizeof(millis), ".%03d] ", static_cast<int>(since_epoch % 1000));
+
+        size_t start = m_out.size();
+        m_out.append(m_cachedPrefix);
+        m_out.append(millis);
+        m_out.push_back('[');
+        m_out.append(m_config.level_names[level & 7]);
+        m_out.append("] ");
+        m_out.append(message.data(), message.size());
+        m_out.push_back('\n');
+        if (m_config.console_output && level >= m_config.console_min_level) {
+            m_console.append(m_out, start, std::string::npos);
+        }
+    }
+
+    // Files are cut at line boundaries so a size-rotated file never exceeds its limit
+    void WriteOut() {
+        size_t offset = 0;
+        while (m_file && offset < m_out.size()) {
+            size_t chunk = m_out.size() - offset;
+            bool full = false;
+            if (m_config.max_file_bytes && m_fileBytes + chunk > m_config.max_file_bytes) {
+                size_t room = m_fileBytes < m_config.max_file_bytes
+                                  ? static_cast<size_t>(m_config.max_file_bytes - m_fileBytes) : 0;
+                size_t cut = room ? m_out.rfind('\n', offset + room - 1) : std::string::npos;
+                if (cut != std::string::npos && cut >= offset) {
+                    chunk = cut + 1 - offset;
+                    full = true;
+                } else if (m_fileBytes > 0) {
+                    Rotate();
+                    continue;
+                }
+            }
+            std::fwrite(m_out.data() + offset, 1, chunk, m_file);
+            m_fileBytes += chunk;
+            offset += chunk;
+            if (full || (m_config.rotate_interval.count() > 0 &&
+                         std::chrono::steady_clock::now() - m_fileOpened >= m_config.rotate_interval)) {
+                Rotate();
+            }
+        }
+        if (!m_console.empty()) {
+            std::fwrite(m_console.data(), 1, m_console.size(), stdout);
+            std::fflush(stdout);
+            m_console.clear();
+        }
+        m_out.clear();
+    }
+
+    bool OpenFile() {
+        m_file = std::fopen(m_config.path.c_str(), "ab");
+        if (!m_file) {
+            return false;
+        }
+        // Writes are already batched; let each fwrite go straight to the kernel
+        std::setvbuf(m_file, nullptr, _IONBF, 0);
+        std::fseek(m_file, 0, SEEK_END);
+        long existing = std::ftell(m_file);
+        m_fileBytes = existing > 0 ? static_cast<uint64_t>(existing) : 0;
+        m_fileOpened = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    void Rotate() {
+        std::fclose(m_file);
+        m_file = nullptr;
+        const std::string& path = m_config.path;
+        if (m_config.max_rotated_files == 0) {
+            std::remove(path.c_str());
+        } else {
+            std::remove((path + "." + std::to_string(m_config.max_rotated_files)).c_str());
+            for (unsigned i = m_config.max_rotated_files - 1; i >= 1; --i) {
+                std::rename((path + "." + std::to_string(i)).c_str(),
+                            (path + "." + std::to_string(i + 1)).c_str());
+            }
+            std::rename(path.c_str(), (path + ".1").c_str());
+        }
+        OpenFile();
+        if (m_config.on_rotate) {
+            m_config.on_rotate();
+        }
+    }
+
+    AsyncLogConfig m_config;
+    const uint64_t m_id;
+
+    std::mutex m_controlMutex;
+    std::atomic<bool> m_running{false};
+    std::thread m_consumer;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_flushed;
+    uint64_t m_flushRequested = 0;
+    uint64_t m_flushCompleted = 0;
+
+    std::mutex m_ringsMutex;
+    std::vector<std::shared_ptr<AsyncLogDetail::Ring>> m_newRings;
+
+    std::atomic<bool> m_wakePending{false};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_written{0};
+
+    // Consumer-thread state
+    std::vector<RingSlot> m_rings;
+    std::vector<Pending> m_pending;
+    std::string m_out;
+    std::string m_console;
+    std::string m_line;
+    uint64_t m_reportedDropped = 0;
+    std::time_t m_cachedSecond = -1;
+    char m_cachedPrefix[32] = {};
+    std::FILE* m_file = nullptr;
+    uint64_t m_fileBytes = 0;
+    std::chrono::steady_clock::time_point m_fileOpened;
+
+    uint64_t m_anchorTsc = 0;
+    std::chrono::steady_clock::time_point m_anchorSteady;
+    std::chrono::system_clock::time_point m_anchorSystem;
+    double m_nsPerTick = 1.0;
+};
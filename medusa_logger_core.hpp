@@ -8,6 +8,9 @@
 #include <chrono>
 #include <sstream>
 #include <iostream>
+#include <atomic>
+
+#include "medusa_logger_async.hpp"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -38,6 +41,11 @@ private:
     std::string m_logFilePath;
     std::mutex m_logMutex;
     
+    // Async mode: when set, the convenience functions below enqueue binary
+    // records and never take m_logMutex or touch I/O on the caller thread
+    std::unique_ptr<AsyncLogBackend> m_asyncBackend;
+    std::atomic<AsyncLogBackend*> m_async{nullptr};
+    
     Logger();
 
 public:
@@ -53,32 +61,80 @@ public:
     void SetFileOutput(bool enable) { m_fileOutput = enable; }
     void SetVerboseMode(bool enable) { m_verboseMode = enable; }
     
+    /**
+     * Switch to the asynchronous ring-buffer backend. An empty config.path
+     * reuses the current log file; console/file switches are taken from the
+     * current settings. Call during startup, before worker threads log.
+     * When the backend rotates that file, m_logFile is reopened on the new one.
+     */
+    bool EnableAsyncLogging(AsyncLogConfig config = AsyncLogConfig()) {
+        if (config.path.empty() && m_fileOutput) {
+            config.path = m_logFilePath;
+        }
+        config.console_output = config.console_output && m_consoleOutput;
+        if (config.path == m_logFilePath) {
+            auto chained = std::move(config.on_rotate);
+            config.on_rotate = [this, chained]() {
+                ReopenLogFile();
+                if (chained) chained();
+            };
+        }
+        if (m_logFile.is_open()) {
+            m_logFile.flush();
+        }
+        DisableAsyncLogging();
+        m_asyncBackend.reset(new AsyncLogBackend(std::move(config)));
+        bool opened = m_asyncBackend->Start();
+        m_async.store(m_asyncBackend.get(), std::memory_order_release);
+        return opened;
+    }
+    
+    // Drain and stop the async backend; later messages go through Log() again
+    void DisableAsyncLogging() {
+        m_async.store(nullptr, std::memory_order_release);
+        if (m_asyncBackend) {
+            m_asyncBackend->Stop();
+        }
+    }
+    
+    bool IsAsyncLogging() const { return m_async.load(std::memory_order_acquire) != nullptr; }
+    
+    void FlushAsync() {
+        if (AsyncLogBackend* async = m_async.load(std::memory_order_acquire)) {
+            async->Flush();
+        }
+    }
+    
+    uint64_t GetDroppedLogCount() const {
+        return m_asyncBackend ? m_asyncBackend->DroppedCount() : 0;
+    }
+    
     // Logging functions
     void Log(LogLevel level, const std::string& message);
     void Log(LogLevel level, const char* format, ...);
     
-    // Convenience functions
-    void Debug(const std::string& message) { Log(LogLevel::DEBUG_LEVEL, message); }
-    void Info(const std::string& message) { Log(LogLevel::INFO_LEVEL, message); }
-    void Warn(const std::string& message) { Log(LogLevel::WARN_LEVEL, message); }
-    void Error(const std::string& message) { Log(LogLevel::ERROR_LEVEL, message); }
-    void Fatal(const std::string& message) { Log(LogLevel::FATAL_LEVEL, message); }
+    // Convenience functions (routed to the async backend when enabled)
+    void Debug(const std::string& message) { Emit(LogLevel::DEBUG_LEVEL, message); }
+    void Info(const std::string& message) { Emit(LogLevel::INFO_LEVEL, message); }
+    void Warn(const std::string& message) { Emit(LogLevel::WARN_LEVEL, message); }
+    void Error(const std::string& message) { Emit(LogLevel::ERROR_LEVEL, message); }
+    void Fatal(const std::string& message) { Emit(LogLevel::FATAL_LEVEL, message); }
     
     // Template versions for convenience
     template<typename... Args>
-    void Debug(const char* format, Args... args) { Log(LogLevel::DEBUG_LEVEL, format, args...); }
+    void Debug(const char* format, Args... args) { Emit(LogLevel::DEBUG_LEVEL, format, args...); }
     
     template<typename... Args>
-    void Info(const char* format, Args... args) { Log(LogLevel::INFO_LEVEL, format, args...); }
+    void Info(const char* format, Args... args) { Emit(LogLevel::INFO_LEVEL, format, args...); }
     
     template<typename... Args>
-    void Warn(const char* format, Args... args) { Log(LogLevel::WARN_LEVEL, format, args...); }
+    void Warn(const char* format, Args... args) { Emit(LogLevel::WARN_LEVEL, format, args...); }
     
     template<typename... Args>
-    void Error(const char* format, Args... args) { Log(LogLevel::ERROR_LEVEL, format, args...); }
+    void Error(const char* format, Args... args) { Emit(LogLevel::ERROR_LEVEL, format, args...); }
     
     template<typename... Args>
-    void Fatal(const char* format, Args... args) { Log(LogLevel::FATAL_LEVEL, format, args...); }
+    void Fatal(const char* format, Args... args) { Emit(LogLevel::FATAL_LEVEL, format, args...); }
     
     // System info logging
     void LogSystemInfo();
@@ -101,6 +157,42 @@ public:
 #endif
 
 private:
+    void Emit(LogLevel level, const std::string& message) {
+        if (AsyncLogBackend* async = m_async.load(std::memory_order_acquire)) {
+            if (level >= m_minLevel) {
+                async->Submit(static_cast<int>(level), "%s", message);
+            }
+            return;
+        }
+        Log(level, message);
+    }
+    
+    template<typename... Args>
+    void Emit(LogLevel level, const char* format, const Args&... args) {
+        if (AsyncLogBackend* async = m_async.load(std::memory_order_acquire)) {
+            if (level < m_minLevel) {
+                return;
+            }
+            if constexpr (sizeof...(Args) == 0) {
+                // No arguments: the text may be a temporary buffer, so copy it
+                async->Submit(static_cast<int>(level), "%s", format);
+            } else {
+                async->Submit(static_cast<int>(level), format, args...);
+            }
+            return;
+        }
+        Log(level, format, args...);
+    }
+    
+    // The async backend renamed the file away; follow the path, not the old inode
+    void ReopenLogFile() {
+        std::lock_guard<std::mutex> lock(m_logMutex);
+        if (m_logFile.is_open()) {
+            m_logFile.close();
+            m_logFile.open(m_logFilePath, std::ios::out | std::ios::app);
+        }
+    }
+    
     std::string GetTimestamp();
     std::string LevelToString(LogLevel level);
     std::string GetSystemInfoString();
@@ -15,6 +15,10 @@
 #include <thread>
 #include <mutex>
 #include <queue>
+#include <atomic>
+
+#include "medusa_purple_pages_audit_writer.hpp"
+#include "medusa_purple_pages_columnar_store.hpp"
 
 namespace MedusaServer {
 
@@ -88,21 +92,62 @@ struct AuditQuery {
 class AuditLogger {
 private:
     std::string database_path_;
-    std::queue<AuditEvent> event_queue_;
-    std::mutex queue_mutex_;
+    AuditWriterConfig writer_config_;
+    std::unique_ptr<AuditEventQueue<AuditEvent>> event_queue_{new AuditEventQueue<AuditEvent>(writer_config_)};
+    SqliteAuditBatchWriter<AuditEvent> batch_writer_;
+    AuditColumnarStore<AuditEvent> columnar_store_;  // query/statistics index next to the database
     std::thread writer_thread_;
     std::atomic<bool> running_;
     std::function<void(const AuditEvent&)> event_callback_;
+    mutable std::mutex metrics_mutex_;
+    AuditWriterMetrics commit_metrics_;
     
 public:
     AuditLogger(const std::string& db_path = "/home/medusa/audit/audit.db");
     ~AuditLogger();
     
-    bool initialize();
-    void shutdown();
+    bool initialize() {
+        if (running_.load()) {
+            return true;
+        }
+        if (!createDatabase() || !columnar_store_.open(database_path_ + ".columns") || !backfillColumnarStore()) {
+            return false;
+        }
+        event_queue_->reopen();
+        running_.store(true);
+        writer_thread_ = std::thread(&AuditLogger::writerLoop, this);
+        return true;
+    }
+    
+    // Stops accepting waits, commits everything still queued, then closes the database
+    void shutdown() {
+        if (!running_.exchange(false)) {
+            return;
+        }
+        event_queue_->close();
+        if (writer_thread_.joinable()) {
+            writer_thread_.join();
+        }
+        batch_writer_.close();
+        columnar_store_.close();
+    }
+    
+    // Event logging: bounded, never blocks on disk; CRITICAL/SECURITY events are never sampled or evicted
+    void logEvent(const AuditEvent& event) {
+        AuditEvent queued = event;
+        if (queued.event_id.empty()) {
+            queued.event_id = generateEventId();
+        }
+        if (queued.timestamp.time_since_epoch().count() == 0) {
+            queued.timestamp = std::chrono::system_clock::now();
+        }
+        if (event_callback_) {
+            event_callback_(queued);
+        }
+        bool critical = queued.severity >= AuditSeverity::CRITICAL;
+        event_queue_->push(std::move(queued), critical);
+    }
     
-    // Event logging
-    void logEvent(const AuditEvent& event);
     void logUserLogin(const std::string& user_id, const std::string& ip_address, bool success, const std::string& details = "");
     void logUserLogout(const std::string& user_id, const std::string& session_id);
     void logSystemEvent(AuditEventType type, AuditSeverity severity, const std::string& description, const std::map<std::string, std::string>& metadata = {});
@@ -111,17 +156,93 @@ public:
     void logSecurityViolation(const std::string& user_id, const std::string& violation_type, const std::string& details, const std::string& ip_address);
     void logError(const std::string& component, const std::string& error_message, const std::string& stack_trace = "");
     
-    // Query interface
-    std::vector<AuditEvent> queryEvents(const AuditQuery& query);
-    std::vector<AuditEvent> getRecentEvents(int limit = 50);
-    std::vector<AuditEvent> getEventsByUser(const std::string& user_id, int limit = 100);
-    std::vector<AuditEvent> getEventsByType(AuditEventType type, int limit = 100);
-    std::vector<AuditEvent> getSecurityEvents(int limit = 100);
+    // Query interface (served from the columnar store: partitions outside the
+    // time range or whose bloom filters rule out user/IP are never opened)
+    std::vector<AuditEvent> queryEvents(const AuditQuery& query) {
+        return columnar_store_.query(query);
+    }
+    
+    std::vector<AuditEvent> getRecentEvents(int limit = 50) {
+        AuditQuery query;
+        query.limit = limit;
+        return queryEvents(query);
+    }
+    
+    std::vector<AuditEvent> getEventsByUser(const std::string& user_id, int limit = 100) {
+        AuditQuery query;
+        query.user_id = user_id;
+        query.limit = limit;
+        return queryEvents(query);
+    }
+    
+    std::vector<AuditEvent> getEventsByType(AuditEventType type, int limit = 100) {
+        AuditQuery query;
+        query.event_types.push_back(type);
+        query.limit = limit;
+        return queryEvents(query);
+    }
+    
+    std::vector<AuditEvent> getSecurityEvents(int limit = 100) {
+        AuditQuery query;
+        query.severities = {AuditSeverity::CRITICAL, AuditSeverity::SECURITY};
+        query.limit = limit;
+        return queryEvents(query);
+    }
+    
+    // Statistics (per-hour rollups; only the hour containing `since` is counted row by row)
+    std::map<std::string, int> getEventTypeStatistics(const std::chrono::system_clock::time_point& since) {
+        auto counts = columnar_store_.countByTypeAndSeverity(since);
+        std::map<std::string, int> statistics;
+        for (unsigned type = 0; type < AuditColumnar::kTypeSlots; ++type) {
+            uint64_t total = 0;
+            for (unsigned severity = 0; severity < AuditColumnar::kSeveritySlots; ++severity) {
+                total += counts[AuditColumnar::rollupSlot(type, severity)];
+            }
+            if (total) {
+                statistics[eventTypeName(type)] += static_cast<int>(total);
+            }
+        }
+        return statistics;
+    }
     
-    // Statistics
-    std::map<std::string, int> getEventTypeStatistics(const std::chrono::system_clock::time_point& since);
-    std::map<std::string, int> getUserActivityStatistics(const std::chrono::system_clock::time_point& since);
-    std::map<std::string, int> getSecurityStatistics(const std::chrono::system_clock::time_point& since);
+    std::map<std::string, int> getUserActivityStatistics(const std::chrono::system_clock::time_point& since) {
+        std::map<std::string, int> statistics;
+        for (const auto& [user_id, count] : columnar_store_.countByUser(since)) {
+            if (!user_id.empty()) {
+                statistics[user_id] = static_cast<int>(count);
+            }
+        }
+        return statistics;
+    }
+    
+    // CRITICAL/SECURITY events by type, plus failed logins and violations at any severity
+    std::map<std::string, int> getSecurityStatistics(const std::chrono::system_clock::time_point& since) {
+        auto counts = columnar_store_.countByTypeAndSeverity(since);
+        std::map<std::string, int> statistics;
+        int total = 0;
+        for (unsigned type = 0; type < AuditColumnar::kTypeSlots; ++type) {
+            int security = 0;
+            int all = 0;
+            for (unsigned severity = 0; severity < AuditColumnar::kSeveritySlots; ++severity) {
+                int count = static_cast<int>(counts[AuditColumnar::rollupSlot(type, severity)]);
+                all += count;
+                if (severity >= static_cast<unsigned>(AuditSeverity::CRITICAL)) {
+                    security += count;
+                }
+            }
+            if (security) {
+                statistics[eventTypeName(type)] = security;
+                total += security;
+            }
+            if (type == static_cast<unsigned>(AuditEventType::USER_FAILED_LOGIN)) {
+                statistics["failed_logins"] = all;
+            } else if (type == static_cast<unsigned>(AuditEventType::SECURITY_VIOLATION)) {
+                statistics["security_violations"] = all;
+            }
+        }
+        statistics["total_security_events"] = total;
+        return statistics;
+    }
     
     // Maintenance
     bool archiveOldEvents(const std::chrono::system_clock::time_point& before);
@@ -131,10 +252,111 @@ public:
     // Configuration
     void setEventCallback(std::function<void(const AuditEvent&)> callback);
     
+    // Queue capacity and back-pressure policy; only takes effect before initialize()
+    bool setWriterConfig(const AuditWriterConfig& config) {
+        if (running_.load()) {
+            return false;
+        }
+        writer_config_ = config;
+        event_queue_.reset(new AuditEventQueue<AuditEvent>(writer_config_));
+        return true;
+    }
+    
+    // Queue depth, drops and commit latency for monitoring
+    AuditWriterMetrics getWriterMetrics() const {
+        AuditWriterMetrics metrics;
+        {
+            std::lock_guard<std::mutex> lock(metrics_mutex_);
+            metrics = commit_metrics_;
+        }
+        event_queue_->fillMetrics(metrics);
+        return metrics;
+    }
+    
 private:
-    void writerLoop();
-    bool createDatabase();
-    bool writeEventToDatabase(const AuditEvent& event);
+    // Group commit: everything that queued up while the last transaction ran goes into the next one
+    void writerLoop() {
+        std::vector<AuditEvent> batch;
+        std::vector<int64_t> rowids;
+        batch.reserve(writer_config_.max_batch);
+        for (;;) {
+            batch.clear();
+            event_queue_->popBatch(batch, writer_config_.max_batch, writer_config_.max_batch_delay);
+            if (batch.empty()) {
+                if (!running_.load()) {
+                    break;
+                }
+                continue;
+            }
+            // Only committed rows are indexed, so the two stores never diverge
+            if (writeBatchToDatabase(batch, &rowids)) {
+                columnar_store_.append(batch, rowids);
+            }
+        }
+    }
+    
+    /**
+     * Index rows SQLite has but no sealed partition holds: history from before the
+     * column store existed, and the in-memory partition a crash lost
+     */
+    bool backfillColumnarStore() {
+        return batch_writer_.readSince(columnar_store_.persistedRowid(), 4096,
+            [this](const std::vector<AuditEvent>& events, const std::vector<int64_t>& rowids) {
+                columnar_store_.append(events, rowids);
+            });
+    }
+    
+    static std::string eventTypeName(unsigned type) {
+        AuditEvent event;
+        event.event_type = static_cast<AuditEventType>(type);
+        return event.getEventTypeString();
+    }
+    
+    bool createDatabase() {
+        return batch_writer_.open(database_path_);
+    }
+    
+    bool writeEventToDatabase(const AuditEvent& event) {
+        return writeBatchToDatabase(std::vector<AuditEvent>{event});
+    }
+    
+    bool writeBatchToDatabase(const std::vector<AuditEvent>& batch, std::vector<int64_t>* rowids = nullptr) {
+        for (int attempt = 0; attempt <= writer_config_.max_commit_retries; ++attempt) {
+            if (attempt > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10 * attempt));
+            }
+            auto started = std::chrono::steady_clock::now();
+            bool committed = batch_writer_.commit(batch, rowids);
+            auto finished = std::chrono::steady_clock::now();
+            uint64_t elapsed_us = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(finished - started).count());
+            
+            std::lock_guard<std::mutex> lock(metrics_mutex_);
+            if (!committed) {
+                ++commit_metrics_.commit_failures;
+                continue;
+            }
+            auto oldest = batch.front().timestamp;
+            for (const auto& event : batch) {
+                if (event.timestamp < oldest) oldest = event.timestamp;
+            }
+            ++commit_metrics_.batches_committed;
+            commit_metrics_.events_committed += batch.size();
+            commit_metrics_.last_batch_size = batch.size();
+            commit_metrics_.last_commit_us = elapsed_us;
+            commit_metrics_.total_commit_us += elapsed_us;
+            if (elapsed_us > commit_metrics_.max_commit_us) {
+                commit_metrics_.max_commit_us = elapsed_us;
+            }
+            commit_metrics_.last_event_lag_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now() - oldest).count();
+            return true;
+        }
+        std::lock_guard<std::mutex> lock(metrics_mutex_);
+        commit_metrics_.events_lost += batch.size();
+        return false;
+    }
+    
     std::string generateEventId();
 };
 
@@ -0,0 +1,627 @@
+/*
+ * MEDUSA PURPLE-PAGES AUDIT WRITER
+ * Bounded event queue and group-committing SQLite writer behind AuditLogger
+ * - producers never grow memory past the configured capacity; what happens
+ *   when the queue is full is an explicit back-pressure policy
+ * - the writer drains whatever has accumulated and commits it as one
+ *   transaction through a single prepared statement
+ */
+
+#pragma once
+
+#include <sqlite3.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace MedusaServer {
+
+enum class AuditBackpressure {
+    BLOCK,          // Producer waits for space (up to block_timeout)
+    DROP_OLDEST,    // Oldest queued event is discarded to make room
+    SAMPLE          // Past the high-water mark keep 1 in sample_rate routine events
+};
+
+struct AuditWriterConfig {
+    size_t queue_capacity = 65536;
+    AuditBackpressure backpressure = AuditBackpressure::SAMPLE;
+    size_t sample_rate = 10;
+    double high_water_ratio = 0.75;
+    std::chrono::milliseconds block_timeout{2000};
+    size_t max_batch = 2048;
+    std::chrono::milliseconds max_batch_delay{20};
+    int max_commit_retries = 3;
+};
+
+struct AuditWriterMetrics {
+    uint64_t enqueued = 0;
+    uint64_t dropped = 0;            // full queue: DROP_OLDEST evictions, timeouts, full-queue drops
+    uint64_t sampled_out = 0;        // skipped by SAMPLE above the high-water mark
+    uint64_t producer_waits = 0;     // pushes that had to wait for space
+    size_t queue_depth = 0;
+    size_t queue_high_water = 0;
+    size_t queue_capacity = 0;
+    uint64_t batches_committed = 0;
+    uint64_t events_committed = 0;
+    uint64_t commit_failures = 0;
+    uint64_t events_lost = 0;        // batches abandoned after max_commit_retries
+    uint64_t last_commit_us = 0;
+    uint64_t max_commit_us = 0;
+    uint64_t total_commit_us = 0;
+    uint64_t last_batch_size = 0;
+    int64_t last_event_lag_ms = 0;   // commit time minus oldest event timestamp in the batch
+};
+
+/**
+ * @brief Bounded lock-free queue (Vyukov array queue)
+ * @details Many producers; the writer thread is the normal consumer, but a
+ *          producer may also pop to evict under DROP_OLDEST, which the
+ *          per-cell sequence numbers make safe.
+ */
+template<typename T>
+class BoundedAuditQueue {
+public:
+    explicit BoundedAuditQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells_.reset(new Cell[size]);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~BoundedAuditQueue() {
+        T discard;
+        while (tryPop(discard)) {
+        }
+    }
+
+    BoundedAuditQueue(const BoundedAuditQueue&) = delete;
+    BoundedAuditQueue& operator=(const BoundedAuditQueue&) = delete;
+
+    bool tryPush(T&& value) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    new (cell.storage) T(std::move(value));
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out) {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    T* value = std::launder(reinterpret_cast<T*>(cell.storage));
+                    out = std::move(*value);
+                    value->~T();
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t sizeApprox() const {
+        size_t tail = dequeue_pos_.load(std::memory_order_relaxed);
+        size_t head = enqueue_pos_.load(std::memory_order_relaxed);
+        return head > tail ? head - tail : 0;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+/**
+ * @brief BoundedAuditQueue plus back-pressure policy, wake-ups and counters
+ */
+template<typename Event>
+class AuditEventQueue {
+public:
+    explicit AuditEventQueue(const AuditWriterConfig& config)
+        : config_(config), queue_(config.queue_capacity) {
+        high_water_ = static_cast<size_t>(static_cast<double>(queue_.capacity()) * config_.high_water_ratio);
+    }
+
+    /**
+     * @brief Enqueue per policy; critical events are never sampled or evicted
+     *        for space and wait (up to block_timeout) when the queue is full
+     * @return false if the event was not queued
+     */
+    bool push(Event event, bool critical) {
+        return pushEntry(Entry{std::move(event), critical}, true);
+    }
+
+    /**
+     * @brief Move up to max events into out, waiting up to wait for the first
+     * @return Number of events appended
+     */
+    size_t popBatch(std::vector<Event>& out, size_t max, std::chrono::milliseconds wait) {
+        size_t taken = drain(out, max);
+        if (taken == 0 && wait.count() > 0 && !closed_.load(std::memory_order_acquire)) {
+            std::unique_lock<std::mutex> lock(wait_mutex_);
+            consumer_waiting_.store(true, std::memory_order_seq_cst);
+            if (queue_.sizeApprox() == 0) {
+                data_ready_.wait_for(lock, wait);
+            }
+            consumer_waiting_.store(false, std::memory_order_relaxed);
+            lock.unlock();
+            taken = drain(out, max);
+        }
+        if (taken && producers_waiting_.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(wait_mutex_);
+            space_ready_.notify_all();
+        }
+        return taken;
+    }
+
+    // Wake everything; blocked producers give up instead of waiting out their timeout
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        std::lock_guard<std::mutex> lock(wait_mutex_);
+        data_ready_.notify_all();
+        space_ready_.notify_all();
+    }
+
+    void reopen() { closed_.store(false, std::memory_order_release); }
+
+    void fillMetrics(AuditWriterMetrics& metrics) const {
+        metrics.enqueued = enqueued_.load(std::memory_order_relaxed);
+        metrics.dropped = dropped_.load(std::memory_order_relaxed);
+        metrics.sampled_out = sampled_out_.load(std::memory_order_relaxed);
+        metrics.producer_waits = producer_waits_.load(std::memory_order_relaxed);
+        metrics.queue_depth = queue_.sizeApprox();
+        metrics.queue_high_water = depth_high_water_.load(std::memory_order_relaxed);
+        metrics.queue_capacity = queue_.capacity();
+    }
+
+private:
+    struct Entry {
+        Event event;
+        bool critical = false;
+    };
+
+    bool pushEntry(Entry entry, bool count) {
+        bool critical = entry.critical;
+        if (config_.backpressure == AuditBackpressure::SAMPLE && !critical &&
+            queue_.sizeApprox() >= high_water_ &&
+            sample_counter_.fetch_add(1, std::memory_order_relaxed) % (config_.sample_rate ? config_.sample_rate : 1) != 0) {
+            sampled_out_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        std::chrono::steady_clock::time_point deadline{};
+        bool waited = false;
+        for (;;) {
+            if (queue_.tryPush(std::move(entry))) {
+                if (count) {
+                    enqueued_.fetch_add(1, std::memory_order_relaxed);
+                }
+                noteDepth();
+                if (consumer_waiting_.load(std::memory_order_seq_cst)) {
+                    std::lock_guard<std::mutex> lock(wait_mutex_);
+                    data_ready_.notify_one();
+                }
+                return true;
+            }
+
+            if (!critical && config_.backpressure == AuditBackpressure::DROP_OLDEST) {
+                Entry evicted;
+                if (queue_.tryPop(evicted)) {
+                    if (evicted.critical) {
+                        // Never evict a critical event: requeue it and give up the routine one instead
+                        pushEntry(std::move(evicted), false);
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+            if (!critical && config_.backpressure == AuditBackpressure::SAMPLE) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // BLOCK, or a critical event under any policy
+            auto now = std::chrono::steady_clock::now();
+            if (!waited) {
+                waited = true;
+                deadline = now + config_.block_timeout;
+                producer_waits_.fetch_add(1, std::memory_order_relaxed);
+            } else if (now >= deadline || closed_.load(std::memory_order_acquire)) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            std::unique_lock<std::mutex> lock(wait_mutex_);
+            producers_waiting_.fetch_add(1, std::memory_order_seq_cst);
+            data_ready_.notify_one();
+            space_ready_.wait_for(lock, std::chrono::milliseconds(1));
+            producers_waiting_.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    size_t drain(std::vector<Event>& out, size_t max) {
+        size_t taken = 0;
+        Entry entry;
+        while (taken < max && queue_.tryPop(entry)) {
+            out.push_back(std::move(entry.event));
+            ++taken;
+        }
+        return taken;
+    }
+
+    void noteDepth() {
+        size_t depth = queue_.sizeApprox();
+        size_t seen = depth_high_water_.load(std::memory_order_relaxed);
+        while (depth > seen && !depth_high_water_.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    AuditWriterConfig config_;
+    BoundedAuditQueue<Entry> queue_;
+    size_t high_water_ = 0;
+
+    std::mutex wait_mutex_;
+    std::condition_variable data_ready_;
+    std::condition_variable space_ready_;
+    std::atomic<bool> consumer_waiting_{false};
+    std::atomic<int> producers_waiting_{0};
+    std::atomic<bool> closed_{false};
+
+    std::atomic<uint64_t> sample_counter_{0};
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> sampled_out_{0};
+    std::atomic<uint64_t> producer_waits_{0};
+    std::atomic<size_t> depth_high_water_{0};
+};
+
+/**
+ * @brief Encode event metadata as a flat JSON object
+ */
+inline std::string encodeAuditMetadata(const std::map<std::string, std::string>& metadata) {
+    std::string out = "{";
+    auto append = [&out](const std::string& text) {
+        out.push_back('"');
+        for (unsigned char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (c < 0x20) {
+                        static const char hex[] = "0123456789abcdef";
+                        out += "\\u00";
+                        out.push_back(hex[c >> 4]);
+                        out.push_back(hex[c & 0xF]);
+                    } else {
+                        out.push_back(static_cast<char>(c));
+                    }
+            }
+        }
+        out.push_back('"');
+    };
+    bool first = true;
+    for (const auto& [key, value] : metadata) {
+        if (!first) out.push_back(',');
+        first = false;
+        append(key);
+        out.push_back(':');
+        append(value);
+    }
+    out.push_back('}');
+    return out;
+}
+
+/**
+ * @brief Decode the flat JSON object written by encodeAuditMetadata
+ */
+inline std::map<std::string, std::string> decodeAuditMetadata(const std::string& json) {
+    std::map<std::string, std::string> metadata;
+    size_t at = 0;
+    auto string = [&](std::string& out) {
+        while (at < json.size() && json[at] != '"') ++at;
+        if (at++ >= json.size()) return false;
+        while (at < json.size() && json[at] != '"') {
+            char c = json[at++];
+            if (c != '\\' || at >= json.size()) {
+                out.push_back(c);
+                continue;
+            }
+            char escape = json[at++];
+            switch (escape) {
+                case 'n': out.push_back('\n'); break;
+                case 'r': out.push_back('\r'); break;
+                case 't': out.push_back('\t'); break;
+                case 'u':
+                    if (at + 4 <= json.size()) {
+                        out.push_back(static_cast<char>(std::strtol(json.substr(at, 4).c_str(), nullptr, 16)));
+                        at += 4;
+                    }
+                    break;
+                default: out.push_back(escape); break;
+            }
+        }
+        return at++ < json.size();
+    };
+    for (;;) {
+        std::string key;
+        std::string value;
+        if (!string(key) || !string(value)) break;
+        metadata[key] = value;
+    }
+    return metadata;
+}
+
+/**
+ * @brief Group-commit writer: one transaction and one prepared INSERT per batch
+ * @details Event is AuditEvent-shaped; the template only exists so this header
+ *          does not depend on medusa_purple_pages.hpp.
+ */
+template<typename Event>
+class SqliteAuditBatchWriter {
+public:
+    SqliteAuditBatchWriter() = default;
+    ~SqliteAuditBatchWriter() { close(); }
+
+    SqliteAuditBatchWriter(const SqliteAuditBatchWriter&) = delete;
+    SqliteAuditBatchWriter& operator=(const SqliteAuditBatchWriter&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        if (sqlite3_open_v2(path.c_str(), &db_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX,
+                            nullptr) != SQLITE_OK) {
+            captureError();
+            close();
+            return false;
+        }
+        sqlite3_busy_timeout(db_, 5000);
+        const char* schema = R"(
+            PRAGMA journal_mode = WAL;
+            PRAGMA synchronous = NORMAL;
+            CREATE TABLE IF NOT EXISTS audit_events (
+                event_id TEXT PRIMARY KEY,
+                event_type INTEGER NOT NULL,
+                severity INTEGER NOT NULL,
+                timestamp_ms INTEGER NOT NULL,
+                user_id TEXT,
+                session_id TEXT,
+                ip_address TEXT,
+                user_agent TEXT,
+                description TEXT,
+                metadata TEXT,
+                stack_trace TEXT,
+                archived INTEGER NOT NULL DEFAULT 0
+            );
+            CREATE INDEX IF NOT EXISTS idx_audit_events_time ON audit_events(timestamp_ms);
+            CREATE INDEX IF NOT EXISTS idx_audit_events_user ON audit_events(user_id, timestamp_ms);
+            CREATE INDEX IF NOT EXISTS idx_audit_events_type ON audit_events(event_type, timestamp_ms);
+        )";
+        if (!exec(schema)) {
+            close();
+            return false;
+        }
+        const char* insert = R"(
+            INSERT OR REPLACE INTO audit_events
+                (event_id, event_type, severity, timestamp_ms, user_id, session_id, ip_address,
+                 user_agent, description, metadata, stack_trace, archived)
+            VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+        )";
+        if (sqlite3_prepare_v2(db_, insert, -1, &insert_, nullptr) != SQLITE_OK) {
+            captureError();
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (insert_) {
+            sqlite3_finalize(insert_);
+            insert_ = nullptr;
+        }
+        if (db_) {
+            sqlite3_close(db_);
+            db_ = nullptr;
+        }
+    }
+
+    bool isOpen() const { return db_ != nullptr; }
+
+    /**
+     * @brief Write the whole batch atomically
+     * @param rowids if given, receives the rowid of each row once committed
+     * @return false (and rolls back) if any row fails
+     */
+    bool commit(const std::vector<Event>& batch, std::vector<int64_t>* rowids = nullptr) {
+        if (rowids) {
+            rowids->clear();
+        }
+        if (!db_ || !insert_) {
+            return false;
+        }
+        if (batch.empty()) {
+            return true;
+        }
+        if (!exec("BEGIN IMMEDIATE")) {
+            return false;
+        }
+        for (const Event& event : batch) {
+            if (!insertRow(event)) {
+                exec("ROLLBACK");
+                if (rowids) rowids->clear();
+                return false;
+            }
+            if (rowids) {
+                rowids->push_back(static_cast<int64_t>(sqlite3_last_insert_rowid(db_)));
+            }
+        }
+        if (!exec("COMMIT")) {
+            exec("ROLLBACK");
+            if (rowids) rowids->clear();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Replay committed rows with rowid > after, in rowid order
+     * @param sink called with each chunk of up to chunk_size events and their rowids
+     * @return false on a database error
+     */
+    template<typename Sink>
+    bool readSince(int64_t after, size_t chunk_size, Sink sink) {
+        if (!db_) {
+            return false;
+        }
+        const char* select = R"(
+            SELECT rowid, event_id, event_type, severity, timestamp_ms, user_id, session_id, ip_address,
+                   user_agent, description, metadata, stack_trace, archived
+            FROM audit_events WHERE rowid > ? ORDER BY rowid
+        )";
+        sqlite3_stmt* statement = nullptr;
+        if (sqlite3_prepare_v2(db_, select, -1, &statement, nullptr) != SQLITE_OK) {
+            captureError();
+            return false;
+        }
+        sqlite3_bind_int64(statement, 1, after);
+        auto text = [statement](int column) {
+            const unsigned char* value = sqlite3_column_text(statement, column);
+            return value ? std::string(reinterpret_cast<const char*>(value),
+                                       static_cast<size_t>(sqlite3_column_bytes(statement, column)))
+                         : std::string();
+        };
+        std::vector<Event> events;
+        std::vector<int64_t> rowids;
+        int rc;
+        while ((rc = sqlite3_step(statement)) == SQLITE_ROW) {
+            Event event;
+            rowids.push_back(static_cast<int64_t>(sqlite3_column_int64(statement, 0)));
+            event.event_id = text(1);
+            event.event_type = static_cast<decltype(event.event_type)>(sqlite3_column_int(statement, 2));
+            event.severity = static_cast<decltype(event.severity)>(sqlite3_column_int(statement, 3));
+            event.timestamp = decltype(event.timestamp)(std::chrono::milliseconds(sqlite3_column_int64(statement, 4)));
+            event.user_id = text(5);
+            event.session_id = text(6);
+            event.ip_address = text(7);
+            event.user_agent = text(8);
+            event.description = text(9);
+            event.metadata = decodeAuditMetadata(text(10));
+            event.stack_trace = text(11);
+            event.archived = sqlite3_column_int(statement, 12) != 0;
+            events.push_back(std::move(event));
+            if (events.size() >= chunk_size) {
+                sink(events, rowids);
+                events.clear();
+                rowids.clear();
+            }
+        }
+        if (!events.empty()) {
+            sink(events, rowids);
+        }
+        if (rc != SQLITE_DONE) {
+            captureError();
+        }
+        sqlite3_finalize(statement);
+        return rc == SQLITE_DONE;
+    }
+
+    const std::string& lastError() const { return last_error_; }
+
+private:
+    bool insertRow(const Event& event) {
+        std::string metadata = encodeAuditMetadata(event.metadata);
+        int64_t timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            event.timestamp.time_since_epoch()).count();
+        auto text = [this](int index, const std::string& value) {
+            sqlite3_bind_text(insert_, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+        };
+        text(1, event.event_id);
+        sqlite3_bind_int(insert_, 2, static_cast<int>(event.event_type));
+        sqlite3_bind_int(insert_, 3, static_cast<int>(event.severity));
+        sqlite3_bind_int64(insert_, 4, timestamp_ms);
+        text(5, event.user_id);
+        text(6, event.session_id);
+        text(7, event.ip_address);
+        text(8, event.user_agent);
+        text(9, event.description);
+        text(10, metadata);
+        text(11, event.stack_trace);
+        sqlite3_bind_int(insert_, 12, event.archived ? 1 : 0);
+
+        int rc = sqlite3_step(insert_);
+        if (rc != SQLITE_DONE) {
+            captureError();
+        }
+        sqlite3_reset(insert_);
+        sqlite3_clear_bindings(insert_);
+        return rc == SQLITE_DONE;
+    }
+
+    bool exec(const char* sql) {
+        char* message = nullptr;
+        if (sqlite3_exec(db_, sql, nullptr, nullptr, &message) != SQLITE_OK) {
+            last_error_ = message ? message : "sqlite3_exec failed";
+            sqlite3_free(message);
+            return false;
+        }
+        return true;
+    }
+
+    void captureError() {
+        last_error_ = db_ ? sqlite3_errmsg(db_) : "sqlite3_open failed";
+    }
+
+    sqlite3* db_ = nullptr;
+    sqlite3_stmt* insert_ = nullptr;
+    std::string last_error_;
+};
+
+} // namespace MedusaServer
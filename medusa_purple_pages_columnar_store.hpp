@@ -0,0 +1,1205 @@
+/*
+ * MEDUSA PURPLE-PAGES COLUMNAR AUDIT STORE
+ * Append-only, time-partitioned on-disk index for audit dashboards
+ * - events go into an in-memory partition that is sealed to one file per
+ *   time span (1 h by default) or row limit
+ * - each file holds one column per field; user_id, ip_address and
+ *   user_agent are dictionary encoded, timestamps delta encoded
+ * - a small footer (min/max timestamp, per-hour type x severity rollups,
+ *   bloom filters over users and IPs) is all that stays in memory, so a
+ *   query opens only the partitions its time range and filters can match
+ * - statistics come from the rollups; only the hour that straddles `since`
+ *   is counted row by row
+ * - the store is an index over the SQLite table: each partition records the
+ *   highest rowid it holds, so the rows after persistedRowid() (history from
+ *   before the store existed, or a tail lost in a crash) can be replayed
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace MedusaServer {
+
+namespace AuditColumnar {
+
+constexpr unsigned kTypeSlots = 32;
+constexpr unsigned kSeveritySlots = 8;
+constexpr unsigned kRollupSlots = kTypeSlots * kSeveritySlots;
+
+enum Section : unsigned {
+    SECTION_TIMESTAMP,
+    SECTION_TYPE,
+    SECTION_SEVERITY,
+    SECTION_USER,
+    SECTION_IP,
+    SECTION_SESSION,
+    SECTION_EVENT_ID,
+    SECTION_USER_AGENT,
+    SECTION_DESCRIPTION,
+    SECTION_METADATA,
+    SECTION_STACK_TRACE,
+    SECTION_ARCHIVED,
+    SECTION_USER_ROLLUP,
+    SECTION_COUNT
+};
+
+constexpr uint32_t sectionBit(Section section) { return uint32_t(1) << section; }
+constexpr uint32_t kAllSections = (uint32_t(1) << SECTION_COUNT) - 1;
+
+inline unsigned rollupSlot(unsigned type, unsigned severity) {
+    return (type % kTypeSlots) * kSeveritySlots + (severity % kSeveritySlots);
+}
+
+inline void putVarint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+inline uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline void putString(std::string& out, const std::string& value) {
+    putVarint(out, value.size());
+    out.append(value);
+}
+
+inline void putFixed64(std::string& out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+inline uint64_t getFixed64(const char* data) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Bounds-checked cursor; any overrun marks the reader failed
+ */
+class ByteReader {
+public:
+    ByteReader(const char* data, size_t size) : data_(data), end_(data + size) {}
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            if (data_ >= end_) {
+                ok_ = false;
+                return 0;
+            }
+            uint8_t byte = static_cast<uint8_t>(*data_++);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        ok_ = false;
+        return 0;
+    }
+
+    uint8_t byte() {
+        if (data_ >= end_) {
+            ok_ = false;
+            return 0;
+        }
+        return static_cast<uint8_t>(*data_++);
+    }
+
+    std::string string() {
+        uint64_t size = varint();
+        if (size > static_cast<uint64_t>(end_ - data_)) {
+            ok_ = false;
+            return std::string();
+        }
+        std::string value(data_, static_cast<size_t>(size));
+        data_ += size;
+        return value;
+    }
+
+    const char* bytes(size_t size) {
+        if (size > static_cast<size_t>(end_ - data_)) {
+            ok_ = false;
+            return nullptr;
+        }
+        const char* at = data_;
+        data_ += size;
+        return at;
+    }
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return data_ >= end_; }
+
+private:
+    const char* data_;
+    const char* end_;
+    bool ok_ = true;
+};
+
+/**
+ * @brief Bloom filter over strings (k probes by double hashing)
+ */
+class Bloom {
+public:
+    Bloom() = default;
+
+    Bloom(size_t expected, unsigned bits_per_value = 10) {
+        size_t bits = std::max<size_t>(64, expected * bits_per_value);
+        bits_.assign((bits + 63) / 64, 0);
+        probes_ = 7;
+    }
+
+    void add(const std::string& value) {
+        uint64_t h1, h2;
+        hashes(value, h1, h2);
+        uint64_t count = bitCount();
+        for (unsigned i = 0; i < probes_; ++i) {
+            uint64_t bit = (h1 + i * h2) % count;
+            bits_[bit / 64] |= uint64_t(1) << (bit % 64);
+        }
+    }
+
+    // Empty filter (never built) answers "maybe"
+    bool mayContain(const std::string& value) const {
+        if (bits_.empty()) {
+            return true;
+        }
+        uint64_t h1, h2;
+        hashes(value, h1, h2);
+        uint64_t count = bitCount();
+        for (unsigned i = 0; i < probes_; ++i) {
+            uint64_t bit = (h1 + i * h2) % count;
+            if (!((bits_[bit / 64] >> (bit % 64)) & 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void encode(std::string& out) const {
+        putVarint(out, bits_.size());
+        out.push_back(static_cast<char>(probes_));
+        for (uint64_t word : bits_) {
+            putFixed64(out, word);
+        }
+    }
+
+    bool decode(ByteReader& in) {
+        uint64_t words = in.varint();
+        probes_ = in.byte();
+        const char* data = in.bytes(static_cast<size_t>(words) * 8);
+        if (!data || !in.ok()) {
+            return false;
+        }
+        bits_.resize(static_cast<size_t>(words));
+        for (size_t i = 0; i < bits_.size(); ++i) {
+            bits_[i] = getFixed64(data + i * 8);
+        }
+        return true;
+    }
+
+private:
+    uint64_t bitCount() const { return static_cast<uint64_t>(bits_.size()) * 64; }
+
+    static void hashes(const std::string& value, uint64_t& h1, uint64_t& h2) {
+        // FNV-1a, then a murmur finaliser for the second probe stride
+        uint64_t h = 1469598103934665603ull;
+        for (unsigned char c : value) {
+            h = (h ^ c) * 1099511628211ull;
+        }
+        h1 = h;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h2 = h | 1;
+    }
+
+    std::vector<uint64_t> bits_;
+    unsigned probes_ = 0;
+};
+
+/**
+ * @brief String column stored as a dictionary plus one code per row
+ */
+struct DictColumn {
+    std::vector<std::string> values;
+    std::unordered_map<std::string, uint32_t> index;  // only while building
+    std::vector<uint32_t> codes;
+
+    void append(const std::string& value) {
+        auto [it, inserted] = index.emplace(value, static_cast<uint32_t>(values.size()));
+        if (inserted) {
+            values.push_back(value);
+        }
+        codes.push_back(it->second);
+    }
+
+    uint32_t find(const std::string& value) const {
+        if (!index.empty()) {
+            auto it = index.find(value);
+            return it == index.end() ? UINT32_MAX : it->second;
+        }
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (values[i] == value) {
+                return static_cast<uint32_t>(i);
+            }
+        }
+        return UINT32_MAX;
+    }
+
+    void encode(std::string& out) const {
+        putVarint(out, values.size());
+        for (const auto& value : values) {
+            putString(out, value);
+        }
+        putVarint(out, codes.size());
+        for (uint32_t code : codes) {
+            putVarint(out, code);
+        }
+    }
+
+    bool decode(ByteReader& in) {
+        values.resize(static_cast<size_t>(in.varint()));
+        for (auto& value : values) {
+            value = in.string();
+        }
+        codes.resize(static_cast<size_t>(in.varint()));
+        for (auto& code : codes) {
+            code = static_cast<uint32_t>(in.varint());
+            if (code >= values.size()) {
+                return false;
+            }
+        }
+        return in.ok();
+    }
+};
+
+struct HourRollup {
+    int64_t hour = 0;  // ms since epoch / 3600000
+    std::array<uint32_t, kRollupSlots> counts{};
+    std::unordered_map<uint32_t, uint32_t> users;  // user code -> events (resident partitions only)
+};
+
+/**
+ * @brief One partition's rows, column by column (only loaded sections are filled)
+ */
+struct Columns {
+    uint32_t loaded = 0;
+    size_t rows = 0;
+    std::vector<int64_t> timestamp_ms;
+    std::vector<uint8_t> type;
+    std::vector<uint8_t> severity;
+    DictColumn user;
+    DictColumn ip;
+    std::vector<std::string> session;
+    std::vector<std::string> event_id;
+    DictColumn user_agent;
+    std::vector<std::string> description;
+    std::vector<std::map<std::string, std::string>> metadata;
+    std::vector<std::string> stack_trace;
+    std::vector<uint8_t> archived;
+    std::vector<HourRollup> user_rollups;  // users map only; counts live in the footer
+};
+
+/**
+ * @brief Footer kept in memory for every partition
+ */
+struct PartitionMeta {
+    uint64_t rows = 0;
+    int64_t min_ms = std::numeric_limits<int64_t>::max();
+    int64_t max_ms = std::numeric_limits<int64_t>::min();
+    std::vector<HourRollup> hours;  // sorted by hour, counts only
+    Bloom users;
+    Bloom ips;
+    std::array<std::pair<uint64_t, uint64_t>, SECTION_COUNT> sections{};  // offset, size
+    int64_t max_rowid = 0;  // highest source (SQLite) rowid among the rows; 0 = unknown
+};
+
+constexpr char kMagic[8] = {'M', 'A', 'U', 'D', 'C', 'O', 'L', '1'};
+constexpr size_t kHeaderSize = 24;  // magic, footer offset, footer size
+
+} // namespace AuditColumnar
+
+/**
+ * @brief Columnar audit store; Event is AuditEvent-shaped
+ * @details One writer (AuditLogger's writer thread) appends; any number of
+ *          threads query. Sealed partitions are immutable files, so a query
+ *          only holds the store lock long enough to copy the partition list
+ *          and scan the in-memory tail.
+ */
+template<typename Event>
+class AuditColumnarStore {
+public:
+    struct Config {
+        int64_t partition_span_ms = 3600 * 1000;
+        size_t max_rows_per_partition = 1 << 20;
+        size_t decoded_cache_partitions = 8;
+    };
+
+    using TypeSeverityCounts = std::array<uint64_t, AuditColumnar::kRollupSlots>;
+
+    AuditColumnarStore() = default;
+    ~AuditColumnarStore() { close(); }
+
+    AuditColumnarStore(const AuditColumnarStore&) = delete;
+    AuditColumnarStore& operator=(const AuditColumnarStore&) = delete;
+
+    /**
+     * @brief Open (creating if needed) a partition directory and read every footer
+     */
+    bool open(const std::string& directory, const Config& config = Config()) {
+        close();
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        directory_ = directory;
+        config_ = config;
+        std::error_code ec;
+        std::filesystem::create_directories(directory_, ec);
+        if (ec) {
+            return false;
+        }
+        for (const auto& entry : std::filesystem::directory_iterator(directory_, ec)) {
+            if (entry.path().extension() != ".mcol") {
+                continue;
+            }
+            auto partition = std::make_shared<Partition>();
+            partition->path = entry.path().string();
+            if (readFooter(partition->path, partition->meta)) {
+                partitions_.push_back(std::move(partition));
+            }
+        }
+        // Partitions without a source rowid cannot be lined up with SQLite: rebuild from scratch
+        bool untracked = std::any_of(partitions_.begin(), partitions_.end(),
+                                     [](const auto& partition) { return partition->meta.max_rowid <= 0; });
+        if (untracked) {
+            for (const auto& partition : partitions_) {
+                std::filesystem::remove(partition->path, ec);
+            }
+            partitions_.clear();
+        }
+        sortPartitions();
+        open_ = true;
+        return true;
+    }
+
+    /**
+     * @brief Seal the in-memory partition to disk
+     */
+    void close() {
+        if (!open_) {
+            return;
+        }
+        sealActive();
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        open_ = false;
+        partitions_.clear();
+        std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+        cache_.clear();
+    }
+
+    /**
+     * @brief Append committed rows
+     * @param rowids SQLite rowid of each row in batch (same order)
+     */
+    void append(const std::vector<Event>& batch, const std::vector<int64_t>& rowids) {
+        bool seal = false;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            if (!open_) {
+                return;
+            }
+            for (size_t index = 0; index < batch.size(); ++index) {
+                const Event& event = batch[index];
+                int64_t ms = toMs(event.timestamp);
+                if (active_.rows > 0 &&
+                    (ms >= active_span_end_ || active_.rows >= config_.max_rows_per_partition)) {
+                    seal = true;
+                    moveActiveToSealing();
+                }
+                if (active_.rows == 0) {
+                    int64_t span = config_.partition_span_ms > 0 ? config_.partition_span_ms : 3600 * 1000;
+                    active_span_end_ = floorDiv(ms, span) * span + span;
+                }
+                appendRow(event, ms);
+                if (index < rowids.size()) {
+                    active_meta_.max_rowid = std::max(active_meta_.max_rowid, rowids[index]);
+                }
+            }
+        }
+        if (seal) {
+            writeSealing();
+        }
+    }
+
+    /**
+     * @brief Matching events, newest first
+     * @details Query is AuditQuery-shaped; a zero end_time means "no upper bound".
+     */
+    template<typename Query>
+    std::vector<Event> query(const Query& query) const {
+        Filter filter = makeFilter(query);
+        size_t wanted = static_cast<size_t>(std::max(0, query.offset)) + static_cast<size_t>(std::max(0, query.limit));
+        std::vector<Event> results;
+        if (wanted == 0) {
+            return results;
+        }
+
+        std::vector<Hit> hits;
+        std::vector<std::shared_ptr<Partition>> partitions;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            collectHits(active_, filter, hits);
+            std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) { return a.ms > b.ms; });
+            if (hits.size() > wanted) hits.resize(wanted);
+            for (const Hit& hit : hits) {
+                results.push_back(materialize(active_, hit.row));
+            }
+            partitions = partitions_;
+        }
+
+        // Newest partitions first; stop once the remaining ones cannot beat what we hold
+        std::vector<std::pair<int64_t, Event>> collected;
+        for (auto& event : results) {
+            collected.emplace_back(toMs(event.timestamp), std::move(event));
+        }
+        for (const auto& partition : partitions) {
+            const AuditColumnar::PartitionMeta& meta = partition->meta;
+            if (meta.max_ms < filter.start_ms || meta.min_ms > filter.end_ms) {
+                continue;
+            }
+            if (collected.size() >= wanted && meta.max_ms < oldestKept(collected)) {
+                continue;
+            }
+            if (!filter.user_id.empty() && !meta.users.mayContain(filter.user_id)) {
+                pruned_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            if (!filter.ip_address.empty() && !meta.ips.mayContain(filter.ip_address)) {
+                pruned_.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            auto columns = load(*partition, kFilterSections);
+            if (!columns) {
+                continue;
+            }
+            scanned_.fetch_add(1, std::memory_order_relaxed);
+            hits.clear();
+            collectHits(*columns, filter, hits);
+            if (hits.empty()) {
+                continue;
+            }
+            std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) { return a.ms > b.ms; });
+            if (hits.size() > wanted) hits.resize(wanted);
+            auto full = load(*partition, AuditColumnar::kAllSections);
+            if (!full) {
+                continue;
+            }
+            for (const Hit& hit : hits) {
+                collected.emplace_back(hit.ms, materialize(*full, hit.row));
+            }
+            std::stable_sort(collected.begin(), collected.end(),
+                             [](const auto& a, const auto& b) { return a.first > b.first; });
+            if (collected.size() > wanted) collected.resize(wanted);
+        }
+
+        std::stable_sort(collected.begin(), collected.end(),
+                         [](const auto& a, const auto& b) { return a.first > b.first; });
+        results.clear();
+        for (size_t i = static_cast<size_t>(std::max(0, query.offset)); i < collected.size() && results.size() < wanted; ++i) {
+            results.push_back(std::move(collected[i].second));
+        }
+        return results;
+    }
+
+    /**
+     * @brief Event counts by (type, severity) at or after since; index with rollupSlot()
+     */
+    TypeSeverityCounts countByTypeAndSeverity(std::chrono::system_clock::time_point since) const {
+        TypeSeverityCounts totals{};
+        int64_t since_ms = toMs(since);
+        auto add_hours = [&](const std::vector<AuditColumnar::HourRollup>& hours, bool& boundary) {
+            for (const auto& hour : hours) {
+                if (hour.hour * kHourMs >= since_ms) {
+                    for (unsigned slot = 0; slot < AuditColumnar::kRollupSlots; ++slot) {
+                        totals[slot] += hour.counts[slot];
+                    }
+                } else if ((hour.hour + 1) * kHourMs > since_ms) {
+                    boundary = true;
+                }
+            }
+        };
+        auto count_rows = [&](const AuditColumnar::Columns& columns) {
+            int64_t boundary_end = (floorDiv(since_ms, kHourMs) + 1) * kHourMs;
+            for (size_t row = 0; row < columns.rows; ++row) {
+                int64_t ms = columns.timestamp_ms[row];
+                if (ms >= since_ms && ms < boundary_end) {
+                    ++totals[AuditColumnar::rollupSlot(columns.type[row], columns.severity[row])];
+                }
+            }
+        };
+
+        std::vector<std::shared_ptr<Partition>> partitions;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            bool boundary = false;
+            add_hours(active_hours_, boundary);
+            if (boundary) {
+                count_rows(active_);
+            }
+            partitions = partitions_;
+        }
+        for (const auto& partition : partitions) {
+            if (partition->meta.max_ms < since_ms) {
+                continue;
+            }
+            bool boundary = false;
+            add_hours(partition->meta.hours, boundary);
+            if (boundary) {
+                scanned_.fetch_add(1, std::memory_order_relaxed);
+                if (auto columns = load(*partition, kCountSections)) {
+                    count_rows(*columns);
+                }
+            }
+        }
+        return totals;
+    }
+
+    /**
+     * @brief Events per user_id at or after since
+     */
+    std::map<std::string, uint64_t> countByUser(std::chrono::system_clock::time_point since) const {
+        std::map<std::string, uint64_t> totals;
+        int64_t since_ms = toMs(since);
+        int64_t boundary_end = (floorDiv(since_ms, kHourMs) + 1) * kHourMs;
+        auto add = [&](const AuditColumnar::Columns& columns, const std::vector<AuditColumnar::HourRollup>& hours) {
+            bool boundary = false;
+            for (const auto& hour : hours) {
+                if (hour.hour * kHourMs >= since_ms) {
+                    for (const auto& [code, count] : hour.users) {
+                        totals[columns.user.values[code]] += count;
+                    }
+                } else if ((hour.hour + 1) * kHourMs > since_ms) {
+                    boundary = true;
+                }
+            }
+            if (boundary) {
+                for (size_t row = 0; row < columns.rows; ++row) {
+                    int64_t ms = columns.timestamp_ms[row];
+                    if (ms >= since_ms && ms < boundary_end) {
+                        ++totals[columns.user.values[columns.user.codes[row]]];
+                    }
+                }
+            }
+        };
+
+        std::vector<std::shared_ptr<Partition>> partitions;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            add(active_, active_hours_);
+            partitions = partitions_;
+        }
+        for (const auto& partition : partitions) {
+            if (partition->meta.max_ms < since_ms) {
+                continue;
+            }
+            bool boundary = partition->meta.min_ms < boundary_end;
+            uint32_t sections = sectionBit(AuditColumnar::SECTION_USER) | sectionBit(AuditColumnar::SECTION_USER_ROLLUP);
+            if (boundary) {
+                sections |= kCountSections;
+            }
+            scanned_.fetch_add(1, std::memory_order_relaxed);
+            if (auto columns = load(*partition, sections)) {
+                add(*columns, columns->user_rollups);
+            }
+        }
+        return totals;
+    }
+
+    /**
+     * @brief Delete whole partitions whose newest event is before cutoff
+     */
+    size_t dropPartitionsBefore(std::chrono::system_clock::time_point cutoff) {
+        int64_t cutoff_ms = toMs(cutoff);
+        std::vector<std::shared_ptr<Partition>> dropped;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            auto keep = std::stable_partition(partitions_.begin(), partitions_.end(), [&](const auto& partition) {
+                return partition->meta.max_ms >= cutoff_ms || partition->path.empty();
+            });
+            dropped.assign(keep, partitions_.end());
+            partitions_.erase(keep, partitions_.end());
+        }
+        for (const auto& partition : dropped) {
+            std::error_code ec;
+            std::filesystem::remove(partition->path, ec);
+            std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+            cache_.remove_if([&](const CacheEntry& entry) { return entry.partition == partition.get(); });
+        }
+        return dropped.size();
+    }
+
+    /**
+     * @brief Highest SQLite rowid held by a partition on disk; rows after it must be replayed on open
+     */
+    int64_t persistedRowid() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        int64_t rowid = 0;
+        for (const auto& partition : partitions_) {
+            if (!partition->path.empty()) {
+                rowid = std::max(rowid, partition->meta.max_rowid);
+            }
+        }
+        return rowid;
+    }
+
+    size_t partitionCount() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return partitions_.size() + (active_.rows ? 1 : 0);
+    }
+
+    // Partitions whose columns had to be read, and those skipped by bloom filters
+    uint64_t partitionsScanned() const { return scanned_.load(std::memory_order_relaxed); }
+    uint64_t partitionsPruned() const { return pruned_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int64_t kHourMs = 3600 * 1000;
+    static constexpr uint32_t kCountSections =
+        AuditColumnar::sectionBit(AuditColumnar::SECTION_TIMESTAMP) |
+        AuditColumnar::sectionBit(AuditColumnar::SECTION_TYPE) |
+        AuditColumnar::sectionBit(AuditColumnar::SECTION_SEVERITY) |
+        AuditColumnar::sectionBit(AuditColumnar::SECTION_USER);
+    static constexpr uint32_t kFilterSections =
+        kCountSections |
+        AuditColumnar::sectionBit(AuditColumnar::SECTION_IP) |
+        AuditColumnar::sectionBit(AuditColumnar::SECTION_SESSION) |
+        AuditColumnar::sectionBit(AuditColumnar::SECTION_DESCRIPTION) |
+        AuditColumnar::sectionBit(AuditColumnar::SECTION_ARCHIVED);
+
+    struct Partition {
+        std::string path;  // empty while the file is being written
+        AuditColumnar::PartitionMeta meta;
+        std::shared_ptr<const AuditColumnar::Columns> resident;
+    };
+
+    struct CacheEntry {
+        const Partition* partition;
+        std::shared_ptr<const AuditColumnar::Columns> columns;
+    };
+
+    struct Filter {
+        int64_t start_ms = std::numeric_limits<int64_t>::min();
+        int64_t end_ms = std::numeric_limits<int64_t>::max();
+        uint64_t type_mask = ~uint64_t(0);
+        uint64_t severity_mask = ~uint64_t(0);
+        std::string user_id;
+        std::string session_id;
+        std::string ip_address;
+        std::string search_text;
+        bool include_archived = false;
+    };
+
+    struct Hit {
+        int64_t ms;
+        size_t row;
+    };
+
+    static int64_t floorDiv(int64_t value, int64_t divisor) {
+        int64_t quotient = value / divisor;
+        return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+    }
+
+    static int64_t toMs(std::chrono::system_clock::time_point when) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(when.time_since_epoch()).count();
+    }
+
+    template<typename Query>
+    static Filter makeFilter(const Query& query) {
+        Filter filter;
+        if (query.start_time.time_since_epoch().count() != 0) filter.start_ms = toMs(query.start_time);
+        if (query.end_time.time_since_epoch().count() != 0) filter.end_ms = toMs(query.end_time);
+        if (!query.event_types.empty()) {
+            filter.type_mask = 0;
+            for (auto type : query.event_types) filter.type_mask |= uint64_t(1) << (static_cast<unsigned>(type) % 64);
+        }
+        if (!query.severities.empty()) {
+            filter.severity_mask = 0;
+            for (auto severity : query.severities) filter.severity_mask |= uint64_t(1) << (static_cast<unsigned>(severity) % 64);
+        }
+        filter.user_id = query.user_id;
+        filter.session_id = query.session_id;
+        filter.ip_address = query.ip_address;
+        filter.search_text = query.search_text;
+        filter.include_archived = query.include_archived;
+        return filter;
+    }
+
+    static void collectHits(const AuditColumnar::Columns& columns, const Filter& filter, std::vector<Hit>& hits) {
+        uint32_t user_code = UINT32_MAX;
+        uint32_t ip_code = UINT32_MAX;
+        if (!filter.user_id.empty() && (user_code = columns.user.find(filter.user_id)) == UINT32_MAX) {
+            return;
+        }
+        if (!filter.ip_address.empty() && (ip_code = columns.ip.find(filter.ip_address)) == UINT32_MAX) {
+            return;
+        }
+        for (size_t row = 0; row < columns.rows; ++row) {
+            int64_t ms = columns.timestamp_ms[row];
+            if (ms < filter.start_ms || ms > filter.end_ms) continue;
+            if (!((filter.type_mask >> (columns.type[row] % 64)) & 1)) continue;
+            if (!((filter.severity_mask >> (columns.severity[row] % 64)) & 1)) continue;
+            if (user_code != UINT32_MAX && columns.user.codes[row] != user_code) continue;
+            if (ip_code != UINT32_MAX && columns.ip.codes[row] != ip_code) continue;
+            if (!filter.include_archived && columns.archived[row]) continue;
+            if (!filter.session_id.empty() && columns.session[row] != filter.session_id) continue;
+            if (!filter.search_text.empty() && columns.description[row].find(filter.search_text) == std::string::npos) continue;
+            hits.push_back(Hit{ms, row});
+        }
+    }
+
+    static Event materialize(const AuditColumnar::Columns& columns, size_t row) {
+        Event event;
+        event.event_id = columns.event_id[row];
+        event.event_type = static_cast<decltype(event.event_type)>(columns.type[row]);
+        event.severity = static_cast<decltype(event.severity)>(columns.severity[row]);
+        event.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::milliseconds(columns.timestamp_ms[row])));
+        event.user_id = columns.user.values[columns.user.codes[row]];
+        event.session_id = columns.session[row];
+        event.ip_address = columns.ip.values[columns.ip.codes[row]];
+        event.user_agent = columns.user_agent.values[columns.user_agent.codes[row]];
+        event.description = columns.description[row];
+        event.metadata = columns.metadata[row];
+        event.stack_trace = columns.stack_trace[row];
+        event.archived = columns.archived[row] != 0;
+        return event;
+    }
+
+    static int64_t oldestKept(const std::vector<std::pair<int64_t, Event>>& collected) {
+        int64_t oldest = std::numeric_limits<int64_t>::max();
+        for (const auto& entry : collected) oldest = std::min(oldest, entry.first);
+        return oldest;
+    }
+
+    // Caller holds mutex_ exclusively
+    void appendRow(const Event& event, int64_t ms) {
+        using namespace AuditColumnar;
+        unsigned type = static_cast<unsigned>(event.event_type);
+        unsigned severity = static_cast<unsigned>(event.severity);
+        active_.timestamp_ms.push_back(ms);
+        active_.type.push_back(static_cast<uint8_t>(type));
+        active_.severity.push_back(static_cast<uint8_t>(severity));
+        active_.user.append(event.user_id);
+        active_.ip.append(event.ip_address);
+        active_.session.push_back(event.session_id);
+        active_.event_id.push_back(event.event_id);
+        active_.user_agent.append(event.user_agent);
+        active_.description.push_back(event.description);
+        active_.metadata.push_back(event.metadata);
+        active_.stack_trace.push_back(event.stack_trace);
+        active_.archived.push_back(event.archived ? 1 : 0);
+        ++active_.rows;
+        active_.loaded = kAllSections;
+
+        int64_t hour = floorDiv(ms, kHourMs);
+        auto it = std::lower_bound(active_hours_.begin(), active_hours_.end(), hour,
+                                   [](const HourRollup& rollup, int64_t value) { return rollup.hour < value; });
+        if (it == active_hours_.end() || it->hour != hour) {
+            it = active_hours_.insert(it, HourRollup());
+            it->hour = hour;
+        }
+        ++it->counts[rollupSlot(type, severity)];
+        ++it->users[active_.user.codes.back()];
+
+        active_meta_.min_ms = std::min(active_meta_.min_ms, ms);
+        active_meta_.max_ms = std::max(active_meta_.max_ms, ms);
+    }
+
+    // Caller holds mutex_ exclusively; the partition stays queryable from memory until written
+    void moveActiveToSealing() {
+        auto partition = std::make_shared<Partition>();
+        partition->meta = std::move(active_meta_);
+        partition->meta.rows = active_.rows;
+        partition->meta.users = AuditColumnar::Bloom(active_.user.values.size());
+        for (const auto& user : active_.user.values) partition->meta.users.add(user);
+        partition->meta.ips = AuditColumnar::Bloom(active_.ip.values.size());
+        for (const auto& ip : active_.ip.values) partition->meta.ips.add(ip);
+
+        auto columns = std::make_shared<AuditColumnar::Columns>(std::move(active_));
+        columns->user_rollups = active_hours_;
+        for (auto& hour : active_hours_) {
+            hour.users.clear();
+        }
+        partition->meta.hours = std::move(active_hours_);
+        partition->resident = std::move(columns);
+        partitions_.push_back(partition);
+        sortPartitions();
+        sealing_.push_back(std::move(partition));
+
+        active_ = AuditColumnar::Columns();
+        active_meta_ = AuditColumnar::PartitionMeta();
+        active_hours_.clear();
+    }
+
+    void sealActive() {
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            if (active_.rows > 0) {
+                moveActiveToSealing();
+            }
+        }
+        writeSealing();
+    }
+
+    // Writer thread only: encode sealed partitions outside the store lock
+    void writeSealing() {
+        std::vector<std::shared_ptr<Partition>> pending;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            pending.swap(sealing_);
+        }
+        for (const auto& partition : pending) {
+            std::string path;
+            std::error_code ec;
+            do {
+                path = directory_ + "/part-" + std::to_string(partition->meta.min_ms) + "-" +
+                       std::to_string(sequence_++) + ".mcol";
+            } while (std::filesystem::exists(path, ec));
+            AuditColumnar::PartitionMeta meta = partition->meta;
+            if (!writePartition(path, *partition->resident, meta)) {
+                // Stays resident (and queryable); retried on the next seal or close
+                std::unique_lock<std::shared_mutex> lock(mutex_);
+                sealing_.push_back(partition);
+                continue;
+            }
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            partition->meta.sections = meta.sections;
+            partition->path = path;
+            std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+            cache_.push_front(CacheEntry{partition.get(), partition->resident});
+            trimCache();
+            partition->resident.reset();
+        }
+    }
+
+    void sortPartitions() {
+        std::sort(partitions_.begin(), partitions_.end(),
+                  [](const auto& a, const auto& b) { return a->meta.max_ms > b->meta.max_ms; });
+    }
+
+    static bool writePartition(const std::string& path, const AuditColumnar::Columns& columns,
+                               AuditColumnar::PartitionMeta& meta) {
+        using namespace AuditColumnar;
+        std::string file(kMagic, sizeof(kMagic));
+        file.append(16, '\0');  // footer offset and size, patched below
+
+        std::string section;
+        auto finish = [&](Section id) {
+            meta.sections[id] = {file.size(), section.size()};
+            file += section;
+            section.clear();
+        };
+
+        int64_t previous = 0;
+        for (int64_t ms : columns.timestamp_ms) {
+            putVarint(section, zigzag(ms - previous));
+            previous = ms;
+        }
+        finish(SECTION_TIMESTAMP);
+        section.assign(columns.type.begin(), columns.type.end());
+        finish(SECTION_TYPE);
+        section.assign(columns.severity.begin(), columns.severity.end());
+        finish(SECTION_SEVERITY);
+        columns.user.encode(section);
+        finish(SECTION_USER);
+        columns.ip.encode(section);
+        finish(SECTION_IP);
+        for (const auto& value : columns.session) putString(section, value);
+        finish(SECTION_SESSION);
+        for (const auto& value : columns.event_id) putString(section, value);
+        finish(SECTION_EVENT_ID);
+        columns.user_agent.encode(section);
+        finish(SECTION_USER_AGENT);
+        for (const auto& value : columns.description) putString(section, value);
+        finish(SECTION_DESCRIPTION);
+        for (const auto& entries : columns.metadata) {
+            putVarint(section, entries.size());
+            for (const auto& [key, value] : entries) {
+                putString(section, key);
+                putString(section, value);
+            }
+        }
+        finish(SECTION_METADATA);
+        for (const auto& value : columns.stack_trace) putString(section, value);
+        finish(SECTION_STACK_TRACE);
+        section.assign(columns.archived.begin(), columns.archived.end());
+        finish(SECTION_ARCHIVED);
+        putVarint(section, columns.user_rollups.size());
+        for (const auto& hour : columns.user_rollups) {
+            putVarint(section, zigzag(hour.hour));
+            putVarint(section, hour.users.size());
+            for (const auto& [code, count] : hour.users) {
+                putVarint(section, code);
+                putVarint(section, count);
+            }
+        }
+        finish(SECTION_USER_ROLLUP);
+
+        std::string footer;
+        putVarint(footer, meta.rows);
+        putVarint(footer, zigzag(meta.min_ms));
+        putVarint(footer, zigzag(meta.max_ms));
+        putVarint(footer, meta.hours.size());
+        for (const auto& hour : meta.hours) {
+            putVarint(footer, zigzag(hour.hour));
+            unsigned nonzero = 0;
+            for (uint32_t count : hour.counts) nonzero += count != 0;
+            putVarint(footer, nonzero);
+            for (unsigned slot = 0; slot < kRollupSlots; ++slot) {
+                if (hour.counts[slot]) {
+                    putVarint(footer, slot);
+                    putVarint(footer, hour.counts[slot]);
+                }
+            }
+        }
+        meta.users.encode(footer);
+        meta.ips.encode(footer);
+        for (const auto& [offset, size] : meta.sections) {
+            putVarint(footer, offset);
+            putVarint(footer, size);
+        }
+        putVarint(footer, zigzag(meta.max_rowid));
+
+        std::string offsets;
+        putFixed64(offsets, file.size());
+        putFixed64(offsets, footer.size());
+        file.replace(sizeof(kMagic), 16, offsets);
+        file += footer;
+
+        // Write then rename, so a crash never leaves a half partition behind
+        std::string temp = path + ".tmp";
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out.write(file.data(), static_cast<std::streamsize>(file.size()))) {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp, path, ec);
+        return !ec;
+    }
+
+    static bool readFooter(const std::string& path, AuditColumnar::PartitionMeta& meta) {
+        using namespace AuditColumnar;
+        std::ifstream in(path, std::ios::binary);
+        char header[kHeaderSize];
+        if (!in.read(header, kHeaderSize) || std::memcmp(header, kMagic, sizeof(kMagic)) != 0) {
+            return false;
+        }
+        uint64_t offset = getFixed64(header + 8);
+        uint64_t size = getFixed64(header + 16);
+        std::string footer(static_cast<size_t>(size), '\0');
+        in.seekg(static_cast<std::streamoff>(offset));
+        if (!in.read(&footer[0], static_cast<std::streamsize>(size))) {
+            return false;
+        }
+
+        ByteReader reader(footer.data(), footer.size());
+        meta.rows = reader.varint();
+        meta.min_ms = unzigzag(reader.varint());
+        meta.max_ms = unzigzag(reader.varint());
+        meta.hours.resize(static_cast<size_t>(reader.varint()));
+        for (auto& hour : meta.hours) {
+            hour.hour = unzigzag(reader.varint());
+            uint64_t nonzero = reader.varint();
+            for (uint64_t i = 0; i < nonzero && reader.ok(); ++i) {
+                uint64_t slot = reader.varint();
+                uint64_t count = reader.varint();
+                if (slot < kRollupSlots) hour.counts[slot] = static_cast<uint32_t>(count);
+            }
+        }
+        if (!meta.users.decode(reader) || !meta.ips.decode(reader)) {
+            return false;
+        }
+        for (auto& [section_offset, section_size] : meta.sections) {
+            section_offset = reader.varint();
+            section_size = reader.varint();
+        }
+        meta.max_rowid = reader.atEnd() ? 0 : unzigzag(reader.varint());
+        return reader.ok();
+    }
+
+    // Decoded columns for a partition with at least the requested sections
+    std::shared_ptr<const AuditColumnar::Columns> load(const Partition& partition, uint32_t sections) const {
+        std::string path;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            if (partition.resident) {
+                return partition.resident;
+            }
+            path = partition.path;
+        }
+        std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+        uint32_t wanted = sections;
+        for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+            if (it->partition == &partition) {
+                if ((it->columns->loaded & sections) == sections) {
+                    cache_.splice(cache_.begin(), cache_, it);
+                    return cache_.front().columns;
+                }
+                wanted |= it->columns->loaded;
+                cache_.erase(it);
+                break;
+            }
+        }
+        auto columns = readColumns(path, partition.meta, wanted);
+        if (!columns) {
+            return nullptr;
+        }
+        cache_.push_front(CacheEntry{&partition, columns});
+        trimCache();
+        return columns;
+    }
+
+    void trimCache() const {
+        while (cache_.size() > std::max<size_t>(1, config_.decoded_cache_partitions)) {
+            cache_.pop_back();
+        }
+    }
+
+    static std::shared_ptr<const AuditColumnar::Columns> readColumns(const std::string& path,
+                                                                     const AuditColumnar::PartitionMeta& meta,
+                                                                     uint32_t sections) {
+        using namespace AuditColumnar;
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return nullptr;
+        }
+        auto columns = std::make_shared<Columns>();
+        columns->rows = static_cast<size_t>(meta.rows);
+        size_t rows = columns->rows;
+        std::string buffer;
+        for (unsigned id = 0; id < SECTION_COUNT; ++id) {
+            if (!(sections & sectionBit(static_cast<Section>(id)))) {
+                continue;
+            }
+            auto [offset, size] = meta.sections[id];
+            buffer.resize(static_cast<size_t>(size));
+            in.seekg(static_cast<std::streamoff>(offset));
+            if (size && !in.read(&buffer[0], static_cast<std::streamsize>(size))) {
+                return nullptr;
+            }
+            ByteReader reader(buffer.data(), buffer.size());
+            auto strings = [&](std::vector<std::string>& out) {
+                out.resize(rows);
+                for (auto& value : out) value = reader.string();
+            };
+            auto bytes = [&](std::vector<uint8_t>& out) {
+                const char* data = reader.bytes(rows);
+                if (data) out.assign(data, data + rows);
+            };
+            bool ok = true;
+            switch (id) {
+                case SECTION_TIMESTAMP: {
+                    columns->timestamp_ms.resize(rows);
+                    int64_t previous = 0;
+                    for (auto& ms : columns->timestamp_ms) {
+                        previous += unzigzag(reader.varint());
+                        ms = previous;
+                    }
+                    break;
+                }
+                case SECTION_TYPE: bytes(columns->type); break;
+                case SECTION_SEVERITY: bytes(columns->severity); break;
+                case SECTION_USER: ok = columns->user.decode(reader) && columns->user.codes.size() == rows; break;
+                case SECTION_IP: ok = columns->ip.decode(reader) && columns->ip.codes.size() == rows; break;
+                case SECTION_SESSION: strings(columns->session); break;
+                case SECTION_EVENT_ID: strings(columns->event_id); break;
+                case SECTION_USER_AGENT:
+                    ok = columns->user_agent.decode(reader) && columns->user_agent.codes.size() == rows;
+                    break;
+                case SECTION_DESCRIPTION: strings(columns->description); break;
+                case SECTION_METADATA:
+                    columns->metadata.resize(rows);
+                    for (auto& entries : columns->metadata) {
+                        uint64_t count = reader.varint();
+                        for (uint64_t i = 0; i < count && reader.ok(); ++i) {
+                            std::string key = reader.string();
+                            entries[key] = reader.string();
+                        }
+                    }
+                    break;
+                case SECTION_STACK_TRACE: strings(columns->stack_trace); break;
+                case SECTION_ARCHIVED: bytes(columns->archived); break;
+                case SECTION_USER_ROLLUP:
+                    columns->user_rollups.resize(static_cast<size_t>(reader.varint()));
+                    for (auto& hour : columns->user_rollups) {
+                        hour.hour = unzigzag(reader.varint());
+                        uint64_t count = reader.varint();
+                        for (uint64_t i = 0; i < count && reader.ok(); ++i) {
+                            uint32_t code = static_cast<uint32_t>(reader.varint());
+                            hour.users[code] = static_cast<uint32_t>(reader.varint());
+                        }
+                    }
+                    break;
+            }
+            if (!ok || !reader.ok()) {
+                return nullptr;
+            }
+        }
+        columns->loaded = sections;
+        return columns;
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::string directory_;
+    Config config_;
+    bool open_ = false;
+    uint64_t sequence_ = 0;
+
+    AuditColumnar::Columns active_;
+    AuditColumnar::PartitionMeta active_meta_;
+    std::vector<AuditColumnar::HourRollup> active_hours_;
+    int64_t active_span_end_ = 0;
+
+    std::vector<std::shared_ptr<Partition>> partitions_;  // newest first
+    std::vector<std::shared_ptr<Partition>> sealing_;
+
+    mutable std::mutex cache_mutex_;
+    mutable std::list<CacheEntry> cache_;
+
+    mutable std::atomic<uint64_t> scanned_{0};
+    mutable std::atomic<uint64_t> pruned_{0};
+};
+
+} // namespace MedusaServer
@@ -0,0 +1,344 @@
+/**
+ * MEDUSASERV SOCKET READINESS GATE
+ * ================================
+ * Holds accepted sockets until their request bytes arrive, so executor
+ * workers only ever read sockets that are already readable
+ * - one epoll thread watches every waiting socket
+ * - watchRequest() also buffers the request there, so handlers never wait
+ *   on a client that sends its request in pieces
+ * - sockets idle past the timeout are closed without touching the executor
+ * - accepted sockets also get SO_RCVTIMEO/SO_SNDTIMEO as a backstop
+ * © 2025 The Medusa Project | Roylepython | D Hargreaves
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace MedusaServ {
+namespace Executor {
+
+/**
+ * @brief Waits for accepted sockets to become readable, then hands them on
+ */
+class ReadinessGate {
+public:
+    using Handler = std::function<void(int)>;
+    using RequestHandler = std::function<void(int, std::string)>;
+
+    static constexpr size_t DEFAULT_MAX_REQUEST_BYTES = 64 * 1024;
+
+    explicit ReadinessGate(std::chrono::milliseconds idle_timeout = std::chrono::seconds(10),
+                           std::chrono::milliseconds io_timeout = std::chrono::seconds(5))
+        : idle_timeout_(idle_timeout), io_timeout_(io_timeout) {}
+
+    ~ReadinessGate() { stop(); }
+
+    ReadinessGate(const ReadinessGate&) = delete;
+    ReadinessGate& operator=(const ReadinessGate&) = delete;
+
+    /**
+     * @brief Start the epoll thread
+     * @return false where epoll is unavailable (callers dispatch directly)
+     */
+    bool start() {
+#ifdef __linux__
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_.load(std::memory_order_acquire)) {
+            return true;
+        }
+        epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epoll_fd_ < 0 || wake_fd_ < 0) {
+            closeDescriptors();
+            return false;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = wake_fd_;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread(&ReadinessGate::loop, this);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Stop the thread and close every socket still waiting
+     */
+    void stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+#ifdef __linux__
+        uint64_t one = 1;
+        ssize_t ignored = ::write(wake_fd_, &one, sizeof(one));
+        (void)ignored;
+#endif
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+#ifdef __linux__
+        for (const auto& entry : waiting_) {
+            ::close(entry.first);
+        }
+#endif
+        waiting_.clear();
+        closeDescriptors();
+    }
+
+    /**
+     * @brief Hand over an accepted socket; on_ready(fd) runs on the gate thread once it is readable
+     * on_ready should only queue work. Sockets idle past the timeout are closed.
+     * @return false when the gate is not running (the caller still owns fd)
+     */
+    bool watch(int fd, Handler on_ready) {
+#ifdef __linux__
+        if (!running_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        Waiting waiting;
+        waiting.on_ready = std::move(on_ready);
+        return add(fd, std::move(waiting));
+#else
+        (void)fd;
+        (void)on_ready;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Like watch(), but on_request(fd, request) runs only once the whole
+     * request (headers plus Content-Length body) has been read on the gate thread
+     * Requests larger than max_bytes, or cut short by the peer, are handed over
+     * as far as they got. Requests not complete within the idle timeout are closed.
+     * @return false when the gate is not running (the caller still owns fd)
+     */
+    bool watchRequest(int fd, RequestHandler on_request, size_t max_bytes = DEFAULT_MAX_REQUEST_BYTES) {
+#ifdef __linux__
+        if (!running_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        Waiting waiting;
+        waiting.on_request = std::move(on_request);
+        waiting.max_bytes = max_bytes;
+        return add(fd, std::move(waiting));
+#else
+        (void)fd;
+        (void)on_request;
+        (void)max_bytes;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Blocking fallback for watchRequest() when the gate is not running
+     * Reads are bounded by the socket's SO_RCVTIMEO.
+     */
+    static std::string readRequest(int fd, size_t max_bytes = DEFAULT_MAX_REQUEST_BYTES) {
+        std::string request;
+#ifdef __linux__
+        char chunk[4096];
+        while (request.size() < max_bytes && !requestComplete(request)) {
+            ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                break;
+            }
+            request.append(chunk, static_cast<size_t>(received));
+        }
+#else
+        (void)fd;
+        (void)max_bytes;
+#endif
+        return request;
+    }
+
+    /**
+     * @brief True once the header block and any Content-Length body have arrived
+     */
+    static bool requestComplete(const std::string& request) {
+        size_t header_end = request.find("\r\n\r\n");
+        if (header_end == std::string::npos) {
+            return false;
+        }
+        static const char name[] = "\r\ncontent-length:";
+        constexpr size_t name_length = sizeof(name) - 1;
+        size_t body = 0;
+        for (size_t at = request.find("\r\n"); at < header_end; at = request.find("\r\n", at + 2)) {
+            size_t i = 0;
+            while (i < name_length && at + i < header_end &&
+                   std::tolower(static_cast<unsigned char>(request[at + i])) == name[i]) {
+                ++i;
+            }
+            if (i == name_length) {
+                body = std::strtoul(request.c_str() + at + name_length, nullptr, 10);
+                break;
+            }
+        }
+        return request.size() - (header_end + 4) >= body;
+    }
+
+    /**
+     * @brief Bound blocking reads and writes on a socket
+     */
+    static void setTimeouts(int fd, std::chrono::milliseconds timeout) {
+#ifdef __linux__
+        timeval tv{};
+        tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+        tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+#else
+        (void)fd;
+        (void)timeout;
+#endif
+    }
+
+    size_t waitingCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return waiting_.size();
+    }
+
+    uint64_t timedOutCount() const { return timed_out_.load(std::memory_order_relaxed); }
+
+private:
+    struct Waiting {
+        Handler on_ready;
+        RequestHandler on_request;   // set by watchRequest(): buffer until complete
+        std::string request;
+        size_t max_bytes = 0;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    struct Ready {
+        int fd;
+        Waiting waiting;
+    };
+
+#ifdef __linux__
+    bool add(int fd, Waiting waiting) {
+        setTimeouts(fd, io_timeout_);
+        waiting.deadline = std::chrono::steady_clock::now() + idle_timeout_;
+        std::lock_guard<std::mutex> lock(mutex_);
+        waiting_[fd] = std::move(waiting);
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            waiting_.erase(fd);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Drain what the socket has without blocking
+     * @return true when the request is complete, capped, or the peer is done sending
+     */
+    static bool fill(int fd, Waiting& waiting) {
+        char chunk[4096];
+        while (waiting.request.size() < waiting.max_bytes) {
+            ssize_t received = ::recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+            if (received > 0) {
+                waiting.request.append(chunk, static_cast<size_t>(received));
+                continue;
+            }
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                return requestComplete(waiting.request);
+            }
+            return true;
+        }
+        return true;
+    }
+#endif
+
+    void closeDescriptors() {
+#ifdef __linux__
+        if (epoll_fd_ >= 0) ::close(epoll_fd_);
+        if (wake_fd_ >= 0) ::close(wake_fd_);
+#endif
+        epoll_fd_ = -1;
+        wake_fd_ = -1;
+    }
+
+#ifdef __linux__
+    void loop() {
+        constexpr int SWEEP_INTERVAL_MS = 250;
+        epoll_event events[256];
+        std::vector<Ready> ready;
+        while (running_.load(std::memory_order_acquire)) {
+            int count = epoll_wait(epoll_fd_, events, 256, SWEEP_INTERVAL_MS);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (int i = 0; i < count; ++i) {
+                    int fd = events[i].data.fd;
+                    auto found = fd == wake_fd_ ? waiting_.end() : waiting_.find(fd);
+                    if (found == waiting_.end()) {
+                        continue;
+                    }
+                    if (found->second.on_request && !fill(fd, found->second)) {
+                        continue;
+                    }
+                    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+                    ready.push_back(Ready{fd, std::move(found->second)});
+                    waiting_.erase(found);
+                }
+                auto now = std::chrono::steady_clock::now();
+                for (auto it = waiting_.begin(); it != waiting_.end();) {
+                    if (it->second.deadline <= now) {
+                        epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, it->first, nullptr);
+                        ::close(it->first);
+                        timed_out_.fetch_add(1, std::memory_order_relaxed);
+                        it = waiting_.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+            // Outside mutex_: handlers may call watch() again
+            for (auto& entry : ready) {
+                if (entry.waiting.on_request) {
+                    entry.waiting.on_request(entry.fd, std::move(entry.waiting.request));
+                } else {
+                    entry.waiting.on_ready(entry.fd);
+                }
+            }
+            ready.clear();
+        }
+    }
+#endif
+
+    std::chrono::milliseconds idle_timeout_;
+    std::chrono::milliseconds io_timeout_;
+    int epoll_fd_ = -1;
+    int wake_fd_ = -1;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::unordered_map<int, Waiting> waiting_;
+    std::atomic<uint64_t> timed_out_{0};
+};
+
+} // namespace Executor
+} // namespace MedusaServ
@@ -0,0 +1,471 @@
+/**
+ * MEDUSASERV WORK-STEALING EXECUTOR
+ * =================================
+ * Shared connection executor for HTTPListener, NativeMedusaServ and MedusaServAuth
+ * Per-worker Chase-Lev deques, bounded global injection queue, optional CPU pinning
+ * © 2025 The Medusa Project | Roylepython | D Hargreaves
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace MedusaServ {
+namespace Executor {
+
+/**
+ * @brief Executor sizing and placement
+ */
+struct ExecutorConfig {
+    size_t worker_count = 0;            // 0 = one worker per hardware thread
+    size_t injection_capacity = 65536;  // rounded up to a power of two
+    size_t deque_initial_capacity = 1024;
+    bool pin_workers_to_cores = false;
+};
+
+/**
+ * @brief Counters exposed for dashboards
+ */
+struct ExecutorStats {
+    uint64_t submitted = 0;
+    uint64_t executed = 0;
+    uint64_t stolen = 0;
+    uint64_t rejected = 0;
+    size_t workers = 0;
+};
+
+/**
+ * @brief One unit of work; heap-allocated so deques only move pointers
+ */
+struct Task {
+    std::function<void()> fn;
+};
+
+/**
+ * @brief Bounded lock-free MPMC ring (Vyukov) used as the global injection queue
+ */
+class InjectionQueue {
+public:
+    explicit InjectionQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        cells_ = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(Task* task) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.task = task;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    Task* pop() {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    Task* task = cell.task;
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return task;
+                }
+            } else if (diff < 0) {
+                return nullptr;  // empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool empty() const {
+        return dequeue_pos_.load(std::memory_order_acquire) >= enqueue_pos_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Task* task = nullptr;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
+
+/**
+ * @brief Chase-Lev work-stealing deque (Lê et al. C11 formulation)
+ * @details Only the owning worker calls push()/pop(); any thread may steal().
+ *          Grown buffers are retired, not freed, until the deque is destroyed
+ *          because a concurrent thief may still be reading them.
+ */
+class WorkStealingDeque {
+public:
+    explicit WorkStealingDeque(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        auto buffer = std::make_unique<Buffer>(size);
+        buffer_.store(buffer.get(), std::memory_order_relaxed);
+        buffers_.push_back(std::move(buffer));
+    }
+
+    void push(Task* task) {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        int64_t top = top_.load(std::memory_order_acquire);
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        if (bottom - top > static_cast<int64_t>(buffer->mask)) {
+            buffer = grow(buffer, top, bottom);
+        }
+        buffer->put(bottom, task);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    Task* pop() {
+        int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = buffer_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        Task* task = buffer->get(bottom);
+        if (top == bottom) {
+            // Last element: race thieves for it
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    Task* steal() {
+        int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return nullptr;
+        }
+        Buffer* buffer = buffer_.load(std::memory_order_acquire);
+        Task* task = buffer->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return task;
+    }
+
+    bool empty() const {
+        return top_.load(std::memory_order_acquire) >= bottom_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t size) : mask(size - 1), slots(new std::atomic<Task*>[size]) {}
+        size_t mask;
+        std::unique_ptr<std::atomic<Task*>[]> slots;
+
+        Task* get(int64_t index) const {
+            return slots[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed);
+        }
+        void put(int64_t index, Task* task) {
+            slots[static_cast<size_t>(index) & mask].store(task, std::memory_order_relaxed);
+        }
+    };
+
+    Buffer* grow(Buffer* old, int64_t top, int64_t bottom) {
+        auto bigger = std::make_unique<Buffer>((old->mask + 1) * 2);
+        for (int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, old->get(i));
+        }
+        Buffer* raw = bigger.get();
+        buffers_.push_back(std::move(bigger));
+        buffer_.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+    alignas(64) std::atomic<int64_t> top_{0};
+    alignas(64) std::atomic<int64_t> bottom_{0};
+    std::atomic<Buffer*> buffer_{nullptr};
+    std::vector<std::unique_ptr<Buffer>> buffers_;  // owner-only
+};
+
+/**
+ * @brief Work-stealing thread pool shared by every MedusaServ listener
+ *
+ * Tasks submitted from a worker go to that worker's deque (LIFO for cache
+ * warmth); tasks from anywhere else go through the bounded injection queue.
+ * Idle workers steal FIFO from random victims before parking.
+ */
+class WorkStealingExecutor {
+public:
+    explicit WorkStealingExecutor(const ExecutorConfig& config = ExecutorConfig())
+        : config_(config), injection_(config.injection_capacity) {
+        size_t workers = config_.worker_count;
+        if (workers == 0) {
+            workers = std::thread::hardware_concurrency();
+            if (workers == 0) {
+                workers = 1;
+            }
+        }
+        for (size_t i = 0; i < workers; ++i) {
+            deques_.push_back(std::make_unique<WorkStealingDeque>(config_.deque_initial_capacity));
+        }
+        running_.store(true, std::memory_order_release);
+        for (size_t i = 0; i < workers; ++i) {
+            threads_.emplace_back(&WorkStealingExecutor::workerLoop, this, i);
+        }
+    }
+
+    ~WorkStealingExecutor() {
+        shutdown();
+    }
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    /**
+     * @brief Process-wide executor used by all listeners
+     */
+    static WorkStealingExecutor& shared() {
+        static WorkStealingExecutor instance;
+        return instance;
+    }
+
+    /**
+     * @brief Queue a task; false when the injection queue is full or the executor stopped
+     */
+    bool submit(std::function<void()> fn) {
+        if (!running_.load(std::memory_order_acquire)) {
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        Task* task = new Task{std::move(fn)};
+        if (current_executor_ == this) {
+            deques_[current_worker_]->push(task);
+        } else if (!injection_.push(task)) {
+            delete task;
+            rejected_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        submitted_.fetch_add(1, std::memory_order_relaxed);
+
+        // Pairs with the fence in park(): either we see the sleeper or it sees the task
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            park_cv_.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stop accepting work, drain queued tasks and join workers
+     */
+    void shutdown() {
+        bool expected = true;
+        if (!running_.compare_exchange_strong(expected, false)) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            park_cv_.notify_all();
+        }
+        for (auto& thread : threads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+
+    size_t workerCount() const {
+        return threads_.size();
+    }
+
+    ExecutorStats getStats() const {
+        ExecutorStats stats;
+        stats.submitted = submitted_.load(std::memory_order_relaxed);
+        stats.executed = executed_.load(std::memory_order_relaxed);
+        stats.stolen = stolen_.load(std::memory_order_relaxed);
+        stats.rejected = rejected_.load(std::memory_order_relaxed);
+        stats.workers = threads_.size();
+        return stats;
+    }
+
+private:
+    void workerLoop(size_t index) {
+        current_executor_ = this;
+        current_worker_ = index;
+        pinToCore(index);
+
+        uint64_t rng = 0x9E3779B97F4A7C15ull ^ (index + 1);
+        int idle_spins = 0;
+
+        for (;;) {
+            Task* task = findTask(index, rng);
+            if (task) {
+                idle_spins = 0;
+                run(task);
+                continue;
+            }
+            if (!running_.load(std::memory_order_acquire)) {
+                if (!hasVisibleWork()) {
+                    break;
+                }
+                continue;
+            }
+            if (++idle_spins < 64) {
+                std::this_thread::yield();
+                continue;
+            }
+            idle_spins = 0;
+            park();
+        }
+
+        current_executor_ = nullptr;
+    }
+
+    Task* findTask(size_t index, uint64_t& rng) {
+        if (Task* task = deques_[index]->pop()) {
+            return task;
+        }
+        if (Task* task = injection_.pop()) {
+            return task;
+        }
+        size_t count = deques_.size();
+        if (count > 1) {
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            size_t start = static_cast<size_t>(rng % count);
+            for (size_t i = 0; i < count; ++i) {
+                size_t victim = (start + i) % count;
+                if (victim == index) {
+                    continue;
+                }
+                if (Task* task = deques_[victim]->steal()) {
+                    stolen_.fetch_add(1, std::memory_order_relaxed);
+                    return task;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    bool hasVisibleWork() const {
+        if (!injection_.empty()) {
+            return true;
+        }
+        for (const auto& deque : deques_) {
+            if (!deque->empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void park() {
+        std::unique_lock<std::mutex> lock(park_mutex_);
+        sleeping_.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (running_.load(std::memory_order_acquire) && !hasVisibleWork()) {
+            // Timed wait is only a safety net; submit() wakes parked workers directly
+            park_cv_.wait_for(lock, std::chrono::milliseconds(100));
+        }
+        sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void run(Task* task) {
+        std::unique_ptr<Task> owned(task);
+        try {
+            owned->fn();
+        } catch (...) {
+            // A failing connection handler must not take the worker down
+        }
+        executed_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void pinToCore(size_t index) {
+#ifdef __linux__
+        if (!config_.pin_workers_to_cores) {
+            return;
+        }
+        unsigned cores = std::thread::hardware_concurrency();
+        if (cores == 0) {
+            return;
+        }
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<int>(index % cores), &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)index;
+#endif
+    }
+
+    ExecutorConfig config_;
+    InjectionQueue injection_;
+    std::vector<std::unique_ptr<WorkStealingDeque>> deques_;
+    std::vector<std::thread> threads_;
+    std::atomic<bool> running_{false};
+
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+    std::atomic<int> sleeping_{0};
+
+    std::atomic<uint64_t> submitted_{0};
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> stolen_{0};
+    std::atomic<uint64_t> rejected_{0};
+
+    static thread_local WorkStealingExecutor* current_executor_;
+    static thread_local size_t current_worker_;
+};
+
+inline thread_local WorkStealingExecutor* WorkStealingExecutor::current_executor_ = nullptr;
+inline thread_local size_t WorkStealingExecutor::current_worker_ = 0;
+
+} // namespace Executor
+} // namespace MedusaServ
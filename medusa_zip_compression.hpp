@@ -38,10 +38,10 @@
 #include <iomanip>
 #include <algorithm>
 #include <cstring>
-// External compression libraries - commented out until properly configured
-// #include <zlib.h>
-// #include <lz4.h>
-// #include <zstd.h>
+#include <filesystem>
+// External compression libraries (zlib, LZ4, Zstandard) are picked up by the
+// streaming engine when their headers are available
+#include "medusa_zip_streaming.hpp"
 
 namespace PFQL2025 {
 
@@ -173,12 +173,41 @@ public:
     MedusaZipCompression();
     ~MedusaZipCompression();
     
-    // Core compression methods
+    // Core compression methods (streamed in blocks: memory is bounded by set_memory_limit_mb)
     bool compress_file(const std::string& input_path, const std::string& output_path, 
                       CompressionAlgorithm algorithm = CompressionAlgorithm::AI_OPTIMIZED,
-                      CompressionLevel level = CompressionLevel::AI_OPTIMAL);
+                      CompressionLevel level = CompressionLevel::AI_OPTIMAL) {
+        std::ifstream in(input_path, std::ios::binary);
+        std::ofstream out(output_path, std::ios::binary | std::ios::trunc);
+        if (!in || !out) return false;
+        StreamingOptions options = streaming_options(algorithm, level);
+        StreamingCompressor compressor(out, options);
+        compressor.write_from(in);
+        StreamingResult result = compressor.finish();
+        record_streaming_result(result, compressor.buffer_bytes());
+        return result.success;
+    }
+    
+    bool decompress_file(const std::string& input_path, const std::string& output_path) {
+        StreamingDecompressor decompressor;
+        if (!decompressor.open(input_path)) return false;
+        std::ofstream out(output_path, std::ios::binary | std::ios::trunc);
+        auto started = std::chrono::steady_clock::now();
+        bool ok = out && decompressor.decompress_to(out, configured_threads(), memory_limit_mb_.load() << 20);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        if (ok && seconds > 0) {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.decompression_speed_mbps = decompressor.size() / (1024.0 * 1024.0) / seconds;
+        }
+        return ok;
+    }
     
-    bool decompress_file(const std::string& input_path, const std::string& output_path);
+    // Partial decompression: only the blocks covering [offset, offset + length) are read
+    bool read_compressed_range(const std::string& archive_path, uint64_t offset, size_t length,
+                               std::vector<uint8_t>& out) {
+        StreamingDecompressor decompressor;
+        return decompressor.open(archive_path) && decompressor.read_range(offset, length, out);
+    }
     
     // Batch operations
     bool compress_directory(const std::string& input_dir, const std::string& output_path,
@@ -214,9 +243,25 @@ public:
     void reset_stats();
     void log_compression_event(const std::string& event, double compression_ratio);
     
+    // Benchmark mode: round-trips sample and fills the speed fields of the stats
+    CompressionStats benchmark_compression(const std::vector<uint8_t>& sample,
+                                           CompressionAlgorithm algorithm = CompressionAlgorithm::AI_OPTIMIZED,
+                                           CompressionLevel level = CompressionLevel::AI_OPTIMAL) {
+        StreamingOptions options = streaming_options(algorithm, level);
+        std::string scratch = (std::filesystem::temp_directory_path() /
+            ("medusa_benchmark_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".mzs")).string();
+        StreamingBenchmark bench = benchmark_streaming_codec(sample, options, scratch);
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        if (bench.verified) {
+            stats_.compression_speed_mbps = bench.compression_speed_mbps;
+            stats_.decompression_speed_mbps = bench.decompression_speed_mbps;
+        }
+        return stats_;
+    }
+    
     // Configuration
-    void set_compression_threads(size_t threads);
-    void set_memory_limit_mb(size_t mb);
+    void set_compression_threads(size_t threads) { active_compression_threads_ = threads; }  // 0 = all cores
+    void set_memory_limit_mb(size_t mb) { memory_limit_mb_ = std::max<size_t>(mb, 1); }
     void enable_ai_optimization(bool enable);
     void set_chaos_compression_enabled(bool enable);
     void set_quantum_compression_enabled(bool enable);
@@ -254,6 +299,42 @@ private:
     std::string generate_unique_filename(const std::string& base_name);
     void update_compression_stats(const CompressionMetadata& metadata);
     
+    // Streaming helpers
+    size_t configured_threads() const {
+        size_t threads = active_compression_threads_.load();
+        return threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    StreamingOptions streaming_options(CompressionAlgorithm algorithm, CompressionLevel level) const {
+        StreamingOptions options;
+        switch (algorithm) {
+            case CompressionAlgorithm::ZLIB: options.codec = BlockCodec::ZLIB; break;
+            case CompressionAlgorithm::LZ4: options.codec = BlockCodec::LZ4; break;
+            case CompressionAlgorithm::ZSTD: options.codec = BlockCodec::ZSTD; break;
+            default: options.codec = best_available_codec(); break;
+        }
+        if (!block_codec_available(options.codec)) options.codec = best_available_codec();
+        if (level == CompressionLevel::STORE) options.codec = BlockCodec::STORE;
+        options.level = level == CompressionLevel::AI_OPTIMAL ? static_cast<int>(CompressionLevel::BALANCED)
+                                                              : static_cast<int>(level);
+        options.threads = configured_threads();
+        options.memory_limit_bytes = memory_limit_mb_.load() << 20;
+        return options;
+    }
+    
+    void record_streaming_result(const StreamingResult& result, size_t buffer_bytes) {
+        if (!result.success) return;
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        size_t files = ++stats_.total_files_compressed;
+        if (result.compressed_bytes < result.raw_bytes) {
+            stats_.total_bytes_saved += result.raw_bytes - result.compressed_bytes;
+        }
+        double ratio = result.raw_bytes ? static_cast<double>(result.compressed_bytes) / result.raw_bytes : 0.0;
+        stats_.average_compression_ratio += (ratio - stats_.average_compression_ratio) / files;
+        stats_.compression_speed_mbps = result.throughput_mbps();
+        stats_.memory_usage_mb = std::max(stats_.memory_usage_mb, (buffer_bytes + (1 << 20) - 1) >> 20);
+    }
+    
     // Member variables
     std::atomic<size_t> active_compression_threads_;
     std::atomic<size_t> memory_limit_mb_;
@@ -0,0 +1,776 @@
+/**
+ * MEDUSA ZIP STREAMING ENGINE
+ * ===========================
+ *
+ * Block-based streaming compression behind MedusaZipCompression:
+ * - input is consumed in fixed-size blocks, so memory is bounded by the
+ *   number of blocks in flight, never by the file size
+ * - blocks are compressed on a worker pool and written in order
+ * - every frame ends with a block index, so any byte range can be
+ *   decompressed by reading only the blocks that cover it
+ * - codecs: zlib, LZ4 and Zstandard when their headers are available at
+ *   build time, STORE always
+ *
+ * FRAME LAYOUT (little-endian)
+ *   header  "MZS1" codec:u8 level:u8 flags:u16 block_size:u32 reserved:u32
+ *   block*  packed_size:u32 (bit 31 = stored raw) raw_size:u32 crc32:u32 payload
+ *   index   per block: file_offset:u64 packed_size:u32 raw_size:u32
+ *   footer  index_offset:u64 block_count:u64 raw_size:u64 "MZSINDEX"
+ */
+
+#ifndef MEDUSA_ZIP_STREAMING_HPP
+#define MEDUSA_ZIP_STREAMING_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<zlib.h>)
+#include <zlib.h>
+#define MEDUSA_ZIP_HAVE_ZLIB 1
+#endif
+#if __has_include(<lz4.h>)
+#include <lz4.h>
+#define MEDUSA_ZIP_HAVE_LZ4 1
+#endif
+#if __has_include(<zstd.h>)
+#include <zstd.h>
+#define MEDUSA_ZIP_HAVE_ZSTD 1
+#endif
+#endif
+
+namespace PFQL2025 {
+
+// ============================================================================
+// BLOCK CODECS
+// ============================================================================
+
+enum class BlockCodec : uint8_t {
+    STORE = 0,
+    ZLIB = 1,
+    LZ4 = 2,
+    ZSTD = 3
+};
+
+inline bool block_codec_available(BlockCodec codec) {
+    switch (codec) {
+        case BlockCodec::STORE: return true;
+#ifdef MEDUSA_ZIP_HAVE_ZLIB
+        case BlockCodec::ZLIB: return true;
+#endif
+#ifdef MEDUSA_ZIP_HAVE_LZ4
+        case BlockCodec::LZ4: return true;
+#endif
+#ifdef MEDUSA_ZIP_HAVE_ZSTD
+        case BlockCodec::ZSTD: return true;
+#endif
+        default: return false;
+    }
+}
+
+// Best ratio/speed trade-off this build can offer
+inline BlockCodec best_available_codec() {
+    if (block_codec_available(BlockCodec::ZSTD)) return BlockCodec::ZSTD;
+    if (block_codec_available(BlockCodec::ZLIB)) return BlockCodec::ZLIB;
+    if (block_codec_available(BlockCodec::LZ4)) return BlockCodec::LZ4;
+    return BlockCodec::STORE;
+}
+
+inline const char* block_codec_name(BlockCodec codec) {
+    switch (codec) {
+        case BlockCodec::STORE: return "STORE";
+        case BlockCodec::ZLIB: return "ZLIB";
+        case BlockCodec::LZ4: return "LZ4";
+        case BlockCodec::ZSTD: return "ZSTD";
+        default: return "UNKNOWN";
+    }
+}
+
+namespace streaming_detail {
+
+inline uint32_t crc32(const uint8_t* data, size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+inline void put_u32(uint8_t* out, uint32_t v) { for (int i = 0; i < 4; ++i) out[i] = static_cast<uint8_t>(v >> (8 * i)); }
+inline void put_u64(uint8_t* out, uint64_t v) { for (int i = 0; i < 8; ++i) out[i] = static_cast<uint8_t>(v >> (8 * i)); }
+inline uint32_t get_u32(const uint8_t* in) { uint32_t v = 0; for (int i = 3; i >= 0; --i) v = (v << 8) | in[i]; return v; }
+inline uint64_t get_u64(const uint8_t* in) { uint64_t v = 0; for (int i = 7; i >= 0; --i) v = (v << 8) | in[i]; return v; }
+
+constexpr char FRAME_MAGIC[4] = {'M', 'Z', 'S', '1'};
+constexpr char FOOTER_MAGIC[8] = {'M', 'Z', 'S', 'I', 'N', 'D', 'E', 'X'};
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t BLOCK_HEADER_SIZE = 12;
+constexpr size_t INDEX_ENTRY_SIZE = 16;
+constexpr size_t FOOTER_SIZE = 32;
+constexpr uint32_t STORED_FLAG = 0x80000000u;
+
+inline size_t compress_bound(BlockCodec codec, size_t size) {
+    switch (codec) {
+#ifdef MEDUSA_ZIP_HAVE_ZLIB
+        case BlockCodec::ZLIB: return compressBound(static_cast<uLong>(size));
+#endif
+#ifdef MEDUSA_ZIP_HAVE_LZ4
+        case BlockCodec::LZ4: return static_cast<size_t>(LZ4_compressBound(static_cast<int>(size)));
+#endif
+#ifdef MEDUSA_ZIP_HAVE_ZSTD
+        case BlockCodec::ZSTD: return ZSTD_compressBound(size);
+#endif
+        default: return size;
+    }
+}
+
+#ifdef MEDUSA_ZIP_HAVE_ZSTD
+// Contexts are expensive to create; keep one of each per thread
+inline ZSTD_CCtx* zstd_compress_context() {
+    thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    return context.get();
+}
+inline ZSTD_DCtx* zstd_decompress_context() {
+    thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+    return context.get();
+}
+#endif
+
+/**
+ * Compress one block into out (resized to the packed size)
+ * @return false if the codec failed or did not shrink the block (store it raw)
+ */
+inline bool compress_block(BlockCodec codec, int level, const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    size_t bound = compress_bound(codec, size);
+    if (out.size() < bound) out.resize(bound);
+    size_t packed = 0;
+    switch (codec) {
+#ifdef MEDUSA_ZIP_HAVE_ZLIB
+        case BlockCodec::ZLIB: {
+            uLongf length = static_cast<uLongf>(out.size());
+            if (compress2(out.data(), &length, data, static_cast<uLong>(size), std::min(std::max(level, 1), 9)) != Z_OK) {
+                return false;
+            }
+            packed = length;
+            break;
+        }
+#endif
+#ifdef MEDUSA_ZIP_HAVE_LZ4
+        case BlockCodec::LZ4: {
+            // Higher levels trade speed for ratio through a lower acceleration
+            int acceleration = std::max(1, 10 - level);
+            int length = LZ4_compress_fast(reinterpret_cast<const char*>(data), reinterpret_cast<char*>(out.data()),
+                                           static_cast<int>(size), static_cast<int>(out.size()), acceleration);
+            if (length <= 0) return false;
+            packed = static_cast<size_t>(length);
+            break;
+        }
+#endif
+#ifdef MEDUSA_ZIP_HAVE_ZSTD
+        case BlockCodec::ZSTD: {
+            size_t length = ZSTD_compressCCtx(zstd_compress_context(), out.data(), out.size(), data, size,
+                                              std::min(std::max(level * 2, 1), 19));
+            if (ZSTD_isError(length)) return false;
+            packed = length;
+            break;
+        }
+#endif
+        default:
+            return false;
+    }
+    if (packed >= size) return false;
+    out.resize(packed);
+    return true;
+}
+
+inline bool decompress_block(BlockCodec codec, const uint8_t* data, size_t size, uint8_t* out, size_t raw_size) {
+    switch (codec) {
+#ifdef MEDUSA_ZIP_HAVE_ZLIB
+        case BlockCodec::ZLIB: {
+            uLongf length = static_cast<uLongf>(raw_size);
+            return uncompress(out, &length, data, static_cast<uLong>(size)) == Z_OK && length == raw_size;
+        }
+#endif
+#ifdef MEDUSA_ZIP_HAVE_LZ4
+        case BlockCodec::LZ4:
+            return LZ4_decompress_safe(reinterpret_cast<const char*>(data), reinterpret_cast<char*>(out),
+                                       static_cast<int>(size), static_cast<int>(raw_size)) == static_cast<int>(raw_size);
+#endif
+#ifdef MEDUSA_ZIP_HAVE_ZSTD
+        case BlockCodec::ZSTD: {
+            size_t length = ZSTD_decompressDCtx(zstd_decompress_context(), out, raw_size, data, size);
+            return !ZSTD_isError(length) && length == raw_size;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+// Fixed worker threads for block jobs; the callers bound how many jobs exist
+class BlockWorkers {
+public:
+    explicit BlockWorkers(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            threads_.emplace_back([this] { run(); });
+        }
+    }
+
+    ~BlockWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        condition_.notify_all();
+        for (auto& thread : threads_) thread.join();
+    }
+
+    void submit(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        condition_.notify_one();
+    }
+
+private:
+    void run() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty()) return;
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<std::function<void()>> jobs_;
+    bool stopping_ = false;
+};
+
+// A block in flight: raw input, packed output and a completion flag
+struct BlockSlot {
+    std::vector<uint8_t> raw;
+    std::vector<uint8_t> packed;
+    size_t raw_size = 0;
+    uint32_t crc = 0;
+    bool stored = false;
+    bool ok = true;
+    bool ready = false;
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    void mark_ready() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready = true;
+        condition.notify_all();
+    }
+
+    void wait_ready() {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [this] { return ready; });
+    }
+};
+
+// Blocks that fit in the memory limit, at least one per thread (and never fewer than one)
+inline size_t slots_for(size_t memory_limit_bytes, size_t per_slot_bytes, size_t threads) {
+    size_t fit = per_slot_bytes ? memory_limit_bytes / per_slot_bytes : 1;
+    return std::max<size_t>(1, std::min(fit, threads * 2));
+}
+
+} // namespace streaming_detail
+
+// ============================================================================
+// STREAMING COMPRESSOR
+// ============================================================================
+
+struct StreamingOptions {
+    BlockCodec codec = best_available_codec();
+    int level = 5;                                // 0-10, mapped onto each codec's range
+    size_t block_size = 1 << 20;                  // 1MB: independent, seekable unit
+    size_t threads = 1;                           // 0 = hardware concurrency
+    size_t memory_limit_bytes = 256ull << 20;     // caps blocks in flight
+};
+
+struct StreamingResult {
+    bool success = false;
+    uint64_t raw_bytes = 0;
+    uint64_t compressed_bytes = 0;
+    uint64_t blocks = 0;
+    uint64_t stored_blocks = 0;                   // incompressible blocks kept raw
+    std::chrono::nanoseconds elapsed{0};
+    std::string error;
+
+    double throughput_mbps() const {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0 ? raw_bytes / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+};
+
+/**
+ * Streaming Compressor
+ * Feed any amount of data through write()/write_from(), then finish()
+ */
+class StreamingCompressor {
+public:
+    StreamingCompressor(std::ostream& out, StreamingOptions options)
+        : out_(out), options_(options), started_(std::chrono::steady_clock::now()) {
+        if (!block_codec_available(options_.codec)) options_.codec = BlockCodec::STORE;
+        options_.block_size = std::min<size_t>(std::max<size_t>(options_.block_size, 4096), 0x7FFFFFFF / 2);
+        size_t threads = options_.threads ? options_.threads : std::max(1u, std::thread::hardware_concurrency());
+        size_t per_slot = options_.block_size + streaming_detail::compress_bound(options_.codec, options_.block_size);
+        slots_.resize(streaming_detail::slots_for(options_.memory_limit_bytes, per_slot, threads));
+        buffer_bytes_ = slots_.size() * per_slot;
+        for (auto& slot : slots_) slot.reset(new streaming_detail::BlockSlot());
+        if (threads > 1 && slots_.size() > 1) workers_.reset(new streaming_detail::BlockWorkers(threads));
+
+        uint8_t header[streaming_detail::HEADER_SIZE] = {};
+        std::memcpy(header, streaming_detail::FRAME_MAGIC, 4);
+        header[4] = static_cast<uint8_t>(options_.codec);
+        header[5] = static_cast<uint8_t>(options_.level);
+        streaming_detail::put_u32(header + 8, static_cast<uint32_t>(options_.block_size));
+        emit(header, sizeof(header));
+    }
+
+    ~StreamingCompressor() {
+        // Workers reference the slots: stop them before the slots go
+        workers_.reset();
+    }
+
+    StreamingCompressor(const StreamingCompressor&) = delete;
+    StreamingCompressor& operator=(const StreamingCompressor&) = delete;
+
+    bool write(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        while (size && result_.error.empty()) {
+            streaming_detail::BlockSlot& slot = current();
+            size_t take = std::min(size, options_.block_size - slot.raw_size);
+            std::memcpy(slot.raw.data() + slot.raw_size, bytes, take);
+            slot.raw_size += take;
+            bytes += take;
+            size -= take;
+            if (slot.raw_size == options_.block_size) dispatch();
+        }
+        return result_.error.empty();
+    }
+
+    // Reads straight into block buffers: no intermediate copy, no whole-file buffer
+    bool write_from(std::istream& in) {
+        while (in && result_.error.empty()) {
+            streaming_detail::BlockSlot& slot = current();
+            in.read(reinterpret_cast<char*>(slot.raw.data() + slot.raw_size),
+                    static_cast<std::streamsize>(options_.block_size - slot.raw_size));
+            slot.raw_size += static_cast<size_t>(in.gcount());
+            if (slot.raw_size == options_.block_size) dispatch();
+        }
+        if (in.bad()) fail("read error");
+        return result_.error.empty();
+    }
+
+    // Flush the last block, write the index and footer
+    StreamingResult finish() {
+        if (finished_) return result_;
+        finished_ = true;
+        if (filling_ && slots_[next_ % slots_.size()]->raw_size) dispatch();
+        while (written_ < next_) flush_oldest();
+
+        uint64_t index_offset = offset_;
+        std::vector<uint8_t> index(index_.size() * streaming_detail::INDEX_ENTRY_SIZE + streaming_detail::FOOTER_SIZE);
+        uint8_t* at = index.data();
+        for (const auto& entry : index_) {
+            streaming_detail::put_u64(at, entry.file_offset);
+            streaming_detail::put_u32(at + 8, entry.packed_size);
+            streaming_detail::put_u32(at + 12, entry.raw_size);
+            at += streaming_detail::INDEX_ENTRY_SIZE;
+        }
+        streaming_detail::put_u64(at, index_offset);
+        streaming_detail::put_u64(at + 8, index_.size());
+        streaming_detail::put_u64(at + 16, result_.raw_bytes);
+        std::memcpy(at + 24, streaming_detail::FOOTER_MAGIC, 8);
+        emit(index.data(), index.size());
+        out_.flush();
+        if (!out_) fail("write error");
+
+        result_.compressed_bytes = offset_;
+        result_.success = result_.error.empty();
+        result_.elapsed = std::chrono::steady_clock::now() - started_;
+        return result_;
+    }
+
+    const StreamingOptions& options() const { return options_; }
+
+    // Upper bound on block memory held at once
+    size_t buffer_bytes() const { return buffer_bytes_; }
+
+private:
+    struct IndexEntry {
+        uint64_t file_offset;
+        uint32_t packed_size;
+        uint32_t raw_size;
+    };
+
+    // The slot for the block being filled; waits for (and writes) the block that last used it
+    streaming_detail::BlockSlot& current() {
+        streaming_detail::BlockSlot& slot = *slots_[next_ % slots_.size()];
+        if (!filling_) {
+            if (next_ >= slots_.size() && written_ <= next_ - slots_.size()) flush_oldest();
+            if (slot.raw.size() < options_.block_size) slot.raw.resize(options_.block_size);
+            slot.raw_size = 0;
+            slot.ready = false;
+            filling_ = true;
+        }
+        return slot;
+    }
+
+    void dispatch() {
+        streaming_detail::BlockSlot* slot = slots_[next_ % slots_.size()].get();
+        ++next_;
+        filling_ = false;
+        BlockCodec codec = options_.codec;
+        int level = options_.level;
+        auto job = [slot, codec, level] {
+            slot->crc = streaming_detail::crc32(slot->raw.data(), slot->raw_size);
+            slot->stored = !streaming_detail::compress_block(codec, level, slot->raw.data(), slot->raw_size, slot->packed);
+            slot->mark_ready();
+        };
+        if (workers_) {
+            workers_->submit(job);
+        } else {
+            job();
+            flush_oldest();
+        }
+    }
+
+    void flush_oldest() {
+        streaming_detail::BlockSlot& slot = *slots_[written_ % slots_.size()];
+        slot.wait_ready();
+        ++written_;
+
+        const uint8_t* payload = slot.stored ? slot.raw.data() : slot.packed.data();
+        size_t payload_size = slot.stored ? slot.raw_size : slot.packed.size();
+        uint32_t packed_field = static_cast<uint32_t>(payload_size) | (slot.stored ? streaming_detail::STORED_FLAG : 0);
+        index_.push_back(IndexEntry{offset_, packed_field, static_cast<uint32_t>(slot.raw_size)});
+
+        uint8_t header[streaming_detail::BLOCK_HEADER_SIZE];
+        streaming_detail::put_u32(header, packed_field);
+        streaming_detail::put_u32(header + 4, static_cast<uint32_t>(slot.raw_size));
+        streaming_detail::put_u32(header + 8, slot.crc);
+        emit(header, sizeof(header));
+        emit(payload, payload_size);
+
+        result_.raw_bytes += slot.raw_size;
+        ++result_.blocks;
+        if (slot.stored) ++result_.stored_blocks;
+    }
+
+    void emit(const uint8_t* data, size_t size) {
+        out_.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        offset_ += size;
+        if (!out_) fail("write error");
+    }
+
+    void fail(const std::string& error) {
+        if (result_.error.empty()) result_.error = error;
+    }
+
+    std::ostream& out_;
+    StreamingOptions options_;
+    std::chrono::steady_clock::time_point started_;
+    std::vector<std::unique_ptr<streaming_detail::BlockSlot>> slots_;
+    std::unique_ptr<streaming_detail::BlockWorkers> workers_;
+    std::vector<IndexEntry> index_;
+    uint64_t next_ = 0;       // blocks dispatched
+    uint64_t written_ = 0;    // blocks written out
+    uint64_t offset_ = 0;     // bytes emitted
+    size_t buffer_bytes_ = 0;
+    bool filling_ = false;
+    bool finished_ = false;
+    StreamingResult result_;
+};
+
+// ============================================================================
+// STREAMING DECOMPRESSOR
+// ============================================================================
+
+/**
+ * Streaming Decompressor
+ * Opens a frame by its index: sequential output, or random access to any range
+ */
+class StreamingDecompressor {
+public:
+    bool open(const std::string& path) {
+        in_.open(path, std::ios::binary);
+        if (!in_) return fail("cannot open " + path);
+
+        uint8_t header[streaming_detail::HEADER_SIZE];
+        if (!read_at(0, header, sizeof(header)) || std::memcmp(header, streaming_detail::FRAME_MAGIC, 4) != 0) {
+            return fail("not a streaming frame");
+        }
+        codec_ = static_cast<BlockCodec>(header[4]);
+        if (!block_codec_available(codec_)) {
+            return fail(std::string("codec not available in this build: ") + block_codec_name(codec_));
+        }
+
+        in_.seekg(0, std::ios::end);
+        uint64_t file_size = static_cast<uint64_t>(in_.tellg());
+        uint8_t footer[streaming_detail::FOOTER_SIZE];
+        if (file_size < streaming_detail::HEADER_SIZE + streaming_detail::FOOTER_SIZE ||
+            !read_at(file_size - streaming_detail::FOOTER_SIZE, footer, sizeof(footer)) ||
+            std::memcmp(footer + 24, streaming_detail::FOOTER_MAGIC, 8) != 0) {
+            return fail("missing index (truncated frame?)");
+        }
+        uint64_t index_offset = streaming_detail::get_u64(footer);
+        uint64_t block_count = streaming_detail::get_u64(footer + 8);
+        raw_size_ = streaming_detail::get_u64(footer + 16);
+        // Bound block_count by the file before multiplying so a forged footer
+        // can neither wrap the size check nor drive a huge allocation
+        uint64_t index_room = file_size - streaming_detail::HEADER_SIZE - streaming_detail::FOOTER_SIZE;
+        if (block_count > index_room / streaming_detail::INDEX_ENTRY_SIZE ||
+            index_offset != file_size - streaming_detail::FOOTER_SIZE - block_count * streaming_detail::INDEX_ENTRY_SIZE) {
+            return fail("corrupt index");
+        }
+
+        std::vector<uint8_t> index(block_count * streaming_detail::INDEX_ENTRY_SIZE);
+        if (!read_at(index_offset, index.data(), index.size())) return fail("cannot read index");
+        blocks_.resize(block_count);
+        uint64_t raw_offset = 0;
+        for (uint64_t i = 0; i < block_count; ++i) {
+            const uint8_t* at = index.data() + i * streaming_detail::INDEX_ENTRY_SIZE;
+            Block& block = blocks_[i];
+            block.file_offset = streaming_detail::get_u64(at);
+            uint32_t packed = streaming_detail::get_u32(at + 8);
+            block.stored = (packed & streaming_detail::STORED_FLAG) != 0;
+            block.packed_size = packed & ~streaming_detail::STORED_FLAG;
+            block.raw_size = streaming_detail::get_u32(at + 12);
+            block.raw_offset = raw_offset;
+            raw_offset += block.raw_size;
+        }
+        if (raw_offset != raw_size_) return fail("corrupt index");
+        return true;
+    }
+
+    uint64_t size() const { return raw_size_; }
+    size_t block_count() const { return blocks_.size(); }
+    BlockCodec codec() const { return codec_; }
+    const std::string& error() const { return error_; }
+
+    /**
+     * Decompress [offset, offset + length) touching only the blocks that cover it
+     */
+    bool read_range(uint64_t offset, size_t length, std::vector<uint8_t>& out) {
+        out.clear();
+        if (offset > raw_size_) return fail("offset beyond end");
+        length = static_cast<size_t>(std::min<uint64_t>(length, raw_size_ - offset));
+        out.reserve(length);
+        auto it = std::upper_bound(blocks_.begin(), blocks_.end(), offset,
+                                   [](uint64_t value, const Block& block) { return value < block.raw_offset; });
+        size_t index = it == blocks_.begin() ? 0 : static_cast<size_t>(it - blocks_.begin()) - 1;
+        while (out.size() < length && index < blocks_.size()) {
+            if (!load_block(index, packed_scratch_, cached_)) return false;
+            cached_index_ = index;
+            const Block& block = blocks_[index];
+            uint64_t skip = offset + out.size() - block.raw_offset;
+            size_t take = static_cast<size_t>(std::min<uint64_t>(block.raw_size - skip, length - out.size()));
+            out.insert(out.end(), cached_.begin() + skip, cached_.begin() + skip + take);
+            ++index;
+        }
+        return true;
+    }
+
+    /**
+     * Decompress everything in order
+     * Up to threads blocks are decoded at once, within memory_limit_bytes
+     */
+    bool decompress_to(std::ostream& out, size_t threads = 1, size_t memory_limit_bytes = 256ull << 20) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t largest = 0;
+        for (const auto& block : blocks_) largest = std::max<size_t>(largest, block.raw_size + block.packed_size);
+        size_t window = streaming_detail::slots_for(memory_limit_bytes, largest, threads);
+
+        if (window <= 1 || threads <= 1) {
+            for (size_t i = 0; i < blocks_.size(); ++i) {
+                if (!load_block(i, packed_scratch_, cached_)) return false;
+                out.write(reinterpret_cast<const char*>(cached_.data()), static_cast<std::streamsize>(cached_.size()));
+                if (!out) return fail("write error");
+            }
+            return true;
+        }
+
+        // Reads stay on this thread (one file handle); decoding fans out
+        struct Slot {
+            std::vector<uint8_t> packed;
+            std::vector<uint8_t> raw;
+            bool ok = false;
+            std::unique_ptr<streaming_detail::BlockSlot> done{new streaming_detail::BlockSlot()};
+        };
+        std::vector<Slot> slots(window);
+        bool ok = true;
+        {
+            streaming_detail::BlockWorkers workers(threads);
+            size_t written = 0;
+            for (size_t i = 0; (ok && i < blocks_.size()) || written < i; ) {
+                if (ok && i < blocks_.size() && i - written < window) {
+                    Slot& slot = slots[i % window];
+                    slot.done->ready = false;
+                    const Block& block = blocks_[i];
+                    if (!read_packed(block, slot.packed)) {
+                        ok = false;
+                        slot.ok = false;
+                        slot.done->mark_ready();
+                    } else {
+                        BlockCodec codec = codec_;
+                        workers.submit([&slot, &block, codec] {
+                            slot.ok = decode(codec, block, slot.packed, slot.raw);
+                            slot.done->mark_ready();
+                        });
+                    }
+                    ++i;
+                    continue;
+                }
+                Slot& slot = slots[written % window];
+                slot.done->wait_ready();
+                ++written;
+                if (!ok || !slot.ok) {
+                    ok = false;
+                    continue;  // let submitted jobs finish before the slots go
+                }
+                out.write(reinterpret_cast<const char*>(slot.raw.data()), static_cast<std::streamsize>(slot.raw.size()));
+                if (!out) ok = false;
+            }
+        }
+        return ok || fail("corrupt block or write error");
+    }
+
+private:
+    struct Block {
+        uint64_t file_offset;
+        uint64_t raw_offset;
+        uint32_t packed_size;
+        uint32_t raw_size;
+        bool stored;
+    };
+
+    bool fail(const std::string& error) {
+        error_ = error;
+        return false;
+    }
+
+    bool read_at(uint64_t offset, uint8_t* out, size_t size) {
+        in_.clear();
+        in_.seekg(static_cast<std::streamoff>(offset));
+        in_.read(reinterpret_cast<char*>(out), static_cast<std::streamsize>(size));
+        return static_cast<size_t>(in_.gcount()) == size;
+    }
+
+    // Block header plus payload
+    bool read_packed(const Block& block, std::vector<uint8_t>& packed) {
+        packed.resize(streaming_detail::BLOCK_HEADER_SIZE + block.packed_size);
+        return read_at(block.file_offset, packed.data(), packed.size());
+    }
+
+    static bool decode(BlockCodec codec, const Block& block, const std::vector<uint8_t>& packed, std::vector<uint8_t>& raw) {
+        uint32_t expected_crc = streaming_detail::get_u32(packed.data() + 8);
+        const uint8_t* payload = packed.data() + streaming_detail::BLOCK_HEADER_SIZE;
+        raw.resize(block.raw_size);
+        if (block.stored) {
+            if (block.packed_size != block.raw_size) return false;
+            std::memcpy(raw.data(), payload, block.raw_size);
+        } else if (!streaming_detail::decompress_block(codec, payload, block.packed_size, raw.data(), block.raw_size)) {
+            return false;
+        }
+        return streaming_detail::crc32(raw.data(), raw.size()) == expected_crc;
+    }
+
+    bool load_block(size_t index, std::vector<uint8_t>& packed, std::vector<uint8_t>& raw) {
+        if (&raw == &cached_ && cached_index_ == index) return true;
+        cached_index_ = SIZE_MAX;
+        if (!read_packed(blocks_[index], packed)) return fail("cannot read block");
+        if (!decode(codec_, blocks_[index], packed, raw)) return fail("corrupt block " + std::to_string(index));
+        return true;
+    }
+
+    std::ifstream in_;
+    BlockCodec codec_ = BlockCodec::STORE;
+    uint64_t raw_size_ = 0;
+    std::vector<Block> blocks_;
+    std::vector<uint8_t> packed_scratch_;
+    std::vector<uint8_t> cached_;     // last decoded block, reused by adjacent range reads
+    size_t cached_index_ = SIZE_MAX;
+    std::string error_;
+};
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+struct StreamingBenchmark {
+    BlockCodec codec = BlockCodec::STORE;
+    double compression_speed_mbps = 0.0;
+    double decompression_speed_mbps = 0.0;
+    double compression_ratio = 0.0;   // compressed / original, as calculate_compression_ratio
+    bool verified = false;
+};
+
+/**
+ * Round-trip a sample in memory and time both directions
+ */
+inline StreamingBenchmark benchmark_streaming_codec(const std::vector<uint8_t>& sample, const StreamingOptions& options,
+                                                    const std::string& scratch_path) {
+    StreamingBenchmark bench;
+    bench.codec = block_codec_available(options.codec) ? options.codec : BlockCodec::STORE;
+    double megabytes = sample.size() / (1024.0 * 1024.0);
+    {
+        std::ofstream out(scratch_path, std::ios::binary | std::ios::trunc);
+        StreamingCompressor compressor(out, options);
+        compressor.write(sample.data(), sample.size());
+        StreamingResult result = compressor.finish();
+        if (!result.success) return bench;
+        double seconds = std::chrono::duration<double>(result.elapsed).count();
+        bench.compression_speed_mbps = seconds > 0 ? megabytes / seconds : 0.0;
+        bench.compression_ratio = sample.empty() ? 0.0 : static_cast<double>(result.compressed_bytes) / sample.size();
+    }
+    StreamingDecompressor decompressor;
+    std::ostringstream restored;
+    auto started = std::chrono::steady_clock::now();
+    bool ok = decompressor.open(scratch_path) && decompressor.decompress_to(restored, options.threads, options.memory_limit_bytes);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    bench.decompression_speed_mbps = ok && seconds > 0 ? megabytes / seconds : 0.0;
+    std::string output = restored.str();
+    bench.verified = ok && output.size() == sample.size() && std::memcmp(output.data(), sample.data(), sample.size()) == 0;
+    std::remove(scratch_path.c_str());
+    return bench;
+}
+
+} // namespace PFQL2025
+
+#endif // MEDUSA_ZIP_STREAMING_HPP
@@ -29,9 +29,13 @@
 #include <regex>
 #include <functional>
 #include <queue>
+#include <list>
+#include <array>
+#include <type_traits>
 #include "medusa_json_standalone.hpp"
 #include "production_compliant_purplepages.hpp"
 #include "enhanced_ssr_psr_plus.hpp"
+#include "medusaserv_hot_response.hpp"
 
 namespace MedusaServ {
 
@@ -226,132 +230,263 @@ private:
 /**
  * SERVER-SIDE RENDERING CACHE SYSTEM
  * Intelligent caching with Purple Pages integration
+ *
+ * Entries live in independently locked shards with a shared byte budget,
+ * LRU ordering per shard and TinyLFU admission. Cached pages are immutable
+ * and reference counted, so lookup() hands out a shared pointer instead of
+ * copying content. Purple Pages sees sampled per-event records plus a
+ * periodic activity summary rather than one audit event per operation.
  */
 class SSRCacheManager {
-private:
+public:
     struct CacheEntry {
         std::string content;
         std::chrono::steady_clock::time_point created_at;
         std::chrono::steady_clock::time_point expires_at;
         std::string etag;
         std::map<std::string, std::string> headers;
-        size_t access_count = 0;
+        mutable std::atomic<size_t> access_count{0};
         RenderMode render_mode;
         bool is_dynamic;
+        // Pre-serialized 200/304 response whose body points into content
+        medusaserv::http::HotResponse response;
     };
+    using EntryPtr = std::shared_ptr<const CacheEntry>;
+    using ResponsePtr = medusaserv::http::HotResponsePtr;
+    
+    static constexpr size_t kDefaultMaxBytes = 256 * 1024 * 1024;
+    static constexpr uint32_t kDefaultAuditSampleRate = 64;
+    
+private:
+    static constexpr size_t kShardCount = 16;
+    static constexpr int kAuditFlushSeconds = 10;
+    static constexpr uint64_t kAuditFlushCheckEvery = 256;  // events between clock reads (power of two)
+    
+    /**
+     * TinyLFU frequency sketch: count-min over 4 rows of saturating counters,
+     * halved every sample period so popularity decays over time
+     */
+    class FrequencySketch {
+    public:
+        explicit FrequencySketch(size_t width) {
+            size_t size = 1024;
+            while (size < width) {
+                size <<= 1;
+            }
+            width_ = size;
+            sample_size_ = size * 10;
+            table_ = std::make_unique<std::atomic<uint8_t>[]>(width_ * 4);
+            for (size_t i = 0; i < width_ * 4; ++i) {
+                table_[i].store(0, std::memory_order_relaxed);
+            }
+        }
+        
+        void increment(uint64_t hash) {
+            for (size_t row = 0; row < 4; ++row) {
+                auto& counter = table_[row * width_ + index(hash, row)];
+                uint8_t value = counter.load(std::memory_order_relaxed);
+                if (value < 15) {
+                    counter.store(value + 1, std::memory_order_relaxed);
+                }
+            }
+            if (additions_.fetch_add(1, std::memory_order_relaxed) + 1 >= sample_size_) {
+                age();
+            }
+        }
+        
+        uint8_t estimate(uint64_t hash) const {
+            uint8_t result = 15;
+            for (size_t row = 0; row < 4; ++row) {
+                uint8_t value = table_[row * width_ + index(hash, row)].load(std::memory_order_relaxed);
+                result = value < result ? value : result;
+            }
+            return result;
+        }
+        
+    private:
+        size_t index(uint64_t hash, size_t row) const {
+            static constexpr uint64_t kSeeds[4] = {
+                0xc3a5c85c97cb3127ull, 0xb492b66fbe98f273ull,
+                0x9ae16a3b2f90404full, 0xcbf29ce484222325ull
+            };
+            uint64_t h = (hash + kSeeds[row]) * 0x9E3779B97F4A7C15ull;
+            h ^= h >> 32;
+            return static_cast<size_t>(h) & (width_ - 1);
+        }
+        
+        void age() {
+            size_t expected = additions_.load(std::memory_order_relaxed);
+            if (expected < sample_size_ ||
+                !additions_.compare_exchange_strong(expected, 0, std::memory_order_relaxed)) {
+                return;  // another thread is ageing
+            }
+            for (size_t i = 0; i < width_ * 4; ++i) {
+                table_[i].store(table_[i].load(std::memory_order_relaxed) >> 1, std::memory_order_relaxed);
+            }
+        }
+        
+        size_t width_ = 0;
+        size_t sample_size_ = 0;
+        std::unique_ptr<std::atomic<uint8_t>[]> table_;
+        std::atomic<size_t> additions_{0};
+    };
+    
+    struct Shard {
+        struct Slot {
+            EntryPtr entry;
+            std::list<std::string>::iterator lru_position;
+            size_t charge;
+        };
+        
+        std::mutex mutex;
+        std::unordered_map<std::string, Slot> entries;
+        std::list<std::string> lru;  // front = most recently used
+        size_t bytes = 0;
+    };
+    
+    enum AuditCounter {
+        AUDIT_STORE,
+        AUDIT_HIT,
+        AUDIT_MISS,
+        AUDIT_EXPIRED,
+        AUDIT_EVICTED,
+        AUDIT_REJECTED,
+        AUDIT_COUNTER_COUNT
+    };
+    
+    std::array<Shard, kShardCount> shards_;
+    size_t max_bytes_;
+    size_t shard_budget_;
+    FrequencySketch sketch_;
     
-    std::unordered_map<std::string, CacheEntry> memory_cache_;
     std::unordered_map<std::string, std::string> file_cache_index_;
-    std::mutex cache_mutex_;
+    std::mutex file_cache_mutex_;
     std::string cache_directory_;
     CacheStrategy strategy_;
     BuildEnvironment environment_;
     std::unique_ptr<ProductionPurplePages::ProductionPurplePagesManager> purple_pages_;
     
+    // Audit batching: totals for stats, pending deltas for the next summary
+    std::array<std::atomic<uint64_t>, AUDIT_COUNTER_COUNT> totals_{};
+    std::array<std::atomic<uint64_t>, AUDIT_COUNTER_COUNT> pending_{};
+    std::atomic<uint64_t> audit_sequence_{0};
+    std::atomic<uint32_t> audit_sample_rate_{kDefaultAuditSampleRate};
+    std::mutex audit_mutex_;
+    // steady_clock ticks before which an unforced summary is skipped without locking
+    std::atomic<std::chrono::steady_clock::rep> next_audit_flush_{0};
+    
 public:
-    SSRCacheManager(CacheStrategy strategy, BuildEnvironment env) 
-        : strategy_(strategy), environment_(env) {
+    SSRCacheManager(CacheStrategy strategy, BuildEnvironment env, size_t max_bytes = kDefaultMaxBytes) 
+        : max_bytes_(max_bytes), shard_budget_(max_bytes / kShardCount),
+          sketch_(max_bytes / (16 * 1024)), strategy_(strategy), environment_(env),
+          next_audit_flush_((std::chrono::steady_clock::now() + std::chrono::seconds(kAuditFlushSeconds))
+                                .time_since_epoch().count()) {
         purple_pages_ = std::make_unique<ProductionPurplePages::ProductionPurplePagesManager>();
         cache_directory_ = "cache/ssr/";
         std::filesystem::create_directories(cache_directory_);
         
         // Log cache manager initialization
+        auto details = MedusaJSON::createObject();
+        details->set("max_bytes", MedusaJSON::createNumber(static_cast<double>(max_bytes_)));
+        details->set("shards", MedusaJSON::createNumber(static_cast<double>(kShardCount)));
+        
         purple_pages_->logAuditEvent("CACHE_MANAGER_INIT", 
                                     cache_directory_, 
                                     "CREATE", 
                                     "CICD_BUILD",
-                                    nullptr, 0, "", 
+                                    details, 0, "", 
                                     "SSRCacheManager", 
                                     "INFO");
     }
     
+    ~SSRCacheManager() {
+        flushAuditSummary(true);
+    }
+    
     // Store rendered content in cache
     bool store(const std::string& key, const std::string& content, 
                RenderMode mode, bool is_dynamic = false, 
                int ttl_seconds = 3600) {
         
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        
         if (environment_ == BuildEnvironment::DEVELOPMENT && strategy_ == CacheStrategy::NO_CACHE) {
             // No caching in development mode for dynamic content
             return false;
         }
         
-        CacheEntry entry;
-        entry.content = content;
-        entry.created_at = std::chrono::steady_clock::now();
-        entry.expires_at = entry.created_at + std::chrono::seconds(ttl_seconds);
-        entry.etag = generateETag(content);
-        entry.render_mode = mode;
-        entry.is_dynamic = is_dynamic;
-        entry.access_count = 0;
-        
-        // Store in memory cache
-        memory_cache_[key] = entry;
+        auto entry = std::make_shared<CacheEntry>();
+        entry->content = content;
+        entry->created_at = std::chrono::steady_clock::now();
+        entry->expires_at = entry->created_at + std::chrono::seconds(ttl_seconds);
+        entry->etag = generateETag(content);
+        entry->render_mode = mode;
+        entry->is_dynamic = is_dynamic;
+        entry->response = medusaserv::http::HotResponse::fromMemory(
+            200, "text/html; charset=utf-8", entry->content, nullptr, entry->etag,
+            is_dynamic ? "no-cache" : "public, max-age=60");
+        
+        uint64_t hash = hashKey(key);
+        sketch_.increment(hash);
+        size_t charge = key.size() * 2 + content.size() + entry->etag.size() +
+                        entry->response.footprint() + sizeof(CacheEntry);
+        
+        bool admitted = charge <= shard_budget_;
+        if (admitted) {
+            admitted = insert(shardFor(hash), key, hash, entry, charge);
+        }
+        if (!admitted) {
+            noteEvent(AUDIT_REJECTED, "CACHE_REJECTED", key, "CREATE", nullptr);
+            return false;
+        }
         
         // Store in file cache for persistent storage
         if (strategy_ == CacheStrategy::FILE_CACHE || strategy_ == CacheStrategy::HYBRID_CACHE) {
-            storeInFileCache(key, entry);
+            storeInFileCache(key, *entry);
         }
         
-        // Log cache storage in Purple Pages
-        auto details = MedusaJSON::createObject();
-        details->set("cache_key", MedusaJSON::createString(key));
-        details->set("content_size", MedusaJSON::createNumber(static_cast<double>(content.size())));
-        details->set("render_mode", MedusaJSON::createString(renderModeToString(mode)));
-        details->set("is_dynamic", MedusaJSON::createBoolean(is_dynamic));
-        details->set("ttl_seconds", MedusaJSON::createNumber(static_cast<double>(ttl_seconds)));
-        
-        purple_pages_->logAuditEvent("CACHE_STORE", 
-                                    "/cache/" + key, 
-                                    "CREATE", 
-                                    "CICD_BUILD",
-                                    details, 0, "", 
-                                    "SSRCacheManager", 
-                                    "INFO");
+        // Sampled audit record; details are only built when the sample fires
+        noteEvent(AUDIT_STORE, "CACHE_STORE", key, "CREATE", [&]() {
+            auto details = MedusaJSON::createObject();
+            details->set("cache_key", MedusaJSON::createString(key));
+            details->set("content_size", MedusaJSON::createNumber(static_cast<double>(content.size())));
+            details->set("render_mode", MedusaJSON::createString(renderModeToString(mode)));
+            details->set("is_dynamic", MedusaJSON::createBoolean(is_dynamic));
+            details->set("ttl_seconds", MedusaJSON::createNumber(static_cast<double>(ttl_seconds)));
+            return details;
+        });
         
         return true;
     }
     
+    // Zero-copy lookup: the returned entry stays valid even if it is evicted meanwhile
+    EntryPtr lookup(const std::string& key) {
+        if (environment_ == BuildEnvironment::DEVELOPMENT && strategy_ == CacheStrategy::NO_CACHE) {
+            return nullptr;
+        }
+        
+        EntryPtr entry = lookupMemory(key);
+        if (!entry) {
+            noteEvent(AUDIT_MISS, "CACHE_MISS", key, "READ", nullptr);
+        }
+        return entry;
+    }
+    
+    // Response for a cached page, ready for deliver(); shares ownership with the entry
+    ResponsePtr lookupResponse(const std::string& key) {
+        EntryPtr entry = lookup(key);
+        if (!entry) {
+            return nullptr;
+        }
+        return ResponsePtr(entry, &entry->response);
+    }
+    
     // Retrieve content from cache
     std::pair<bool, std::string> retrieve(const std::string& key) {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        
         if (environment_ == BuildEnvironment::DEVELOPMENT && strategy_ == CacheStrategy::NO_CACHE) {
             return {false, ""};
         }
         
-        auto it = memory_cache_.find(key);
-        if (it != memory_cache_.end()) {
-            auto& entry = it->second;
-            
-            // Check if cache entry is still valid
-            if (std::chrono::steady_clock::now() < entry.expires_at) {
-                entry.access_count++;
-                
-                // Log cache hit
-                purple_pages_->logAuditEvent("CACHE_HIT", 
-                                            "/cache/" + key, 
-                                            "READ", 
-                                            "CICD_BUILD",
-                                            nullptr, 0, "", 
-                                            "SSRCacheManager", 
-                                            "INFO");
-                
-                return {true, entry.content};
-            } else {
-                // Cache expired, remove entry
-                memory_cache_.erase(it);
-                
-                // Log cache expiry
-                purple_pages_->logAuditEvent("CACHE_EXPIRED", 
-                                            "/cache/" + key, 
-                                            "DELETE", 
-                                            "CICD_BUILD",
-                                            nullptr, 0, "", 
-                                            "SSRCacheManager", 
-                                            "INFO");
-            }
+        if (EntryPtr entry = lookupMemory(key)) {
+            return {true, entry->content};
         }
         
         // Try file cache if memory cache miss
@@ -363,24 +498,23 @@ public:
         }
         
         // Log cache miss
-        purple_pages_->logAuditEvent("CACHE_MISS", 
-                                    "/cache/" + key, 
-                                    "READ", 
-                                    "CICD_BUILD",
-                                    nullptr, 0, "", 
-                                    "SSRCacheManager", 
-                                    "INFO");
+        noteEvent(AUDIT_MISS, "CACHE_MISS", key, "READ", nullptr);
         
         return {false, ""};
     }
     
     // Invalidate cache entries
     void invalidate(const std::string& pattern = "*") {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        
         if (pattern == "*") {
             // Clear all cache
-            memory_cache_.clear();
+            for (auto& shard : shards_) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.entries.clear();
+                shard.lru.clear();
+                shard.bytes = 0;
+            }
+            
+            std::lock_guard<std::mutex> lock(file_cache_mutex_);
             file_cache_index_.clear();
             
             // Clear file cache directory
@@ -390,12 +524,17 @@ public:
         } else {
             // Pattern-based invalidation
             std::regex pattern_regex(pattern);
-            auto it = memory_cache_.begin();
-            while (it != memory_cache_.end()) {
-                if (std::regex_match(it->first, pattern_regex)) {
-                    it = memory_cache_.erase(it);
-                } else {
-                    ++it;
+            for (auto& shard : shards_) {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto it = shard.entries.begin();
+                while (it != shard.entries.end()) {
+                    if (std::regex_match(it->first, pattern_regex)) {
+                        shard.bytes -= it->second.charge;
+                        shard.lru.erase(it->second.lru_position);
+                        it = shard.entries.erase(it);
+                    } else {
+                        ++it;
+                    }
                 }
             }
         }
@@ -404,6 +543,7 @@ public:
         auto details = MedusaJSON::createObject();
         details->set("pattern", MedusaJSON::createString(pattern));
         
+        std::lock_guard<std::mutex> lock(audit_mutex_);
         purple_pages_->logAuditEvent("CACHE_INVALIDATE", 
                                     "/cache", 
                                     "DELETE", 
@@ -413,27 +553,216 @@ public:
                                     "INFO");
     }
     
+    // Log one audit record for every Nth cache event (1 = log everything)
+    void setAuditSampleRate(uint32_t rate) {
+        audit_sample_rate_.store(rate == 0 ? 1 : rate, std::memory_order_relaxed);
+    }
+    
+    // Emit the pending activity summary; without force only once per flush interval
+    void flushAuditSummary(bool force = false) {
+        auto now = std::chrono::steady_clock::now();
+        if (!force && now.time_since_epoch().count() < next_audit_flush_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        
+        std::unique_lock<std::mutex> lock(audit_mutex_, std::defer_lock);
+        if (force) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            return;
+        }
+        
+        if (!force && now.time_since_epoch().count() < next_audit_flush_.load(std::memory_order_relaxed)) {
+            return;  // another thread flushed while we waited for the lock
+        }
+        next_audit_flush_.store((now + std::chrono::seconds(kAuditFlushSeconds)).time_since_epoch().count(),
+                                std::memory_order_relaxed);
+        
+        std::array<uint64_t, AUDIT_COUNTER_COUNT> counts;
+        uint64_t total = 0;
+        for (size_t i = 0; i < AUDIT_COUNTER_COUNT; ++i) {
+            counts[i] = pending_[i].exchange(0, std::memory_order_relaxed);
+            total += counts[i];
+        }
+        if (total == 0) {
+            return;
+        }
+        
+        auto details = MedusaJSON::createObject();
+        details->set("stores", MedusaJSON::createNumber(static_cast<double>(counts[AUDIT_STORE])));
+        details->set("hits", MedusaJSON::createNumber(static_cast<double>(counts[AUDIT_HIT])));
+        details->set("misses", MedusaJSON::createNumber(static_cast<double>(counts[AUDIT_MISS])));
+        details->set("expired", MedusaJSON::createNumber(static_cast<double>(counts[AUDIT_EXPIRED])));
+        details->set("evicted", MedusaJSON::createNumber(static_cast<double>(counts[AUDIT_EVICTED])));
+        details->set("rejected", MedusaJSON::createNumber(static_cast<double>(counts[AUDIT_REJECTED])));
+        
+        purple_pages_->logAuditEvent("CACHE_ACTIVITY_SUMMARY", 
+                                    "/cache", 
+                                    "READ", 
+                                    "CICD_BUILD",
+                                    details, 0, "", 
+                                    "SSRCacheManager", 
+                                    "INFO");
+    }
+    
     // Get cache statistics
     std::shared_ptr<MedusaJSON> getCacheStats() {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        size_t entries = 0;
+        size_t total_size = 0;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            entries += shard.entries.size();
+            total_size += shard.bytes;
+        }
+        size_t file_entries = 0;
+        {
+            std::lock_guard<std::mutex> lock(file_cache_mutex_);
+            file_entries = file_cache_index_.size();
+        }
         
         auto stats = MedusaJSON::createObject();
-        stats->set("memory_cache_entries", MedusaJSON::createNumber(static_cast<double>(memory_cache_.size())));
-        stats->set("file_cache_entries", MedusaJSON::createNumber(static_cast<double>(file_cache_index_.size())));
+        stats->set("memory_cache_entries", MedusaJSON::createNumber(static_cast<double>(entries)));
+        stats->set("file_cache_entries", MedusaJSON::createNumber(static_cast<double>(file_entries)));
         stats->set("cache_strategy", MedusaJSON::createString(cacheStrategyToString(strategy_)));
         stats->set("environment", MedusaJSON::createString(environmentToString(environment_)));
-        
-        // Calculate total cache size
-        size_t total_size = 0;
-        for (const auto& [key, entry] : memory_cache_) {
-            total_size += entry.content.size();
-        }
         stats->set("total_cache_size_bytes", MedusaJSON::createNumber(static_cast<double>(total_size)));
+        stats->set("max_cache_size_bytes", MedusaJSON::createNumber(static_cast<double>(max_bytes_)));
+        stats->set("hits", MedusaJSON::createNumber(static_cast<double>(totals_[AUDIT_HIT].load())));
+        stats->set("misses", MedusaJSON::createNumber(static_cast<double>(totals_[AUDIT_MISS].load())));
+        stats->set("evictions", MedusaJSON::createNumber(static_cast<double>(totals_[AUDIT_EVICTED].load())));
+        stats->set("admission_rejections", MedusaJSON::createNumber(static_cast<double>(totals_[AUDIT_REJECTED].load())));
         
         return stats;
     }
     
 private:
+    static uint64_t hashKey(const std::string& key) {
+        uint64_t h = std::hash<std::string>{}(key);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        return h;
+    }
+    
+    Shard& shardFor(uint64_t hash) {
+        return shards_[hash & (kShardCount - 1)];
+    }
+    
+    EntryPtr lookupMemory(const std::string& key) {
+        uint64_t hash = hashKey(key);
+        sketch_.increment(hash);
+        Shard& shard = shardFor(hash);
+        
+        EntryPtr entry;
+        bool expired = false;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.entries.find(key);
+            if (it == shard.entries.end()) {
+                return nullptr;
+            }
+            
+            // Check if cache entry is still valid
+            if (std::chrono::steady_clock::now() < it->second.entry->expires_at) {
+                shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru_position);
+                entry = it->second.entry;
+            } else {
+                // Cache expired, remove entry
+                shard.bytes -= it->second.charge;
+                shard.lru.erase(it->second.lru_position);
+                shard.entries.erase(it);
+                expired = true;
+            }
+        }
+        
+        if (expired) {
+            noteEvent(AUDIT_EXPIRED, "CACHE_EXPIRED", key, "DELETE", nullptr);
+            return nullptr;
+        }
+        entry->access_count.fetch_add(1, std::memory_order_relaxed);
+        noteEvent(AUDIT_HIT, "CACHE_HIT", key, "READ", nullptr);
+        return entry;
+    }
+    
+    // Inserts under TinyLFU admission: a new key only displaces LRU victims it outranks
+    bool insert(Shard& shard, const std::string& key, uint64_t hash, EntryPtr entry, size_t charge) {
+        size_t evicted = 0;
+        bool admitted = true;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            
+            auto existing = shard.entries.find(key);
+            bool replacing = existing != shard.entries.end();
+            if (replacing) {
+                shard.bytes -= existing->second.charge;
+                shard.lru.erase(existing->second.lru_position);
+                shard.entries.erase(existing);
+            }
+            
+            // Decide first, against every victim needed to free charge; evict only once admitted
+            size_t victims = 0;
+            size_t freed = 0;
+            uint8_t candidate_frequency = sketch_.estimate(hash);
+            for (auto it = shard.lru.rbegin(); it != shard.lru.rend() && shard.bytes - freed + charge > shard_budget_; ++it) {
+                const Shard::Slot& victim = shard.entries.find(*it)->second;
+                if (!replacing && candidate_frequency <= sketch_.estimate(hashKey(*it))) {
+                    admitted = false;
+                    break;
+                }
+                freed += victim.charge;
+                ++victims;
+            }
+            
+            if (admitted) {
+                for (; evicted < victims; ++evicted) {
+                    auto victim = shard.entries.find(shard.lru.back());
+                    shard.bytes -= victim->second.charge;
+                    shard.lru.pop_back();
+                    shard.entries.erase(victim);
+                }
+                shard.lru.push_front(key);
+                shard.entries[key] = Shard::Slot{std::move(entry), shard.lru.begin(), charge};
+                shard.bytes += charge;
+            }
+        }
+        
+        if (evicted > 0) {
+            totals_[AUDIT_EVICTED].fetch_add(evicted, std::memory_order_relaxed);
+            pending_[AUDIT_EVICTED].fetch_add(evicted, std::memory_order_relaxed);
+        }
+        return admitted;
+    }
+    
+    // Counts an event for the batched summary and logs it individually when sampled
+    template <typename DetailsFactory>
+    void noteEvent(AuditCounter counter, const char* event_type, const std::string& key,
+                   const char* action, DetailsFactory&& make_details) {
+        totals_[counter].fetch_add(1, std::memory_order_relaxed);
+        pending_[counter].fetch_add(1, std::memory_order_relaxed);
+        
+        uint32_t rate = audit_sample_rate_.load(std::memory_order_relaxed);
+        uint64_t sequence = audit_sequence_.fetch_add(1, std::memory_order_relaxed);
+        if (sequence % rate == 0) {
+            std::shared_ptr<MedusaJSON> details;
+            if constexpr (!std::is_same_v<std::decay_t<DetailsFactory>, std::nullptr_t>) {
+                details = make_details();
+            }
+            std::lock_guard<std::mutex> lock(audit_mutex_);
+            purple_pages_->logAuditEvent(event_type, 
+                                        "/cache/" + key, 
+                                        action, 
+                                        "CICD_BUILD",
+                                        details, 0, "", 
+                                        "SSRCacheManager", 
+                                        "INFO");
+        }
+        
+        // Only every kAuditFlushCheckEvery-th event looks at the clock; the deadline gates the lock
+        if ((sequence & (kAuditFlushCheckEvery - 1)) == 0) {
+            flushAuditSummary();
+        }
+    }
+    
     std::string generateETag(const std::string& content) {
         // Simple hash-based ETag generation
         return "\"" + std::to_string(std::hash<std::string>{}(content)) + "\"";
@@ -453,24 +782,32 @@ private:
             file << cache_json->serialize();
             file.close();
             
+            std::lock_guard<std::mutex> lock(file_cache_mutex_);
             file_cache_index_[key] = filename;
         }
     }
     
     std::pair<bool, std::string> retrieveFromFileCache(const std::string& key) {
-        auto it = file_cache_index_.find(key);
-        if (it != file_cache_index_.end()) {
-            std::ifstream file(it->second);
-            if (file.is_open()) {
-                std::string content((std::istreambuf_iterator<char>(file)),
-                                   std::istreambuf_iterator<char>());
-                file.close();
-                
-                // Parse JSON and extract content
-                // In a real implementation, we'd parse the JSON properly
-                // For now, return the raw content
-                return {true, content};
+        std::string filename;
+        {
+            std::lock_guard<std::mutex> lock(file_cache_mutex_);
+            auto it = file_cache_index_.find(key);
+            if (it == file_cache_index_.end()) {
+                return {false, ""};
             }
+            filename = it->second;
+        }
+        
+        std::ifstream file(filename);
+        if (file.is_open()) {
+            std::string content((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+            file.close();
+            
+            // Parse JSON and extract content
+            // In a real implementation, we'd parse the JSON properly
+            // For now, return the raw content
+            return {true, content};
         }
         return {false, ""};
     }
@@ -0,0 +1,564 @@
+/**
+ * LIBMEDUSASERV_HOT_RESPONSE HEADER v0.3.0a
+ * ==========================================
+ * Precompiled responses for MedusaServ hot paths
+ * Status line and headers are serialized once; the body is either an
+ * in-memory slab or an open file delivered with sendfile(). Serving a hit
+ * is a writev()/sendfile() pair with no allocation and no body copy, and a
+ * matching If-None-Match turns it into a 304 without touching the body.
+ * © 2025 The Medusa Project | Roylepython | D Hargreaves
+ */
+
+#ifndef MEDUSASERV_HOT_RESPONSE_HPP
+#define MEDUSASERV_HOT_RESPONSE_HPP
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <array>
+#include <unordered_map>
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/sendfile.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace medusaserv {
+namespace http {
+
+enum class DeliveryStatus {
+    COMPLETE,      // every byte has been handed to the kernel
+    WOULD_BLOCK,   // non-blocking socket is full; call deliver() again on EPOLLOUT
+    FAILED         // peer gone or I/O error; close the connection
+};
+
+/**
+ * Per-request delivery state. Fixed size so a connection can keep one
+ * inline; the Date line is captured at begin() so a resumed write sends
+ * the same bytes it started with.
+ */
+struct DeliveryCursor {
+    size_t offset = 0;
+    bool not_modified = false;
+    bool head_only = false;
+    bool keep_alive = true;
+    char date_line[48] = {0};
+    size_t date_length = 0;
+};
+
+inline std::string_view trim_etag_token(std::string_view token) {
+    while (!token.empty() && (token.front() == ' ' || token.front() == '\t')) {
+        token.remove_prefix(1);
+    }
+    while (!token.empty() && (token.back() == ' ' || token.back() == '\t')) {
+        token.remove_suffix(1);
+    }
+    // If-None-Match uses weak comparison (RFC 9110 13.1.2)
+    if (token.size() >= 2 && token[0] == 'W' && token[1] == '/') {
+        token.remove_prefix(2);
+    }
+    return token;
+}
+
+/**
+ * Weak comparison of an If-None-Match list against an entity tag
+ */
+inline bool etag_matches(std::string_view if_none_match, std::string_view etag) {
+    if (if_none_match.empty() || etag.empty()) {
+        return false;
+    }
+    std::string_view ours = trim_etag_token(etag);
+    while (!if_none_match.empty()) {
+        size_t comma = if_none_match.find(',');
+        std::string_view token = trim_etag_token(if_none_match.substr(0, comma));
+        if (token == "*" || token == ours) {
+            return true;
+        }
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        if_none_match.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+inline uint64_t fnv1a_hash(std::string_view data, uint64_t hash = 0xcbf29ce484222325ull) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+inline std::string format_http_date(time_t when) {
+    char buffer[64];
+    struct tm parts;
+    gmtime_r(&when, &parts);
+    size_t length = strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &parts);
+    return std::string(buffer, length);
+}
+
+/**
+ * Immutable, pre-serialized response. Share it through shared_ptr and keep
+ * a DeliveryCursor per connection.
+ */
+class HotResponse {
+public:
+    static constexpr size_t kInlineFileBytes = 64 * 1024;
+
+    HotResponse() = default;
+    HotResponse(HotResponse&& other) noexcept { *this = std::move(other); }
+    HotResponse& operator=(HotResponse&& other) noexcept {
+        if (this != &other) {
+            closeFile();
+            head_ = std::move(other.head_);
+            not_modified_head_ = std::move(other.not_modified_head_);
+            etag_ = std::move(other.etag_);
+            file_path_ = std::move(other.file_path_);
+            owner_ = std::move(other.owner_);
+            body_ = other.body_;
+            file_fd_ = other.file_fd_;
+            file_size_ = other.file_size_;
+            file_inode_ = other.file_inode_;
+            file_mtime_ns_ = other.file_mtime_ns_;
+            status_code_ = other.status_code_;
+            other.file_fd_ = -1;
+            other.body_ = {};
+        }
+        return *this;
+    }
+    HotResponse(const HotResponse&) = delete;
+    HotResponse& operator=(const HotResponse&) = delete;
+    ~HotResponse() { closeFile(); }
+
+    /**
+     * Build a response around a body the caller keeps alive. Pass an owner
+     * to tie the body's lifetime to this response; leave it empty when the
+     * response is itself a member of the object that owns the body.
+     */
+    static HotResponse fromMemory(int status_code, std::string_view content_type,
+                                  std::string_view body, std::shared_ptr<const void> owner = nullptr,
+                                  std::string_view etag = {}, std::string_view cache_control = "no-cache") {
+        HotResponse response;
+        response.status_code_ = status_code;
+        response.body_ = body;
+        response.owner_ = std::move(owner);
+        if (etag.empty()) {
+            char generated[24];
+            snprintf(generated, sizeof(generated), "\"%016llx\"",
+                     static_cast<unsigned long long>(fnv1a_hash(body)));
+            response.etag_ = generated;
+        } else {
+            response.etag_ = std::string(etag);
+        }
+        response.serializeHeads(content_type, body.size(), cache_control, {});
+        return response;
+    }
+
+    /**
+     * Open a regular file and precompile its response. Small files are read
+     * into a slab; larger ones keep the descriptor open for sendfile().
+     * @return nullptr if the path is not a readable regular file
+     */
+    static std::shared_ptr<const HotResponse> fromFile(const std::string& path, std::string_view content_type,
+                                                       std::string_view cache_control = "public, max-age=300") {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return nullptr;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            ::close(fd);
+            return nullptr;
+        }
+
+        auto response = std::make_shared<HotResponse>();
+        response->status_code_ = 200;
+        response->file_path_ = path;
+        response->file_size_ = static_cast<size_t>(info.st_size);
+        response->file_inode_ = static_cast<uint64_t>(info.st_ino);
+        response->file_mtime_ns_ = mtimeNanos(info);
+
+        if (response->file_size_ <= kInlineFileBytes) {
+            auto slab = std::make_shared<std::string>(response->file_size_, '\0');
+            size_t filled = 0;
+            while (filled < slab->size()) {
+                ssize_t got = ::pread(fd, &(*slab)[filled], slab->size() - filled, static_cast<off_t>(filled));
+                if (got < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (got <= 0) {
+                    ::close(fd);
+                    return nullptr;
+                }
+                filled += static_cast<size_t>(got);
+            }
+            ::close(fd);
+            response->body_ = *slab;
+            response->owner_ = std::move(slab);
+        } else {
+            response->file_fd_ = fd;
+        }
+
+        char etag[64];
+        snprintf(etag, sizeof(etag), "W/\"%llx-%llx-%llx\"",
+                 static_cast<unsigned long long>(response->file_inode_),
+                 static_cast<unsigned long long>(response->file_size_),
+                 static_cast<unsigned long long>(response->file_mtime_ns_));
+        response->etag_ = etag;
+        response->serializeHeads(content_type, response->file_size_, cache_control,
+                                 format_http_date(info.st_mtime));
+        return response;
+    }
+
+    /**
+     * True while the file behind this response is unchanged on disk
+     */
+    bool matchesFile(const struct stat& info) const {
+        return file_inode_ == static_cast<uint64_t>(info.st_ino) &&
+               file_size_ == static_cast<size_t>(info.st_size) &&
+               file_mtime_ns_ == mtimeNanos(info);
+    }
+
+    /**
+     * Start delivering this response for one request
+     */
+    DeliveryCursor begin(bool keep_alive, bool head_only, std::string_view if_none_match) const {
+        DeliveryCursor cursor;
+        cursor.keep_alive = keep_alive;
+        cursor.head_only = head_only;
+        cursor.not_modified = status_code_ == 200 && etag_matches(if_none_match, etag_);
+        cursor.date_length = currentDateLine(cursor.date_line, sizeof(cursor.date_line));
+        return cursor;
+    }
+
+    /**
+     * Push as much of the response as the socket accepts. Safe to call
+     * repeatedly with the same cursor on a non-blocking socket.
+     */
+    DeliveryStatus deliver(int socket_fd, DeliveryCursor& cursor) const {
+        const std::string& head = cursor.not_modified ? not_modified_head_ : head_;
+        std::string_view connection = cursor.keep_alive ? kKeepAliveLine : kCloseLine;
+        bool send_body = !cursor.not_modified && !cursor.head_only;
+        bool file_body = send_body && file_fd_ >= 0;
+
+        std::array<std::string_view, 4> segments = {
+            std::string_view(head),
+            std::string_view(cursor.date_line, cursor.date_length),
+            connection,
+            send_body && !file_body ? body_ : std::string_view()
+        };
+        size_t header_bytes = head.size() + cursor.date_length + connection.size();
+
+        while (true) {
+            struct iovec iov[4];
+            int count = 0;
+            size_t skip = cursor.offset;
+            for (std::string_view segment : segments) {
+                if (skip >= segment.size()) {
+                    skip -= segment.size();
+                    continue;
+                }
+                iov[count].iov_base = const_cast<char*>(segment.data() + skip);
+                iov[count].iov_len = segment.size() - skip;
+                skip = 0;
+                ++count;
+            }
+            if (count == 0) {
+                break;
+            }
+
+            struct msghdr message;
+            std::memset(&message, 0, sizeof(message));
+            message.msg_iov = iov;
+            message.msg_iovlen = static_cast<size_t>(count);
+            // Hold the headers back so they leave in the same segment as the file's first bytes
+            ssize_t sent = ::sendmsg(socket_fd, &message, MSG_NOSIGNAL | (file_body ? MSG_MORE : 0));
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? DeliveryStatus::WOULD_BLOCK
+                                                                 : DeliveryStatus::FAILED;
+            }
+            cursor.offset += static_cast<size_t>(sent);
+        }
+
+        if (!file_body) {
+            return DeliveryStatus::COMPLETE;
+        }
+
+        while (cursor.offset < header_bytes + file_size_) {
+            off_t file_offset = static_cast<off_t>(cursor.offset - header_bytes);
+            ssize_t sent = ::sendfile(socket_fd, file_fd_, &file_offset, file_size_ - (cursor.offset - header_bytes));
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return (errno == EAGAIN || errno == EWOULDBLOCK) ? DeliveryStatus::WOULD_BLOCK
+                                                                 : DeliveryStatus::FAILED;
+            }
+            if (sent == 0) {
+                return DeliveryStatus::FAILED;  // file truncated underneath us
+            }
+            cursor.offset += static_cast<size_t>(sent);
+        }
+        return DeliveryStatus::COMPLETE;
+    }
+
+    int statusCode() const { return status_code_; }
+    const std::string& etag() const { return etag_; }
+    const std::string& filePath() const { return file_path_; }
+    size_t bodySize() const { return file_fd_ >= 0 ? file_size_ : body_.size(); }
+    bool holdsFile() const { return file_fd_ >= 0; }
+    size_t footprint() const {
+        return sizeof(HotResponse) + head_.size() + not_modified_head_.size() + etag_.size() +
+               file_path_.size() + (owner_ ? body_.size() : 0);
+    }
+
+private:
+    static constexpr std::string_view kKeepAliveLine = "Connection: keep-alive\r\n\r\n";
+    static constexpr std::string_view kCloseLine = "Connection: close\r\n\r\n";
+
+    static uint64_t mtimeNanos(const struct stat& info) {
+        return static_cast<uint64_t>(info.st_mtim.tv_sec) * 1000000000ull +
+               static_cast<uint64_t>(info.st_mtim.tv_nsec);
+    }
+
+    // Date changes once a second, so each thread formats it at most that often
+    static size_t currentDateLine(char* out, size_t capacity) {
+        thread_local time_t cached_second = 0;
+        thread_local char cached_line[48];
+        thread_local size_t cached_length = 0;
+        time_t now = time(nullptr);
+        if (now != cached_second) {
+            struct tm parts;
+            gmtime_r(&now, &parts);
+            cached_length = strftime(cached_line, sizeof(cached_line),
+                                     "Date: %a, %d %b %Y %H:%M:%S GMT\r\n", &parts);
+            cached_second = now;
+        }
+        size_t length = cached_length < capacity ? cached_length : 0;
+        std::memcpy(out, cached_line, length);
+        return length;
+    }
+
+    static const char* reasonPhrase(int status_code) {
+        switch (status_code) {
+            case 200: return "OK";
+            case 204: return "No Content";
+            case 304: return "Not Modified";
+            case 400: return "Bad Request";
+            case 403: return "Forbidden";
+            case 404: return "Not Found";
+            case 500: return "Internal Server Error";
+            case 503: return "Service Unavailable";
+            default:  return "OK";
+        }
+    }
+
+    void serializeHeads(std::string_view content_type, size_t content_length,
+                        std::string_view cache_control, const std::string& last_modified) {
+        std::string validators;
+        validators.append("ETag: ").append(etag_).append("\r\n");
+        if (!last_modified.empty()) {
+            validators.append("Last-Modified: ").append(last_modified).append("\r\n");
+        }
+        if (!cache_control.empty()) {
+            validators.append("Cache-Control: ").append(cache_control).append("\r\n");
+        }
+
+        head_.reserve(256 + validators.size());
+        head_.append("HTTP/1.1 ").append(std::to_string(status_code_)).append(" ")
+             .append(reasonPhrase(status_code_)).append("\r\n");
+        head_.append("Server: MedusaServ v0.3.0a (Professional Native C++ Server)\r\n");
+        head_.append("Content-Type: ").append(content_type).append("\r\n");
+        head_.append("Content-Length: ").append(std::to_string(content_length)).append("\r\n");
+        head_.append(validators);
+
+        not_modified_head_.append("HTTP/1.1 304 Not Modified\r\n");
+        not_modified_head_.append("Server: MedusaServ v0.3.0a (Professional Native C++ Server)\r\n");
+        not_modified_head_.append(validators);
+    }
+
+    void closeFile() {
+        if (file_fd_ >= 0) {
+            ::close(file_fd_);
+            file_fd_ = -1;
+        }
+    }
+
+    std::string head_;               // status line + headers, no Date/Connection/blank line
+    std::string not_modified_head_;
+    std::string etag_;
+    std::string file_path_;
+    std::shared_ptr<const void> owner_;
+    std::string_view body_;
+    int file_fd_ = -1;
+    size_t file_size_ = 0;
+    uint64_t file_inode_ = 0;
+    uint64_t file_mtime_ns_ = 0;
+    int status_code_ = 200;
+};
+
+using HotResponsePtr = std::shared_ptr<const HotResponse>;
+
+/**
+ * Bounded cache of file-backed responses keyed by (root, request path).
+ * Keys are hashed straight from the caller's strings, so a hit allocates
+ * nothing; the file is re-stat()ed at most once per revalidation interval.
+ * Entries that keep a descriptor open for sendfile() are capped separately,
+ * by default at a quarter of RLIMIT_NOFILE, so the cache never starves accept().
+ */
+class HotResponseCache {
+public:
+    static constexpr size_t kShardCount = 8;
+
+    explicit HotResponseCache(size_t max_entries = 4096,
+                              std::chrono::milliseconds revalidate_interval = std::chrono::milliseconds(1000),
+                              size_t max_open_files = defaultOpenFileLimit())
+        : per_shard_limit_(perShard(max_entries)),
+          per_shard_file_limit_(perShard(max_open_files < max_entries ? max_open_files : max_entries)),
+          revalidate_interval_(revalidate_interval) {}
+
+    /**
+     * A quarter of the soft descriptor limit; the rest is left for sockets
+     */
+    static size_t defaultOpenFileLimit() {
+        struct rlimit limit;
+        if (::getrlimit(RLIMIT_NOFILE, &limit) != 0 || limit.rlim_cur == RLIM_INFINITY) {
+            return SIZE_MAX;
+        }
+        return static_cast<size_t>(limit.rlim_cur / 4);
+    }
+
+    HotResponsePtr find(std::string_view root, std::string_view request_path) {
+        uint64_t hash = keyHash(root, request_path);
+        Shard& shard = shards_[hash % kShardCount];
+        auto now = std::chrono::steady_clock::now();
+
+        HotResponsePtr response;
+        bool revalidate = false;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.slots.find(hash);
+            if (it == shard.slots.end() || it->second.root != root || it->second.request_path != request_path) {
+                return nullptr;
+            }
+            response = it->second.response;
+            if (now - it->second.validated_at >= revalidate_interval_) {
+                it->second.validated_at = now;
+                revalidate = true;
+            }
+        }
+
+        if (revalidate) {
+            struct stat info;
+            if (::stat(response->filePath().c_str(), &info) != 0 || !response->matchesFile(info)) {
+                erase(root, request_path);
+                return nullptr;
+            }
+        }
+        return response;
+    }
+
+    void insert(std::string_view root, std::string_view request_path, HotResponsePtr response) {
+        uint64_t hash = keyHash(root, request_path);
+        Shard& shard = shards_[hash % kShardCount];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto existing = shard.slots.find(hash);
+        if (existing != shard.slots.end()) {
+            release(shard, existing->second);
+        } else if (shard.slots.size() >= per_shard_limit_) {
+            release(shard, shard.slots.begin()->second);
+            shard.slots.erase(shard.slots.begin());
+        }
+        if (response && response->holdsFile()) {
+            if (shard.open_files >= per_shard_file_limit_) {
+                // Drop another descriptor-holding entry; its fd closes with the last in-flight delivery
+                for (auto it = shard.slots.begin(); it != shard.slots.end(); ++it) {
+                    if (it->first != hash && it->second.response && it->second.response->holdsFile()) {
+                        release(shard, it->second);
+                        shard.slots.erase(it);
+                        break;
+                    }
+                }
+            }
+            ++shard.open_files;
+        }
+        Slot& slot = shard.slots[hash];
+        slot.root = std::string(root);
+        slot.request_path = std::string(request_path);
+        slot.response = std::move(response);
+        slot.validated_at = std::chrono::steady_clock::now();
+    }
+
+    void erase(std::string_view root, std::string_view request_path) {
+        uint64_t hash = keyHash(root, request_path);
+        Shard& shard = shards_[hash % kShardCount];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.slots.find(hash);
+        if (it != shard.slots.end() && it->second.root == root && it->second.request_path == request_path) {
+            release(shard, it->second);
+            shard.slots.erase(it);
+        }
+    }
+
+    void clear() {
+        for (Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.slots.clear();
+            shard.open_files = 0;
+        }
+    }
+
+private:
+    struct Slot {
+        std::string root;
+        std::string request_path;
+        HotResponsePtr response;
+        std::chrono::steady_clock::time_point validated_at;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<uint64_t, Slot> slots;
+        size_t open_files = 0;   // slots whose response holds a descriptor
+    };
+
+    static size_t perShard(size_t limit) {
+        return limit / kShardCount ? limit / kShardCount : 1;
+    }
+
+    static void release(Shard& shard, const Slot& slot) {
+        if (slot.response && slot.response->holdsFile()) {
+            --shard.open_files;
+        }
+    }
+
+    static uint64_t keyHash(std::string_view root, std::string_view request_path) {
+        uint64_t hash = fnv1a_hash(root);
+        hash = fnv1a_hash(std::string_view("\0", 1), hash);
+        return fnv1a_hash(request_path, hash);
+    }
+
+    size_t per_shard_limit_;
+    size_t per_shard_file_limit_;
+    std::chrono::milliseconds revalidate_interval_;
+    std::array<Shard, kShardCount> shards_;
+};
+
+} // namespace http
+} // namespace medusaserv
+
+#endif // MEDUSASERV_HOT_RESPONSE_HPP
@@ -0,0 +1,271 @@
+/**
+ * MEDUSASERV ROUTE TABLE v1.0.0
+ * =============================
+ * Compiled path router for MedusaServ
+ * Routes are compiled into a radix tree keyed on path segments. Matching
+ * walks the request path once, returns captures as string_views into it
+ * and never allocates. A built table is immutable, so any number of
+ * threads can match against it concurrently.
+ * © 2025 The Medusa Initiative | Yorkshire Champion Standards
+ */
+
+#ifndef MEDUSASERV_ROUTE_TABLE_HPP
+#define MEDUSASERV_ROUTE_TABLE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace MedusaServ {
+namespace URLRouting {
+
+static constexpr size_t kMaxRouteCaptures = 8;
+
+/**
+ * @brief Result of a route lookup; views point into the matched path
+ */
+struct RouteMatch {
+    const std::string* pattern = nullptr;
+    const std::vector<std::string>* names = nullptr;
+    size_t route_index = 0;
+    std::array<std::string_view, kMaxRouteCaptures> values{};
+    size_t count = 0;
+
+    explicit operator bool() const { return pattern != nullptr; }
+
+    std::string_view param(std::string_view name) const {
+        if (names) {
+            for (size_t i = 0; i < count && i < names->size(); ++i) {
+                if ((*names)[i] == name) {
+                    return values[i];
+                }
+            }
+        }
+        return {};
+    }
+};
+
+/**
+ * @brief Segment radix tree mapping route patterns to handlers
+ * @details Pattern syntax, one rule per '/'-separated segment:
+ *            about          static segment
+ *            :id            parameter (whole segment, non-empty)
+ *            User=:name     parameter with a static prefix
+ *            *path          wildcard: the rest of the path, may be empty;
+ *                           only valid as the last segment
+ *          When several routes could match, static segments beat prefixed
+ *          parameters (longest prefix first), which beat plain parameters,
+ *          which beat wildcards. A trailing '/' on the request is ignored.
+ */
+template<typename Handler>
+class RouteTable {
+public:
+    static constexpr size_t kMaxCaptures = kMaxRouteCaptures;
+
+    RouteTable() { nodes_.emplace_back(); }
+
+    /**
+     * @brief Add or replace a route
+     * @return false (with error filled in) if the pattern is malformed
+     */
+    bool add(std::string_view pattern, Handler handler, std::string* error = nullptr) {
+        auto fail = [&](const char* message) {
+            if (error) {
+                *error = message;
+            }
+            return false;
+        };
+        if (pattern.empty() || pattern.front() != '/') {
+            return fail("route pattern must start with '/'");
+        }
+
+        std::vector<std::string> params;
+        int32_t node = 0;
+        std::string_view rest = pattern.substr(1);
+        while (!rest.empty()) {
+            size_t slash = rest.find('/');
+            std::string_view segment = rest.substr(0, slash);
+            rest = slash == std::string_view::npos ? std::string_view() : rest.substr(slash + 1);
+            if (segment.empty()) {
+                if (rest.empty()) {
+                    break;  // trailing slash
+                }
+                return fail("empty path segment in route pattern");
+            }
+
+            if (segment.front() == '*') {
+                if (!rest.empty()) {
+                    return fail("wildcard must be the last segment");
+                }
+                params.emplace_back(segment.substr(1));
+                if (nodes_[node].wildcard == kNone) {
+                    int32_t child = newNode();
+                    nodes_[node].wildcard = child;
+                }
+                node = nodes_[node].wildcard;
+                break;
+            }
+
+            size_t colon = segment.find(':');
+            if (colon == std::string_view::npos) {
+                node = staticChild(node, segment);
+            } else {
+                std::string_view name = segment.substr(colon + 1);
+                if (name.empty()) {
+                    return fail("parameter needs a name");
+                }
+                params.emplace_back(name);
+                node = paramChild(node, segment.substr(0, colon));
+            }
+            if (params.size() > kMaxCaptures) {
+                return fail("too many parameters in route pattern");
+            }
+        }
+
+        Route route{std::string(pattern), std::move(params), std::move(handler)};
+        if (nodes_[node].route != kNone) {
+            routes_[nodes_[node].route] = std::move(route);
+        } else {
+            nodes_[node].route = static_cast<int32_t>(routes_.size());
+            routes_.push_back(std::move(route));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Match a request path (the part before any '?'); no allocation
+     */
+    bool match(std::string_view path, RouteMatch& out) const {
+        out.pattern = nullptr;
+        out.names = nullptr;
+        out.count = 0;
+        if (path.empty() || path.front() != '/') {
+            return false;
+        }
+        return walk(0, path.substr(1), out, 0);
+    }
+
+    const Handler& handler(const RouteMatch& match) const { return routes_[match.route_index].handler; }
+
+    size_t size() const { return routes_.size(); }
+    size_t nodeCount() const { return nodes_.size(); }
+
+private:
+    static constexpr int32_t kNone = -1;
+
+    struct Route {
+        std::string pattern;
+        std::vector<std::string> params;
+        Handler handler;
+    };
+
+    struct ParamEdge {
+        std::string prefix;
+        int32_t child;
+    };
+
+    struct Node {
+        std::vector<std::pair<std::string, int32_t>> statics;  // sorted by segment
+        std::vector<ParamEdge> params;                         // longest prefix first
+        int32_t wildcard = kNone;
+        int32_t route = kNone;
+    };
+
+    int32_t newNode() {
+        nodes_.emplace_back();
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+
+    int32_t staticChild(int32_t node, std::string_view segment) {
+        auto& statics = nodes_[node].statics;
+        auto it = std::lower_bound(statics.begin(), statics.end(), segment,
+                                   [](const auto& edge, std::string_view key) { return edge.first < key; });
+        if (it != statics.end() && it->first == segment) {
+            return it->second;
+        }
+        size_t position = static_cast<size_t>(it - statics.begin());
+        int32_t child = newNode();
+        auto& edges = nodes_[node].statics;  // newNode() may have moved nodes_
+        edges.insert(edges.begin() + static_cast<std::ptrdiff_t>(position), {std::string(segment), child});
+        return child;
+    }
+
+    int32_t paramChild(int32_t node, std::string_view prefix) {
+        for (const auto& edge : nodes_[node].params) {
+            if (edge.prefix == prefix) {
+                return edge.child;
+            }
+        }
+        int32_t child = newNode();
+        auto& params = nodes_[node].params;
+        auto it = std::find_if(params.begin(), params.end(),
+                               [&](const ParamEdge& edge) { return edge.prefix.size() < prefix.size(); });
+        params.insert(it, ParamEdge{std::string(prefix), child});
+        return child;
+    }
+
+    bool finish(int32_t node, RouteMatch& out, size_t depth) const {
+        const Route& route = routes_[nodes_[node].route];
+        out.pattern = &route.pattern;
+        out.names = &route.params;
+        out.route_index = static_cast<size_t>(nodes_[node].route);
+        out.count = depth;
+        return true;
+    }
+
+    bool walk(int32_t index, std::string_view rest, RouteMatch& out, size_t depth) const {
+        const Node& node = nodes_[index];
+        if (rest.empty()) {
+            if (node.route != kNone) {
+                return finish(index, out, depth);
+            }
+            if (node.wildcard != kNone && nodes_[node.wildcard].route != kNone && depth < kMaxCaptures) {
+                out.values[depth] = rest;
+                return finish(node.wildcard, out, depth + 1);
+            }
+            return false;
+        }
+
+        size_t slash = rest.find('/');
+        std::string_view segment = rest.substr(0, slash);
+        std::string_view next = slash == std::string_view::npos ? std::string_view() : rest.substr(slash + 1);
+
+        if (!node.statics.empty()) {
+            auto it = std::lower_bound(node.statics.begin(), node.statics.end(), segment,
+                                       [](const auto& edge, std::string_view key) { return edge.first < key; });
+            if (it != node.statics.end() && it->first == segment && walk(it->second, next, out, depth)) {
+                return true;
+            }
+        }
+
+        if (depth < kMaxCaptures) {
+            for (const auto& edge : node.params) {
+                if (segment.size() > edge.prefix.size() &&
+                    segment.compare(0, edge.prefix.size(), edge.prefix) == 0) {
+                    out.values[depth] = segment.substr(edge.prefix.size());
+                    if (walk(edge.child, next, out, depth + 1)) {
+                        return true;
+                    }
+                }
+            }
+            if (node.wildcard != kNone && nodes_[node.wildcard].route != kNone) {
+                out.values[depth] = rest;
+                return finish(node.wildcard, out, depth + 1);
+            }
+        }
+        return false;
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<Route> routes_;
+};
+
+} // namespace URLRouting
+} // namespace MedusaServ
+
+#endif // MEDUSASERV_ROUTE_TABLE_HPP
@@ -0,0 +1,263 @@
+/**
+ * MEDUSASERV TIMER WHEEL v1.0.0
+ * =============================
+ * Hashed timing wheel for bulk expiry (temporary routes, sessions, leases)
+ * Scheduling is O(1) and advancing visits only the slots whose ticks have
+ * passed, so long-lived deadlines never need a scan of the whole table.
+ * Cancellation is lazy: owners tag keys with a generation and ignore stale
+ * firings instead of searching the wheel.
+ * HierarchicalTimerWheel cascades deadlines down from coarse levels, so
+ * week-long expiries are touched a handful of times instead of once per
+ * revolution.
+ * © 2025 The Medusa Initiative | Yorkshire Champion Standards
+ */
+
+#ifndef MEDUSASERV_TIMER_WHEEL_HPP
+#define MEDUSASERV_TIMER_WHEEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace MedusaServ {
+
+/**
+ * @brief Single-level hashed timer wheel (not synchronised; owner locks)
+ * @details A deadline further out than one revolution simply stays in its
+ *          slot and is re-checked each time the wheel passes it, so a 24 h
+ *          deadline on a 4096 x 1 s wheel is looked at ~21 times in total.
+ */
+template<typename Key, typename Clock = std::chrono::steady_clock>
+class TimerWheel {
+public:
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+    explicit TimerWheel(duration tick = std::chrono::seconds(1), size_t slots = 4096,
+                        time_point start = Clock::now())
+        : tick_(tick > duration::zero() ? tick : duration(1)), start_(start) {
+        size_t count = 1;
+        while (count < slots) {
+            count <<= 1;
+        }
+        slots_.resize(count);
+        mask_ = count - 1;
+    }
+
+    /**
+     * @brief Fire key once now >= deadline (deadlines in the past fire on the next advance)
+     */
+    void schedule(Key key, time_point deadline) {
+        uint64_t tick = tickOf(deadline);
+        if (tick <= current_tick_) {
+            tick = current_tick_ + 1;
+        }
+        slots_[tick & mask_].push_back(Entry{std::move(key), tick});
+        ++pending_;
+    }
+
+    /**
+     * @brief Move the wheel to now, calling fire(key) for every due entry
+     * @return Number of entries fired
+     */
+    template<typename Fire>
+    size_t advance(time_point now, Fire&& fire) {
+        uint64_t target = tickOf(now);
+        if (target <= current_tick_) {
+            return 0;
+        }
+        size_t fired = 0;
+        uint64_t steps = target - current_tick_;
+        if (steps > mask_) {
+            // Slept through a whole revolution: every slot is due for a look
+            for (auto& slot : slots_) {
+                fired += expireSlot(slot, target, fire);
+            }
+        } else {
+            for (uint64_t tick = current_tick_ + 1; tick <= target; ++tick) {
+                fired += expireSlot(slots_[tick & mask_], target, fire);
+            }
+        }
+        current_tick_ = target;
+        return fired;
+    }
+
+    /**
+     * @brief Earliest time at which advance() can fire anything new
+     */
+    time_point nextTick() const {
+        return start_ + tick_ * static_cast<typename duration::rep>(current_tick_ + 1);
+    }
+
+    size_t pending() const { return pending_; }
+    size_t slotCount() const { return slots_.size(); }
+
+private:
+    struct Entry {
+        Key key;
+        uint64_t tick;
+    };
+
+    uint64_t tickOf(time_point when) const {
+        if (when <= start_) {
+            return 0;
+        }
+        // Round up so an entry never fires before its deadline
+        auto elapsed = when - start_;
+        return static_cast<uint64_t>((elapsed + tick_ - duration(1)) / tick_);
+    }
+
+    template<typename Fire>
+    size_t expireSlot(std::vector<Entry>& slot, uint64_t target, Fire& fire) {
+        size_t fired = 0;
+        size_t i = 0;
+        while (i < slot.size()) {
+            if (slot[i].tick <= target) {
+                Key key = std::move(slot[i].key);
+                slot[i] = std::move(slot.back());
+                slot.pop_back();
+                --pending_;
+                ++fired;
+                fire(key);
+            } else {
+                ++i;
+            }
+        }
+        return fired;
+    }
+
+    duration tick_;
+    time_point start_;
+    std::vector<std::vector<Entry>> slots_;
+    size_t mask_ = 0;
+    uint64_t current_tick_ = 0;
+    size_t pending_ = 0;
+};
+
+/**
+ * @brief Multi-level timer wheel (not synchronised; owner locks)
+ * @details Level n has 64 slots of 64^n ticks each; with 1 s ticks the four
+ *          levels span 64 s, 68 min, 73 h and 194 days. An entry is placed at
+ *          the coarsest level that fits and moves down one level each time
+ *          that level's slot comes due, so every entry is touched at most
+ *          kLevels times before it fires. Deadlines beyond the top level wait
+ *          in an overflow list that is re-placed whenever the top level turns.
+ */
+template<typename Key, typename Clock = std::chrono::steady_clock>
+class HierarchicalTimerWheel {
+public:
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+    static constexpr unsigned kLevels = 4;
+    static constexpr unsigned kSlotBits = 6;
+    static constexpr uint64_t kSlots = uint64_t(1) << kSlotBits;
+
+    explicit HierarchicalTimerWheel(duration tick = std::chrono::seconds(1), time_point start = Clock::now())
+        : tick_(tick > duration::zero() ? tick : duration(1)), start_(start) {}
+
+    void schedule(Key key, time_point deadline) {
+        uint64_t tick = tickOf(deadline);
+        if (tick <= current_tick_) {
+            tick = current_tick_ + 1;
+        }
+        place(Entry{std::move(key), tick});
+        ++pending_;
+    }
+
+    /**
+     * @brief Move the wheel to now, calling fire(key) for every due entry
+     */
+    template<typename Fire>
+    size_t advance(time_point now, Fire&& fire) {
+        uint64_t target = tickOf(now);
+        size_t fired = 0;
+        while (current_tick_ < target) {
+            // Skip runs of ticks where nothing can be due or cascade
+            if (pending_ == 0) {
+                current_tick_ = target;
+                break;
+            }
+            ++current_tick_;
+            for (unsigned level = kLevels - 1; level > 0; --level) {
+                uint64_t span_mask = (uint64_t(1) << (kSlotBits * level)) - 1;
+                if ((current_tick_ & span_mask) == 0) {
+                    cascade(level);
+                }
+            }
+            if ((current_tick_ & ((uint64_t(1) << (kSlotBits * kLevels)) - 1)) == 0 && !overflow_.empty()) {
+                std::vector<Entry> waiting;
+                waiting.swap(overflow_);
+                for (auto& entry : waiting) {
+                    place(std::move(entry));
+                }
+            }
+
+            std::vector<Entry>& slot = levels_[0][current_tick_ & (kSlots - 1)];
+            if (!slot.empty()) {
+                std::vector<Entry> due;
+                due.swap(slot);
+                for (auto& entry : due) {
+                    --pending_;
+                    ++fired;
+                    fire(entry.key);
+                }
+            }
+        }
+        return fired;
+    }
+
+    time_point nextTick() const {
+        return start_ + tick_ * static_cast<typename duration::rep>(current_tick_ + 1);
+    }
+
+    size_t pending() const { return pending_; }
+
+private:
+    struct Entry {
+        Key key;
+        uint64_t tick;
+    };
+
+    uint64_t tickOf(time_point when) const {
+        if (when <= start_) {
+            return 0;
+        }
+        auto elapsed = when - start_;
+        return static_cast<uint64_t>((elapsed + tick_ - duration(1)) / tick_);
+    }
+
+    void place(Entry entry) {
+        uint64_t delta = entry.tick > current_tick_ ? entry.tick - current_tick_ : 0;
+        for (unsigned level = 0; level < kLevels; ++level) {
+            if (delta < (uint64_t(1) << (kSlotBits * (level + 1)))) {
+                uint64_t slot = (entry.tick >> (kSlotBits * level)) & (kSlots - 1);
+                levels_[level][slot].push_back(std::move(entry));
+                return;
+            }
+        }
+        overflow_.push_back(std::move(entry));
+    }
+
+    void cascade(unsigned level) {
+        uint64_t slot = (current_tick_ >> (kSlotBits * level)) & (kSlots - 1);
+        std::vector<Entry> moving;
+        moving.swap(levels_[level][slot]);
+        for (auto& entry : moving) {
+            place(std::move(entry));
+        }
+    }
+
+    duration tick_;
+    time_point start_;
+    std::vector<Entry> levels_[kLevels][kSlots];
+    std::vector<Entry> overflow_;
+    uint64_t current_tick_ = 0;
+    size_t pending_ = 0;
+};
+
+} // namespace MedusaServ
+
+#endif // MEDUSASERV_TIMER_WHEEL_HPP
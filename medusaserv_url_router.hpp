@@ -26,13 +26,21 @@
 #define MEDUSASERV_URL_ROUTER_HPP
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
-#include <regex>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <iostream>
 
+#include "medusaserv_route_table.hpp"
+#include "medusaserv_timer_wheel.hpp"
+
 namespace MedusaServ {
 namespace URLRouting {
 
@@ -40,8 +48,9 @@ struct TemporaryRoute {
     std::string username;
     std::string target_path;
     std::chrono::system_clock::time_point created_at;
-    std::chrono::system_clock::time_point last_accessed;
+    std::atomic<std::chrono::system_clock::time_point> last_accessed;
     bool is_active;
+    uint64_t generation = 0;
     std::unordered_map<std::string, std::string> permissions;
     
     TemporaryRoute(const std::string& user, const std::string& path)
@@ -58,22 +67,131 @@ struct TemporaryRoute {
     }
 };
 
+/**
+ * Route handlers receive the match and return the rewritten target path
+ */
+using RouteHandler = std::function<std::string(const RouteMatch&)>;
+
 class URLRouter {
+public:
+    using CompiledRoutes = RouteTable<RouteHandler>;
+    static constexpr const char* kUserRoutePattern = "/User=:username/*path";
+    
 private:
-    std::unordered_map<std::string, std::unique_ptr<TemporaryRoute>> temp_routes_;
-    std::regex user_param_pattern_;
+    static constexpr size_t kRouteShards = 16;
+    
+    struct RouteShard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::shared_ptr<TemporaryRoute>> routes;
+    };
+    
+    struct ExpiryKey {
+        std::string username;
+        uint64_t generation;
+    };
+    
+    // Per-thread pin on the current compiled table; refreshed only when the
+    // router publishes a new version, so lookups touch no shared cache line
+    struct RouteCache {
+        uint64_t router_id = 0;
+        uint64_t version = 0;
+        std::shared_ptr<const CompiledRoutes> table;
+        unsigned pins = 0;
+    };
+    
+    class PinnedRoutes {
+    public:
+        explicit PinnedRoutes(const URLRouter& router) {
+            RouteCache& cache = threadRouteCache();
+            if (cache.pins == 0) {
+                uint64_t version = router.routes_version_.load(std::memory_order_acquire);
+                if (cache.router_id != router.router_id_ || cache.version != version) {
+                    cache.table = std::atomic_load(&router.routes_);
+                    cache.router_id = router.router_id_;
+                    cache.version = version;
+                }
+            }
+            if (cache.router_id == router.router_id_) {
+                cache_ = &cache;
+                cache.pins++;
+                table_ = cache.table.get();
+            } else {
+                // Re-entered from another router's handler; hold our own reference
+                owned_ = std::atomic_load(&router.routes_);
+                table_ = owned_.get();
+            }
+        }
+        ~PinnedRoutes() {
+            if (cache_) {
+                cache_->pins--;
+            }
+        }
+        PinnedRoutes(const PinnedRoutes&) = delete;
+        PinnedRoutes& operator=(const PinnedRoutes&) = delete;
+        
+        const CompiledRoutes& operator*() const { return *table_; }
+        const CompiledRoutes* operator->() const { return table_; }
+        
+    private:
+        RouteCache* cache_ = nullptr;
+        const CompiledRoutes* table_ = nullptr;
+        std::shared_ptr<const CompiledRoutes> owned_;
+    };
+    
+    static RouteCache& threadRouteCache() {
+        thread_local RouteCache cache;
+        return cache;
+    }
+    
+    static uint64_t nextRouterId() {
+        static std::atomic<uint64_t> next_id{1};
+        return next_id.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    const uint64_t router_id_;
+    std::shared_ptr<const CompiledRoutes> routes_;
+    std::atomic<uint64_t> routes_version_{1};
+    std::mutex routes_write_mutex_;
+    
+    std::array<RouteShard, kRouteShards> temp_routes_;
+    std::atomic<uint64_t> next_generation_{1};
     std::chrono::hours expiry_time_;
     
+    std::mutex expiry_mutex_;
+    TimerWheel<ExpiryKey> expiry_wheel_;
+    std::atomic<std::chrono::steady_clock::rep> next_expiry_check_{0};
+    
 public:
     URLRouter() 
-        : user_param_pattern_(R"(/User=([^/]+)/?(.*)?)"),
-          expiry_time_(24) { // 24 hours expiry
+        : router_id_(nextRouterId()),
+          routes_(std::make_shared<const CompiledRoutes>()),
+          expiry_time_(24), // 24 hours expiry
+          expiry_wheel_(std::chrono::seconds(1), 4096) {
+        
+        addRoute(kUserRoutePattern, [this](const RouteMatch& match) {
+            return routeTemporary(match.param("username"), match.param("path"));
+        });
         
         std::cout << "🔗 MedusaServ URL Router initialized" << std::endl;
         std::cout << "   Temporary URL support: Active" << std::endl;
         std::cout << "   Route expiry: 24 hours" << std::endl;
     }
     
+    /**
+     * Register a route pattern (see RouteTable for the syntax)
+     * Copy-on-write: in-flight lookups keep the table they started with
+     */
+    bool addRoute(const std::string& pattern, RouteHandler handler, std::string* error = nullptr) {
+        std::lock_guard<std::mutex> lock(routes_write_mutex_);
+        auto updated = std::make_shared<CompiledRoutes>(*std::atomic_load(&routes_));
+        if (!updated->add(pattern, std::move(handler), error)) {
+            return false;
+        }
+        std::atomic_store(&routes_, std::shared_ptr<const CompiledRoutes>(std::move(updated)));
+        routes_version_.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+    
     /**
      * Parse incoming URL and extract User parameter
      */
@@ -88,15 +206,15 @@ public:
         ParsedURL result;
         result.original_url = url;
         
-        std::smatch matches;
-        if (std::regex_search(url, matches, user_param_pattern_)) {
+        PinnedRoutes routes(*this);
+        RouteMatch match;
+        std::string_view path, query;
+        splitQuery(url, path, query);
+        if (routes->match(path, match) && *match.pattern == kUserRoutePattern) {
             result.has_user_param = true;
-            result.username = matches[1].str();
-            result.remaining_path = matches[2].str();
-            
-            std::cout << "🔗 Parsed temporary URL:" << std::endl;
-            std::cout << "   Username: " << result.username << std::endl;
-            std::cout << "   Path: /" << result.remaining_path << std::endl;
+            result.username = std::string(match.param("username"));
+            result.remaining_path = std::string(match.param("path"));
+            result.remaining_path.append(query.data(), query.size());
         }
         
         return result;
@@ -108,67 +226,46 @@ public:
     bool createTemporaryRoute(const std::string& username, const std::string& target_path = "/") {
         // Security validation
         if (!isValidUsername(username)) {
-            std::cerr << "❌ Invalid username for temporary route: " << username << std::endl;
             return false;
         }
         
-        // Create or update route
-        auto route_key = "temp_" + username;
-        temp_routes_[route_key] = std::make_unique<TemporaryRoute>(username, target_path);
+        auto route = std::make_shared<TemporaryRoute>(username, target_path);
+        route->generation = next_generation_.fetch_add(1, std::memory_order_relaxed);
+        uint64_t generation = route->generation;
         
-        std::cout << "✅ Created temporary route: /User=" << username << "/" << std::endl;
-        std::cout << "   Target: " << target_path << std::endl;
-        std::cout << "   Expires: 24 hours from now" << std::endl;
+        {
+            RouteShard& shard = shardFor(username);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.routes[username] = std::move(route);
+        }
+        {
+            std::lock_guard<std::mutex> lock(expiry_mutex_);
+            expiry_wheel_.schedule(ExpiryKey{username, generation},
+                                   std::chrono::steady_clock::now() + expiry_time_);
+        }
         
         return true;
     }
     
     /**
-     * Route request through temporary URL system
+     * Route request through the compiled route table
+     * Unmatched URLs are returned unchanged for normal routing
      */
     std::string routeRequest(const std::string& url) {
-        auto parsed = parseURL(url);
+        expireDueRoutes(std::chrono::steady_clock::now());
         
-        if (!parsed.has_user_param) {
+        PinnedRoutes routes(*this);
+        RouteMatch match;
+        std::string_view path, query;
+        splitQuery(url, path, query);
+        if (!routes->match(path, match)) {
             // Normal routing
             return url;
         }
         
-        // Check if temporary route exists
-        auto route_key = "temp_" + parsed.username;
-        auto route_it = temp_routes_.find(route_key);
-        
-        if (route_it == temp_routes_.end()) {
-            // Create new temporary route
-            if (createTemporaryRoute(parsed.username)) {
-                route_it = temp_routes_.find(route_key);
-            } else {
-                return "/error/invalid_route";
-            }
-        }
-        
-        auto& route = route_it->second;
-        
-        // Check if route has expired
-        if (isRouteExpired(route.get())) {
-            std::cout << "⏰ Temporary route expired for user: " << parsed.username << std::endl;
-            temp_routes_.erase(route_it);
-            return "/error/route_expired";
-        }
-        
-        // Update access time
-        route->last_accessed = std::chrono::system_clock::now();
-        
-        // Build target path
-        std::string target_path = "/web/site/" + parsed.username + "/";
-        if (!parsed.remaining_path.empty()) {
-            target_path += parsed.remaining_path;
-        }
-        
-        std::cout << "🎯 Routed temporary URL: " << url << std::endl;
-        std::cout << "   Target: " << target_path << std::endl;
-        
-        return target_path;
+        std::string target = routes->handler(match)(match);
+        target.append(query.data(), query.size());
+        return target;
     }
     
     /**
@@ -178,69 +275,144 @@ public:
         std::cout << std::endl << "🔗 TEMPORARY ROUTE STATUS" << std::endl;
         std::cout << "========================" << std::endl;
         
-        if (temp_routes_.empty()) {
+        if (getActiveRouteCount() == 0) {
             std::cout << "No active temporary routes" << std::endl;
             return;
         }
         
         auto now = std::chrono::system_clock::now();
         
-        for (const auto& [key, route] : temp_routes_) {
-            auto hours_since_created = std::chrono::duration_cast<std::chrono::hours>(
-                now - route->created_at).count();
-            auto hours_since_accessed = std::chrono::duration_cast<std::chrono::hours>(
-                now - route->last_accessed).count();
-            
-            std::cout << "Route: /User=" << route->username << "/" << std::endl;
-            std::cout << "  Target: " << route->target_path << std::endl;
-            std::cout << "  Created: " << hours_since_created << " hours ago" << std::endl;
-            std::cout << "  Last Access: " << hours_since_accessed << " hours ago" << std::endl;
-            std::cout << "  Status: " << (route->is_active ? "Active" : "Inactive") << std::endl;
-            std::cout << "  Expires In: " << (24 - hours_since_created) << " hours" << std::endl;
-            std::cout << std::endl;
+        for (const auto& shard : temp_routes_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto& [key, route] : shard.routes) {
+                auto hours_since_created = std::chrono::duration_cast<std::chrono::hours>(
+                    now - route->created_at).count();
+                auto hours_since_accessed = std::chrono::duration_cast<std::chrono::hours>(
+                    now - route->last_accessed.load(std::memory_order_relaxed)).count();
+                
+                std::cout << "Route: /User=" << route->username << "/" << std::endl;
+                std::cout << "  Target: " << route->target_path << std::endl;
+                std::cout << "  Created: " << hours_since_created << " hours ago" << std::endl;
+                std::cout << "  Last Access: " << hours_since_accessed << " hours ago" << std::endl;
+                std::cout << "  Status: " << (route->is_active ? "Active" : "Inactive") << std::endl;
+                std::cout << "  Expires In: " << (expiry_time_.count() - hours_since_created) << " hours" << std::endl;
+                std::cout << std::endl;
+            }
         }
     }
     
     /**
-     * Clean up expired routes
+     * Clean up expired routes (drives the expiry wheel up to now)
      */
     void cleanupExpiredRoutes() {
-        auto it = temp_routes_.begin();
-        while (it != temp_routes_.end()) {
-            if (isRouteExpired(it->second.get())) {
-                std::cout << "🧹 Cleaning up expired route for user: " << it->second->username << std::endl;
-                it = temp_routes_.erase(it);
-            } else {
-                ++it;
-            }
-        }
+        std::lock_guard<std::mutex> lock(expiry_mutex_);
+        advanceExpiry(std::chrono::steady_clock::now());
     }
     
     /**
      * Get active route count
      */
     size_t getActiveRouteCount() const {
-        return temp_routes_.size();
+        size_t total = 0;
+        for (const auto& shard : temp_routes_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            total += shard.routes.size();
+        }
+        return total;
+    }
+    
+    size_t getCompiledRouteCount() const {
+        return std::atomic_load(&routes_)->size();
     }
 
 private:
-    bool isValidUsername(const std::string& username) {
+    std::string routeTemporary(std::string_view username, std::string_view remaining_path) {
+        std::string name(username);
+        std::shared_ptr<TemporaryRoute> route = findTemporaryRoute(name);
+        
+        if (!route) {
+            // Create new temporary route
+            if (!createTemporaryRoute(name)) {
+                return "/error/invalid_route";
+            }
+        } else {
+            // Update access time
+            route->last_accessed.store(std::chrono::system_clock::now(), std::memory_order_relaxed);
+        }
+        
+        // Build target path
+        std::string target_path;
+        target_path.reserve(11 + name.size() + remaining_path.size());
+        target_path.append("/web/site/").append(name).append("/");
+        target_path.append(remaining_path.data(), remaining_path.size());
+        return target_path;
+    }
+    
+    std::shared_ptr<TemporaryRoute> findTemporaryRoute(const std::string& username) const {
+        const RouteShard& shard = shardFor(username);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.routes.find(username);
+        return it == shard.routes.end() ? nullptr : it->second;
+    }
+    
+    RouteShard& shardFor(const std::string& username) {
+        return temp_routes_[std::hash<std::string>{}(username) % kRouteShards];
+    }
+    const RouteShard& shardFor(const std::string& username) const {
+        return temp_routes_[std::hash<std::string>{}(username) % kRouteShards];
+    }
+    
+    /**
+     * Opportunistic expiry from the request path: at most once per wheel tick,
+     * and only by whichever thread wins the try_lock
+     */
+    void expireDueRoutes(std::chrono::steady_clock::time_point now) {
+        auto now_count = now.time_since_epoch().count();
+        if (now_count < next_expiry_check_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(expiry_mutex_, std::try_to_lock);
+        if (lock.owns_lock()) {
+            advanceExpiry(now);
+        }
+    }
+    
+    // Caller holds expiry_mutex_
+    void advanceExpiry(std::chrono::steady_clock::time_point now) {
+        expiry_wheel_.advance(now, [this](const ExpiryKey& key) {
+            RouteShard& shard = shardFor(key.username);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto it = shard.routes.find(key.username);
+            // A recreated route has a newer generation and its own wheel entry
+            if (it != shard.routes.end() && it->second->generation == key.generation) {
+                shard.routes.erase(it);
+            }
+        });
+        next_expiry_check_.store(expiry_wheel_.nextTick().time_since_epoch().count(),
+                                 std::memory_order_relaxed);
+    }
+    
+    static void splitQuery(std::string_view url, std::string_view& path, std::string_view& query) {
+        size_t mark = url.find_first_of("?#");
+        path = url.substr(0, mark);
+        query = mark == std::string_view::npos ? std::string_view() : url.substr(mark);
+    }
+    
+    static bool isValidUsername(std::string_view username) {
         // Basic security validation
         if (username.empty() || username.length() > 50) {
             return false;
         }
         
         // Only allow alphanumeric and safe characters
-        std::regex safe_pattern(R"(^[a-zA-Z0-9_-]+$)");
-        return std::regex_match(username, safe_pattern);
-    }
-    
-    bool isRouteExpired(const TemporaryRoute* route) {
-        auto now = std::chrono::system_clock::now();
-        auto time_since_created = std::chrono::duration_cast<std::chrono::hours>(
-            now - route->created_at);
-        
-        return time_since_created >= expiry_time_;
+        for (char c : username) {
+            bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                        (c >= '0' && c <= '9') || c == '_' || c == '-';
+            if (!safe) {
+                return false;
+            }
+        }
+        return true;
     }
 };
 
@@ -250,4 +422,4 @@ extern URLRouter g_url_router;
 } // namespace URLRouting
 } // namespace MedusaServ
 
-#endif // MEDUSASERV_URL_ROUTER_HPP
\ No newline at end of file
+#endif // MEDUSASERV_URL_ROUTER_HPP
@@ -30,11 +30,16 @@
 #include <thread>
 #include <regex>
 
+#include "../medusa_work_stealing_executor.hpp"
+#include "../medusa_socket_readiness.hpp"
+
 class MedusaServAuth {
 private:
     int server_socket;
     bool server_running;
     int port;
+    // Sockets reach the executor only once readable: a silent client never holds a worker
+    MedusaServ::Executor::ReadinessGate readiness_gate;
 
 public:
     MedusaServAuth(int listen_port = 80) : server_socket(-1), server_running(false), port(listen_port) {}
@@ -682,7 +687,7 @@ Connection: close
         std::cout << "📊 === END FORENSICS ===" << std::endl;
     }
 
-    void handle_client(int client_socket, const std::string& client_ip = "") {
+    void handle_client(int client_socket, const std::string& client_ip, const std::string& request) {
         log_connection_forensics(client_socket, client_ip);
         std::cout << "🔍 Connection from IP: " << client_ip << std::endl;
         
@@ -709,17 +714,11 @@ Connection: close
         
         std::cout << "✅ IP " << client_ip << " whitelisted - allowing access" << std::endl;
         
-        char buffer[4096];
-        int bytes_read = read(client_socket, buffer, sizeof(buffer) - 1);
-        
-        if (bytes_read <= 0) {
+        if (request.empty()) {
             close(client_socket);
             return;
         }
         
-        buffer[bytes_read] = '\0';
-        std::string request(buffer);
-        
         std::istringstream iss(request);
         std::string method, path, protocol;
         iss >> method >> path >> protocol;
@@ -777,6 +776,7 @@ Connection: close
         std::cout << "🔮 Native Lamia processing enabled - Yorkshire Champion Standards" << std::endl;
         
         server_running = true;
+        readiness_gate.start();
         
         while (server_running) {
             sockaddr_in client_address;
@@ -789,7 +789,23 @@ Connection: close
                 inet_ntop(AF_INET, &(client_address.sin_addr), client_ip_str, INET_ADDRSTRLEN);
                 std::string client_ip(client_ip_str);
                 
-                std::thread(&MedusaServAuth::handle_client, this, client_socket, client_ip).detach();
+                auto dispatch = [this, client_ip](int ready_socket, std::string request) {
+                    bool queued = MedusaServ::Executor::WorkStealingExecutor::shared().submit(
+                        [this, ready_socket, client_ip, request = std::move(request)]() {
+                            handle_client(ready_socket, client_ip, request);
+                        });
+                    if (!queued) {
+                        // Executor saturated: refuse rather than spawn another thread
+                        std::string busy_response = "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+                        send(ready_socket, busy_response.c_str(), busy_response.length(), MSG_NOSIGNAL);
+                        close(ready_socket);
+                    }
+                };
+                // The gate reads the whole request, so workers never wait on the client
+                if (!readiness_gate.watchRequest(client_socket, dispatch)) {
+                    MedusaServ::Executor::ReadinessGate::setTimeouts(client_socket, std::chrono::seconds(5));
+                    dispatch(client_socket, MedusaServ::Executor::ReadinessGate::readRequest(client_socket));
+                }
             }
         }
         
@@ -801,6 +817,7 @@ Connection: close
         if (server_socket >= 0) {
             close(server_socket);
         }
+        readiness_gate.stop();
     }
 };
 
@@ -24,6 +24,9 @@
 #include <signal.h>
 #include <fcntl.h>
 
+#include "../../../medusa_work_stealing_executor.hpp"
+#include "../../../medusa_socket_readiness.hpp"
+
 // Forward declarations for established library functions
 extern "C" {
     // Established library function declarations
@@ -42,12 +45,15 @@ private:
     int server_socket_;
     int port_;
     std::string server_version_;
-    std::vector<std::thread> worker_threads_;
+    MedusaServ::Executor::WorkStealingExecutor& executor_;
+    std::atomic<int> in_flight_;
+    MedusaServ::Executor::ReadinessGate readiness_gate_;   // executor workers only see readable sockets
     
 public:
     NativeMedusaServ(int port = 2000) 
         : running_(false), server_socket_(-1), port_(port), 
-          server_version_("MedusaServ v0.3.0a (Professional Native C++ Server)") {
+          server_version_("MedusaServ v0.3.0a (Professional Native C++ Server)"),
+          executor_(MedusaServ::Executor::WorkStealingExecutor::shared()), in_flight_(0) {
         
         std::cout << "🚀 Initializing Native C++ MedusaServ v0.3.0a..." << std::endl;
         std::cout << "🔬 Ground Up methodology - established libraries active" << std::endl;
@@ -131,11 +137,7 @@ public:
         std::cout << "👑 Native C++ MedusaServ is now OPERATIONAL" << std::endl;
         std::cout << "⚡ Maximum performance with established library support" << std::endl;
         
-        // Start worker threads for handling connections
-        const int num_workers = std::thread::hardware_concurrency();
-        for (int i = 0; i < num_workers; ++i) {
-            worker_threads_.emplace_back(&NativeMedusaServ::worker_thread, this);
-        }
+        readiness_gate_.start();
         
         // Main accept loop
         while (running_) {
@@ -144,8 +146,13 @@ public:
             
             int client_socket = accept(server_socket_, (struct sockaddr*)&client_address, &client_len);
             if (client_socket >= 0) {
-                // Handle connection in separate thread
-                std::thread(&NativeMedusaServ::handle_connection, this, client_socket).detach();
+                // Read the whole request off the executor, then handle it on a worker
+                if (!readiness_gate_.watchRequest(client_socket, [this](int ready_socket, std::string request) {
+                        dispatch(ready_socket, std::move(request));
+                    })) {
+                    MedusaServ::Executor::ReadinessGate::setTimeouts(client_socket, std::chrono::seconds(5));
+                    dispatch(client_socket, MedusaServ::Executor::ReadinessGate::readRequest(client_socket));
+                }
             }
         }
     }
@@ -159,11 +166,10 @@ public:
                 server_socket_ = -1;
             }
             
-            // Wait for worker threads
-            for (auto& thread : worker_threads_) {
-                if (thread.joinable()) {
-                    thread.join();
-                }
+            // Drop sockets that never sent a request, then wait for those running on the executor
+            readiness_gate_.stop();
+            while (in_flight_.load() > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
             }
             
             std::cout << std::endl;
@@ -173,26 +179,29 @@ public:
     }
     
 private:
-    void worker_thread() {
-        while (running_) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            // Worker thread for connection pool management
+    void dispatch(int client_socket, std::string request) {
+        in_flight_.fetch_add(1);
+        bool queued = executor_.submit([this, client_socket, request = std::move(request)]() {
+            handle_connection(client_socket, request);
+            in_flight_.fetch_sub(1);
+        });
+        if (!queued) {
+            // Injection queue full: shed load instead of spawning threads
+            in_flight_.fetch_sub(1);
+            static const char busy[] = "HTTP/1.1 503 Service Unavailable\r\n"
+                                       "Content-Length: 0\r\nConnection: close\r\n\r\n";
+            send(client_socket, busy, sizeof(busy) - 1, MSG_NOSIGNAL);
+            close(client_socket);
         }
     }
     
-    void handle_connection(int client_socket) {
-        char buffer[4096];
-        ssize_t bytes_read = recv(client_socket, buffer, sizeof(buffer) - 1, 0);
-        
-        if (bytes_read > 0) {
-            buffer[bytes_read] = '\0';
-            std::string request(buffer);
-            
+    void handle_connection(int client_socket, const std::string& request) {
+        if (!request.empty()) {
             // Parse HTTP request
             std::string response = process_request(request);
             
             // Send response
-            send(client_socket, response.c_str(), response.length(), 0);
+            send(client_socket, response.c_str(), response.length(), MSG_NOSIGNAL);
         }
         
         close(client_socket);